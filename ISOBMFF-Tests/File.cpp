@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        File.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF.hpp>
+#include <ISOBMFF/HEIFReader.hpp>
+#include <ISOBMFF/BinaryFileOutputStream.hpp>
+#include <XSTest/XSTest.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+static std::string            ExampleFile( const std::string & name );
+static std::vector< uint8_t > Load( const std::string & path );
+
+XSTest( ISOBMFF_File, WriteWithoutSource )
+{
+    std::string     path( "ISOBMFF-Tests-File.heic" );
+    ISOBMFF::Parser parser( ExampleFile( "IMG1.HEIC" ) );
+    
+    /* Without a source, all boxes are encoded, including the mdat box and its 64-bit header */
+    {
+        ISOBMFF::BinaryFileOutputStream stream( path );
+        
+        parser.GetFile()->Write( stream );
+    }
+    
+    ASSERT_TRUE( Load( path ) == Load( ExampleFile( "IMG1.HEIC" ) ) );
+    
+    {
+        ISOBMFF::HEIFReader original( ExampleFile( "IMG1.HEIC" ) );
+        ISOBMFF::HEIFReader written( path );
+        
+        ASSERT_TRUE( written.GetThumbnail() != nullptr );
+        ASSERT_TRUE( written.GetThumbnail()->GetData() == original.GetThumbnail()->GetData() );
+        ASSERT_TRUE( written.GetExifData().size() > 0 );
+        ASSERT_TRUE( written.GetExifData() == original.GetExifData() );
+    }
+    
+    std::remove( path.c_str() );
+}
+
+static std::string ExampleFile( const std::string & name )
+{
+    std::string path( __FILE__ );
+    
+    path = path.substr( 0, path.find_last_of( "/\\" ) + 1 );
+    
+    return path + "../Example-Files/" + name;
+}
+
+static std::vector< uint8_t > Load( const std::string & path )
+{
+    std::ifstream stream( path, std::ios::binary );
+    
+    return std::vector< uint8_t >( std::istreambuf_iterator< char >( stream ), std::istreambuf_iterator< char >() );
+}
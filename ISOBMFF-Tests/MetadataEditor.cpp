@@ -0,0 +1,225 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        MetadataEditor.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF.hpp>
+#include <ISOBMFF/MetadataEditor.hpp>
+#include <XSTest/XSTest.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+static std::string            ExampleFile( const std::string & name );
+static std::vector< uint8_t > Load( const std::string & path );
+static void                   Store( const std::string & path, const std::vector< uint8_t > & data );
+
+template< class T >
+static std::shared_ptr< T > Find( const ISOBMFF::Container & container, const std::string & name );
+
+XSTest( ISOBMFF_MetadataEditor, SaveNCLCColour )
+{
+    std::string            path( "ISOBMFF-Tests-MetadataEditor.mov" );
+    std::vector< uint8_t > original( Load( ExampleFile( "MOV1.MOV" ) ) );
+    std::vector< uint8_t > data;
+    size_t                 changes;
+    
+    ASSERT_TRUE( original.size() > 0 );
+    
+    Store( path, original );
+    
+    {
+        ISOBMFF::MetadataEditor editor( path );
+        
+        ASSERT_EQ( Find< ISOBMFF::COLR >( *( editor.GetFile() ), "colr" )->GetColourType(), "nclc" );
+        
+        Find< ISOBMFF::COLR >( *( editor.GetFile() ), "colr" )->SetColourPrimaries( 9 );
+        
+        ASSERT_EQ( editor.Save(), 1 );
+    }
+    
+    data    = Load( path );
+    changes = 0;
+    
+    ASSERT_EQ( data.size(), original.size() );
+    
+    for( size_t i = 0; i < data.size(); i++ )
+    {
+        changes += ( data[ i ] != original[ i ] ) ? 1 : 0;
+    }
+    
+    ASSERT_EQ( changes, 1 );
+    
+    {
+        ISOBMFF::Parser parser( path );
+        
+        ASSERT_EQ( Find< ISOBMFF::COLR >( *( parser.GetFile() ), "colr" )->GetColourType(),      "nclc" );
+        ASSERT_EQ( Find< ISOBMFF::COLR >( *( parser.GetFile() ), "colr" )->GetColourPrimaries(), 9 );
+        ASSERT_EQ( Find< ISOBMFF::HVC1 >( *( parser.GetFile() ), "hvc1" )->GetSourceSize(),      682 );
+    }
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_MetadataEditor, RefuseLossyEncoding )
+{
+    std::string            path( "ISOBMFF-Tests-MetadataEditor.mov" );
+    std::vector< uint8_t > original( Load( ExampleFile( "MOV1.MOV" ) ) );
+    
+    ASSERT_TRUE( original.size() > 0 );
+    
+    /* Reserved bytes of the hvc1 sample entry, which are not kept */
+    original[ 589 ] = 0x42;
+    
+    Store( path, original );
+    
+    {
+        ISOBMFF::MetadataEditor editor( path );
+        
+        std::shared_ptr< ISOBMFF::HVC1 > hvc1( Find< ISOBMFF::HVC1 >( *( editor.GetFile() ), "hvc1" ) );
+        
+        hvc1->SetWidth( hvc1->GetWidth() );
+        
+        ASSERT_ANY_THROW( editor.Save() );
+    }
+    
+    ASSERT_TRUE( Load( path ) == original );
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_MetadataEditor, EncodeNestedBoxesOnly )
+{
+    std::string path( "ISOBMFF-Tests-MetadataEditor.heic" );
+    std::string error;
+    
+    Store( path, Load( ExampleFile( "IMG1.HEIC" ) ) );
+    
+    {
+        ISOBMFF::MetadataEditor          editor( path );
+        std::shared_ptr< ISOBMFF::HDLR > hdlr( Find< ISOBMFF::HDLR >( *( editor.GetFile() ), "hdlr" ) );
+        
+        hdlr->SetHandlerName( hdlr->GetHandlerName() + "ABCD" );
+        
+        try
+        {
+            editor.Save();
+        }
+        catch( const std::exception & e )
+        {
+            error = e.what();
+        }
+    }
+    
+    /* The error names the HDLR box, not the META box containing it */
+    ASSERT_TRUE( error.find( "hdlr" ) != std::string::npos );
+    
+    std::remove( path.c_str() );
+}
+
+XSTest( ISOBMFF_MetadataEditor, SavePIXIBitDepth )
+{
+    std::string path( "ISOBMFF-Tests-MetadataEditor.heic" );
+    
+    Store( path, Load( ExampleFile( "IMG2.HEIC" ) ) );
+    
+    {
+        ISOBMFF::MetadataEditor         editor( path );
+        std::shared_ptr< ISOBMFF::PIXI > pixi( Find< ISOBMFF::PIXI >( *( editor.GetFile() ), "pixi" ) );
+        
+        ASSERT_TRUE( pixi != nullptr );
+        ASSERT_TRUE( pixi->GetChannels().size() > 0 );
+        
+        for( size_t i = 0; i < pixi->GetChannels().size(); i++ )
+        {
+            pixi->SetBitsPerChannel( i, 10 );
+        }
+        
+        ASSERT_ANY_THROW( pixi->SetBitsPerChannel( pixi->GetChannels().size(), 10 ) );
+        ASSERT_EQ( editor.Save(), pixi->GetChannels().size() );
+    }
+    
+    {
+        ISOBMFF::Parser parser( path );
+        
+        for( const auto & channel: Find< ISOBMFF::PIXI >( *( parser.GetFile() ), "pixi" )->GetChannels() )
+        {
+            ASSERT_EQ( channel->GetBitsPerChannel(), 10 );
+        }
+    }
+    
+    std::remove( path.c_str() );
+}
+
+static std::string ExampleFile( const std::string & name )
+{
+    std::string path( __FILE__ );
+    
+    path = path.substr( 0, path.find_last_of( "/\\" ) + 1 );
+    
+    return path + "../Example-Files/" + name;
+}
+
+static std::vector< uint8_t > Load( const std::string & path )
+{
+    std::ifstream stream( path, std::ios::binary );
+    
+    return std::vector< uint8_t >( std::istreambuf_iterator< char >( stream ), std::istreambuf_iterator< char >() );
+}
+
+static void Store( const std::string & path, const std::vector< uint8_t > & data )
+{
+    std::ofstream stream( path, std::ios::binary );
+    
+    stream.write( reinterpret_cast< const char * >( data.data() ), static_cast< std::streamsize >( data.size() ) );
+}
+
+template< class T >
+static std::shared_ptr< T > Find( const ISOBMFF::Container & container, const std::string & name )
+{
+    for( const auto & box: container.GetBoxes() )
+    {
+        std::shared_ptr< ISOBMFF::Container > nested;
+        std::shared_ptr< T >                  found;
+        
+        if( box->GetName() == name )
+        {
+            return std::dynamic_pointer_cast< T >( box );
+        }
+        
+        nested = std::dynamic_pointer_cast< ISOBMFF::Container >( box );
+        found  = ( nested != nullptr ) ? Find< T >( *( nested ), name ) : nullptr;
+        
+        if( found != nullptr )
+        {
+            return found;
+        }
+    }
+    
+    return nullptr;
+}
@@ -37,6 +37,10 @@
 #include <ISOBMFF/BinaryStream.hpp>
 #include <ISOBMFF/BinaryDataStream.hpp>
 #include <ISOBMFF/BinaryFileStream.hpp>
+#include <ISOBMFF/BinaryMappedFileStream.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+#include <ISOBMFF/BinaryFileOutputStream.hpp>
 #include <ISOBMFF/DisplayableObject.hpp>
 #include <ISOBMFF/DisplayableObjectContainer.hpp>
 #include <ISOBMFF/Box.hpp>
@@ -57,6 +61,7 @@
 #include <ISOBMFF/URL.hpp>
 #include <ISOBMFF/URN.hpp>
 #include <ISOBMFF/ILOC.hpp>
+#include <ISOBMFF/IDAT.hpp>
 #include <ISOBMFF/IREF.hpp>
 #include <ISOBMFF/INFE.hpp>
 #include <ISOBMFF/IROT.hpp>
@@ -75,10 +80,58 @@
 #include <ISOBMFF/STSD.hpp>
 #include <ISOBMFF/STSS.hpp>
 #include <ISOBMFF/STTS.hpp>
+#include <ISOBMFF/STSZ.hpp>
+#include <ISOBMFF/STZ2.hpp>
+#include <ISOBMFF/STCO.hpp>
+#include <ISOBMFF/CO64.hpp>
+#include <ISOBMFF/STSC.hpp>
+#include <ISOBMFF/CTTS.hpp>
+#include <ISOBMFF/ELST.hpp>
+#include <ISOBMFF/MEHD.hpp>
+#include <ISOBMFF/TREX.hpp>
+#include <ISOBMFF/MFHD.hpp>
+#include <ISOBMFF/TFHD.hpp>
+#include <ISOBMFF/TFDT.hpp>
+#include <ISOBMFF/TRUN.hpp>
+#include <ISOBMFF/SIDX.hpp>
+#include <ISOBMFF/TFRA.hpp>
+#include <ISOBMFF/MFRO.hpp>
+#include <ISOBMFF/TENC.hpp>
+#include <ISOBMFF/PSSH.hpp>
+#include <ISOBMFF/SENC.hpp>
+#include <ISOBMFF/SAIZ.hpp>
+#include <ISOBMFF/SAIO.hpp>
+#include <ISOBMFF/SBGP.hpp>
+#include <ISOBMFF/SGPD.hpp>
+#include <ISOBMFF/SampleTable.hpp>
+#include <ISOBMFF/Timeline.hpp>
+#include <ISOBMFF/BufferPool.hpp>
+#include <ISOBMFF/TrackReader.hpp>
+#include <ISOBMFF/Demuxer.hpp>
+#include <ISOBMFF/FragmentIndex.hpp>
+#include <ISOBMFF/RangePlanner.hpp>
+#include <ISOBMFF/EncryptionIndex.hpp>
+#include <ISOBMFF/SampleDecryptor.hpp>
+#include <ISOBMFF/MetadataEditor.hpp>
+#include <ISOBMFF/FastStart.hpp>
+#include <ISOBMFF/Segmenter.hpp>
+#include <ISOBMFF/FragmentedMuxer.hpp>
+#include <ISOBMFF/HEIFWriter.hpp>
 #include <ISOBMFF/FRMA.hpp>
 #include <ISOBMFF/SCHM.hpp>
 #include <ISOBMFF/HVC1.hpp>
 #include <ISOBMFF/AVC1.hpp>
+#include <ISOBMFF/ItemReader.hpp>
+#include <ISOBMFF/NAL.hpp>
+#include <ISOBMFF/BitReader.hpp>
+#include <ISOBMFF/HEVCProfileTierLevel.hpp>
+#include <ISOBMFF/HEVCVPS.hpp>
+#include <ISOBMFF/HEVCSPS.hpp>
+#include <ISOBMFF/AVCSPS.hpp>
+#include <ISOBMFF/AnnexBAssembler.hpp>
+#include <ISOBMFF/ItemReferenceGraph.hpp>
+#include <ISOBMFF/GridPlan.hpp>
+#include <ISOBMFF/HEIFReader.hpp>
 
 #ifdef _WIN32
 #include <ISOBMFF/WIN32.hpp>
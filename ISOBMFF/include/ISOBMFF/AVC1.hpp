@@ -54,6 +54,9 @@ namespace ISOBMFF
             void ReadData( Parser & parser, BinaryStream & stream ) override;
             void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
 
+            uint64_t GetDataSize()                              const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
+            
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
 
             uint16_t    GetDataReferenceIndex() const;
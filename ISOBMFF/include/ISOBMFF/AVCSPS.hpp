@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      AVCSPS.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_AVC_SPS_HPP
+#define ISOBMFF_AVC_SPS_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/AVCC.hpp>
+#include <cstdint>
+#include <cstddef>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       AVCSPS
+     * @abstract    AVC sequence parameter set (ISO/IEC 14496-10 7.3.2.1).
+     * @discussion  Parsing stops after the VUI timing information, so only
+     *              the fields describing the pictures (size, format,
+     *              colour, frame rate) are available.
+     */
+    class ISOBMFF_EXPORT AVCSPS
+    {
+        public:
+            
+            /*!
+             * @function    AVCSPS
+             * @abstract    Parses an SPS NAL unit.
+             * @param       data    The NAL unit, including its header, with emulation prevention bytes.
+             * @param       size    The size of the NAL unit.
+             */
+            AVCSPS( const uint8_t * data, size_t size );
+            
+            /*!
+             * @function    AVCSPS
+             * @abstract    Parses the first SPS of an AVC decoder configuration.
+             * @param       avcC    The AVC decoder configuration.
+             * @discussion  Throws if the configuration has no SPS.
+             */
+            AVCSPS( const AVCC & avcC );
+            
+            AVCSPS( const AVCSPS & o );
+            AVCSPS( AVCSPS && o ) noexcept;
+            virtual ~AVCSPS();
+            
+            AVCSPS & operator =( AVCSPS o );
+            
+            uint8_t  GetProfileIDC()              const;
+            uint8_t  GetConstraintFlags()         const;
+            uint8_t  GetLevelIDC()                const;
+            uint32_t GetSPSID()                   const;
+            uint32_t GetChromaFormatIDC()         const;
+            bool     GetSeparateColourPlaneFlag() const;
+            uint8_t  GetBitDepthLuma()            const;
+            uint8_t  GetBitDepthChroma()          const;
+            uint32_t GetLog2MaxFrameNum()         const;
+            uint32_t GetPicOrderCountType()       const;
+            uint32_t GetMaxNumRefFrames()         const;
+            uint32_t GetPicWidthInMBs()           const;
+            uint32_t GetPicHeightInMapUnits()     const;
+            bool     GetFrameMBsOnlyFlag()        const;
+            uint32_t GetFrameCropLeftOffset()     const;
+            uint32_t GetFrameCropRightOffset()    const;
+            uint32_t GetFrameCropTopOffset()      const;
+            uint32_t GetFrameCropBottomOffset()   const;
+            bool     HasVUI()                     const;
+            uint16_t GetSARWidth()                const;
+            uint16_t GetSARHeight()               const;
+            bool     HasColourDescription()       const;
+            bool     GetVideoFullRangeFlag()      const;
+            uint8_t  GetColourPrimaries()         const;
+            uint8_t  GetTransferCharacteristics() const;
+            uint8_t  GetMatrixCoefficients()      const;
+            bool     HasTimingInfo()              const;
+            uint32_t GetNumUnitsInTick()          const;
+            uint32_t GetTimeScale()               const;
+            
+            /*!
+             * @function    GetWidth
+             * @abstract    Gets the width of the frames, with the cropping rectangle applied.
+             * @result      The cropped width, in luma samples.
+             */
+            uint32_t GetWidth() const;
+            
+            /*!
+             * @function    GetHeight
+             * @abstract    Gets the height of the frames, with the cropping rectangle applied.
+             * @result      The cropped height, in luma samples.
+             */
+            uint32_t GetHeight() const;
+            
+            /*!
+             * @function    GetFrameRate
+             * @abstract    Gets the frame rate, from the VUI timing information.
+             * @result      The frame rate, or 0 if not available.
+             * @discussion  AVC timing counts fields, so a frame lasts two ticks.
+             */
+            double GetFrameRate() const;
+            
+            ISOBMFF_EXPORT friend void swap( AVCSPS & o1, AVCSPS & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_AVC_SPS_HPP */
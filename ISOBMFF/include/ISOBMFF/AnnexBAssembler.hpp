@@ -0,0 +1,176 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      AnnexBAssembler.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_ANNEX_B_ASSEMBLER_HPP
+#define ISOBMFF_ANNEX_B_ASSEMBLER_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/HVCC.hpp>
+#include <ISOBMFF/AVCC.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       AnnexBAssembler
+     * @abstract    Converts HEVC/AVC data from ISOBMFF to Annex-B form.
+     * @discussion  Items and samples store NAL units prefixed by their
+     *              length, while decoders usually expect start codes
+     *              (ISO/IEC 14496-10/23008-2 Annex B), preceded by the
+     *              parameter sets from the decoder configuration.
+     *              The parameter sets are converted once, when creating
+     *              the assembler, and the output size is computed up
+     *              front, so converting data requires a single
+     *              allocation, or none with a caller-provided buffer.
+     */
+    class ISOBMFF_EXPORT AnnexBAssembler
+    {
+        public:
+            
+            /*!
+             * @function    AnnexBAssembler
+             * @abstract    Creates an assembler for HEVC data.
+             * @param       hvcC    The HEVC decoder configuration.
+             */
+            AnnexBAssembler( const HVCC & hvcC );
+            
+            /*!
+             * @function    AnnexBAssembler
+             * @abstract    Creates an assembler for AVC data.
+             * @param       avcC    The AVC decoder configuration.
+             */
+            AnnexBAssembler( const AVCC & avcC );
+            
+            /*!
+             * @function    AnnexBAssembler
+             * @abstract    Copy constructor.
+             * @param       o   The object to copy from.
+             */
+            AnnexBAssembler( const AnnexBAssembler & o );
+            
+            /*!
+             * @function    AnnexBAssembler
+             * @abstract    Move constructor.
+             * @param       o   The object to move from.
+             */
+            AnnexBAssembler( AnnexBAssembler && o ) noexcept;
+            
+            /*!
+             * @function    ~AnnexBAssembler
+             * @abstract    Destructor.
+             */
+            virtual ~AnnexBAssembler();
+            
+            /*!
+             * @function    operator=
+             * @abstract    Assignment operator.
+             * @param       o   The object to assign from.
+             */
+            AnnexBAssembler & operator =( AnnexBAssembler o );
+            
+            /*!
+             * @function    GetLengthSize
+             * @abstract    Gets the size of the NAL unit length fields.
+             * @result      The length size, in bytes (lengthSizeMinusOne + 1).
+             */
+            uint8_t GetLengthSize() const;
+            
+            /*!
+             * @function    GetParameterSets
+             * @abstract    Gets the parameter sets, in Annex-B form.
+             * @result      The VPS/SPS/PPS (HEVC) or SPS/PPS (AVC) NAL units, with start codes.
+             */
+            std::vector< uint8_t > GetParameterSets() const;
+            
+            /*!
+             * @function    GetSize
+             * @abstract    Gets the size of the Annex-B form of some data.
+             * @param       data            The length-prefixed NAL units.
+             * @param       size            The size of the data.
+             * @param       parameterSets   Whether to account for the parameter sets.
+             * @result      The exact output size, in bytes.
+             * @discussion  Throws if the data is not valid.
+             */
+            size_t GetSize( const uint8_t * data, size_t size, bool parameterSets = true ) const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the Annex-B form of some data into a caller-provided buffer.
+             * @param       data            The length-prefixed NAL units.
+             * @param       size            The size of the data.
+             * @param       buffer          The destination buffer.
+             * @param       bufferSize      The size of the destination buffer.
+             * @param       parameterSets   Whether to write the parameter sets first.
+             * @result      The number of bytes written to the buffer.
+             * @discussion  Throws if the data is not valid, or if the
+             *              buffer is too small.
+             * @see         GetSize
+             */
+            size_t Write( const uint8_t * data, size_t size, uint8_t * buffer, size_t bufferSize, bool parameterSets = true ) const;
+            
+            /*!
+             * @function    Assemble
+             * @abstract    Gets the Annex-B form of some data.
+             * @param       data            The length-prefixed NAL units.
+             * @param       size            The size of the data.
+             * @param       parameterSets   Whether to write the parameter sets first.
+             * @result      The Annex-B data.
+             */
+            std::vector< uint8_t > Assemble( const uint8_t * data, size_t size, bool parameterSets = true ) const;
+            
+            /*!
+             * @function    Assemble
+             * @abstract    Gets the Annex-B form of some data.
+             * @param       data            The length-prefixed NAL units.
+             * @param       parameterSets   Whether to write the parameter sets first.
+             * @result      The Annex-B data.
+             */
+            std::vector< uint8_t > Assemble( const std::vector< uint8_t > & data, bool parameterSets = true ) const;
+            
+            /*!
+             * @function    swap
+             * @abstract    Swap two objects.
+             * @param       o1  The first object to swap.
+             * @param       o2  The second object to swap.
+             */
+            ISOBMFF_EXPORT friend void swap( AnnexBAssembler & o1, AnnexBAssembler & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_ANNEX_B_ASSEMBLER_HPP */
@@ -59,6 +59,8 @@ namespace ISOBMFF
             void   Seek( std::streamoff offset, SeekDirection dir ) override;
             size_t Tell()                                     const override;
             
+            const uint8_t * GetBytes() const override;
+            
             ISOBMFF_EXPORT friend void swap( BinaryDataStream & o1, BinaryDataStream & o2 );
             
         private:
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      BinaryMappedFileStream.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_BINARY_MAPPED_FILE_STREAM_HPP
+#define ISOBMFF_BINARY_MAPPED_FILE_STREAM_HPP
+
+#include <ISOBMFF/BinaryStream.hpp>
+#include <string>
+#include <cstdint>
+#include <memory>
+#include <algorithm>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       BinaryMappedFileStream
+     * @abstract    Read-only binary stream backed by a memory-mapped file.
+     * @discussion  The whole file is mapped for the lifetime of the
+     *              stream, so pointers returned by `GetBytes` can be
+     *              handed out as borrowed views instead of copying data.
+     */
+    class ISOBMFF_EXPORT BinaryMappedFileStream: public BinaryStream
+    {
+        public:
+            
+            BinaryMappedFileStream( const std::string & path );
+            
+            virtual ~BinaryMappedFileStream() override;
+            
+            BinaryMappedFileStream( const BinaryMappedFileStream & o )              = delete;
+            BinaryMappedFileStream( BinaryMappedFileStream && o )                   = delete;
+            BinaryMappedFileStream & operator =( const BinaryMappedFileStream & o ) = delete;
+            BinaryMappedFileStream & operator =( BinaryMappedFileStream && o )      = delete;
+            
+            using BinaryStream::Read;
+            using BinaryStream::Seek;
+            
+            void   Read( uint8_t * buf, size_t size )               override;
+            void   Seek( std::streamoff offset, SeekDirection dir ) override;
+            size_t Tell()                                     const override;
+            
+            const uint8_t * GetBytes() const override;
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_BINARY_MAPPED_FILE_STREAM_HPP */
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      BinaryOutputStream.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_BINARY_OUTPUT_STREAM_HPP
+#define ISOBMFF_BINARY_OUTPUT_STREAM_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/Matrix.hpp>
+#include <cstdint>
+#include <vector>
+#include <string>
+
+namespace ISOBMFF
+{
+    class ISOBMFF_EXPORT BinaryOutputStream
+    {
+        public:
+            
+            BinaryOutputStream();
+            
+            virtual ~BinaryOutputStream();
+            
+            BinaryOutputStream( const BinaryOutputStream & o )              = delete;
+            BinaryOutputStream( BinaryOutputStream && o )                   = delete;
+            BinaryOutputStream & operator =( const BinaryOutputStream & o ) = delete;
+            BinaryOutputStream & operator =( BinaryOutputStream && o )      = delete;
+            
+            virtual void   Write( const uint8_t * buf, size_t size ) = 0;
+            virtual size_t Tell()                              const = 0;
+            virtual void   Flush();
+            
+            /*!
+             * @function    GetSource
+             * @abstract    Gets the stream unmodified boxes are copied from.
+             * @result      The source stream, or nullptr.
+             * @discussion  This is the stream the boxes were parsed from.
+             *              Boxes that were not modified since they were
+             *              read are copied from their range in the source,
+             *              without being encoded again.
+             */
+            BinaryStream * GetSource() const;
+            void           SetSource( BinaryStream * source );
+            
+            /*!
+             * @function    Copy
+             * @abstract    Copies a range of another stream.
+             * @param       stream  The stream to copy from.
+             * @param       offset  The offset of the range in the stream.
+             * @param       size    The size of the range.
+             * @discussion  The position of the copied stream is not preserved.
+             */
+            void Copy( BinaryStream & stream, uint64_t offset, uint64_t size );
+            
+            void Write( const std::vector< uint8_t > & data );
+            
+            void WriteUInt8( uint8_t value );
+            void WriteBigEndianUInt16( uint16_t value );
+            void WriteBigEndianUInt32( uint32_t value );
+            void WriteBigEndianUInt64( uint64_t value );
+            
+            void WriteBigEndianUInt32Array( const std::vector< uint32_t > & values );
+            void WriteBigEndianUInt64Array( const std::vector< uint64_t > & values );
+            
+            void WriteBigEndianFixedPoint( float value, unsigned int integerLength, unsigned int fractionalLength );
+            
+            void WriteFourCC( const std::string & value );
+            void WritePascalString( const std::string & value );
+            void WriteString( const std::string & value, size_t length );
+            void WriteNULLTerminatedString( const std::string & value );
+            
+            void WriteMatrix( const Matrix & value );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_BINARY_OUTPUT_STREAM_HPP */
@@ -58,6 +58,8 @@ namespace ISOBMFF
             virtual size_t Tell()                                     const = 0;
             virtual void   Seek( std::streamoff offset, SeekDirection dir ) = 0;
             
+            virtual const uint8_t * GetBytes() const;
+            
             bool   HasBytesAvailable();
             size_t AvailableBytes();
             
@@ -95,6 +97,9 @@ namespace ISOBMFF
             uint64_t ReadBigEndianUInt64();
             uint64_t ReadLittleEndianUInt64();
             
+            std::vector< uint32_t > ReadBigEndianUInt32Array( size_t count );
+            std::vector< uint64_t > ReadBigEndianUInt64Array( size_t count );
+            
             float ReadBigEndianFixedPoint( unsigned int integerLength, unsigned int fractionalLength );
             float ReadLittleEndianFixedPoint( unsigned int integerLength, unsigned int fractionalLength );
             
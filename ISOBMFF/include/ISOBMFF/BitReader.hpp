@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      BitReader.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_BIT_READER_HPP
+#define ISOBMFF_BIT_READER_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <cstdint>
+#include <cstddef>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       BitReader
+     * @abstract    Reads bits from a byte buffer, MSB first.
+     * @discussion  Used for bitstream syntax such as parameter sets, with
+     *              exp-Golomb codes decoded by counting leading zeros on
+     *              a 64-bit window rather than bit by bit.
+     *              The buffer is not owned, and should not contain
+     *              emulation prevention bytes.
+     *              Reads past the end of the buffer throw.
+     */
+    class ISOBMFF_EXPORT BitReader
+    {
+        public:
+            
+            /*!
+             * @function    BitReader
+             * @abstract    Creates a bit reader.
+             * @param       data    The data bytes.
+             * @param       size    The size of the data.
+             */
+            BitReader( const uint8_t * data, size_t size );
+            
+            /*!
+             * @function    ReadBits
+             * @abstract    Reads an unsigned integer - u(n).
+             * @param       count   The number of bits to read (up to 32).
+             * @result      The value.
+             */
+            uint32_t ReadBits( unsigned int count );
+            
+            /*!
+             * @function    ReadFlag
+             * @abstract    Reads a single bit - u(1).
+             * @result      true if the bit is set, otherwise false.
+             */
+            bool ReadFlag();
+            
+            /*!
+             * @function    ReadUE
+             * @abstract    Reads an unsigned exp-Golomb code - ue(v).
+             * @result      The value.
+             */
+            uint32_t ReadUE();
+            
+            /*!
+             * @function    ReadSE
+             * @abstract    Reads a signed exp-Golomb code - se(v).
+             * @result      The value.
+             */
+            int32_t ReadSE();
+            
+            /*!
+             * @function    SkipBits
+             * @abstract    Skips bits.
+             * @param       count   The number of bits to skip.
+             */
+            void SkipBits( size_t count );
+            
+            /*!
+             * @function    GetPosition
+             * @abstract    Gets the current position.
+             * @result      The position, in bits.
+             */
+            size_t GetPosition() const;
+            
+            /*!
+             * @function    GetRemainingBits
+             * @abstract    Gets the number of bits left to read.
+             * @result      The number of bits left.
+             */
+            size_t GetRemainingBits() const;
+            
+            /*!
+             * @function    IsByteAligned
+             * @abstract    Checks if the current position is on a byte boundary.
+             * @result      true if byte aligned, otherwise false.
+             */
+            bool IsByteAligned() const;
+        
+        private:
+            
+            uint64_t Peek64() const;
+            
+            const uint8_t * _data;
+            size_t          _size;
+            size_t          _pos;
+    };
+}
+
+#endif /* ISOBMFF_BIT_READER_HPP */
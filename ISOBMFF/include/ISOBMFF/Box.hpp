@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <ISOBMFF/Macros.hpp>
 #include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
 #include <ISOBMFF/DisplayableObject.hpp>
 #include <string>
 #include <ostream>
@@ -44,6 +45,7 @@
 namespace ISOBMFF
 {
     class Parser;
+    class Container;
     
     /*!
      * @class       Box
@@ -118,6 +120,97 @@ namespace ISOBMFF
              */
             virtual std::vector< uint8_t > GetData() const;
             
+            /*!
+             * @function    SetData
+             * @abstract    Sets the box data.
+             * @param       value   The box data, as a vector of bytes.
+             * @discussion  Only used by boxes without a specific encoder.
+             */
+            void SetData( const std::vector< uint8_t > & value );
+            
+            /*!
+             * @function    GetDataSize
+             * @abstract    Gets the size of the box data.
+             * @result      The number of bytes written by WriteData.
+             */
+            virtual uint64_t GetDataSize() const;
+            
+            /*!
+             * @function    WriteData
+             * @abstract    Writes box data to a stream.
+             * @param       stream  The binary stream to which to write the box data.
+             * @discussion  The box header is not written. Boxes without a
+             *              specific encoder write the data kept by ReadData.
+             */
+            virtual void WriteData( BinaryOutputStream & stream ) const;
+            
+            /*!
+             * @function    GetSerializedSize
+             * @abstract    Gets the size of the box, header included.
+             * @result      The number of bytes written by Write.
+             * @discussion  The sizes of the box and of all nested boxes are
+             *              computed in a single pass, and kept for the next
+             *              call to Write.
+             *              A box that was not modified since it was read
+             *              keeps its original size.
+             */
+            virtual uint64_t GetSerializedSize() const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the box, header included, to a stream.
+             * @param       stream  The binary stream to which to write the box.
+             * @discussion  Sizes are computed first, so each header is
+             *              written once, with its final size.
+             *              A box that was not modified since it was read
+             *              is copied from its range in the stream's source,
+             *              without being encoded again. If the stream has
+             *              no source, all boxes are encoded, so boxes read
+             *              from a file can be written to another one.
+             */
+            virtual void Write( BinaryOutputStream & stream ) const;
+            
+            /*!
+             * @function    IsModified
+             * @abstract    Checks if the box, or one of its nested boxes, was modified since it was read.
+             * @result      true if the box was modified, otherwise false.
+             * @discussion  Setters mark boxes as modified. Changes made to
+             *              nested objects (eg. ILOC items) are not tracked,
+             *              and must be followed by a call to SetModified.
+             */
+            bool IsModified() const;
+            void SetModified( bool value );
+            
+            /*!
+             * @function    HasModifiedFields
+             * @abstract    Checks if the box itself was modified since it was read, nested boxes excluded.
+             * @result      true if the box was marked as modified, otherwise false.
+             */
+            bool HasModifiedFields() const;
+            
+            /*!
+             * @function    HasSource
+             * @abstract    Checks if the box was read from a stream.
+             * @result      true if the box has a source range, otherwise false.
+             */
+            bool     HasSource()       const;
+            uint64_t GetSourceOffset() const;
+            uint64_t GetSourceSize()   const;
+            
+            /*!
+             * @function    SetSource
+             * @abstract    Sets the range from which the box was read.
+             * @param       offset  The offset of the box in the parsed file, header included.
+             * @param       size    The size of the box, header included.
+             * @param       header  The size of the header, 16 if it holds a 64-bit size.
+             * @discussion  This is called by the parser, once the box was
+             *              read, and clears the modified flag.
+             *              A box read with a 64-bit size keeps it when it
+             *              is encoded again, so the offsets of the boxes
+             *              that follow don't change.
+             */
+            void SetSource( uint64_t offset, uint64_t size, uint64_t header = 8 );
+            
             /*!
              * @function    swap
              * @abstract    Swap two objects.
@@ -126,8 +219,22 @@ namespace ISOBMFF
              */
             ISOBMFF_EXPORT friend void swap( Box & o1, Box & o2 );
             
+        protected:
+            
+            /*!
+             * @function    SetEncode
+             * @abstract    Sets whether the box and its nested boxes are encoded even if unmodified.
+             * @param       value   true to encode the boxes, false to allow copying them.
+             * @discussion  Used while writing to a stream without a source.
+             */
+            void SetEncode( bool value ) const;
+            
         private:
             
+            friend class Container;
+            
+            void WriteBox( BinaryOutputStream & stream ) const;
+            
             class IMPL;
             
             std::unique_ptr< IMPL > impl;
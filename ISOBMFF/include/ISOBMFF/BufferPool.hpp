@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      BufferPool.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_BUFFER_POOL_HPP
+#define ISOBMFF_BUFFER_POOL_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       BufferPool
+     * @abstract    Pool of reusable byte buffers.
+     * @discussion  Buffers are handed out as shared pointers, and go back
+     *              to the pool when the last reference is released, so
+     *              they may outlive the pool itself.
+     *              The pool is thread-safe, and can be shared by several
+     *              readers.
+     */
+    class ISOBMFF_EXPORT BufferPool
+    {
+        public:
+            
+            /*!
+             * @function    BufferPool
+             * @abstract    Creates a buffer pool.
+             * @param       maxBuffers  The maximum number of idle buffers kept for reuse.
+             */
+            BufferPool( size_t maxBuffers = 16 );
+            
+            virtual ~BufferPool();
+            
+            BufferPool( const BufferPool & o )              = delete;
+            BufferPool( BufferPool && o )                   = delete;
+            BufferPool & operator =( const BufferPool & o ) = delete;
+            BufferPool & operator =( BufferPool && o )      = delete;
+            
+            /*!
+             * @function    Acquire
+             * @abstract    Gets a buffer from the pool.
+             * @param       size    The size of the buffer.
+             * @result      A buffer of the requested size.
+             * @discussion  An idle buffer large enough is reused if
+             *              possible, otherwise a new one is allocated.
+             *              Its contents are unspecified.
+             */
+            std::shared_ptr< std::vector< uint8_t > > Acquire( size_t size );
+            
+            size_t GetMaxBuffers()  const;
+            size_t GetIdleBuffers() const;
+        
+        private:
+            
+            class IMPL;
+            
+            std::shared_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_BUFFER_POOL_HPP */
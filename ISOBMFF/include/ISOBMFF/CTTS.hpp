@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      CTTS.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_CTTS_HPP
+#define ISOBMFF_CTTS_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/FullBox.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       CTTS
+     * @abstract    Composition time to sample box (ISO/IEC 14496-12 8.6.1.3).
+     * @discussion  Entries are stored as one packed array per field, read
+     *              from the file in one bulk read.
+     *              Offsets are always returned as signed values: version 1
+     *              boxes are signed by definition, and negative offsets are
+     *              commonly written in version 0 boxes as well.
+     */
+    class ISOBMFF_EXPORT CTTS: public FullBox
+    {
+        public:
+            
+            CTTS();
+            CTTS( const CTTS & o );
+            CTTS( CTTS && o ) noexcept;
+            virtual ~CTTS() override;
+            
+            CTTS & operator =( CTTS o );
+            
+            void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
+            std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
+            
+            size_t   GetEntryCount()                 const;
+            uint32_t GetSampleCount( size_t index )  const;
+            int32_t  GetSampleOffset( size_t index ) const;
+            
+            /*!
+             * @function    GetTotalSampleCount
+             * @abstract    Gets the number of samples described by the box.
+             * @result      The sum of all entries' sample counts.
+             */
+            uint64_t GetTotalSampleCount() const;
+            
+            /*!
+             * @function    GetCompositionOffset
+             * @abstract    Gets the composition offset of a sample.
+             * @param       sample  The zero-based sample index.
+             * @result      The offset to add to the sample's decode time.
+             * @discussion  Lookups use an index of the entries, built on
+             *              first use, and run in O(log n).
+             *              Samples not covered by the box have no offset.
+             */
+            int32_t GetCompositionOffset( uint64_t sample ) const;
+            
+            /*!
+             * @function    GetEntryForSample
+             * @abstract    Gets the entry describing a sample.
+             * @param       sample  The zero-based sample index.
+             * @result      The index of the entry.
+             * @discussion  Throws if the sample is not covered by the box.
+             */
+            size_t GetEntryForSample( uint64_t sample ) const;
+            
+            /*!
+             * @function    GetEntryFirstSample
+             * @abstract    Gets the first sample described by an entry.
+             * @param       index   The index of the entry.
+             * @result      The zero-based index of the entry's first sample.
+             */
+            uint64_t GetEntryFirstSample( size_t index ) const;
+            
+            ISOBMFF_EXPORT friend void swap( CTTS & o1, CTTS & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_CTTS_HPP */
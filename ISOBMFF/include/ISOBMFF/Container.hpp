@@ -51,6 +51,23 @@ namespace ISOBMFF
             
             void WriteBoxes( std::ostream & os, std::size_t indentLevel ) const;
             
+            /*!
+             * @function    GetBoxesSize
+             * @abstract    Gets the serialized size of the contained boxes.
+             * @result      The sum of the boxes' serialized sizes.
+             */
+            uint64_t GetBoxesSize() const;
+            
+            /*!
+             * @function    WriteBoxes
+             * @abstract    Writes the contained boxes to a stream.
+             * @param       stream  The binary stream to which to write the boxes.
+             * @discussion  Sizes must have been computed by GetBoxesSize,
+             *              from the GetDataSize implementation of the
+             *              container.
+             */
+            void WriteBoxes( BinaryOutputStream & stream ) const;
+            
             std::vector< std::shared_ptr< Box > > GetBoxes( const std::string & name ) const;
             std::shared_ptr< Box >                GetBox( const std::string & name )   const;
             
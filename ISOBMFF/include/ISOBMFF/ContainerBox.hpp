@@ -55,9 +55,31 @@ namespace ISOBMFF
             void ReadData( Parser & parser, BinaryStream & stream ) override;
             void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
             
+            uint64_t GetDataSize()                              const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
+            
             void                                  AddBox( std::shared_ptr< Box > box ) override;
             std::vector< std::shared_ptr< Box > > GetBoxes() const override;
             
+            /*!
+             * @function    ReplaceBox
+             * @abstract    Replaces a child box.
+             * @param       box         The box to replace.
+             * @param       replacement The new box, at the same position.
+             * @discussion  Throws if the box is not a child of the container.
+             */
+            void ReplaceBox( std::shared_ptr< Box > box, std::shared_ptr< Box > replacement );
+            
+            /*!
+             * @function    GetTrailingData
+             * @abstract    Gets the bytes following the last child box.
+             * @result      The trailing bytes, usually the 32-bit zero
+             *              terminator of QuickTime sample entries.
+             * @discussion  The bytes are written back after the child boxes.
+             */
+            std::vector< uint8_t > GetTrailingData() const;
+            void                   SetTrailingData( const std::vector< uint8_t > & data );
+            
             ISOBMFF_EXPORT friend void swap( ContainerBox & o1, ContainerBox & o2 );
             
         private:
@@ -54,6 +54,9 @@ namespace ISOBMFF
             void ReadData( Parser & parser, BinaryStream & stream ) override;
             void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
             
+            uint64_t GetDataSize()                              const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
+            
             void                                  AddBox( std::shared_ptr< Box > box ) override;
             std::vector< std::shared_ptr< Box > > GetBoxes() const override;
             
@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Demuxer.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_DEMUXER_HPP
+#define ISOBMFF_DEMUXER_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/File.hpp>
+#include <ISOBMFF/Box.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/BufferPool.hpp>
+#include <ISOBMFF/TrackReader.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Demuxer
+     * @abstract    Reads the samples of a movie's tracks as timestamped packets.
+     * @discussion  Tracks are described by their TKHD, MDHD, HDLR and STSD
+     *              boxes. Packets of all selected tracks are returned in
+     *              file offset order, so interleaved files are read
+     *              front to back, without seeking back and forth between
+     *              tracks.
+     *              Each track is read with a `TrackReader`, sharing a
+     *              single buffer pool. When the stream exposes its bytes
+     *              (eg. `BinaryMappedFileStream`), payloads are borrowed
+     *              from the stream.
+     *              The stream is not owned by the demuxer, and must stay
+     *              valid for the lifetime of the demuxer and of the
+     *              packets it returns.
+     */
+    class ISOBMFF_EXPORT Demuxer
+    {
+        public:
+            
+            /*!
+             * @class       Track
+             * @abstract    Describes a track of the movie.
+             */
+            class ISOBMFF_EXPORT Track
+            {
+                public:
+                    
+                    Track();
+                    Track( const Track & o );
+                    Track( Track && o ) noexcept;
+                    virtual ~Track();
+                    
+                    Track & operator =( Track o );
+                    
+                    uint32_t                              GetTrackID()       const;
+                    std::string                           GetHandlerType()   const;
+                    uint32_t                              GetTimescale()     const;
+                    uint64_t                              GetDuration()      const;
+                    float                                 GetWidth()         const;
+                    float                                 GetHeight()        const;
+                    uint64_t                              GetSampleCount()   const;
+                    std::vector< std::shared_ptr< Box > > GetSampleEntries() const;
+                    
+                    /*!
+                     * @function    GetCodec
+                     * @abstract    Gets the type of the track's first sample entry.
+                     * @result      The sample entry type (eg. 'hvc1'), or an empty string.
+                     */
+                    std::string GetCodec() const;
+                    
+                    void SetTrackID( uint32_t value );
+                    void SetHandlerType( const std::string & value );
+                    void SetTimescale( uint32_t value );
+                    void SetDuration( uint64_t value );
+                    void SetWidth( float value );
+                    void SetHeight( float value );
+                    void SetSampleCount( uint64_t value );
+                    void SetSampleEntries( const std::vector< std::shared_ptr< Box > > & value );
+                    
+                    ISOBMFF_EXPORT friend void swap( Track & o1, Track & o2 );
+                
+                private:
+                    
+                    class IMPL;
+                    
+                    std::unique_ptr< IMPL > impl;
+            };
+            
+            /*!
+             * @class       Packet
+             * @abstract    A sample of a track, returned by the demuxer.
+             * @discussion  Times are expressed in the track's timescale.
+             *              The payload is a view kept alive by the packet.
+             *              Reusing the same object for successive reads
+             *              avoids allocations.
+             */
+            class ISOBMFF_EXPORT Packet
+            {
+                public:
+                    
+                    Packet();
+                    Packet( const Packet & o );
+                    Packet( Packet && o ) noexcept;
+                    virtual ~Packet();
+                    
+                    Packet & operator =( Packet o );
+                    
+                    uint32_t        GetTrackID()                const;
+                    uint64_t        GetSampleIndex()            const;
+                    uint64_t        GetOffset()                 const;
+                    uint64_t        GetDecodeTime()             const;
+                    int64_t         GetCompositionTime()        const;
+                    uint32_t        GetDuration()               const;
+                    bool            IsSync()                    const;
+                    uint32_t        GetSampleDescriptionIndex() const;
+                    const uint8_t * GetData()                   const;
+                    size_t          GetSize()                   const;
+                    
+                    ISOBMFF_EXPORT friend void swap( Packet & o1, Packet & o2 );
+                
+                private:
+                    
+                    friend class Demuxer;
+                    
+                    void Set( uint32_t trackID, TrackReader::Sample & sample );
+                    
+                    class IMPL;
+                    
+                    std::unique_ptr< IMPL > impl;
+            };
+            
+            /*!
+             * @function    Demuxer
+             * @abstract    Creates a demuxer.
+             * @param       file    The parsed file.
+             * @param       stream  The stream of the file.
+             * @discussion  Tracks without a usable sample table (eg.
+             *              fragmented tracks) are ignored.
+             *              All tracks are initially selected.
+             */
+            Demuxer( const File & file, BinaryStream & stream );
+            
+            virtual ~Demuxer();
+            
+            Demuxer( const Demuxer & o )              = delete;
+            Demuxer( Demuxer && o )                   = delete;
+            Demuxer & operator =( const Demuxer & o ) = delete;
+            Demuxer & operator =( Demuxer && o )      = delete;
+            
+            /*!
+             * @function    GetTracks
+             * @abstract    Gets the tracks of the movie.
+             * @result      The tracks, in file order.
+             */
+            std::vector< Track > GetTracks() const;
+            
+            /*!
+             * @function    IsTrackSelected
+             * @abstract    Checks if packets are returned for a track.
+             * @param       trackID The track ID.
+             * @result      true if the track is selected, otherwise false.
+             */
+            bool IsTrackSelected( uint32_t trackID ) const;
+            
+            /*!
+             * @function    SelectTrack
+             * @abstract    Selects or deselects a track.
+             * @param       trackID     The track ID.
+             * @param       selected    Whether packets should be returned for the track.
+             * @discussion  A track selected again resumes where it was left.
+             *              Throws if the track does not exist.
+             */
+            void SelectTrack( uint32_t trackID, bool selected );
+            
+            /*!
+             * @function    SetPrefetchChunks
+             * @abstract    Sets the number of chunks read ahead in each track.
+             * @param       value   The number of chunks to prefetch.
+             * @see         TrackReader::SetPrefetchChunks
+             */
+            void SetPrefetchChunks( size_t value );
+            
+            /*!
+             * @function    GetReadCount
+             * @abstract    Gets the number of reads issued to the stream.
+             * @result      The number of reads of all tracks.
+             */
+            uint64_t GetReadCount() const;
+            
+            /*!
+             * @function    Seek
+             * @abstract    Moves all tracks to a presentation time.
+             * @param       seconds The time to seek to, in seconds.
+             * @discussion  Each track restarts at the sync sample needed to
+             *              present the given time.
+             */
+            void Seek( double seconds );
+            
+            /*!
+             * @function    ReadPacket
+             * @abstract    Reads the next packet.
+             * @param       packet  On output, the packet read.
+             * @result      true if a packet was read, false when all selected tracks are finished.
+             * @discussion  The packet with the lowest file offset among the
+             *              selected tracks is returned.
+             *              Throws if a sample's data cannot be read.
+             */
+            bool ReadPacket( Packet & packet );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_DEMUXER_HPP */
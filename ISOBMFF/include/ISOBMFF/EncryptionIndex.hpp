@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      EncryptionIndex.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_ENCRYPTION_INDEX_HPP
+#define ISOBMFF_ENCRYPTION_INDEX_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Container.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/TENC.hpp>
+#include <ISOBMFF/SGPD.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       EncryptionIndex
+     * @abstract    Per-sample encryption parameters of a track or track fragment (ISO/IEC 23001-7).
+     * @discussion  Sample auxiliary information is taken from the SENC
+     *              box, or read through the SAIZ and SAIO boxes.
+     *              Keys come from the TENC box, unless a sample is mapped
+     *              to a 'seig' sample group.
+     *              All samples are decoded once, at construction, into
+     *              packed arrays: IVs, subsample ranges, and an index into
+     *              the key table (TENC defaults, then 'seig' entries).
+     *              Sample indices are zero-based, and relative to the
+     *              container (the first sample of a track fragment is 0).
+     */
+    class ISOBMFF_EXPORT EncryptionIndex
+    {
+        public:
+            
+            /*!
+             * @function    EncryptionIndex
+             * @abstract    Creates an index from a SENC box.
+             * @param       container   The TRAF or STBL box.
+             * @param       tenc        The track's TENC box.
+             * @param       trackGroups The track's 'seig' SGPD box, if any.
+             * @discussion  Throws if the container has no SENC box, or if
+             *              the sample information is invalid.
+             */
+            EncryptionIndex( const Container & container, std::shared_ptr< TENC > tenc, std::shared_ptr< SGPD > trackGroups = nullptr );
+            
+            /*!
+             * @function    EncryptionIndex
+             * @abstract    Creates an index, reading auxiliary information if needed.
+             * @param       container   The TRAF or STBL box.
+             * @param       stream      The stream of the file.
+             * @param       baseOffset  The offset SAIO offsets are relative to (the MOOF offset, or 0 for a STBL box).
+             * @param       tenc        The track's TENC box.
+             * @param       trackGroups The track's 'seig' SGPD box, if any.
+             * @discussion  The SENC box is used if present. Otherwise,
+             *              sample information is read from the stream,
+             *              with one read per SAIO entry.
+             */
+            EncryptionIndex( const Container & container, BinaryStream & stream, uint64_t baseOffset, std::shared_ptr< TENC > tenc, std::shared_ptr< SGPD > trackGroups = nullptr );
+            
+            EncryptionIndex( const EncryptionIndex & o );
+            EncryptionIndex( EncryptionIndex && o ) noexcept;
+            virtual ~EncryptionIndex();
+            
+            EncryptionIndex & operator =( EncryptionIndex o );
+            
+            size_t GetSampleCount() const;
+            
+            bool                   IsProtected( size_t sample )       const;
+            uint8_t                GetCryptByteBlock( size_t sample ) const;
+            uint8_t                GetSkipByteBlock( size_t sample )  const;
+            std::vector< uint8_t > GetKID( size_t sample )            const;
+            
+            /*!
+             * @function    GetIV
+             * @abstract    Gets the initialization vector of a sample.
+             * @param       sample  The zero-based sample index.
+             * @result      The sample's IV, or the key's constant IV.
+             */
+            std::vector< uint8_t > GetIV( size_t sample ) const;
+            
+            size_t   GetSubsampleCount( size_t sample )                            const;
+            uint16_t GetSubsampleClearBytes( size_t sample, size_t subsample )     const;
+            uint32_t GetSubsampleEncryptedBytes( size_t sample, size_t subsample ) const;
+            
+            ISOBMFF_EXPORT friend void swap( EncryptionIndex & o1, EncryptionIndex & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_ENCRYPTION_INDEX_HPP */
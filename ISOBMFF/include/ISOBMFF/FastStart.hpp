@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      FastStart.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_FAST_START_HPP
+#define ISOBMFF_FAST_START_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <cstdint>
+#include <string>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       FastStart
+     * @abstract    Remuxes a progressive file so the MOOV box comes before the media data.
+     * @discussion  The MOOV box is moved right before the first MDAT
+     *              box. Chunk offsets (STCO, CO64) and item locations
+     *              (ILOC, construction method 0) are relocated, and STCO
+     *              boxes are promoted to CO64 when an offset no longer
+     *              fits in 32 bits. Other boxes are copied unchanged.
+     *              On Linux, copies are done by the kernel
+     *              (copy_file_range, then sendfile), so the media data
+     *              never goes through user space.
+     */
+    class ISOBMFF_EXPORT FastStart
+    {
+        public:
+            
+            /*!
+             * @function    FastStart
+             * @abstract    Creates a remuxer for a file.
+             * @param       path    The path of the file.
+             * @discussion  Throws if the file cannot be parsed.
+             */
+            FastStart( const std::string & path );
+            
+            FastStart( const FastStart & o );
+            FastStart( FastStart && o ) noexcept;
+            virtual ~FastStart();
+            
+            FastStart & operator =( FastStart o );
+            
+            std::string GetPath() const;
+            
+            /*!
+             * @function    IsRequired
+             * @abstract    Checks if the MOOV box comes after the media data.
+             * @result      true if the file needs to be remuxed, otherwise false.
+             */
+            bool IsRequired() const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the remuxed file.
+             * @param       path    The path of the new file, which must not be the source file.
+             * @discussion  Throws if the file has no MOOV box, if it is
+             *              fragmented, or if an offset does not point to
+             *              a copied box.
+             */
+            void Write( const std::string & path ) const;
+            
+            ISOBMFF_EXPORT friend void swap( FastStart & o1, FastStart & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_FAST_START_HPP */
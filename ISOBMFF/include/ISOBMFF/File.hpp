@@ -52,6 +52,23 @@ namespace ISOBMFF
             
             std::string GetName() const override;
             
+            /*!
+             * @function    GetSerializedSize
+             * @abstract    Gets the size of the serialized file.
+             * @result      The sum of the top-level boxes' serialized sizes.
+             */
+            uint64_t GetSerializedSize() const override;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the top-level boxes to a stream.
+             * @param       stream  The binary stream to which to write the file.
+             * @discussion  The stream's source should be the stream the file
+             *              was parsed from, so unmodified boxes can be
+             *              copied. Without a source, all boxes are encoded.
+             */
+            void Write( BinaryOutputStream & stream ) const override;
+            
             ISOBMFF_EXPORT friend void swap( File & o1, File & o2 );
             
         private:
@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      FragmentIndex.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_FRAGMENT_INDEX_HPP
+#define ISOBMFF_FRAGMENT_INDEX_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/TREX.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       FragmentIndex
+     * @abstract    Indexes the samples of a fragmented file.
+     * @discussion  Only top-level box headers are read, and only the MOOV
+     *              and MOOF boxes are parsed, so media data is never
+     *              loaded. Sample durations, sizes and flags missing from
+     *              the track runs are taken from the TFHD, then from the
+     *              TREX defaults, and data offsets are resolved to file
+     *              offsets.
+     *              Run entries are kept in their packed form. Locating a
+     *              sample is a binary search over the runs, followed by a
+     *              scan of a single run.
+     */
+    class ISOBMFF_EXPORT FragmentIndex
+    {
+        public:
+            
+            /*!
+             * @class       Sample
+             * @abstract    A sample of a fragmented track.
+             * @discussion  Times are expressed in the track's timescale.
+             */
+            class ISOBMFF_EXPORT Sample
+            {
+                public:
+                    
+                    Sample();
+                    Sample( const Sample & o );
+                    Sample( Sample && o ) noexcept;
+                    virtual ~Sample();
+                    
+                    Sample & operator =( Sample o );
+                    
+                    size_t   GetFragment()               const;
+                    uint64_t GetOffset()                 const;
+                    uint32_t GetSize()                   const;
+                    uint64_t GetDecodeTime()             const;
+                    int64_t  GetCompositionTime()        const;
+                    uint32_t GetDuration()               const;
+                    uint32_t GetFlags()                  const;
+                    uint32_t GetSampleDescriptionIndex() const;
+                    bool     IsSync()                    const;
+                    
+                    void SetFragment( size_t value );
+                    void SetOffset( uint64_t value );
+                    void SetSize( uint32_t value );
+                    void SetDecodeTime( uint64_t value );
+                    void SetCompositionTime( int64_t value );
+                    void SetDuration( uint32_t value );
+                    void SetFlags( uint32_t value );
+                    void SetSampleDescriptionIndex( uint32_t value );
+                    
+                    ISOBMFF_EXPORT friend void swap( Sample & o1, Sample & o2 );
+                
+                private:
+                    
+                    class IMPL;
+                    
+                    std::unique_ptr< IMPL > impl;
+            };
+            
+            /*!
+             * @function    FragmentIndex
+             * @abstract    Creates the index of a fragmented file.
+             * @param       stream  The stream of the file.
+             * @discussion  The stream is only used during construction.
+             *              Throws if a box is invalid.
+             */
+            FragmentIndex( BinaryStream & stream );
+            
+            FragmentIndex( const FragmentIndex & o );
+            FragmentIndex( FragmentIndex && o ) noexcept;
+            virtual ~FragmentIndex();
+            
+            FragmentIndex & operator =( FragmentIndex o );
+            
+            /*!
+             * @function    GetFragmentCount
+             * @abstract    Gets the number of movie fragments (MOOF boxes).
+             * @result      The number of fragments.
+             */
+            size_t GetFragmentCount() const;
+            
+            uint64_t GetFragmentOffset( size_t fragment ) const;
+            uint64_t GetFragmentSize( size_t fragment )   const;
+            uint32_t GetSequenceNumber( size_t fragment ) const;
+            
+            /*!
+             * @function    GetTrackIDs
+             * @abstract    Gets the IDs of the fragmented tracks.
+             * @result      The track IDs, from the TREX and TFHD boxes.
+             */
+            std::vector< uint32_t > GetTrackIDs() const;
+            
+            /*!
+             * @function    GetTREX
+             * @abstract    Gets the defaults of a track.
+             * @param       trackID The track ID.
+             * @result      The track's TREX box, or nullptr.
+             */
+            std::shared_ptr< TREX > GetTREX( uint32_t trackID ) const;
+            
+            /*!
+             * @function    GetSampleCount
+             * @abstract    Gets the number of samples of a track.
+             * @param       trackID The track ID.
+             * @result      The number of samples in all fragments, or 0 for unknown tracks.
+             */
+            uint64_t GetSampleCount( uint32_t trackID ) const;
+            
+            /*!
+             * @function    GetSampleAtTime
+             * @abstract    Gets the sample being decoded at a given time.
+             * @param       trackID The track ID.
+             * @param       time    The decode time.
+             * @result      The sample index.
+             * @discussion  Times past the end map to the last sample.
+             *              Throws if the track has no samples.
+             */
+            uint64_t GetSampleAtTime( uint32_t trackID, uint64_t time ) const;
+            
+            /*!
+             * @function    GetFragmentAtTime
+             * @abstract    Gets the fragment holding the sample decoded at a given time.
+             * @param       trackID The track ID.
+             * @param       time    The decode time.
+             * @result      The fragment index.
+             * @discussion  Throws if the track has no samples.
+             * @see         GetFragmentOffset
+             */
+            size_t GetFragmentAtTime( uint32_t trackID, uint64_t time ) const;
+            
+            /*!
+             * @function    GetSample
+             * @abstract    Gets a sample of a track.
+             * @param       trackID The track ID.
+             * @param       sample  The zero-based sample index.
+             * @result      The sample, with its file offset and size.
+             * @discussion  Throws if the sample does not exist.
+             */
+            Sample GetSample( uint32_t trackID, uint64_t sample ) const;
+            
+            ISOBMFF_EXPORT friend void swap( FragmentIndex & o1, FragmentIndex & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_FRAGMENT_INDEX_HPP */
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      FragmentedMuxer.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_FRAGMENTED_MUXER_HPP
+#define ISOBMFF_FRAGMENTED_MUXER_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Box.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <cstdint>
+#include <vector>
+#include <string>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       FragmentedMuxer
+     * @abstract    Writes encoded samples as a fragmented file, incrementally.
+     * @discussion  The init segment (FTYP and MOOV boxes, with a MVEX
+     *              box) is written before the first fragment. Each call
+     *              to Flush then writes the pending samples as a MOOF box
+     *              followed by a MDAT box, so a fragment can be sent as
+     *              soon as its last sample was added.
+     *              Sample data and fragment boxes are kept between
+     *              fragments, so once storage has grown to the size of
+     *              the largest fragment, adding samples does not
+     *              allocate.
+     */
+    class ISOBMFF_EXPORT FragmentedMuxer
+    {
+        public:
+            
+            /*!
+             * @function    FragmentedMuxer
+             * @abstract    Creates a muxer.
+             * @param       stream  The stream to write to, which must outlive the muxer.
+             */
+            FragmentedMuxer( BinaryOutputStream & stream );
+            
+            virtual ~FragmentedMuxer();
+            
+            FragmentedMuxer( const FragmentedMuxer & o )              = delete;
+            FragmentedMuxer( FragmentedMuxer && o )                   = delete;
+            FragmentedMuxer & operator =( const FragmentedMuxer & o ) = delete;
+            FragmentedMuxer & operator =( FragmentedMuxer && o )      = delete;
+            
+            /*!
+             * @function    AddTrack
+             * @abstract    Adds a track.
+             * @param       handlerType The handler type (vide, soun, ...).
+             * @param       timescale   The media timescale.
+             * @param       sampleEntry The sample entry, with its codec configuration.
+             * @result      The track ID.
+             * @discussion  Throws if the init segment was already written.
+             */
+            uint32_t AddTrack( const std::string & handlerType, uint32_t timescale, std::shared_ptr< Box > sampleEntry );
+            
+            /*!
+             * @function    AddVideoTrack
+             * @abstract    Adds a video track.
+             * @param       codec       The sample entry type (avc1 or hvc1).
+             * @param       timescale   The media timescale.
+             * @param       width       The width of the pictures.
+             * @param       height      The height of the pictures.
+             * @param       config      The decoder configuration record (avcC or hvcC data).
+             * @result      The track ID.
+             * @discussion  Throws if the codec is not supported, or if the
+             *              init segment was already written.
+             */
+            uint32_t AddVideoTrack( const std::string & codec, uint32_t timescale, uint16_t width, uint16_t height, const std::vector< uint8_t > & config );
+            
+            /*!
+             * @function    Reserve
+             * @abstract    Preallocates storage for the samples of a fragment.
+             * @param       trackID The track ID.
+             * @param       samples The number of samples.
+             * @param       size    The total size of the samples.
+             */
+            void Reserve( uint32_t trackID, size_t samples, size_t size );
+            
+            /*!
+             * @function    AddSample
+             * @abstract    Adds a sample to the pending fragment.
+             * @param       trackID             The track ID.
+             * @param       data                The sample data, which is copied.
+             * @param       size                The size of the sample data.
+             * @param       decodeTime          The decode time, in the media timescale.
+             * @param       duration            The sample duration.
+             * @param       compositionOffset   The composition time offset.
+             * @param       sync                Whether the sample is a sync sample.
+             * @discussion  Decode times must increase. Within a fragment,
+             *              the duration of the previous sample is derived
+             *              from the decode times, so only the duration of
+             *              the last sample is used as is.
+             */
+            void AddSample( uint32_t trackID, const uint8_t * data, size_t size, uint64_t decodeTime, uint32_t duration, int32_t compositionOffset, bool sync );
+            
+            /*!
+             * @function    GetPendingDuration
+             * @abstract    Gets the duration of the pending samples of a track.
+             * @param       trackID The track ID.
+             * @result      The duration, in the media timescale.
+             */
+            uint64_t GetPendingDuration( uint32_t trackID ) const;
+            
+            /*!
+             * @function    GetSequenceNumber
+             * @abstract    Gets the sequence number of the last written fragment.
+             * @result      The sequence number, or 0 if no fragment was written.
+             */
+            uint32_t GetSequenceNumber() const;
+            
+            /*!
+             * @function    WriteInitSegment
+             * @abstract    Writes the FTYP and MOOV boxes.
+             * @discussion  Called by Flush if needed. Does nothing if
+             *              the init segment was already written.
+             */
+            void WriteInitSegment();
+            
+            /*!
+             * @function    Flush
+             * @abstract    Writes the pending samples as a fragment, and flushes the stream.
+             * @discussion  Writes the init segment first if needed. Does
+             *              not write a fragment if no sample is pending.
+             */
+            void Flush();
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_FRAGMENTED_MUXER_HPP */
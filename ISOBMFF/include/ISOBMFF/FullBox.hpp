@@ -50,6 +50,8 @@ namespace ISOBMFF
             FullBox & operator =( FullBox o );
             
             void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
             
             uint8_t  GetVersion() const;
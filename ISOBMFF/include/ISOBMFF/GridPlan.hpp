@@ -0,0 +1,184 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      GridPlan.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_GRID_PLAN_HPP
+#define ISOBMFF_GRID_PLAN_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/ItemReader.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       GridPlan
+     * @abstract    Describes how to fetch the tiles of a grid image item.
+     * @discussion  Tiles are listed in 'dimg' reference order (row-major).
+     *              Each tile knows the byte ranges holding its data, and
+     *              where its data goes in a single buffer (arena) large
+     *              enough for all tiles.
+     * @see         HEIFReader::GetGridPlan
+     */
+    class ISOBMFF_EXPORT GridPlan
+    {
+        public:
+            
+            /*!
+             * @class       Tile
+             * @abstract    A tile of a grid image.
+             * @discussion  The rectangle is expressed in the grid's
+             *              reconstructed image, and may extend past the
+             *              grid's output size, in which case the tile
+             *              should be cropped.
+             */
+            class ISOBMFF_EXPORT Tile
+            {
+                public:
+                    
+                    Tile();
+                    Tile( const Tile & o );
+                    Tile( Tile && o ) noexcept;
+                    virtual ~Tile();
+                    
+                    Tile & operator =( Tile o );
+                    
+                    uint32_t                         GetItemID()     const;
+                    uint32_t                         GetRow()        const;
+                    uint32_t                         GetColumn()     const;
+                    uint64_t                         GetX()          const;
+                    uint64_t                         GetY()          const;
+                    uint32_t                         GetWidth()      const;
+                    uint32_t                         GetHeight()     const;
+                    std::vector< ItemReader::Range > GetRanges()     const;
+                    uint64_t                         GetDataOffset() const;
+                    uint64_t                         GetDataSize()   const;
+                    
+                    void SetItemID( uint32_t value );
+                    void SetRow( uint32_t value );
+                    void SetColumn( uint32_t value );
+                    void SetX( uint64_t value );
+                    void SetY( uint64_t value );
+                    void SetWidth( uint32_t value );
+                    void SetHeight( uint32_t value );
+                    void SetRanges( const std::vector< ItemReader::Range > & value );
+                    void SetDataOffset( uint64_t value );
+                    
+                    ISOBMFF_EXPORT friend void swap( Tile & o1, Tile & o2 );
+                
+                private:
+                    
+                    class IMPL;
+                    
+                    std::unique_ptr< IMPL > impl;
+            };
+            
+            /*!
+             * @function    GridPlan
+             * @abstract    Default constructor.
+             */
+            GridPlan();
+            
+            /*!
+             * @function    GridPlan
+             * @abstract    Copy constructor.
+             * @param       o   The object to copy from.
+             */
+            GridPlan( const GridPlan & o );
+            
+            /*!
+             * @function    GridPlan
+             * @abstract    Move constructor.
+             * @param       o   The object to move from.
+             */
+            GridPlan( GridPlan && o ) noexcept;
+            
+            /*!
+             * @function    ~GridPlan
+             * @abstract    Destructor.
+             */
+            virtual ~GridPlan();
+            
+            /*!
+             * @function    operator=
+             * @abstract    Assignment operator.
+             * @param       o   The object to assign from.
+             */
+            GridPlan & operator =( GridPlan o );
+            
+            uint32_t            GetItemID()       const;
+            uint32_t            GetRows()         const;
+            uint32_t            GetColumns()      const;
+            uint64_t            GetOutputWidth()  const;
+            uint64_t            GetOutputHeight() const;
+            std::vector< Tile > GetTiles()        const;
+            
+            void SetItemID( uint32_t value );
+            void SetRows( uint32_t value );
+            void SetColumns( uint32_t value );
+            void SetOutputWidth( uint64_t value );
+            void SetOutputHeight( uint64_t value );
+            
+            /*!
+             * @function    AddTile
+             * @abstract    Adds a tile to the plan.
+             * @param       tile    The tile to add.
+             * @discussion  The tile is placed in the arena after the
+             *              previously added tiles, and its data offset is
+             *              updated accordingly.
+             */
+            void AddTile( Tile tile );
+            
+            /*!
+             * @function    GetDataSize
+             * @abstract    Gets the size of the arena holding all tiles.
+             * @result      The total size of the tiles' data, in bytes.
+             */
+            uint64_t GetDataSize() const;
+            
+            /*!
+             * @function    swap
+             * @abstract    Swap two objects.
+             * @param       o1  The first object to swap.
+             * @param       o2  The second object to swap.
+             */
+            ISOBMFF_EXPORT friend void swap( GridPlan & o1, GridPlan & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_GRID_PLAN_HPP */
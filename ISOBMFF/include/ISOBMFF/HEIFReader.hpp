@@ -0,0 +1,329 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      HEIFReader.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_HEIF_READER_HPP
+#define ISOBMFF_HEIF_READER_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/ItemReader.hpp>
+#include <ISOBMFF/GridPlan.hpp>
+#include <ISOBMFF/ItemReferenceGraph.hpp>
+#include <ISOBMFF/AnnexBAssembler.hpp>
+#include <ISOBMFF/FTYP.hpp>
+#include <ISOBMFF/META.hpp>
+#include <ISOBMFF/HVCC.hpp>
+#include <ISOBMFF/ISPE.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       HEIFReader
+     * @abstract    Reads images from HEIF files, with minimal I/O.
+     * @discussion  Only the top-level box headers are read, up to the
+     *              META box. The FTYP and META boxes are the only boxes
+     *              parsed, so the rest of the file (eg. MDAT) is never
+     *              loaded. Item data is then read on demand, from the
+     *              item's own extents.
+     */
+    class ISOBMFF_EXPORT HEIFReader
+    {
+        public:
+            
+            /*!
+             * @class       Image
+             * @abstract    An image item, with its data and configuration.
+             */
+            class ISOBMFF_EXPORT Image
+            {
+                public:
+                    
+                    Image();
+                    Image( const Image & o );
+                    Image( Image && o ) noexcept;
+                    virtual ~Image();
+                    
+                    Image & operator =( Image o );
+                    
+                    uint32_t                 GetItemID()   const;
+                    std::string              GetItemType() const;
+                    std::vector< uint8_t >   GetData()     const;
+                    std::shared_ptr< HVCC >  GetHVCC()     const;
+                    std::shared_ptr< ISPE >  GetISPE()     const;
+                    
+                    void SetItemID( uint32_t value );
+                    void SetItemType( const std::string & value );
+                    void SetData( const std::vector< uint8_t > & value );
+                    void SetHVCC( std::shared_ptr< HVCC > value );
+                    void SetISPE( std::shared_ptr< ISPE > value );
+                    
+                    ISOBMFF_EXPORT friend void swap( Image & o1, Image & o2 );
+                
+                private:
+                    
+                    class IMPL;
+                    
+                    std::unique_ptr< IMPL > impl;
+            };
+            
+            /*!
+             * @function    HEIFReader
+             * @abstract    Creates a reader for a file.
+             * @param       path    The file's path.
+             */
+            HEIFReader( const std::string & path );
+            
+            /*!
+             * @function    HEIFReader
+             * @abstract    Creates a reader for a stream.
+             * @param       stream  The stream object.
+             * @discussion  The stream is not owned by the reader, and must
+             *              stay valid for the lifetime of the reader.
+             */
+            HEIFReader( BinaryStream & stream );
+            
+            /*!
+             * @function    HEIFReader
+             * @abstract    Copy constructor.
+             * @param       o   The object to copy from.
+             */
+            HEIFReader( const HEIFReader & o );
+            
+            /*!
+             * @function    HEIFReader
+             * @abstract    Move constructor.
+             * @param       o   The object to move from.
+             */
+            HEIFReader( HEIFReader && o ) noexcept;
+            
+            /*!
+             * @function    ~HEIFReader
+             * @abstract    Destructor.
+             */
+            virtual ~HEIFReader();
+            
+            /*!
+             * @function    operator=
+             * @abstract    Assignment operator.
+             * @param       o   The object to assign from.
+             */
+            HEIFReader & operator =( HEIFReader o );
+            
+            /*!
+             * @function    GetFTYP
+             * @abstract    Gets the FTYP box of the file.
+             * @result      The FTYP box, or nullptr.
+             */
+            std::shared_ptr< FTYP > GetFTYP() const;
+            
+            /*!
+             * @function    GetMETA
+             * @abstract    Gets the top-level META box of the file.
+             * @result      The META box.
+             */
+            std::shared_ptr< META > GetMETA() const;
+            
+            /*!
+             * @function    GetItemReader
+             * @abstract    Gets the reader used for item data.
+             * @result      The item reader.
+             */
+            const ItemReader & GetItemReader() const;
+            
+            /*!
+             * @function    GetPrimaryItemID
+             * @abstract    Gets the ID of the primary item.
+             * @result      The primary item ID.
+             * @discussion  Throws if the file has no PITM box.
+             */
+            uint32_t GetPrimaryItemID() const;
+            
+            /*!
+             * @function    GetItemType
+             * @abstract    Gets the type of an item.
+             * @param       itemID  The item ID.
+             * @result      The item type (eg. 'hvc1'), or an empty string.
+             */
+            std::string GetItemType( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetThumbnailItemIDs
+             * @abstract    Gets the thumbnails of an item.
+             * @param       itemID  The item ID.
+             * @result      The IDs of the items having a 'thmb' reference to the item.
+             */
+            std::vector< uint32_t > GetThumbnailItemIDs( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetMetadataItemIDs
+             * @abstract    Gets the metadata items describing an item.
+             * @param       itemID  The item ID.
+             * @result      The IDs of the items having a 'cdsc' reference to the item (eg. Exif or XMP).
+             */
+            std::vector< uint32_t > GetMetadataItemIDs( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetItemReferences
+             * @abstract    Gets the indexed item references of the file.
+             * @result      The item reference graph.
+             */
+            const ItemReferenceGraph & GetItemReferences() const;
+            
+            /*!
+             * @function    GetItemProperty
+             * @abstract    Gets a property associated to an item.
+             * @param       itemID  The item ID.
+             * @param       type    The property type (four character string).
+             * @result      The first associated property with the given type, or nullptr.
+             */
+            std::shared_ptr< Box > GetItemProperty( uint32_t itemID, const std::string & type ) const;
+            
+            /*!
+             * @function    GetItemProperty
+             * @abstract    Gets a typed property associated to an item.
+             * @param       itemID  The item ID.
+             * @param       type    The property type (four character string).
+             * @result      The first associated property with the given type, or nullptr.
+             */
+            template< class _T_ >
+            std::shared_ptr< _T_ > GetItemProperty( uint32_t itemID, const std::string & type ) const
+            {
+                return std::dynamic_pointer_cast< _T_ >( this->GetItemProperty( itemID, type ) );
+            }
+            
+            /*!
+             * @function    GetImage
+             * @abstract    Gets an image item, with its data and configuration.
+             * @param       itemID  The item ID.
+             * @result      The image.
+             * @discussion  Throws if the item cannot be located.
+             */
+            Image GetImage( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetThumbnail
+             * @abstract    Gets the thumbnail of the primary item.
+             * @result      The thumbnail image, or nullptr if the primary item has no thumbnail.
+             * @discussion  Only the thumbnail's own extents are read.
+             */
+            std::shared_ptr< Image > GetThumbnail() const;
+            
+            /*!
+             * @function    ReadItemAnnexB
+             * @abstract    Reads an HEVC or AVC image item, in Annex-B form.
+             * @param       itemID  The item ID.
+             * @result      The item's parameter sets and NAL units, with start codes.
+             * @discussion  The item's 'hvcC' or 'avcC' property is used for
+             *              the parameter sets and NAL unit length size.
+             *              When the item's bytes are directly addressable
+             *              (IDAT or mapped file), the output buffer is the
+             *              only allocation.
+             *              Throws if the item has no decoder configuration.
+             */
+            std::vector< uint8_t > ReadItemAnnexB( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetExifData
+             * @abstract    Gets the Exif metadata of the primary item.
+             * @result      The Exif data, starting with the TIFF header, or an empty vector.
+             * @discussion  The offset prefix of the 'Exif' item is removed,
+             *              so the result can be given directly to a TIFF
+             *              parser. Only the item's own extents are read.
+             */
+            std::vector< uint8_t > GetExifData() const;
+            
+            /*!
+             * @function    GetXMPData
+             * @abstract    Gets the XMP metadata of the primary item.
+             * @result      The XMP packet, or an empty vector.
+             * @discussion  XMP is stored in a 'mime' item with the
+             *              'application/rdf+xml' content type.
+             *              Only the item's own extents are read.
+             */
+            std::vector< uint8_t > GetXMPData() const;
+            
+            /*!
+             * @function    GetGridPlan
+             * @abstract    Gets the tile fetch plan of a grid image item.
+             * @param       itemID  The ID of a 'grid' item.
+             * @result      The grid plan, with tiles in 'dimg' reference order.
+             * @discussion  Throws if the item is not a valid grid item.
+             */
+            GridPlan GetGridPlan( uint32_t itemID ) const;
+            
+            /*!
+             * @function    ReadGridTiles
+             * @abstract    Reads the data of all tiles of a grid into a caller-provided arena.
+             * @param       plan    The grid plan.
+             * @param       buffer  The destination buffer.
+             * @param       size    The size of the destination buffer.
+             * @param       threads The maximum number of threads to use, or 0 for the number of CPUs.
+             * @discussion  Each tile's data is written at its data offset.
+             *              Extents that are contiguous both in the file and
+             *              in the arena are fetched with a single read, and
+             *              reads are spread over multiple threads when the
+             *              file's bytes are mapped, or when the reader was
+             *              created with a path.
+             *              Throws if the buffer is too small.
+             * @see         GridPlan::GetDataSize
+             */
+            void ReadGridTiles( const GridPlan & plan, uint8_t * buffer, size_t size, unsigned int threads = 0 ) const;
+            
+            /*!
+             * @function    ReadGridTiles
+             * @abstract    Reads the data of all tiles of a grid.
+             * @param       plan    The grid plan.
+             * @param       threads The maximum number of threads to use, or 0 for the number of CPUs.
+             * @result      An arena holding all tiles, each at its data offset.
+             */
+            std::vector< uint8_t > ReadGridTiles( const GridPlan & plan, unsigned int threads = 0 ) const;
+            
+            /*!
+             * @function    swap
+             * @abstract    Swap two objects.
+             * @param       o1  The first object to swap.
+             * @param       o2  The second object to swap.
+             */
+            ISOBMFF_EXPORT friend void swap( HEIFReader & o1, HEIFReader & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_HEIF_READER_HPP */
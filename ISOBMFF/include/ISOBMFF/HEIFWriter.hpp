@@ -0,0 +1,166 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      HEIFWriter.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_HEIF_WRITER_HPP
+#define ISOBMFF_HEIF_WRITER_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Box.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <cstdint>
+#include <vector>
+#include <string>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       HEIFWriter
+     * @abstract    Writes HEIF files from encoded HEVC images.
+     * @discussion  The file holds a FTYP box, a META box describing the
+     *              items, and a single MDAT box with the data of all
+     *              items, in item order.
+     *              Item locations are computed in two passes: the META
+     *              box is built and measured first, then the offsets are
+     *              set, without changing its size.
+     *              Identical properties are stored once, so the tiles
+     *              of a grid share their hvcC and ispe properties.
+     *              Items are added first. Their data can then be set
+     *              from several threads, as long as each thread sets
+     *              different items and no item is added meanwhile.
+     */
+    class ISOBMFF_EXPORT HEIFWriter
+    {
+        public:
+            
+            HEIFWriter();
+            HEIFWriter( const HEIFWriter & o );
+            HEIFWriter( HEIFWriter && o ) noexcept;
+            virtual ~HEIFWriter();
+            
+            HEIFWriter & operator =( HEIFWriter o );
+            
+            /*!
+             * @function    AddImage
+             * @abstract    Adds a HEVC image item.
+             * @param       config  The decoder configuration record (hvcC data).
+             * @param       width   The width of the image.
+             * @param       height  The height of the image.
+             * @result      The item ID.
+             * @discussion  The image gets hvcC and ispe properties.
+             *              Its data must be set with SetItemData.
+             */
+            uint32_t AddImage( const std::vector< uint8_t > & config, uint32_t width, uint32_t height );
+            
+            /*!
+             * @function    AddGrid
+             * @abstract    Adds a grid image item.
+             * @param       rows    The number of rows.
+             * @param       columns The number of columns.
+             * @param       width   The width of the output image.
+             * @param       height  The height of the output image.
+             * @param       tiles   The image items of the tiles, in row-major order.
+             * @result      The item ID.
+             * @discussion  The tiles are hidden, and referenced with a
+             *              dimg reference. Throws if the number of tiles
+             *              does not match the grid, or if a tile is not
+             *              an image item.
+             */
+            uint32_t AddGrid( uint32_t rows, uint32_t columns, uint32_t width, uint32_t height, const std::vector< uint32_t > & tiles );
+            
+            /*!
+             * @function    AddThumbnail
+             * @abstract    Makes an image item the thumbnail of another one.
+             * @param       thumbnailID The thumbnail item.
+             * @param       itemID      The item described by the thumbnail.
+             */
+            void AddThumbnail( uint32_t thumbnailID, uint32_t itemID );
+            
+            /*!
+             * @function    AddProperty
+             * @abstract    Associates a property with an item.
+             * @param       itemID      The item ID.
+             * @param       property    The property (eg. COLR, IROT, PIXI).
+             * @param       essential   Whether readers must support the property.
+             * @discussion  Transformative properties, like irot, must be
+             *              added after descriptive ones.
+             *              The property is encoded when added, so later
+             *              changes to it are ignored. Properties read from
+             *              another file can be added, as they are encoded
+             *              rather than copied from that file.
+             */
+            void AddProperty( uint32_t itemID, std::shared_ptr< Box > property, bool essential );
+            
+            /*!
+             * @function    SetItemData
+             * @abstract    Sets the data of an image item.
+             * @param       itemID  The item ID.
+             * @param       data    The encoded image, as length-prefixed NAL units.
+             */
+            void SetItemData( uint32_t itemID, std::vector< uint8_t > data );
+            
+            uint32_t GetPrimaryItemID() const;
+            
+            /*!
+             * @function    SetPrimaryItemID
+             * @abstract    Sets the primary item.
+             * @param       itemID  The item ID.
+             * @discussion  Defaults to the last added item which is
+             *              neither hidden nor a thumbnail.
+             */
+            void SetPrimaryItemID( uint32_t itemID );
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the file to a stream.
+             * @param       stream  The stream to write to.
+             * @discussion  Throws if an image item has no data.
+             */
+            void Write( BinaryOutputStream & stream ) const;
+            
+            /*!
+             * @function    Write
+             * @abstract    Writes the file.
+             * @param       path    The path of the file.
+             */
+            void Write( const std::string & path ) const;
+            
+            ISOBMFF_EXPORT friend void swap( HEIFWriter & o1, HEIFWriter & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_HEIF_WRITER_HPP */
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      HEVCProfileTierLevel.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_HEVC_PROFILE_TIER_LEVEL_HPP
+#define ISOBMFF_HEVC_PROFILE_TIER_LEVEL_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BitReader.hpp>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       HEVCProfileTierLevel
+     * @abstract    HEVC profile_tier_level() syntax structure (ISO/IEC 23008-2 7.3.3).
+     * @discussion  Only general values are kept. Sub-layer values are
+     *              skipped.
+     */
+    class ISOBMFF_EXPORT HEVCProfileTierLevel
+    {
+        public:
+            
+            HEVCProfileTierLevel();
+            HEVCProfileTierLevel( BitReader & reader, uint8_t maxSubLayersMinusOne );
+            HEVCProfileTierLevel( const HEVCProfileTierLevel & o );
+            HEVCProfileTierLevel( HEVCProfileTierLevel && o ) noexcept;
+            virtual ~HEVCProfileTierLevel();
+            
+            HEVCProfileTierLevel & operator =( HEVCProfileTierLevel o );
+            
+            uint8_t  GetGeneralProfileSpace()              const;
+            bool     GetGeneralTierFlag()                  const;
+            uint8_t  GetGeneralProfileIDC()                const;
+            uint32_t GetGeneralProfileCompatibilityFlags() const;
+            uint64_t GetGeneralConstraintIndicatorFlags()  const;
+            uint8_t  GetGeneralLevelIDC()                  const;
+            
+            ISOBMFF_EXPORT friend void swap( HEVCProfileTierLevel & o1, HEVCProfileTierLevel & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_HEVC_PROFILE_TIER_LEVEL_HPP */
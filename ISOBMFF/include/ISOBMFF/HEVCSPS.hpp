@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      HEVCSPS.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_HEVC_SPS_HPP
+#define ISOBMFF_HEVC_SPS_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/HEVCProfileTierLevel.hpp>
+#include <ISOBMFF/HVCC.hpp>
+#include <cstdint>
+#include <cstddef>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       HEVCSPS
+     * @abstract    HEVC sequence parameter set (ISO/IEC 23008-2 7.3.2.2).
+     * @discussion  Coding tools are skipped, and parsing stops after the
+     *              VUI timing information, so only the fields describing
+     *              the pictures (size, format, colour, frame rate) are
+     *              available.
+     */
+    class ISOBMFF_EXPORT HEVCSPS
+    {
+        public:
+            
+            /*!
+             * @function    HEVCSPS
+             * @abstract    Parses an SPS NAL unit.
+             * @param       data    The NAL unit, including its header, with emulation prevention bytes.
+             * @param       size    The size of the NAL unit.
+             */
+            HEVCSPS( const uint8_t * data, size_t size );
+            
+            /*!
+             * @function    HEVCSPS
+             * @abstract    Parses the first SPS of an HEVC decoder configuration.
+             * @param       hvcC    The HEVC decoder configuration.
+             * @discussion  Throws if the configuration has no SPS.
+             */
+            HEVCSPS( const HVCC & hvcC );
+            
+            HEVCSPS( const HEVCSPS & o );
+            HEVCSPS( HEVCSPS && o ) noexcept;
+            virtual ~HEVCSPS();
+            
+            HEVCSPS & operator =( HEVCSPS o );
+            
+            uint8_t              GetVPSID()                         const;
+            uint8_t              GetMaxSubLayersMinusOne()          const;
+            HEVCProfileTierLevel GetProfileTierLevel()              const;
+            uint32_t             GetSPSID()                         const;
+            uint32_t             GetChromaFormatIDC()               const;
+            bool                 GetSeparateColourPlaneFlag()       const;
+            uint32_t             GetPicWidthInLumaSamples()         const;
+            uint32_t             GetPicHeightInLumaSamples()        const;
+            uint32_t             GetConformanceWindowLeftOffset()   const;
+            uint32_t             GetConformanceWindowRightOffset()  const;
+            uint32_t             GetConformanceWindowTopOffset()    const;
+            uint32_t             GetConformanceWindowBottomOffset() const;
+            uint8_t              GetBitDepthLuma()                  const;
+            uint8_t              GetBitDepthChroma()                const;
+            bool                 HasVUI()                           const;
+            uint16_t             GetSARWidth()                      const;
+            uint16_t             GetSARHeight()                     const;
+            bool                 HasColourDescription()             const;
+            bool                 GetVideoFullRangeFlag()            const;
+            uint8_t              GetColourPrimaries()               const;
+            uint8_t              GetTransferCharacteristics()       const;
+            uint8_t              GetMatrixCoefficients()            const;
+            bool                 HasTimingInfo()                    const;
+            uint32_t             GetNumUnitsInTick()                const;
+            uint32_t             GetTimeScale()                     const;
+            
+            /*!
+             * @function    GetWidth
+             * @abstract    Gets the width of the pictures, with the conformance window applied.
+             * @result      The cropped width, in luma samples.
+             */
+            uint32_t GetWidth() const;
+            
+            /*!
+             * @function    GetHeight
+             * @abstract    Gets the height of the pictures, with the conformance window applied.
+             * @result      The cropped height, in luma samples.
+             */
+            uint32_t GetHeight() const;
+            
+            /*!
+             * @function    GetFrameRate
+             * @abstract    Gets the frame rate, from the VUI timing information.
+             * @result      The frame rate, or 0 if not available.
+             */
+            double GetFrameRate() const;
+            
+            ISOBMFF_EXPORT friend void swap( HEVCSPS & o1, HEVCSPS & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_HEVC_SPS_HPP */
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      HEVCVPS.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_HEVC_VPS_HPP
+#define ISOBMFF_HEVC_VPS_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/HEVCProfileTierLevel.hpp>
+#include <ISOBMFF/HVCC.hpp>
+#include <cstdint>
+#include <cstddef>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       HEVCVPS
+     * @abstract    HEVC video parameter set (ISO/IEC 23008-2 7.3.2.1).
+     * @discussion  Parsing stops after the timing information, so HRD
+     *              parameters and extensions are not available.
+     */
+    class ISOBMFF_EXPORT HEVCVPS
+    {
+        public:
+            
+            /*!
+             * @function    HEVCVPS
+             * @abstract    Parses a VPS NAL unit.
+             * @param       data    The NAL unit, including its header, with emulation prevention bytes.
+             * @param       size    The size of the NAL unit.
+             */
+            HEVCVPS( const uint8_t * data, size_t size );
+            
+            /*!
+             * @function    HEVCVPS
+             * @abstract    Parses the first VPS of an HEVC decoder configuration.
+             * @param       hvcC    The HEVC decoder configuration.
+             * @discussion  Throws if the configuration has no VPS.
+             */
+            HEVCVPS( const HVCC & hvcC );
+            
+            HEVCVPS( const HEVCVPS & o );
+            HEVCVPS( HEVCVPS && o ) noexcept;
+            virtual ~HEVCVPS();
+            
+            HEVCVPS & operator =( HEVCVPS o );
+            
+            uint8_t              GetVPSID()                const;
+            uint8_t              GetMaxLayersMinusOne()    const;
+            uint8_t              GetMaxSubLayersMinusOne() const;
+            bool                 GetTemporalIDNesting()    const;
+            HEVCProfileTierLevel GetProfileTierLevel()     const;
+            bool                 HasTimingInfo()           const;
+            uint32_t             GetNumUnitsInTick()       const;
+            uint32_t             GetTimeScale()            const;
+            
+            /*!
+             * @function    GetFrameRate
+             * @abstract    Gets the frame rate, from the timing information.
+             * @result      The frame rate, or 0 if not available.
+             */
+            double GetFrameRate() const;
+            
+            ISOBMFF_EXPORT friend void swap( HEVCVPS & o1, HEVCVPS & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_HEVC_VPS_HPP */
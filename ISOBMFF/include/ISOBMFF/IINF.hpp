@@ -55,6 +55,9 @@ namespace ISOBMFF
             void ReadData( Parser & parser, BinaryStream & stream ) override;
             void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
             
+            uint64_t GetDataSize()                              const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
+            
             void                                   AddEntry( std::shared_ptr< INFE > entry );
             std::vector< std::shared_ptr< INFE > > GetEntries()                   const;
             std::shared_ptr< INFE >                GetItemInfo( uint32_t itemID ) const;
@@ -51,6 +51,8 @@ namespace ISOBMFF
             ISPE & operator =( ISPE o );
             
             void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
             
             uint32_t GetDisplayWidth()  const;
@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <ISOBMFF/Macros.hpp>
 #include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/BinaryOutputStream.hpp>
 #include <ISOBMFF/DisplayableObject.hpp>
 #include <cstdint>
 #include <ostream>
@@ -69,6 +70,16 @@ namespace ISOBMFF
             void SetOutputWidth( uint64_t value );
             void SetOutputHeight( uint64_t value );
             
+            /*!
+             * @function    Write
+             * @abstract    Writes the grid to a stream.
+             * @param       stream  The stream to write to.
+             * @discussion  Rows and columns are written as is (minus one).
+             *              Output dimensions are written on 32 bits if
+             *              flag 1 is set, otherwise on 16 bits.
+             */
+            void Write( BinaryOutputStream & stream ) const;
+            
             virtual std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
             
             ISOBMFF_EXPORT friend void swap( ImageGrid & o1, ImageGrid & o2 );
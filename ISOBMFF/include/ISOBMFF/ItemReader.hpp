@@ -0,0 +1,230 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ItemReader.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_ITEM_READER_HPP
+#define ISOBMFF_ITEM_READER_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/META.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       ItemReader
+     * @abstract    Reads the data of items described in a META box.
+     * @discussion  Item locations are resolved from the ILOC box, for all
+     *              construction methods: file offsets (0), offsets in the
+     *              IDAT box (1) and offsets in other items (2).
+     *              Adjacent extents are merged, so an item is read with
+     *              as few stream reads as possible.
+     *              The stream is not owned by the reader, and must stay
+     *              valid for the lifetime of the reader.
+     */
+    class ISOBMFF_EXPORT ItemReader
+    {
+        public:
+            
+            /*!
+             * @class       Range
+             * @abstract    A contiguous range of bytes holding item data.
+             */
+            class ISOBMFF_EXPORT Range
+            {
+                public:
+                    
+                    /*!
+                     * @enum        Source
+                     * @abstract    Possible locations for item data.
+                     * @constant    File    The data is located in the file stream.
+                     * @constant    IDAT    The data is located in the IDAT box.
+                     */
+                    enum class Source: int
+                    {
+                        File,
+                        IDAT
+                    };
+                    
+                    Range();
+                    Range( Source source, uint64_t offset, uint64_t length );
+                    Range( const Range & o );
+                    Range( Range && o ) noexcept;
+                    virtual ~Range();
+                    
+                    Range & operator =( Range o );
+                    
+                    Source   GetSource() const;
+                    uint64_t GetOffset() const;
+                    uint64_t GetLength() const;
+                    
+                    void SetSource( Source value );
+                    void SetOffset( uint64_t value );
+                    void SetLength( uint64_t value );
+                    
+                    ISOBMFF_EXPORT friend void swap( Range & o1, Range & o2 );
+                
+                private:
+                    
+                    class IMPL;
+                    
+                    std::unique_ptr< IMPL > impl;
+            };
+            
+            /*!
+             * @function    ItemReader
+             * @abstract    Creates an item reader.
+             * @param       meta    The META box describing the items.
+             * @param       stream  The stream of the file containing the META box.
+             */
+            ItemReader( const META & meta, BinaryStream & stream );
+            
+            /*!
+             * @function    ItemReader
+             * @abstract    Copy constructor.
+             * @param       o   The object to copy from.
+             */
+            ItemReader( const ItemReader & o );
+            
+            /*!
+             * @function    ItemReader
+             * @abstract    Move constructor.
+             * @param       o   The object to move from.
+             */
+            ItemReader( ItemReader && o ) noexcept;
+            
+            /*!
+             * @function    ~ItemReader
+             * @abstract    Destructor.
+             */
+            virtual ~ItemReader();
+            
+            /*!
+             * @function    operator=
+             * @abstract    Assignment operator.
+             * @param       o   The object to assign from.
+             */
+            ItemReader & operator =( ItemReader o );
+            
+            /*!
+             * @function    HasItem
+             * @abstract    Checks if the location of an item is known.
+             * @param       itemID  The item ID.
+             * @result      true if the item has an entry in the ILOC box, otherwise false.
+             */
+            bool HasItem( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetItemRanges
+             * @abstract    Gets the byte ranges holding the data of an item.
+             * @param       itemID  The item ID.
+             * @result      The item's byte ranges, in data order, with adjacent extents merged.
+             * @discussion  Throws if the item cannot be located.
+             */
+            std::vector< Range > GetItemRanges( uint32_t itemID ) const;
+            
+            /*!
+             * @function    GetItemSize
+             * @abstract    Gets the size of an item's data.
+             * @param       itemID  The item ID.
+             * @result      The item's data size, in bytes.
+             * @discussion  Throws if the item cannot be located.
+             */
+            uint64_t GetItemSize( uint32_t itemID ) const;
+            
+            /*!
+             * @function    ReadItem
+             * @abstract    Reads an item's data into a caller-provided buffer.
+             * @param       itemID  The item ID.
+             * @param       buffer  The destination buffer.
+             * @param       size    The size of the destination buffer.
+             * @result      The number of bytes written to the buffer.
+             * @discussion  Throws if the buffer is too small to hold the
+             *              item's data.
+             * @see         GetItemSize
+             */
+            size_t ReadItem( uint32_t itemID, uint8_t * buffer, size_t size ) const;
+            
+            /*!
+             * @function    ReadItem
+             * @abstract    Reads an item's data.
+             * @param       itemID  The item ID.
+             * @result      The item's data.
+             */
+            std::vector< uint8_t > ReadItem( uint32_t itemID ) const;
+            
+            /*!
+             * @function    ReadRanges
+             * @abstract    Reads byte ranges into a caller-provided buffer.
+             * @param       ranges  The ranges to read, usually obtained from `GetItemRanges`.
+             * @param       buffer  The destination buffer.
+             * @param       size    The size of the destination buffer.
+             * @result      The number of bytes written to the buffer.
+             * @discussion  Ranges are written one after the other.
+             *              Throws if the buffer is too small.
+             */
+            size_t ReadRanges( const std::vector< Range > & ranges, uint8_t * buffer, size_t size ) const;
+            
+            /*!
+             * @function    GetItemBytes
+             * @abstract    Gets a borrowed view on an item's data, without copying it.
+             * @param       itemID  The item ID.
+             * @result      A pointer to the item's data, or nullptr.
+             * @discussion  A view is only available when the item's data is
+             *              contiguous and either located in the IDAT box, or
+             *              in a stream exposing its bytes (eg.
+             *              `BinaryMappedFileStream`). Otherwise, nullptr is
+             *              returned and `ReadItem` should be used.
+             *              The pointer is valid as long as the stream and
+             *              the META box are alive.
+             * @see         GetItemSize
+             */
+            const uint8_t * GetItemBytes( uint32_t itemID ) const;
+            
+            /*!
+             * @function    swap
+             * @abstract    Swap two objects.
+             * @param       o1  The first object to swap.
+             * @param       o2  The second object to swap.
+             */
+            ISOBMFF_EXPORT friend void swap( ItemReader & o1, ItemReader & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_ITEM_READER_HPP */
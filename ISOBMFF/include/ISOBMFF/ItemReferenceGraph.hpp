@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      ItemReferenceGraph.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_ITEM_REFERENCE_GRAPH_HPP
+#define ISOBMFF_ITEM_REFERENCE_GRAPH_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/IREF.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       ItemReferenceGraph
+     * @abstract    Indexed graph of the item references of an IREF box.
+     * @discussion  References are indexed by type, in both directions, so
+     *              queries don't need to scan the IREF box.
+     *              A reference of type 'thmb' from item A to item B means
+     *              A is a thumbnail of B, 'cdsc' means A describes B (eg.
+     *              Exif or XMP), and 'dimg' means A is derived from B (eg.
+     *              a grid using tile B).
+     */
+    class ISOBMFF_EXPORT ItemReferenceGraph
+    {
+        public:
+            
+            /*!
+             * @function    ItemReferenceGraph
+             * @abstract    Creates an empty graph.
+             */
+            ItemReferenceGraph();
+            
+            /*!
+             * @function    ItemReferenceGraph
+             * @abstract    Creates a graph from an IREF box.
+             * @param       iref    The IREF box.
+             */
+            ItemReferenceGraph( const IREF & iref );
+            
+            /*!
+             * @function    ItemReferenceGraph
+             * @abstract    Copy constructor.
+             * @param       o   The object to copy from.
+             */
+            ItemReferenceGraph( const ItemReferenceGraph & o );
+            
+            /*!
+             * @function    ItemReferenceGraph
+             * @abstract    Move constructor.
+             * @param       o   The object to move from.
+             */
+            ItemReferenceGraph( ItemReferenceGraph && o ) noexcept;
+            
+            /*!
+             * @function    ~ItemReferenceGraph
+             * @abstract    Destructor.
+             */
+            virtual ~ItemReferenceGraph();
+            
+            /*!
+             * @function    operator=
+             * @abstract    Assignment operator.
+             * @param       o   The object to assign from.
+             */
+            ItemReferenceGraph & operator =( ItemReferenceGraph o );
+            
+            /*!
+             * @function    AddReference
+             * @abstract    Adds a reference to the graph.
+             * @param       type        The reference type (four character string).
+             * @param       fromItemID  The referencing item ID.
+             * @param       toItemID    The referenced item ID.
+             */
+            void AddReference( const std::string & type, uint32_t fromItemID, uint32_t toItemID );
+            
+            /*!
+             * @function    GetReferenceTypes
+             * @abstract    Gets the reference types present in the graph.
+             * @result      The reference types.
+             */
+            std::vector< std::string > GetReferenceTypes() const;
+            
+            /*!
+             * @function    GetReferencedItemIDs
+             * @abstract    Gets the items referenced by an item.
+             * @param       type        The reference type (four character string).
+             * @param       fromItemID  The referencing item ID.
+             * @result      The referenced item IDs, in reference order.
+             * @discussion  For instance, the tiles of a grid for 'dimg'.
+             */
+            std::vector< uint32_t > GetReferencedItemIDs( const std::string & type, uint32_t fromItemID ) const;
+            
+            /*!
+             * @function    GetReferencingItemIDs
+             * @abstract    Gets the items referencing an item.
+             * @param       type        The reference type (four character string).
+             * @param       toItemID    The referenced item ID.
+             * @result      The referencing item IDs.
+             * @discussion  For instance, the thumbnails of an item for
+             *              'thmb', its metadata items for 'cdsc', or the
+             *              grids using a tile for 'dimg'.
+             */
+            std::vector< uint32_t > GetReferencingItemIDs( const std::string & type, uint32_t toItemID ) const;
+            
+            /*!
+             * @function    HasReference
+             * @abstract    Checks if a reference exists.
+             * @param       type        The reference type (four character string).
+             * @param       fromItemID  The referencing item ID.
+             * @param       toItemID    The referenced item ID.
+             * @result      true if the reference exists, otherwise false.
+             */
+            bool HasReference( const std::string & type, uint32_t fromItemID, uint32_t toItemID ) const;
+            
+            /*!
+             * @function    swap
+             * @abstract    Swap two objects.
+             * @param       o1  The first object to swap.
+             * @param       o2  The second object to swap.
+             */
+            ISOBMFF_EXPORT friend void swap( ItemReferenceGraph & o1, ItemReferenceGraph & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_ITEM_REFERENCE_GRAPH_HPP */
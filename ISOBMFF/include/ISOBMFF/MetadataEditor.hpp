@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      MetadataEditor.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_METADATA_EDITOR_HPP
+#define ISOBMFF_METADATA_EDITOR_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/File.hpp>
+#include <cstdint>
+#include <string>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       MetadataEditor
+     * @abstract    Edits the boxes of a file in place, without rewriting the file.
+     * @discussion  Boxes are changed with their setters, on the file
+     *              returned by `GetFile`, and written back by `Save`.
+     *              Only the smallest modified boxes are encoded again,
+     *              and only the bytes that differ are written, at the
+     *              offsets the boxes were read from.
+     *              A box may grow into the FREE or SKIP box that follows
+     *              it, or shrink, leaving a FREE box behind. Sample data
+     *              is never moved, so chunk offsets stay valid.
+     */
+    class ISOBMFF_EXPORT MetadataEditor
+    {
+        public:
+            
+            /*!
+             * @function    MetadataEditor
+             * @abstract    Creates an editor for a file.
+             * @param       path    The path of the file.
+             * @discussion  The file is parsed without keeping the data of
+             *              MDAT boxes. Throws if it cannot be parsed.
+             */
+            MetadataEditor( const std::string & path );
+            
+            MetadataEditor( const MetadataEditor & o );
+            MetadataEditor( MetadataEditor && o ) noexcept;
+            virtual ~MetadataEditor();
+            
+            MetadataEditor & operator =( MetadataEditor o );
+            
+            std::string             GetPath() const;
+            std::shared_ptr< File > GetFile() const;
+            
+            /*!
+             * @function    Save
+             * @abstract    Writes modified boxes back to the file.
+             * @result      The number of bytes written.
+             * @discussion  Throws, before anything is written, if a box
+             *              was added, if a box changed size and there
+             *              is no room for it, or if the original bytes of
+             *              a modified box cannot be encoded again exactly.
+             *              The file is parsed again once written, so boxes
+             *              must be retrieved again from `GetFile`.
+             */
+            uint64_t Save();
+            
+            ISOBMFF_EXPORT friend void swap( MetadataEditor & o1, MetadataEditor & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_METADATA_EDITOR_HPP */
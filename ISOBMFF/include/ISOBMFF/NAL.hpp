@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      NAL.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_NAL_HPP
+#define ISOBMFF_NAL_HPP
+
+#include <ISOBMFF/Macros.hpp>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace ISOBMFF
+{
+    namespace NAL
+    {
+        /*!
+         * @function    FindPattern
+         * @abstract    Finds the next `00 00 0x` pattern (x <= 3) in NAL data.
+         * @param       data    The data to scan.
+         * @param       size    The size of the data.
+         * @result      The offset of the pattern's first byte, or `size` if not found.
+         * @discussion  This pattern covers start codes (`00 00 01`) and
+         *              sequences requiring emulation prevention.
+         *              Scanning uses AVX2 or SSE2 when available, with a
+         *              scalar fallback.
+         */
+        ISOBMFF_EXPORT size_t FindPattern( const uint8_t * data, size_t size );
+        
+        /*!
+         * @function    FindStartCode
+         * @abstract    Finds the next Annex-B start code.
+         * @param       data            The data to scan.
+         * @param       size            The size of the data.
+         * @param       startCodeSize   On output, if not nullptr, the size of the start code (3 or 4 bytes).
+         * @result      The offset of the start code, or `size` if not found.
+         */
+        ISOBMFF_EXPORT size_t FindStartCode( const uint8_t * data, size_t size, size_t * startCodeSize = nullptr );
+        
+        /*!
+         * @function    SplitAnnexB
+         * @abstract    Finds the NAL units in Annex-B data.
+         * @param       data    The Annex-B data.
+         * @param       size    The size of the data.
+         * @result      The offset and size of each NAL unit, without start codes.
+         */
+        ISOBMFF_EXPORT std::vector< std::pair< size_t, size_t > > SplitAnnexB( const uint8_t * data, size_t size );
+        
+        /*!
+         * @function    AnnexBToLengthPrefixed
+         * @abstract    Converts Annex-B data to length-prefixed NAL units.
+         * @param       data        The Annex-B data.
+         * @param       size        The size of the data.
+         * @param       lengthSize  The size of the length fields (1, 2 or 4 bytes).
+         * @result      The length-prefixed NAL units.
+         * @discussion  Throws if a NAL unit is too large for the length size.
+         * @see         AnnexBAssembler
+         */
+        ISOBMFF_EXPORT std::vector< uint8_t > AnnexBToLengthPrefixed( const uint8_t * data, size_t size, uint8_t lengthSize );
+        
+        /*!
+         * @function    RemoveEmulationPrevention
+         * @abstract    Removes emulation prevention bytes (EBSP to RBSP).
+         * @param       data    The NAL unit data.
+         * @param       size    The size of the data.
+         * @param       out     The destination buffer, at least `size` bytes long.
+         * @result      The number of bytes written.
+         * @discussion  `out` may be equal to `data`, to convert in place.
+         */
+        ISOBMFF_EXPORT size_t RemoveEmulationPrevention( const uint8_t * data, size_t size, uint8_t * out );
+        
+        /*!
+         * @function    RemoveEmulationPrevention
+         * @abstract    Removes emulation prevention bytes (EBSP to RBSP).
+         * @param       data    The NAL unit data.
+         * @result      The RBSP data.
+         */
+        ISOBMFF_EXPORT std::vector< uint8_t > RemoveEmulationPrevention( const std::vector< uint8_t > & data );
+        
+        /*!
+         * @function    GetEmulationPreventionSize
+         * @abstract    Gets the size of data once emulation prevention bytes are added.
+         * @param       data    The RBSP data.
+         * @param       size    The size of the data.
+         * @result      The size of the EBSP data.
+         */
+        ISOBMFF_EXPORT size_t GetEmulationPreventionSize( const uint8_t * data, size_t size );
+        
+        /*!
+         * @function    AddEmulationPrevention
+         * @abstract    Adds emulation prevention bytes (RBSP to EBSP).
+         * @param       data    The RBSP data.
+         * @param       size    The size of the data.
+         * @param       out     The destination buffer.
+         * @param       outSize The size of the destination buffer.
+         * @result      The number of bytes written.
+         * @discussion  Throws if the destination buffer is too small.
+         * @see         GetEmulationPreventionSize
+         */
+        ISOBMFF_EXPORT size_t AddEmulationPrevention( const uint8_t * data, size_t size, uint8_t * out, size_t outSize );
+        
+        /*!
+         * @function    AddEmulationPrevention
+         * @abstract    Adds emulation prevention bytes (RBSP to EBSP).
+         * @param       data    The RBSP data.
+         * @result      The EBSP data.
+         */
+        ISOBMFF_EXPORT std::vector< uint8_t > AddEmulationPrevention( const std::vector< uint8_t > & data );
+    }
+}
+
+#endif /* ISOBMFF_NAL_HPP */
@@ -56,6 +56,9 @@ namespace ISOBMFF
             void ReadData( Parser & parser, BinaryStream & stream ) override;
             void WriteDescription( std::ostream & os, std::size_t indentLevel ) const override;
             
+            uint64_t GetDataSize()                              const override;
+            void     WriteData( BinaryOutputStream & stream ) const override;
+            
             virtual std::vector< std::shared_ptr< DisplayableObject > >  GetDisplayableObjects()    const override;
             virtual std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
             
@@ -90,6 +93,17 @@ namespace ISOBMFF
             std::vector< std::shared_ptr< Channel > > GetChannels() const;
             void                                      AddChannel( std::shared_ptr< Channel > array );
             
+            /*!
+             * @function    SetBitsPerChannel
+             * @abstract    Sets the bit depth of a channel.
+             * @param       index   The index of the channel.
+             * @param       value   The number of bits.
+             * @discussion  Unlike Channel::SetBitsPerChannel, this marks
+             *              the box as modified, so the change is written.
+             *              Throws if the index is invalid.
+             */
+            void SetBitsPerChannel( size_t index, uint8_t value );
+            
             ISOBMFF_EXPORT friend void swap( PIXI & o1, PIXI & o2 );
             
         private:
@@ -264,6 +264,25 @@ namespace ISOBMFF
              */
             void SetInfo( const std::string & key, void * value );
             
+            /*!
+             * @function    GetStreamOffset
+             * @abstract    Gets the offset of the stream currently being read.
+             * @result      The offset, in the parsed file, of the first byte of the stream passed to ReadData.
+             * @discussion  Nested boxes are read from streams holding their
+             *              parent's data only. This offset is used to get
+             *              the source range of boxes, in the parsed file.
+             * @see         Box::SetSource
+             */
+            uint64_t GetStreamOffset() const;
+            
+            /*!
+             * @function    SetStreamOffset
+             * @abstract    Sets the offset of the stream currently being read.
+             * @param       value   The offset, in the parsed file, of the first byte of the stream.
+             * @see         GetStreamOffset
+             */
+            void SetStreamOffset( uint64_t value );
+            
             /*!
              * @function    swap
              * @abstract    Swap two objects.
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      RangePlanner.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_RANGE_PLANNER_HPP
+#define ISOBMFF_RANGE_PLANNER_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/ItemReader.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       RangePlanner
+     * @abstract    Plans the byte ranges to fetch to play a time range of a fragmented file.
+     * @discussion  The random access points of a track are taken from its
+     *              segment index (SIDX), following hierarchical and
+     *              daisy-chained indexes, or from the movie fragment
+     *              random access box (MFRA) found at the end of the file.
+     *              Only top-level box headers up to the first SIDX or
+     *              MOOF box are read, plus the index boxes themselves.
+     *              Entries are subsegments (SIDX) or movie fragments
+     *              starting with a random access point (TFRA). Ranges do
+     *              not include the initialization data (FTYP, MOOV).
+     */
+    class ISOBMFF_EXPORT RangePlanner
+    {
+        public:
+            
+            /*!
+             * @enum        Source
+             * @abstract    Possible sources for the index.
+             * @constant    SIDX    Segment index boxes.
+             * @constant    TFRA    Track fragment random access box.
+             */
+            enum class Source: int
+            {
+                SIDX,
+                TFRA
+            };
+            
+            /*!
+             * @function    RangePlanner
+             * @abstract    Creates a planner for a track.
+             * @param       stream  The stream of the file.
+             * @param       trackID The track ID, or 0 for the first indexed track.
+             * @discussion  The stream is only used during construction.
+             *              Throws if the file has no usable index.
+             */
+            RangePlanner( BinaryStream & stream, uint32_t trackID = 0 );
+            
+            RangePlanner( const RangePlanner & o );
+            RangePlanner( RangePlanner && o ) noexcept;
+            virtual ~RangePlanner();
+            
+            RangePlanner & operator =( RangePlanner o );
+            
+            Source   GetSource()  const;
+            uint32_t GetTrackID() const;
+            
+            /*!
+             * @function    GetTimescale
+             * @abstract    Gets the timescale of the entry times.
+             * @result      The timescale, or 0 if unknown (TFRA without a MOOV box).
+             */
+            uint32_t GetTimescale() const;
+            
+            size_t   GetEntryCount()                  const;
+            uint64_t GetEntryTime( size_t index )     const;
+            uint64_t GetEntryDuration( size_t index ) const;
+            uint64_t GetEntryOffset( size_t index )   const;
+            uint64_t GetEntrySize( size_t index )     const;
+            bool     IsEntrySync( size_t index )      const;
+            
+            /*!
+             * @function    GetEntryAtTime
+             * @abstract    Gets the entry containing a time.
+             * @param       time    The presentation time, in the planner's timescale.
+             * @result      The index of the last entry starting at or before the time, or 0.
+             * @discussion  Throws if the planner has no entries.
+             */
+            size_t GetEntryAtTime( uint64_t time ) const;
+            
+            /*!
+             * @function    Plan
+             * @abstract    Gets the byte ranges needed to present a time range.
+             * @param       start   The start of the time range, in the planner's timescale.
+             * @param       end     The end of the time range (exclusive).
+             * @result      The byte ranges, in file order, with adjacent ranges merged.
+             * @discussion  The first range starts at a random access point
+             *              at or before the start time.
+             */
+            std::vector< ItemReader::Range > Plan( uint64_t start, uint64_t end ) const;
+            
+            ISOBMFF_EXPORT friend void swap( RangePlanner & o1, RangePlanner & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_RANGE_PLANNER_HPP */
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      SBGP.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SBGP_HPP
+#define ISOBMFF_SBGP_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/FullBox.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       SBGP
+     * @abstract    Sample to group box (ISO/IEC 14496-12 8.9.2).
+     * @discussion  Entries are stored as one packed array per field, read
+     *              from the file in one bulk read.
+     *              In track fragments, group description indices above
+     *              0x10000 refer to the fragment's own SGPD box.
+     */
+    class ISOBMFF_EXPORT SBGP: public FullBox
+    {
+        public:
+            
+            SBGP();
+            SBGP( const SBGP & o );
+            SBGP( SBGP && o ) noexcept;
+            virtual ~SBGP() override;
+            
+            SBGP & operator =( SBGP o );
+            
+            void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
+            std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
+            
+            std::string GetGroupingType()                        const;
+            uint32_t    GetGroupingTypeParameter()               const;
+            size_t      GetEntryCount()                          const;
+            uint32_t    GetSampleCount( size_t index )           const;
+            uint32_t    GetGroupDescriptionIndex( size_t index ) const;
+            
+            ISOBMFF_EXPORT friend void swap( SBGP & o1, SBGP & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_SBGP_HPP */
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      SGPD.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SGPD_HPP
+#define ISOBMFF_SGPD_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/FullBox.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       SGPD
+     * @abstract    Sample group description box (ISO/IEC 14496-12 8.9.3).
+     * @discussion  Entries are kept as raw data, in a single packed array,
+     *              as their format depends on the grouping type.
+     *              Version 0 boxes do not give the entry sizes, so their
+     *              entries are assumed to have the same size.
+     */
+    class ISOBMFF_EXPORT SGPD: public FullBox
+    {
+        public:
+            
+            SGPD();
+            SGPD( const SGPD & o );
+            SGPD( SGPD && o ) noexcept;
+            virtual ~SGPD() override;
+            
+            SGPD & operator =( SGPD o );
+            
+            void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
+            std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
+            
+            std::string            GetGroupingType()                  const;
+            uint32_t               GetDefaultLength()                 const;
+            uint32_t               GetDefaultSampleDescriptionIndex() const;
+            size_t                 GetEntryCount()                    const;
+            std::vector< uint8_t > GetEntry( size_t index )           const;
+            const uint8_t *        GetEntryData( size_t index )       const;
+            size_t                 GetEntrySize( size_t index )       const;
+            
+            ISOBMFF_EXPORT friend void swap( SGPD & o1, SGPD & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_SGPD_HPP */
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      SIDX.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SIDX_HPP
+#define ISOBMFF_SIDX_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/FullBox.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       SIDX
+     * @abstract    Segment index box (ISO/IEC 14496-12 8.16.3).
+     * @discussion  References are stored as three packed arrays, holding
+     *              the raw fields, read from the file in one bulk read.
+     *              A reference either points to media (a subsegment) or
+     *              to another SIDX box, for hierarchical indexes.
+     *              Referenced offsets are relative to the first byte
+     *              following the box, plus the first offset.
+     */
+    class ISOBMFF_EXPORT SIDX: public FullBox
+    {
+        public:
+            
+            SIDX();
+            SIDX( const SIDX & o );
+            SIDX( SIDX && o ) noexcept;
+            virtual ~SIDX() override;
+            
+            SIDX & operator =( SIDX o );
+            
+            void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
+            std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
+            
+            uint32_t GetReferenceID()              const;
+            uint32_t GetTimescale()                const;
+            uint64_t GetEarliestPresentationTime() const;
+            uint64_t GetFirstOffset()              const;
+            size_t   GetReferenceCount()           const;
+            
+            bool     IsIndexReference( size_t index )      const;
+            uint32_t GetReferencedSize( size_t index )     const;
+            uint32_t GetSubsegmentDuration( size_t index ) const;
+            bool     StartsWithSAP( size_t index )         const;
+            uint8_t  GetSAPType( size_t index )            const;
+            uint32_t GetSAPDeltaTime( size_t index )       const;
+            
+            ISOBMFF_EXPORT friend void swap( SIDX & o1, SIDX & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_SIDX_HPP */
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      STCO.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_STCO_HPP
+#define ISOBMFF_STCO_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/FullBox.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       STCO
+     * @abstract    Chunk offset box (ISO/IEC 14496-12 8.7.5).
+     * @discussion  Offsets are stored as a packed array, read from the
+     *              file in one bulk read.
+     */
+    class ISOBMFF_EXPORT STCO: public FullBox
+    {
+        public:
+            
+            STCO();
+            STCO( const STCO & o );
+            STCO( STCO && o ) noexcept;
+            virtual ~STCO() override;
+            
+            STCO & operator =( STCO o );
+            
+            void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
+            std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
+            
+            size_t   GetEntryCount()                const;
+            uint32_t GetChunkOffset( size_t index ) const;
+            
+            /*!
+             * @function    GetChunkOffsets
+             * @abstract    Gets all chunk offsets.
+             * @result      The chunk offsets, from the start of the file.
+             */
+            const std::vector< uint32_t > & GetChunkOffsets() const;
+            
+            /*!
+             * @function    SetChunkOffsets
+             * @abstract    Sets all chunk offsets.
+             * @param       value   The chunk offsets, from the start of the file.
+             */
+            void SetChunkOffsets( const std::vector< uint32_t > & value );
+            
+            ISOBMFF_EXPORT friend void swap( STCO & o1, STCO & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_STCO_HPP */
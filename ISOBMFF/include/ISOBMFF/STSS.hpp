@@ -35,6 +35,8 @@
 #include <algorithm>
 #include <ISOBMFF/Macros.hpp>
 #include <ISOBMFF/FullBox.hpp>
+#include <ISOBMFF/STTS.hpp>
+#include <ISOBMFF/CTTS.hpp>
 #include <string>
 
 namespace ISOBMFF
@@ -51,10 +53,57 @@ namespace ISOBMFF
             STSS & operator =( STSS o );
 
             void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
 
             size_t   GetEntryCount()                 const;
             uint32_t GetSampleNumber(  size_t index ) const;
+            
+            /*!
+             * @function    IsSyncSample
+             * @abstract    Checks if a sample is a sync sample.
+             * @param       sample  The zero-based sample index.
+             * @result      true if the sample is listed in the box, otherwise false.
+             */
+            bool IsSyncSample( uint64_t sample ) const;
+            
+            /*!
+             * @function    GetSyncSampleAtOrBefore
+             * @abstract    Gets the nearest sync sample at or before a sample.
+             * @param       sample  The zero-based sample index.
+             * @result      The zero-based index of the sync sample.
+             * @discussion  If no sync sample precedes the sample, the first
+             *              sync sample is returned.
+             *              Throws if the box has no entries.
+             */
+            uint64_t GetSyncSampleAtOrBefore( uint64_t sample ) const;
+            
+            /*!
+             * @function    GetSyncSampleAtOrAfter
+             * @abstract    Gets the nearest sync sample at or after a sample.
+             * @param       sample  The zero-based sample index.
+             * @result      The zero-based index of the sync sample.
+             * @discussion  If no sync sample follows the sample, the last
+             *              sync sample is returned.
+             *              Throws if the box has no entries.
+             */
+            uint64_t GetSyncSampleAtOrAfter( uint64_t sample ) const;
+            
+            /*!
+             * @function    GetSyncSampleAtOrBeforeTime
+             * @abstract    Gets the sync sample to start decoding from to present a given time.
+             * @param       stss    The sync sample box, or nullptr if the track has none, in which case every sample is a sync sample.
+             * @param       stts    The time to sample box of the track.
+             * @param       ctts    The composition offset box of the track, or nullptr.
+             * @param       time    The presentation time, in media timescale units.
+             * @result      The zero-based index of the latest sync sample presented at or before the time.
+             * @discussion  Lookups are binary searches on the STTS, CTTS
+             *              and STSS indexes. If no sync sample is
+             *              presented before the time, the first sync
+             *              sample is returned.
+             */
+            static uint64_t GetSyncSampleAtOrBeforeTime( const STSS * stss, const STTS & stts, const CTTS * ctts, uint64_t time );
 
             ISOBMFF_EXPORT friend void swap( STSS & o1, STSS & o2 );
 
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      STSZ.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_STSZ_HPP
+#define ISOBMFF_STSZ_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/FullBox.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       STSZ
+     * @abstract    Sample size box (ISO/IEC 14496-12 8.7.3.2).
+     * @discussion  Sizes are stored as a packed array, read from the file
+     *              in one bulk read. No array is stored when all samples
+     *              have the same size.
+     */
+    class ISOBMFF_EXPORT STSZ: public FullBox
+    {
+        public:
+            
+            STSZ();
+            STSZ( const STSZ & o );
+            STSZ( STSZ && o ) noexcept;
+            virtual ~STSZ() override;
+            
+            STSZ & operator =( STSZ o );
+            
+            void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
+            std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
+            
+            uint32_t GetSampleSize()  const;
+            uint32_t GetSampleCount() const;
+            
+            /*!
+             * @function    GetEntrySize
+             * @abstract    Gets the size of a sample.
+             * @param       index   The zero-based sample index.
+             * @result      The sample size, in bytes.
+             * @discussion  Handles both constant and per-sample sizes.
+             */
+            uint32_t GetEntrySize( size_t index ) const;
+            
+            /*!
+             * @function    GetEntrySizes
+             * @abstract    Gets the per-sample sizes.
+             * @result      The sample sizes, or an empty array if all samples have the size returned by `GetSampleSize`.
+             */
+            const std::vector< uint32_t > & GetEntrySizes() const;
+            
+            ISOBMFF_EXPORT friend void swap( STSZ & o1, STSZ & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_STSZ_HPP */
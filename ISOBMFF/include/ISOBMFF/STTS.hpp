@@ -51,11 +51,74 @@ namespace ISOBMFF
             STTS & operator =( STTS o );
 
             void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
 
             size_t   GetEntryCount()                 const;
             uint32_t GetSampleCount(  size_t index ) const;
             uint32_t GetSampleOffset( size_t index ) const;
+            
+            /*!
+             * @function    GetTotalSampleCount
+             * @abstract    Gets the number of samples described by the box.
+             * @result      The sum of all entries' sample counts.
+             */
+            uint64_t GetTotalSampleCount() const;
+            
+            /*!
+             * @function    GetTotalDuration
+             * @abstract    Gets the duration of all samples.
+             * @result      The duration, in media timescale units.
+             */
+            uint64_t GetTotalDuration() const;
+            
+            /*!
+             * @function    GetDecodeTime
+             * @abstract    Gets the decode time of a sample.
+             * @param       sample  The zero-based sample index.
+             * @result      The decode time, in media timescale units.
+             * @discussion  Lookups use an index of the entries, built on
+             *              first use, and run in O(log n).
+             *              Throws if the sample does not exist.
+             */
+            uint64_t GetDecodeTime( uint64_t sample ) const;
+            
+            /*!
+             * @function    GetSampleDuration
+             * @abstract    Gets the duration of a sample.
+             * @param       sample  The zero-based sample index.
+             * @result      The duration, in media timescale units.
+             * @discussion  Throws if the sample does not exist.
+             */
+            uint32_t GetSampleDuration( uint64_t sample ) const;
+            
+            /*!
+             * @function    GetSampleAtTime
+             * @abstract    Gets the sample being decoded at a given time.
+             * @param       time    The decode time, in media timescale units.
+             * @result      The zero-based index of the sample whose decode interval contains the time.
+             * @discussion  Times after the last sample map to the last
+             *              sample. Throws if the box has no samples.
+             */
+            uint64_t GetSampleAtTime( uint64_t time ) const;
+            
+            /*!
+             * @function    GetEntryForSample
+             * @abstract    Gets the entry describing a sample.
+             * @param       sample  The zero-based sample index.
+             * @result      The index of the entry.
+             * @discussion  Throws if the sample does not exist.
+             */
+            size_t GetEntryForSample( uint64_t sample ) const;
+            
+            /*!
+             * @function    GetEntryFirstSample
+             * @abstract    Gets the first sample described by an entry.
+             * @param       index   The index of the entry.
+             * @result      The zero-based index of the entry's first sample.
+             */
+            uint64_t GetEntryFirstSample( size_t index ) const;
 
             ISOBMFF_EXPORT friend void swap( STTS & o1, STTS & o2 );
 
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      SampleDecryptor.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SAMPLE_DECRYPTOR_HPP
+#define ISOBMFF_SAMPLE_DECRYPTOR_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/EncryptionIndex.hpp>
+#include <cstdint>
+#include <vector>
+#include <string>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       SampleDecryptor
+     * @abstract    Decrypts samples protected with the 'cenc' or 'cbcs' schemes (ISO/IEC 23001-7).
+     * @discussion  Samples are decrypted in place, following the
+     *              subsample map and encryption pattern of an
+     *              `EncryptionIndex`.
+     *              'cenc' uses AES-128 CTR on the whole protected range
+     *              of a sample. 'cbcs' uses AES-128 CBC, restarting from
+     *              the IV at each subsample, on the crypted blocks of the
+     *              pattern only.
+     *              AES-NI instructions are used when the CPU supports
+     *              them, with a portable implementation as fallback.
+     */
+    class ISOBMFF_EXPORT SampleDecryptor
+    {
+        public:
+            
+            /*!
+             * @function    SampleDecryptor
+             * @abstract    Creates a decryptor.
+             * @param       scheme  The protection scheme type, from the SCHM box ('cenc' or 'cbcs').
+             * @param       key     The 16-byte content key.
+             * @discussion  Throws if the scheme is not supported, or if the
+             *              key is not a 128-bit key.
+             */
+            SampleDecryptor( const std::string & scheme, const std::vector< uint8_t > & key );
+            
+            SampleDecryptor( const SampleDecryptor & o );
+            SampleDecryptor( SampleDecryptor && o ) noexcept;
+            virtual ~SampleDecryptor();
+            
+            SampleDecryptor & operator =( SampleDecryptor o );
+            
+            std::string GetScheme() const;
+            
+            /*!
+             * @function    IsAccelerated
+             * @abstract    Checks if AES-NI instructions are used.
+             * @result      true if samples are decrypted with AES-NI, otherwise false.
+             */
+            bool IsAccelerated() const;
+            
+            /*!
+             * @function    SetAccelerated
+             * @abstract    Enables or disables AES-NI instructions.
+             * @param       value   true to use AES-NI when available, false to force the portable implementation.
+             */
+            void SetAccelerated( bool value );
+            
+            /*!
+             * @function    Decrypt
+             * @abstract    Decrypts a sample in place.
+             * @param       data    The sample's data.
+             * @param       size    The size of the sample's data.
+             * @param       index   The encryption index of the sample's track or track fragment.
+             * @param       sample  The zero-based index of the sample in the encryption index.
+             * @discussion  Unprotected samples are left untouched.
+             *              Throws if the subsamples do not fit in the data.
+             */
+            void Decrypt( uint8_t * data, size_t size, const EncryptionIndex & index, size_t sample ) const;
+            
+            ISOBMFF_EXPORT friend void swap( SampleDecryptor & o1, SampleDecryptor & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_SAMPLE_DECRYPTOR_HPP */
@@ -0,0 +1,192 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      SampleTable.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SAMPLE_TABLE_HPP
+#define ISOBMFF_SAMPLE_TABLE_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Container.hpp>
+#include <ISOBMFF/STTS.hpp>
+#include <ISOBMFF/CTTS.hpp>
+#include <ISOBMFF/STSS.hpp>
+#include <ISOBMFF/STSC.hpp>
+#include <cstdint>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       SampleTable
+     * @abstract    Index of the samples of a track.
+     * @discussion  Combines the boxes of a sample table (STBL) to locate
+     *              and time samples: chunk runs (STSC), chunk offsets
+     *              (STCO/CO64), sample sizes (STSZ/STZ2), decode times
+     *              (STTS), composition offsets (CTTS) and sync samples
+     *              (STSS).
+     *              No per-sample record is created: random access runs
+     *              in O(log n) using the boxes' own indexes, and the
+     *              `Iterator` class walks samples in O(1) per sample.
+     *              All sample indexes are zero-based.
+     */
+    class ISOBMFF_EXPORT SampleTable
+    {
+        public:
+            
+            /*!
+             * @class       Iterator
+             * @abstract    Forward iterator over the samples of a table.
+             * @discussion  The iterator tracks its position in every box,
+             *              so moving to the next sample does not search
+             *              anything. The table must outlive the iterator.
+             */
+            class ISOBMFF_EXPORT Iterator
+            {
+                public:
+                    
+                    /*!
+                     * @function    Iterator
+                     * @abstract    Creates an iterator.
+                     * @param       table   The sample table.
+                     * @param       sample  The first sample to visit.
+                     */
+                    Iterator( const SampleTable & table, uint64_t sample = 0 );
+                    Iterator( const Iterator & o );
+                    Iterator( Iterator && o ) noexcept;
+                    virtual ~Iterator();
+                    
+                    Iterator & operator =( Iterator o );
+                    
+                    /*!
+                     * @function    HasSample
+                     * @abstract    Checks if the iterator is on a sample.
+                     * @result      false once past the last sample, otherwise true.
+                     */
+                    bool HasSample() const;
+                    
+                    /*!
+                     * @function    Next
+                     * @abstract    Moves to the next sample.
+                     */
+                    void Next();
+                    
+                    uint64_t GetSample()                 const;
+                    uint64_t GetChunk()                  const;
+                    uint64_t GetOffset()                 const;
+                    uint32_t GetSize()                   const;
+                    uint64_t GetDecodeTime()             const;
+                    int64_t  GetCompositionTime()        const;
+                    uint32_t GetDuration()               const;
+                    bool     IsSync()                    const;
+                    uint32_t GetSampleDescriptionIndex() const;
+                    
+                    ISOBMFF_EXPORT friend void swap( Iterator & o1, Iterator & o2 );
+                
+                private:
+                    
+                    class IMPL;
+                    
+                    std::unique_ptr< IMPL > impl;
+            };
+            
+            /*!
+             * @function    SampleTable
+             * @abstract    Creates a sample table.
+             * @param       stbl    The STBL box of the track.
+             * @discussion  Throws if a mandatory box is missing, or if the
+             *              chunk layout is invalid.
+             *              The number of samples is the smallest number
+             *              described by the sizes, the chunk layout and
+             *              the decode times.
+             */
+            SampleTable( const Container & stbl );
+            
+            SampleTable( const SampleTable & o );
+            SampleTable( SampleTable && o ) noexcept;
+            virtual ~SampleTable();
+            
+            SampleTable & operator =( SampleTable o );
+            
+            std::shared_ptr< STTS > GetSTTS() const;
+            std::shared_ptr< CTTS > GetCTTS() const;
+            std::shared_ptr< STSS > GetSTSS() const;
+            std::shared_ptr< STSC > GetSTSC() const;
+            
+            uint64_t GetSampleCount() const;
+            uint64_t GetChunkCount()  const;
+            
+            uint64_t GetChunkOffset( uint64_t chunk )             const;
+            uint64_t GetChunkForSample( uint64_t sample )         const;
+            uint64_t GetChunkFirstSample( uint64_t chunk )        const;
+            uint64_t GetSampleOffset( uint64_t sample )           const;
+            uint32_t GetSampleSize( uint64_t sample )             const;
+            uint64_t GetDecodeTime( uint64_t sample )             const;
+            int64_t  GetCompositionTime( uint64_t sample )        const;
+            uint32_t GetSampleDuration( uint64_t sample )         const;
+            bool     IsSyncSample( uint64_t sample )              const;
+            uint32_t GetSampleDescriptionIndex( uint64_t sample ) const;
+            
+            /*!
+             * @function    GetSampleAtTime
+             * @abstract    Gets the sample being decoded at a given time.
+             * @param       time    The decode time, in media timescale units.
+             * @result      The sample index.
+             * @see         STTS::GetSampleAtTime
+             */
+            uint64_t GetSampleAtTime( uint64_t time ) const;
+            
+            /*!
+             * @function    GetSyncSampleAtOrBeforeTime
+             * @abstract    Gets the sync sample to start decoding from to present a given time.
+             * @param       time    The presentation time, in media timescale units.
+             * @result      The sample index.
+             * @see         STSS::GetSyncSampleAtOrBeforeTime
+             */
+            uint64_t GetSyncSampleAtOrBeforeTime( uint64_t time ) const;
+            
+            /*!
+             * @function    GetIterator
+             * @abstract    Gets an iterator starting at a sample.
+             * @param       sample  The first sample to visit.
+             * @result      The iterator.
+             */
+            Iterator GetIterator( uint64_t sample = 0 ) const;
+            
+            ISOBMFF_EXPORT friend void swap( SampleTable & o1, SampleTable & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_SAMPLE_TABLE_HPP */
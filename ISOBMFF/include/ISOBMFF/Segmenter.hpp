@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Segmenter.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_SEGMENTER_HPP
+#define ISOBMFF_SEGMENTER_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/ItemReader.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Segmenter
+     * @abstract    Generates fragmented (CMAF) segments from a track of a progressive file.
+     * @discussion  The init segment holds a copy of the track's boxes,
+     *              with empty sample tables, and a MVEX box.
+     *              Media segments hold one MOOF box, built from the
+     *              sample table, followed by a MDAT box. Only the MOOF
+     *              box and the MDAT header are generated: the payload is
+     *              a list of byte ranges in the source file, to be sent
+     *              as is.
+     *              Segments start on sync samples. Times are decode
+     *              times, in the media timescale.
+     *              Protected tracks are not supported.
+     */
+    class ISOBMFF_EXPORT Segmenter
+    {
+        public:
+            
+            /*!
+             * @class       Segment
+             * @abstract    A media segment.
+             */
+            class ISOBMFF_EXPORT Segment
+            {
+                public:
+                    
+                    Segment();
+                    Segment( const Segment & o );
+                    Segment( Segment && o ) noexcept;
+                    virtual ~Segment();
+                    
+                    Segment & operator =( Segment o );
+                    
+                    uint32_t GetSequenceNumber() const;
+                    uint64_t GetFirstSample()    const;
+                    uint64_t GetSampleCount()    const;
+                    uint64_t GetStartTime()      const;
+                    uint64_t GetDuration()       const;
+                    
+                    /*!
+                     * @function    GetHeader
+                     * @abstract    Gets the generated part of the segment.
+                     * @result      The MOOF box, followed by the header of the MDAT box.
+                     */
+                    std::vector< uint8_t > GetHeader() const;
+                    
+                    /*!
+                     * @function    GetRanges
+                     * @abstract    Gets the payload of the MDAT box.
+                     * @result      The byte ranges of the samples in the source file, in order, with adjacent ranges merged.
+                     */
+                    std::vector< ItemReader::Range > GetRanges() const;
+                    
+                    /*!
+                     * @function    GetSize
+                     * @abstract    Gets the size of the segment.
+                     * @result      The size of the header, plus the size of the ranges.
+                     */
+                    uint64_t GetSize() const;
+                    
+                    void SetSequenceNumber( uint32_t value );
+                    void SetFirstSample( uint64_t value );
+                    void SetSampleCount( uint64_t value );
+                    void SetStartTime( uint64_t value );
+                    void SetDuration( uint64_t value );
+                    void SetHeader( const std::vector< uint8_t > & value );
+                    void SetRanges( const std::vector< ItemReader::Range > & value );
+                    
+                    ISOBMFF_EXPORT friend void swap( Segment & o1, Segment & o2 );
+                
+                private:
+                    
+                    class IMPL;
+                    
+                    std::unique_ptr< IMPL > impl;
+            };
+            
+            /*!
+             * @function    Segmenter
+             * @abstract    Creates a segmenter for a track.
+             * @param       stream  The stream of the file.
+             * @param       trackID The track ID, or 0 for the first track.
+             * @discussion  The stream is only used during construction,
+             *              to parse the file and copy the boxes of the
+             *              init segment.
+             *              Throws if the track cannot be found, has no
+             *              samples, or is protected.
+             */
+            Segmenter( BinaryStream & stream, uint32_t trackID = 0 );
+            
+            Segmenter( const Segmenter & o );
+            Segmenter( Segmenter && o ) noexcept;
+            virtual ~Segmenter();
+            
+            Segmenter & operator =( Segmenter o );
+            
+            uint32_t GetTrackID()   const;
+            uint32_t GetTimescale() const;
+            uint64_t GetDuration()  const;
+            
+            /*!
+             * @function    GetInitSegment
+             * @abstract    Gets the init segment.
+             * @result      The FTYP and MOOV boxes of the init segment.
+             */
+            std::vector< uint8_t > GetInitSegment() const;
+            
+            /*!
+             * @function    GetBoundaries
+             * @abstract    Splits the track in segments of a target duration.
+             * @param       duration    The target duration of the segments.
+             * @result      The start time of each segment, followed by the end time of the track.
+             * @discussion  Segments are at least as long as the target
+             *              duration, except the last one, as they must
+             *              start on sync samples.
+             */
+            std::vector< uint64_t > GetBoundaries( uint64_t duration ) const;
+            
+            /*!
+             * @function    GetSegment
+             * @abstract    Generates a media segment for a time range.
+             * @param       start           The start of the time range.
+             * @param       end             The end of the time range (exclusive).
+             * @param       sequenceNumber  The sequence number of the MFHD box.
+             * @result      The segment.
+             * @discussion  Both bounds are moved forward to the next sync
+             *              sample, so consecutive ranges give contiguous
+             *              segments. Throws if the range has no samples,
+             *              or if the sample description changes within it.
+             */
+            Segment GetSegment( uint64_t start, uint64_t end, uint32_t sequenceNumber ) const;
+            
+            ISOBMFF_EXPORT friend void swap( Segmenter & o1, Segmenter & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_SEGMENTER_HPP */
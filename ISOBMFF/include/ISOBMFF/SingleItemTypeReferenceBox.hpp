@@ -51,6 +51,8 @@ namespace ISOBMFF
             SingleItemTypeReferenceBox & operator =( SingleItemTypeReferenceBox o );
             
             void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
             std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
             
             uint32_t                GetFromItemID() const;
@@ -59,6 +61,14 @@ namespace ISOBMFF
             void SetFromItemID( uint32_t value );
             void AddToItemID( uint32_t value );
             
+            /*!
+             * @function    GetVersion
+             * @abstract    Gets the version of the IREF box holding the reference.
+             * @result      The IREF version. Version 0 uses 16-bit item IDs, version 1 uses 32-bit item IDs.
+             */
+            uint8_t GetVersion() const;
+            void    SetVersion( uint8_t value );
+            
             ISOBMFF_EXPORT friend void swap( SingleItemTypeReferenceBox & o1, SingleItemTypeReferenceBox & o2 );
             
         private:
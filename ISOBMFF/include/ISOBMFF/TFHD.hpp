@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      TFHD.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_TFHD_HPP
+#define ISOBMFF_TFHD_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/FullBox.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       TFHD
+     * @abstract    Track fragment header box (ISO/IEC 14496-12 8.8.7).
+     * @discussion  Optional fields are present according to the box flags,
+     *              and are 0 when absent. Defaults for absent fields come
+     *              from the track's TREX box.
+     */
+    class ISOBMFF_EXPORT TFHD: public FullBox
+    {
+        public:
+            
+            TFHD();
+            TFHD( const TFHD & o );
+            TFHD( TFHD && o ) noexcept;
+            virtual ~TFHD() override;
+            
+            TFHD & operator =( TFHD o );
+            
+            void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
+            std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
+            
+            uint32_t GetTrackID()                const;
+            uint64_t GetBaseDataOffset()         const;
+            uint32_t GetSampleDescriptionIndex() const;
+            uint32_t GetDefaultSampleDuration()  const;
+            uint32_t GetDefaultSampleSize()      const;
+            uint32_t GetDefaultSampleFlags()     const;
+            
+            void SetTrackID( uint32_t value );
+            void SetBaseDataOffset( uint64_t value );
+            void SetSampleDescriptionIndex( uint32_t value );
+            void SetDefaultSampleDuration( uint32_t value );
+            void SetDefaultSampleSize( uint32_t value );
+            void SetDefaultSampleFlags( uint32_t value );
+            
+            bool HasBaseDataOffset()         const;
+            bool HasSampleDescriptionIndex() const;
+            bool HasDefaultSampleDuration()  const;
+            bool HasDefaultSampleSize()      const;
+            bool HasDefaultSampleFlags()     const;
+            bool IsDurationEmpty()           const;
+            bool IsDefaultBaseMOOF()         const;
+            
+            ISOBMFF_EXPORT friend void swap( TFHD & o1, TFHD & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_TFHD_HPP */
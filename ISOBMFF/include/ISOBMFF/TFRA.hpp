@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      TFRA.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_TFRA_HPP
+#define ISOBMFF_TFRA_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/FullBox.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       TFRA
+     * @abstract    Track fragment random access box (ISO/IEC 14496-12 8.8.10).
+     * @discussion  Entries are stored as one packed array per field, and
+     *              decoded from a single read of the entry table.
+     *              Traf, trun and sample numbers are 1-based, as in the
+     *              file.
+     */
+    class ISOBMFF_EXPORT TFRA: public FullBox
+    {
+        public:
+            
+            TFRA();
+            TFRA( const TFRA & o );
+            TFRA( TFRA && o ) noexcept;
+            virtual ~TFRA() override;
+            
+            TFRA & operator =( TFRA o );
+            
+            void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
+            std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
+            
+            uint32_t GetTrackID()          const;
+            uint8_t  GetTrafNumberSize()   const;
+            uint8_t  GetTrunNumberSize()   const;
+            uint8_t  GetSampleNumberSize() const;
+            size_t   GetEntryCount()       const;
+            
+            uint64_t GetTime( size_t index )         const;
+            uint64_t GetMoofOffset( size_t index )   const;
+            uint32_t GetTrafNumber( size_t index )   const;
+            uint32_t GetTrunNumber( size_t index )   const;
+            uint32_t GetSampleNumber( size_t index ) const;
+            
+            ISOBMFF_EXPORT friend void swap( TFRA & o1, TFRA & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_TFRA_HPP */
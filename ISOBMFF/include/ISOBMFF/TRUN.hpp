@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      TRUN.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_TRUN_HPP
+#define ISOBMFF_TRUN_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/FullBox.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       TRUN
+     * @abstract    Track fragment run box (ISO/IEC 14496-12 8.8.8).
+     * @discussion  Per-sample fields are stored as one packed array per
+     *              field present in the box, read from the file in one
+     *              bulk read. Absent fields should be taken from the TFHD
+     *              or TREX defaults.
+     */
+    class ISOBMFF_EXPORT TRUN: public FullBox
+    {
+        public:
+            
+            TRUN();
+            TRUN( const TRUN & o );
+            TRUN( TRUN && o ) noexcept;
+            virtual ~TRUN() override;
+            
+            TRUN & operator =( TRUN o );
+            
+            void                                                 ReadData( Parser & parser, BinaryStream & stream ) override;
+            uint64_t                                             GetDataSize() const override;
+            void                                                 WriteData( BinaryOutputStream & stream ) const override;
+            std::vector< std::pair< std::string, std::string > > GetDisplayableProperties() const override;
+            
+            uint32_t GetSampleCount()      const;
+            bool     HasDataOffset()       const;
+            int32_t  GetDataOffset()       const;
+            bool     HasFirstSampleFlags() const;
+            uint32_t GetFirstSampleFlags() const;
+            
+            bool HasSampleDuration()              const;
+            bool HasSampleSize()                  const;
+            bool HasSampleFlags()                 const;
+            bool HasSampleCompositionTimeOffset() const;
+            
+            uint32_t GetSampleDuration( size_t index )              const;
+            uint32_t GetSampleSize( size_t index )                  const;
+            uint32_t GetSampleFlags( size_t index )                 const;
+            int64_t  GetSampleCompositionTimeOffset( size_t index ) const;
+            
+            void SetDataOffset( int32_t value );
+            void SetFirstSampleFlags( uint32_t value );
+            
+            /*!
+             * @function    AddSample
+             * @abstract    Adds a sample to the run.
+             * @param       duration                The sample duration.
+             * @param       size                    The sample size.
+             * @param       flags                   The sample flags.
+             * @param       compositionTimeOffset   The sample composition time offset (signed for version 1).
+             * @discussion  Only the fields present according to the box
+             *              flags are written.
+             */
+            void AddSample( uint32_t duration, uint32_t size, uint32_t flags, int64_t compositionTimeOffset );
+            
+            /*!
+             * @function    ClearSamples
+             * @abstract    Removes all samples from the run.
+             * @discussion  Storage is kept, so a run can be refilled
+             *              without allocations.
+             */
+            void ClearSamples();
+            
+            ISOBMFF_EXPORT friend void swap( TRUN & o1, TRUN & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_TRUN_HPP */
@@ -0,0 +1,147 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      Timeline.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_TIMELINE_HPP
+#define ISOBMFF_TIMELINE_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/ELST.hpp>
+#include <ISOBMFF/SampleTable.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       Timeline
+     * @abstract    Maps the movie timeline of a track to its media timeline.
+     * @discussion  The mapping is described by the track's edit list.
+     *              Without an edit list, movie time 0 maps to media time
+     *              0 for the whole track.
+     *              Movie times are expressed in the movie timescale (MVHD)
+     *              and media times in the media timescale (MDHD). Media
+     *              times are composition times.
+     *              Segments with a media rate of 0 (dwells) map their
+     *              whole duration to their media time. Other rates are
+     *              treated as 1.
+     *              Lookups are binary searches over the segments.
+     */
+    class ISOBMFF_EXPORT Timeline
+    {
+        public:
+            
+            /*!
+             * @function    Timeline
+             * @abstract    Creates a timeline.
+             * @param       elst            The track's edit list, or nullptr.
+             * @param       movieTimescale  The movie timescale.
+             * @param       mediaTimescale  The media timescale.
+             * @discussion  Throws if a timescale is 0.
+             */
+            Timeline( std::shared_ptr< ELST > elst, uint32_t movieTimescale, uint32_t mediaTimescale );
+            
+            Timeline( const Timeline & o );
+            Timeline( Timeline && o ) noexcept;
+            virtual ~Timeline();
+            
+            Timeline & operator =( Timeline o );
+            
+            uint32_t GetMovieTimescale() const;
+            uint32_t GetMediaTimescale() const;
+            
+            size_t   GetSegmentCount()                   const;
+            uint64_t GetSegmentMovieTime( size_t index ) const;
+            uint64_t GetSegmentDuration( size_t index )  const;
+            int64_t  GetSegmentMediaTime( size_t index ) const;
+            bool     IsEmptySegment( size_t index )      const;
+            
+            /*!
+             * @function    GetInitialDelay
+             * @abstract    Gets the time before the first media sample is presented.
+             * @result      The total duration of the leading empty edits, in movie timescale units.
+             */
+            uint64_t GetInitialDelay() const;
+            
+            /*!
+             * @function    GetMediaTime
+             * @abstract    Converts a movie time to a media time.
+             * @param       movieTime   The movie time.
+             * @param       mediaTime   On output, the media time.
+             * @result      false if nothing is presented at the movie time (empty edit, or past the last segment), otherwise true.
+             */
+            bool GetMediaTime( uint64_t movieTime, int64_t & mediaTime ) const;
+            
+            /*!
+             * @function    GetMovieTime
+             * @abstract    Converts a media time to a movie time.
+             * @param       mediaTime   The media time.
+             * @param       movieTime   On output, the movie time.
+             * @result      false if the media time is not presented, otherwise true.
+             * @discussion  When the media time is presented by several
+             *              segments, the earliest movie time is returned.
+             */
+            bool GetMovieTime( int64_t mediaTime, uint64_t & movieTime ) const;
+            
+            /*!
+             * @function    GetSampleAtMovieTime
+             * @abstract    Gets the sample presented at a movie time.
+             * @param       table       The track's sample table.
+             * @param       movieTime   The movie time.
+             * @param       sample      On output, the index of the sample with the latest composition time not after the mapped media time.
+             * @result      false if nothing is presented at the movie time, otherwise true.
+             * @discussion  Only the samples of the group of pictures
+             *              containing the target are visited.
+             */
+            bool GetSampleAtMovieTime( const SampleTable & table, uint64_t movieTime, uint64_t & sample ) const;
+            
+            /*!
+             * @function    GetSyncSampleAtMovieTime
+             * @abstract    Gets the sync sample to start decoding from to present a movie time.
+             * @param       table       The track's sample table.
+             * @param       movieTime   The movie time.
+             * @param       sample      On output, the index of the sync sample.
+             * @result      false if nothing is presented at the movie time, otherwise true.
+             * @see         SampleTable::GetSyncSampleAtOrBeforeTime
+             */
+            bool GetSyncSampleAtMovieTime( const SampleTable & table, uint64_t movieTime, uint64_t & sample ) const;
+            
+            ISOBMFF_EXPORT friend void swap( Timeline & o1, Timeline & o2 );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_TIMELINE_HPP */
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @header      TrackReader.hpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#ifndef ISOBMFF_TRACK_READER_HPP
+#define ISOBMFF_TRACK_READER_HPP
+
+#include <memory>
+#include <algorithm>
+#include <ISOBMFF/Macros.hpp>
+#include <ISOBMFF/Container.hpp>
+#include <ISOBMFF/BinaryStream.hpp>
+#include <ISOBMFF/BufferPool.hpp>
+#include <ISOBMFF/SampleTable.hpp>
+#include <ISOBMFF/EncryptionIndex.hpp>
+#include <ISOBMFF/SampleDecryptor.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ISOBMFF
+{
+    /*!
+     * @class       TrackReader
+     * @abstract    Reads the samples of a track, in decode order.
+     * @discussion  Samples are read in batches: the remaining samples of
+     *              the current chunk, plus the samples of the next
+     *              prefetched chunks, are loaded together, with one read
+     *              per contiguous byte range.
+     *              Batch buffers come from a buffer pool, and return to it
+     *              once the last sample referencing them is released.
+     *              When the stream exposes its bytes (eg.
+     *              `BinaryMappedFileStream`), payloads are borrowed from
+     *              the stream and nothing is read.
+     *              The stream is not owned by the reader, and must stay
+     *              valid for the lifetime of the reader and of the
+     *              samples it returns.
+     */
+    class ISOBMFF_EXPORT TrackReader
+    {
+        public:
+            
+            /*!
+             * @class       Sample
+             * @abstract    A sample returned by a track reader.
+             * @discussion  The payload is a view on a batch buffer or on
+             *              the stream's bytes, kept alive by the sample.
+             *              Reusing the same object for successive reads
+             *              avoids allocations.
+             */
+            class ISOBMFF_EXPORT Sample
+            {
+                public:
+                    
+                    Sample();
+                    Sample( const Sample & o );
+                    Sample( Sample && o ) noexcept;
+                    virtual ~Sample();
+                    
+                    Sample & operator =( Sample o );
+                    
+                    uint64_t        GetIndex()                  const;
+                    uint64_t        GetOffset()                 const;
+                    uint64_t        GetDecodeTime()             const;
+                    int64_t         GetCompositionTime()        const;
+                    uint32_t        GetDuration()               const;
+                    bool            IsSync()                    const;
+                    uint32_t        GetSampleDescriptionIndex() const;
+                    const uint8_t * GetData()                   const;
+                    size_t          GetSize()                   const;
+                    
+                    ISOBMFF_EXPORT friend void swap( Sample & o1, Sample & o2 );
+                
+                private:
+                    
+                    friend class TrackReader;
+                    
+                    void Set( const SampleTable::Iterator & it, const uint8_t * data, std::shared_ptr< const std::vector< uint8_t > > buffer );
+                    
+                    class IMPL;
+                    
+                    std::unique_ptr< IMPL > impl;
+            };
+            
+            /*!
+             * @function    TrackReader
+             * @abstract    Creates a track reader.
+             * @param       trak    The TRAK box of the track.
+             * @param       stream  The stream of the file containing the track.
+             * @param       pool    The pool providing batch buffers, or nullptr to allocate buffers as needed.
+             * @discussion  Throws if the track has no valid sample table.
+             */
+            TrackReader( const Container & trak, BinaryStream & stream, std::shared_ptr< BufferPool > pool = nullptr );
+            
+            virtual ~TrackReader();
+            
+            TrackReader( const TrackReader & o )              = delete;
+            TrackReader( TrackReader && o )                   = delete;
+            TrackReader & operator =( const TrackReader & o ) = delete;
+            TrackReader & operator =( TrackReader && o )      = delete;
+            
+            const SampleTable & GetSampleTable() const;
+            
+            /*!
+             * @function    GetPrefetchChunks
+             * @abstract    Gets the number of chunks read ahead of the current one.
+             * @result      The number of prefetched chunks.
+             */
+            size_t GetPrefetchChunks() const;
+            
+            /*!
+             * @function    SetPrefetchChunks
+             * @abstract    Sets the number of chunks read ahead of the current one.
+             * @param       value   The number of chunks to prefetch. Defaults to 0.
+             * @discussion  Prefetched chunks are read with the current
+             *              chunk, merging reads when the chunks are
+             *              contiguous in the file.
+             */
+            void SetPrefetchChunks( size_t value );
+            
+            /*!
+             * @function    SetDecryptor
+             * @abstract    Decrypts samples as they are read.
+             * @param       decryptor   The decryptor, or nullptr to return samples as stored.
+             * @param       index       The encryption index of the track's sample table.
+             * @discussion  Samples are decrypted in place, in the batch
+             *              buffer, once per batch. While a decryptor is
+             *              set, payloads are never borrowed from the
+             *              stream's bytes, as those are read-only.
+             *              Throws if a decryptor is given without an index.
+             */
+            void SetDecryptor( std::shared_ptr< SampleDecryptor > decryptor, std::shared_ptr< EncryptionIndex > index );
+            
+            /*!
+             * @function    GetReadCount
+             * @abstract    Gets the number of reads issued to the stream.
+             * @result      The number of reads since the reader was created.
+             */
+            uint64_t GetReadCount() const;
+            
+            /*!
+             * @function    HasSample
+             * @abstract    Checks if samples remain to be read.
+             * @result      true if `ReadSample` will return a sample, otherwise false.
+             */
+            bool HasSample() const;
+            
+            /*!
+             * @function    Seek
+             * @abstract    Moves the reader to a sample.
+             * @param       sample  The zero-based index of the next sample to read.
+             */
+            void Seek( uint64_t sample );
+            
+            /*!
+             * @function    ReadSample
+             * @abstract    Reads the next sample.
+             * @param       sample  On output, the sample read.
+             * @result      true if a sample was read, false at the end of the track.
+             * @discussion  Throws if the sample's data cannot be read.
+             */
+            bool ReadSample( Sample & sample );
+        
+        private:
+            
+            class IMPL;
+            
+            std::unique_ptr< IMPL > impl;
+    };
+}
+
+#endif /* ISOBMFF_TRACK_READER_HPP */
@@ -101,6 +101,16 @@ namespace ISOBMFF
          */
         ISOBMFF_EXPORT std::string ToHexString( uint64_t u );
         
+        /*!
+         * @function    ToHexString
+         * @abstract    Returns an hexadecimal string representation of a byte array.
+         * @param       v   The bytes.
+         * @result      The hexacdecimal string representation of the bytes.
+         * @discussion  Result string will be prefixed by `0x`, with two
+         *              digits per byte, or empty if the array is empty.
+         */
+        ISOBMFF_EXPORT std::string ToHexString( const std::vector< uint8_t > & v );
+        
         /*!
          * @function        ToString
          * @abstract        Returns a string representation of a vector of values.
@@ -141,6 +141,53 @@ namespace ISOBMFF
         }
     }
 
+    uint64_t AVCC::GetDataSize() const
+    {
+        uint64_t size;
+        
+        size = 7;
+        
+        for( const auto & nal: this->impl->_sequence_parameter_set_nal_units )
+        {
+            size += 2 + nal->GetData().size();
+        }
+        
+        for( const auto & nal: this->impl->_picture_parameter_set_nal_units )
+        {
+            size += 2 + nal->GetData().size();
+        }
+        
+        return size;
+    }
+    
+    void AVCC::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteUInt8( this->GetConfigurationVersion() );
+        stream.WriteUInt8( this->GetAVCProfileIndication() );
+        stream.WriteUInt8( this->GetProfileCompatibility() );
+        stream.WriteUInt8( this->GetAVCLevelIndication() );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xFC | ( this->GetLengthSizeMinusOne() & 0x3 ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xE0 | ( this->impl->_sequence_parameter_set_nal_units.size() & 0x1F ) ) );
+        
+        for( const auto & nal: this->impl->_sequence_parameter_set_nal_units )
+        {
+            std::vector< uint8_t > data( nal->GetData() );
+            
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( data.size() ) );
+            stream.Write( data );
+        }
+        
+        stream.WriteUInt8( static_cast< uint8_t >( this->impl->_picture_parameter_set_nal_units.size() ) );
+        
+        for( const auto & nal: this->impl->_picture_parameter_set_nal_units )
+        {
+            std::vector< uint8_t > data( nal->GetData() );
+            
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( data.size() ) );
+            stream.Write( data );
+        }
+    }
+    
     void AVCC::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         Box::WriteDescription( os, indentLevel );
@@ -213,36 +260,43 @@ namespace ISOBMFF
     void AVCC::SetConfigurationVersion( uint8_t value )
     {
         this->impl->_configurationVersion = value;
+        this->SetModified( true );
     }
 
     void AVCC::SetAVCProfileIndication( uint8_t value )
     {
         this->impl->_AVCProfileIndication = value;
+        this->SetModified( true );
     }
 
     void AVCC::SetProfileCompatibility( uint8_t value )
     {
         this->impl->_profileCompatibility = value;
+        this->SetModified( true );
     }
 
     void AVCC::SetAVCLevelIndication( uint8_t value )
     {
         this->impl->_AVCLevelIndication = value;
+        this->SetModified( true );
     }
 
     void AVCC::SetLengthSizeMinusOne( uint8_t value )
     {
         this->impl->_lengthSizeMinusOne = value;
+        this->SetModified( true );
     }
 
     void AVCC::SetNumOfSequenceParameterSets( uint8_t value )
     {
         this->impl->_numOfSequenceParameterSets = value;
+        this->SetModified( true );
     }
 
     void AVCC::SetNumOfPictureParameterSets( uint8_t value )
     {
         this->impl->_numOfPictureParameterSets = value;
+        this->SetModified( true );
     }
 
 
@@ -260,11 +314,13 @@ namespace ISOBMFF
     void AVCC::AddSequenceParameterSetNALUnit( std::shared_ptr< NALUnit > nal_unit )
     {
         this->impl->_sequence_parameter_set_nal_units.push_back( nal_unit );
+        this->SetModified( true );
     }
 
     void AVCC::AddPictureParameterSetNALUnit( std::shared_ptr< NALUnit > nal_unit )
     {
         this->impl->_picture_parameter_set_nal_units.push_back( nal_unit );
+        this->SetModified( true );
     }
 
     AVCC::IMPL::IMPL():
@@ -0,0 +1,571 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        AVCSPS.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/AVCSPS.hpp>
+#include <ISOBMFF/BitReader.hpp>
+#include <ISOBMFF/NAL.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace ISOBMFF
+{
+    class AVCSPS::IMPL
+    {
+        public:
+            
+            IMPL( const uint8_t * data, size_t size );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void ReadScalingMatrix( BitReader & reader );
+            void ReadVUI( BitReader & reader );
+            
+            static bool                   HasChromaInfo( uint8_t profileIDC );
+            static std::vector< uint8_t > GetNALUnit( const AVCC & avcC );
+            
+            uint8_t  _profileIDC;
+            uint8_t  _constraintFlags;
+            uint8_t  _levelIDC;
+            uint32_t _spsID;
+            uint32_t _chromaFormatIDC;
+            bool     _separateColourPlaneFlag;
+            uint8_t  _bitDepthLuma;
+            uint8_t  _bitDepthChroma;
+            uint32_t _log2MaxFrameNum;
+            uint32_t _picOrderCountType;
+            uint32_t _maxNumRefFrames;
+            uint32_t _picWidthInMBs;
+            uint32_t _picHeightInMapUnits;
+            bool     _frameMBsOnlyFlag;
+            uint32_t _frameCropLeftOffset;
+            uint32_t _frameCropRightOffset;
+            uint32_t _frameCropTopOffset;
+            uint32_t _frameCropBottomOffset;
+            bool     _hasVUI;
+            uint16_t _sarWidth;
+            uint16_t _sarHeight;
+            bool     _hasColourDescription;
+            bool     _videoFullRangeFlag;
+            uint8_t  _colourPrimaries;
+            uint8_t  _transferCharacteristics;
+            uint8_t  _matrixCoefficients;
+            bool     _hasTimingInfo;
+            uint32_t _numUnitsInTick;
+            uint32_t _timeScale;
+    };
+    
+    AVCSPS::AVCSPS( const uint8_t * data, size_t size ):
+        impl( std::make_unique< IMPL >( data, size ) )
+    {}
+    
+    AVCSPS::AVCSPS( const AVCC & avcC ):
+        impl( nullptr )
+    {
+        std::vector< uint8_t > data( IMPL::GetNALUnit( avcC ) );
+        
+        this->impl = std::make_unique< IMPL >( data.data(), data.size() );
+    }
+    
+    AVCSPS::AVCSPS( const AVCSPS & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    AVCSPS::AVCSPS( AVCSPS && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    AVCSPS::~AVCSPS()
+    {}
+    
+    AVCSPS & AVCSPS::operator =( AVCSPS o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( AVCSPS & o1, AVCSPS & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint8_t AVCSPS::GetProfileIDC() const
+    {
+        return this->impl->_profileIDC;
+    }
+    
+    uint8_t AVCSPS::GetConstraintFlags() const
+    {
+        return this->impl->_constraintFlags;
+    }
+    
+    uint8_t AVCSPS::GetLevelIDC() const
+    {
+        return this->impl->_levelIDC;
+    }
+    
+    uint32_t AVCSPS::GetSPSID() const
+    {
+        return this->impl->_spsID;
+    }
+    
+    uint32_t AVCSPS::GetChromaFormatIDC() const
+    {
+        return this->impl->_chromaFormatIDC;
+    }
+    
+    bool AVCSPS::GetSeparateColourPlaneFlag() const
+    {
+        return this->impl->_separateColourPlaneFlag;
+    }
+    
+    uint8_t AVCSPS::GetBitDepthLuma() const
+    {
+        return this->impl->_bitDepthLuma;
+    }
+    
+    uint8_t AVCSPS::GetBitDepthChroma() const
+    {
+        return this->impl->_bitDepthChroma;
+    }
+    
+    uint32_t AVCSPS::GetLog2MaxFrameNum() const
+    {
+        return this->impl->_log2MaxFrameNum;
+    }
+    
+    uint32_t AVCSPS::GetPicOrderCountType() const
+    {
+        return this->impl->_picOrderCountType;
+    }
+    
+    uint32_t AVCSPS::GetMaxNumRefFrames() const
+    {
+        return this->impl->_maxNumRefFrames;
+    }
+    
+    uint32_t AVCSPS::GetPicWidthInMBs() const
+    {
+        return this->impl->_picWidthInMBs;
+    }
+    
+    uint32_t AVCSPS::GetPicHeightInMapUnits() const
+    {
+        return this->impl->_picHeightInMapUnits;
+    }
+    
+    bool AVCSPS::GetFrameMBsOnlyFlag() const
+    {
+        return this->impl->_frameMBsOnlyFlag;
+    }
+    
+    uint32_t AVCSPS::GetFrameCropLeftOffset() const
+    {
+        return this->impl->_frameCropLeftOffset;
+    }
+    
+    uint32_t AVCSPS::GetFrameCropRightOffset() const
+    {
+        return this->impl->_frameCropRightOffset;
+    }
+    
+    uint32_t AVCSPS::GetFrameCropTopOffset() const
+    {
+        return this->impl->_frameCropTopOffset;
+    }
+    
+    uint32_t AVCSPS::GetFrameCropBottomOffset() const
+    {
+        return this->impl->_frameCropBottomOffset;
+    }
+    
+    bool AVCSPS::HasVUI() const
+    {
+        return this->impl->_hasVUI;
+    }
+    
+    uint16_t AVCSPS::GetSARWidth() const
+    {
+        return this->impl->_sarWidth;
+    }
+    
+    uint16_t AVCSPS::GetSARHeight() const
+    {
+        return this->impl->_sarHeight;
+    }
+    
+    bool AVCSPS::HasColourDescription() const
+    {
+        return this->impl->_hasColourDescription;
+    }
+    
+    bool AVCSPS::GetVideoFullRangeFlag() const
+    {
+        return this->impl->_videoFullRangeFlag;
+    }
+    
+    uint8_t AVCSPS::GetColourPrimaries() const
+    {
+        return this->impl->_colourPrimaries;
+    }
+    
+    uint8_t AVCSPS::GetTransferCharacteristics() const
+    {
+        return this->impl->_transferCharacteristics;
+    }
+    
+    uint8_t AVCSPS::GetMatrixCoefficients() const
+    {
+        return this->impl->_matrixCoefficients;
+    }
+    
+    bool AVCSPS::HasTimingInfo() const
+    {
+        return this->impl->_hasTimingInfo;
+    }
+    
+    uint32_t AVCSPS::GetNumUnitsInTick() const
+    {
+        return this->impl->_numUnitsInTick;
+    }
+    
+    uint32_t AVCSPS::GetTimeScale() const
+    {
+        return this->impl->_timeScale;
+    }
+    
+    uint32_t AVCSPS::GetWidth() const
+    {
+        uint32_t cropUnitX;
+        uint64_t width;
+        uint64_t crop;
+        
+        cropUnitX = ( this->impl->_chromaFormatIDC == 1 || this->impl->_chromaFormatIDC == 2 ) && this->impl->_separateColourPlaneFlag == false ? 2 : 1;
+        width     = static_cast< uint64_t >( this->impl->_picWidthInMBs ) * 16;
+        crop      = static_cast< uint64_t >( cropUnitX ) * ( static_cast< uint64_t >( this->impl->_frameCropLeftOffset ) + this->impl->_frameCropRightOffset );
+        
+        return ( crop >= width ) ? 0 : static_cast< uint32_t >( width - crop );
+    }
+    
+    uint32_t AVCSPS::GetHeight() const
+    {
+        uint32_t cropUnitY;
+        uint64_t height;
+        uint64_t crop;
+        
+        cropUnitY = ( this->impl->_chromaFormatIDC == 1 && this->impl->_separateColourPlaneFlag == false ) ? 2 : 1;
+        cropUnitY = ( this->impl->_frameMBsOnlyFlag ) ? cropUnitY : cropUnitY * 2;
+        height    = static_cast< uint64_t >( this->impl->_picHeightInMapUnits ) * 16 * ( ( this->impl->_frameMBsOnlyFlag ) ? 1 : 2 );
+        crop      = static_cast< uint64_t >( cropUnitY ) * ( static_cast< uint64_t >( this->impl->_frameCropTopOffset ) + this->impl->_frameCropBottomOffset );
+        
+        return ( crop >= height ) ? 0 : static_cast< uint32_t >( height - crop );
+    }
+    
+    double AVCSPS::GetFrameRate() const
+    {
+        if( this->impl->_hasTimingInfo == false || this->impl->_numUnitsInTick == 0 )
+        {
+            return 0;
+        }
+        
+        return static_cast< double >( this->impl->_timeScale ) / ( 2.0 * static_cast< double >( this->impl->_numUnitsInTick ) );
+    }
+    
+    AVCSPS::IMPL::IMPL( const uint8_t * data, size_t size ):
+        _profileIDC( 0 ),
+        _constraintFlags( 0 ),
+        _levelIDC( 0 ),
+        _spsID( 0 ),
+        _chromaFormatIDC( 1 ),
+        _separateColourPlaneFlag( false ),
+        _bitDepthLuma( 8 ),
+        _bitDepthChroma( 8 ),
+        _log2MaxFrameNum( 0 ),
+        _picOrderCountType( 0 ),
+        _maxNumRefFrames( 0 ),
+        _picWidthInMBs( 0 ),
+        _picHeightInMapUnits( 0 ),
+        _frameMBsOnlyFlag( true ),
+        _frameCropLeftOffset( 0 ),
+        _frameCropRightOffset( 0 ),
+        _frameCropTopOffset( 0 ),
+        _frameCropBottomOffset( 0 ),
+        _hasVUI( false ),
+        _sarWidth( 0 ),
+        _sarHeight( 0 ),
+        _hasColourDescription( false ),
+        _videoFullRangeFlag( false ),
+        _colourPrimaries( 2 ),
+        _transferCharacteristics( 2 ),
+        _matrixCoefficients( 2 ),
+        _hasTimingInfo( false ),
+        _numUnitsInTick( 0 ),
+        _timeScale( 0 )
+    {
+        std::vector< uint8_t > rbsp;
+        uint32_t               cycle;
+        
+        if( size < 1 || ( data[ 0 ] & 0x1F ) != 7 )
+        {
+            throw std::runtime_error( "Data is not an AVC SPS NAL unit" );
+        }
+        
+        rbsp.resize( size - 1 );
+        rbsp.resize( NAL::RemoveEmulationPrevention( data + 1, size - 1, rbsp.data() ) );
+        
+        BitReader reader( rbsp.data(), rbsp.size() );
+        
+        this->_profileIDC      = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+        this->_constraintFlags = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+        this->_levelIDC        = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+        this->_spsID           = reader.ReadUE();
+        
+        if( HasChromaInfo( this->_profileIDC ) )
+        {
+            this->_chromaFormatIDC = reader.ReadUE();
+            
+            if( this->_chromaFormatIDC == 3 )
+            {
+                this->_separateColourPlaneFlag = reader.ReadFlag();
+            }
+            
+            this->_bitDepthLuma   = static_cast< uint8_t >( reader.ReadUE() + 8 );
+            this->_bitDepthChroma = static_cast< uint8_t >( reader.ReadUE() + 8 );
+            
+            reader.SkipBits( 1 );
+            
+            if( reader.ReadFlag() )
+            {
+                this->ReadScalingMatrix( reader );
+            }
+        }
+        
+        this->_log2MaxFrameNum   = reader.ReadUE() + 4;
+        this->_picOrderCountType = reader.ReadUE();
+        
+        if( this->_picOrderCountType == 0 )
+        {
+            reader.ReadUE();
+        }
+        else if( this->_picOrderCountType == 1 )
+        {
+            reader.SkipBits( 1 );
+            reader.ReadSE();
+            reader.ReadSE();
+            
+            cycle = reader.ReadUE();
+            
+            if( cycle > 255 )
+            {
+                throw std::runtime_error( "Invalid AVC SPS" );
+            }
+            
+            for( uint32_t i = 0; i < cycle; i++ )
+            {
+                reader.ReadSE();
+            }
+        }
+        
+        this->_maxNumRefFrames = reader.ReadUE();
+        
+        reader.SkipBits( 1 );
+        
+        this->_picWidthInMBs       = reader.ReadUE() + 1;
+        this->_picHeightInMapUnits = reader.ReadUE() + 1;
+        this->_frameMBsOnlyFlag    = reader.ReadFlag();
+        
+        if( this->_frameMBsOnlyFlag == false )
+        {
+            reader.SkipBits( 1 );
+        }
+        
+        reader.SkipBits( 1 );
+        
+        if( reader.ReadFlag() )
+        {
+            this->_frameCropLeftOffset   = reader.ReadUE();
+            this->_frameCropRightOffset  = reader.ReadUE();
+            this->_frameCropTopOffset    = reader.ReadUE();
+            this->_frameCropBottomOffset = reader.ReadUE();
+        }
+        
+        this->_hasVUI = reader.ReadFlag();
+        
+        if( this->_hasVUI )
+        {
+            this->ReadVUI( reader );
+        }
+    }
+    
+    AVCSPS::IMPL::IMPL( const IMPL & o ):
+        _profileIDC( o._profileIDC ),
+        _constraintFlags( o._constraintFlags ),
+        _levelIDC( o._levelIDC ),
+        _spsID( o._spsID ),
+        _chromaFormatIDC( o._chromaFormatIDC ),
+        _separateColourPlaneFlag( o._separateColourPlaneFlag ),
+        _bitDepthLuma( o._bitDepthLuma ),
+        _bitDepthChroma( o._bitDepthChroma ),
+        _log2MaxFrameNum( o._log2MaxFrameNum ),
+        _picOrderCountType( o._picOrderCountType ),
+        _maxNumRefFrames( o._maxNumRefFrames ),
+        _picWidthInMBs( o._picWidthInMBs ),
+        _picHeightInMapUnits( o._picHeightInMapUnits ),
+        _frameMBsOnlyFlag( o._frameMBsOnlyFlag ),
+        _frameCropLeftOffset( o._frameCropLeftOffset ),
+        _frameCropRightOffset( o._frameCropRightOffset ),
+        _frameCropTopOffset( o._frameCropTopOffset ),
+        _frameCropBottomOffset( o._frameCropBottomOffset ),
+        _hasVUI( o._hasVUI ),
+        _sarWidth( o._sarWidth ),
+        _sarHeight( o._sarHeight ),
+        _hasColourDescription( o._hasColourDescription ),
+        _videoFullRangeFlag( o._videoFullRangeFlag ),
+        _colourPrimaries( o._colourPrimaries ),
+        _transferCharacteristics( o._transferCharacteristics ),
+        _matrixCoefficients( o._matrixCoefficients ),
+        _hasTimingInfo( o._hasTimingInfo ),
+        _numUnitsInTick( o._numUnitsInTick ),
+        _timeScale( o._timeScale )
+    {}
+    
+    AVCSPS::IMPL::~IMPL()
+    {}
+    
+    void AVCSPS::IMPL::ReadScalingMatrix( BitReader & reader )
+    {
+        unsigned int lists;
+        unsigned int coefficients;
+        int32_t      last;
+        int32_t      next;
+        
+        lists = ( this->_chromaFormatIDC == 3 ) ? 12 : 8;
+        
+        for( unsigned int i = 0; i < lists; i++ )
+        {
+            if( reader.ReadFlag() == false )
+            {
+                continue;
+            }
+            
+            coefficients = ( i < 6 ) ? 16 : 64;
+            last         = 8;
+            next         = 8;
+            
+            /*
+             * A next scale of zero means the rest of the list repeats the
+             * last value, so no more deltas are coded.
+             */
+            for( unsigned int j = 0; j < coefficients && next != 0; j++ )
+            {
+                next = ( last + reader.ReadSE() + 256 ) % 256;
+                last = ( next == 0 ) ? last : next;
+            }
+        }
+    }
+    
+    void AVCSPS::IMPL::ReadVUI( BitReader & reader )
+    {
+        if( reader.ReadFlag() )
+        {
+            if( reader.ReadBits( 8 ) == 255 )
+            {
+                this->_sarWidth  = static_cast< uint16_t >( reader.ReadBits( 16 ) );
+                this->_sarHeight = static_cast< uint16_t >( reader.ReadBits( 16 ) );
+            }
+        }
+        
+        if( reader.ReadFlag() )
+        {
+            reader.SkipBits( 1 );
+        }
+        
+        if( reader.ReadFlag() )
+        {
+            reader.SkipBits( 3 );
+            
+            this->_videoFullRangeFlag   = reader.ReadFlag();
+            this->_hasColourDescription = reader.ReadFlag();
+            
+            if( this->_hasColourDescription )
+            {
+                this->_colourPrimaries         = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+                this->_transferCharacteristics = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+                this->_matrixCoefficients      = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+            }
+        }
+        
+        if( reader.ReadFlag() )
+        {
+            reader.ReadUE();
+            reader.ReadUE();
+        }
+        
+        this->_hasTimingInfo = reader.ReadFlag();
+        
+        if( this->_hasTimingInfo )
+        {
+            this->_numUnitsInTick = reader.ReadBits( 32 );
+            this->_timeScale      = reader.ReadBits( 32 );
+        }
+    }
+    
+    bool AVCSPS::IMPL::HasChromaInfo( uint8_t profileIDC )
+    {
+        switch( profileIDC )
+        {
+            case 100: case 110: case 122: case 244: case 44:
+            case 83:  case 86:  case 118: case 128: case 138:
+            case 139: case 134: case 135:
+                
+                return true;
+            
+            default:
+                
+                return false;
+        }
+    }
+    
+    std::vector< uint8_t > AVCSPS::IMPL::GetNALUnit( const AVCC & avcC )
+    {
+        std::vector< std::shared_ptr< AVCC::NALUnit > > units( avcC.GetSequenceParameterSetNALUnits() );
+        
+        if( units.size() == 0 )
+        {
+            throw std::runtime_error( "No SPS in AVC decoder configuration" );
+        }
+        
+        return units[ 0 ]->GetData();
+    }
+}
@@ -0,0 +1,254 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        AnnexBAssembler.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/AnnexBAssembler.hpp>
+#include <stdexcept>
+#include <cstring>
+
+namespace ISOBMFF
+{
+    class AnnexBAssembler::IMPL
+    {
+        public:
+            
+            IMPL( uint8_t lengthSize );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void   AddParameterSet( const std::vector< uint8_t > & data );
+            size_t ReadLength( const uint8_t * data ) const;
+            
+            uint8_t                _lengthSize;
+            std::vector< uint8_t > _parameterSets;
+    };
+    
+    static const uint8_t StartCode[] = { 0x00, 0x00, 0x00, 0x01 };
+    
+    AnnexBAssembler::AnnexBAssembler( const HVCC & hvcC ):
+        impl( std::make_unique< IMPL >( static_cast< uint8_t >( hvcC.GetLengthSizeMinusOne() + 1 ) ) )
+    {
+        for( const auto & array: hvcC.GetArrays() )
+        {
+            for( const auto & unit: array->GetNALUnits() )
+            {
+                this->impl->AddParameterSet( unit->GetData() );
+            }
+        }
+    }
+    
+    AnnexBAssembler::AnnexBAssembler( const AVCC & avcC ):
+        impl( std::make_unique< IMPL >( static_cast< uint8_t >( avcC.GetLengthSizeMinusOne() + 1 ) ) )
+    {
+        for( const auto & unit: avcC.GetSequenceParameterSetNALUnits() )
+        {
+            this->impl->AddParameterSet( unit->GetData() );
+        }
+        
+        for( const auto & unit: avcC.GetPictureParameterSetNALUnits() )
+        {
+            this->impl->AddParameterSet( unit->GetData() );
+        }
+    }
+    
+    AnnexBAssembler::AnnexBAssembler( const AnnexBAssembler & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    AnnexBAssembler::AnnexBAssembler( AnnexBAssembler && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    AnnexBAssembler::~AnnexBAssembler()
+    {}
+    
+    AnnexBAssembler & AnnexBAssembler::operator =( AnnexBAssembler o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( AnnexBAssembler & o1, AnnexBAssembler & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint8_t AnnexBAssembler::GetLengthSize() const
+    {
+        return this->impl->_lengthSize;
+    }
+    
+    std::vector< uint8_t > AnnexBAssembler::GetParameterSets() const
+    {
+        return this->impl->_parameterSets;
+    }
+    
+    size_t AnnexBAssembler::GetSize( const uint8_t * data, size_t size, bool parameterSets ) const
+    {
+        size_t total;
+        size_t pos;
+        size_t length;
+        
+        total = ( parameterSets ) ? this->impl->_parameterSets.size() : 0;
+        pos   = 0;
+        
+        while( pos < size )
+        {
+            if( size - pos < this->impl->_lengthSize )
+            {
+                throw std::runtime_error( "Invalid NAL unit length" );
+            }
+            
+            length = this->impl->ReadLength( data + pos );
+            pos   += this->impl->_lengthSize;
+            
+            if( length > size - pos )
+            {
+                throw std::runtime_error( "Invalid NAL unit length" );
+            }
+            
+            if( length > 0 )
+            {
+                total += sizeof( StartCode ) + length;
+            }
+            
+            pos += length;
+        }
+        
+        return total;
+    }
+    
+    size_t AnnexBAssembler::Write( const uint8_t * data, size_t size, uint8_t * buffer, size_t bufferSize, bool parameterSets ) const
+    {
+        size_t total;
+        size_t pos;
+        size_t length;
+        
+        if( this->GetSize( data, size, parameterSets ) > bufferSize )
+        {
+            throw std::runtime_error( "Buffer is too small for Annex-B data" );
+        }
+        
+        total = 0;
+        pos   = 0;
+        
+        if( parameterSets && this->impl->_parameterSets.size() > 0 )
+        {
+            memcpy( buffer, &( this->impl->_parameterSets[ 0 ] ), this->impl->_parameterSets.size() );
+            
+            total = this->impl->_parameterSets.size();
+        }
+        
+        /*
+         * Lengths were validated by GetSize, so each length field can be
+         * replaced by a start code directly.
+         */
+        while( pos < size )
+        {
+            length = this->impl->ReadLength( data + pos );
+            pos   += this->impl->_lengthSize;
+            
+            if( length > 0 )
+            {
+                memcpy( buffer + total, StartCode, sizeof( StartCode ) );
+                memcpy( buffer + total + sizeof( StartCode ), data + pos, length );
+                
+                total += sizeof( StartCode ) + length;
+            }
+            
+            pos += length;
+        }
+        
+        return total;
+    }
+    
+    std::vector< uint8_t > AnnexBAssembler::Assemble( const uint8_t * data, size_t size, bool parameterSets ) const
+    {
+        std::vector< uint8_t > out( this->GetSize( data, size, parameterSets ) );
+        
+        if( out.size() > 0 )
+        {
+            this->Write( data, size, &( out[ 0 ] ), out.size(), parameterSets );
+        }
+        
+        return out;
+    }
+    
+    std::vector< uint8_t > AnnexBAssembler::Assemble( const std::vector< uint8_t > & data, bool parameterSets ) const
+    {
+        return this->Assemble( data.data(), data.size(), parameterSets );
+    }
+    
+    AnnexBAssembler::IMPL::IMPL( uint8_t lengthSize ):
+        _lengthSize( lengthSize )
+    {
+        if( lengthSize != 1 && lengthSize != 2 && lengthSize != 4 )
+        {
+            throw std::runtime_error( "Unsupported NAL unit length size: " + std::to_string( lengthSize ) );
+        }
+    }
+    
+    AnnexBAssembler::IMPL::IMPL( const IMPL & o ):
+        _lengthSize( o._lengthSize ),
+        _parameterSets( o._parameterSets )
+    {}
+    
+    AnnexBAssembler::IMPL::~IMPL()
+    {}
+    
+    void AnnexBAssembler::IMPL::AddParameterSet( const std::vector< uint8_t > & data )
+    {
+        if( data.size() == 0 )
+        {
+            return;
+        }
+        
+        this->_parameterSets.insert( this->_parameterSets.end(), StartCode, StartCode + sizeof( StartCode ) );
+        this->_parameterSets.insert( this->_parameterSets.end(), data.begin(), data.end() );
+    }
+    
+    size_t AnnexBAssembler::IMPL::ReadLength( const uint8_t * data ) const
+    {
+        size_t length;
+        
+        length = 0;
+        
+        for( uint8_t i = 0; i < this->_lengthSize; i++ )
+        {
+            length = ( length << 8 ) | data[ i ];
+        }
+        
+        return length;
+    }
+}
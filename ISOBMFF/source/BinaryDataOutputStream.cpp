@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BinaryDataOutputStream.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+
+namespace ISOBMFF
+{
+    class BinaryDataOutputStream::IMPL
+    {
+        public:
+            
+            IMPL();
+            ~IMPL();
+            
+            std::vector< uint8_t > _data;
+    };
+    
+    BinaryDataOutputStream::BinaryDataOutputStream():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    BinaryDataOutputStream::~BinaryDataOutputStream()
+    {}
+    
+    void BinaryDataOutputStream::Write( const uint8_t * buf, size_t size )
+    {
+        this->impl->_data.insert( this->impl->_data.end(), buf, buf + size );
+    }
+    
+    size_t BinaryDataOutputStream::Tell() const
+    {
+        return this->impl->_data.size();
+    }
+    
+    const std::vector< uint8_t > & BinaryDataOutputStream::GetData() const
+    {
+        return this->impl->_data;
+    }
+    
+    BinaryDataOutputStream::IMPL::IMPL()
+    {}
+    
+    BinaryDataOutputStream::IMPL::~IMPL()
+    {}
+}
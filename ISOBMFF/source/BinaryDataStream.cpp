@@ -132,6 +132,16 @@ namespace ISOBMFF
         return this->impl->_pos;
     }
     
+    const uint8_t * BinaryDataStream::GetBytes() const
+    {
+        if( this->impl->_data.size() == 0 )
+        {
+            return nullptr;
+        }
+        
+        return &( this->impl->_data[ 0 ] );
+    }
+    
     void swap( BinaryDataStream & o1, BinaryDataStream & o2 )
     {
         using std::swap;
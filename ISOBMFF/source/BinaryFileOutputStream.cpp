@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BinaryFileOutputStream.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <fstream>
+#include <vector>
+#include <ISOBMFF/BinaryFileOutputStream.hpp>
+#include <ISOBMFF/Casts.hpp>
+
+#ifdef _WIN32
+#include <ISOBMFF/WIN32.hpp>
+#endif
+
+namespace ISOBMFF
+{
+    class BinaryFileOutputStream::IMPL
+    {
+        public:
+            
+            IMPL( const std::string & path );
+            ~IMPL();
+            
+            void FlushBuffer();
+            
+            std::ofstream          _stream;
+            std::string            _path;
+            std::vector< uint8_t > _buffer;
+            size_t                 _pos;
+    };
+    
+    BinaryFileOutputStream::BinaryFileOutputStream( const std::string & path ):
+        impl( std::make_unique< IMPL >( path ) )
+    {}
+    
+    BinaryFileOutputStream::~BinaryFileOutputStream()
+    {}
+    
+    void BinaryFileOutputStream::Write( const uint8_t * buf, size_t size )
+    {
+        if( this->impl->_stream.is_open() == false )
+        {
+            throw std::runtime_error( "Invalid file stream" );
+        }
+        
+        if( size > this->impl->_buffer.capacity() - this->impl->_buffer.size() )
+        {
+            this->impl->FlushBuffer();
+        }
+        
+        if( size >= this->impl->_buffer.capacity() )
+        {
+            this->impl->_stream.write( reinterpret_cast< const char * >( buf ), numeric_cast< std::streamsize >( size ) );
+        }
+        else
+        {
+            this->impl->_buffer.insert( this->impl->_buffer.end(), buf, buf + size );
+        }
+        
+        if( this->impl->_stream.good() == false )
+        {
+            throw std::runtime_error( "Invalid write - Cannot write to file" );
+        }
+        
+        this->impl->_pos += size;
+    }
+    
+    size_t BinaryFileOutputStream::Tell() const
+    {
+        if( this->impl->_stream.is_open() == false )
+        {
+            throw std::runtime_error( "Invalid file stream" );
+        }
+        
+        return this->impl->_pos;
+    }
+    
+    void BinaryFileOutputStream::Flush()
+    {
+        if( this->impl->_stream.is_open() == false )
+        {
+            throw std::runtime_error( "Invalid file stream" );
+        }
+        
+        this->impl->FlushBuffer();
+        this->impl->_stream.flush();
+        
+        if( this->impl->_stream.good() == false )
+        {
+            throw std::runtime_error( "Invalid write - Cannot write to file" );
+        }
+    }
+    
+    BinaryFileOutputStream::IMPL::IMPL( const std::string & path ):
+        _path( path ),
+        _pos( 0 )
+    {
+        #ifdef _WIN32
+        this->_stream.open( ISOBMFF::StringToWideString( path ), std::ios::binary | std::ios::trunc );
+        #else
+        this->_stream.open( path, std::ios::binary | std::ios::trunc );
+        #endif
+        
+        if( this->_stream.good() == false )
+        {
+            throw std::runtime_error( "Cannot open file for writing: " + path );
+        }
+        
+        this->_buffer.reserve( 256 * 1024 );
+    }
+    
+    BinaryFileOutputStream::IMPL::~IMPL()
+    {
+        if( this->_stream.is_open() )
+        {
+            this->FlushBuffer();
+            this->_stream.close();
+        }
+    }
+    
+    void BinaryFileOutputStream::IMPL::FlushBuffer()
+    {
+        if( this->_buffer.size() > 0 )
+        {
+            this->_stream.write( reinterpret_cast< const char * >( this->_buffer.data() ), numeric_cast< std::streamsize >( this->_buffer.size() ) );
+            this->_buffer.clear();
+        }
+    }
+}
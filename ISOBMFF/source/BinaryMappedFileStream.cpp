@@ -0,0 +1,267 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BinaryMappedFileStream.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <cstring>
+#include <cstdlib>
+#include <stdexcept>
+#include <ISOBMFF/BinaryMappedFileStream.hpp>
+#include <ISOBMFF/Casts.hpp>
+
+#ifdef _WIN32
+#include <ISOBMFF/WIN32.hpp>
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace ISOBMFF
+{
+    class BinaryMappedFileStream::IMPL
+    {
+        public:
+            
+            IMPL( const std::string & path );
+            ~IMPL();
+            
+            std::string     _path;
+            const uint8_t * _bytes;
+            size_t          _size;
+            size_t          _pos;
+
+            #ifdef _WIN32
+            HANDLE          _file;
+            HANDLE          _mapping;
+            #endif
+    };
+    
+    BinaryMappedFileStream::BinaryMappedFileStream( const std::string & path ):
+        impl( std::make_unique< IMPL >( path ) )
+    {}
+    
+    BinaryMappedFileStream::~BinaryMappedFileStream()
+    {}
+    
+    void BinaryMappedFileStream::Read( uint8_t * buf, size_t size )
+    {
+        if( size > this->impl->_size - this->impl->_pos )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        if( size > 0 )
+        {
+            memcpy( buf, this->impl->_bytes + this->impl->_pos, size );
+        }
+        
+        this->impl->_pos += size;
+    }
+    
+    void BinaryMappedFileStream::Seek( std::streamoff offset, SeekDirection dir )
+    {
+        size_t pos;
+        
+        if( dir == SeekDirection::Begin )
+        {
+            if( offset < 0 )
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            pos = numeric_cast< size_t >( offset );
+        }
+        else if( dir == SeekDirection::End )
+        {
+            if( offset > 0 )
+            {
+                throw std::runtime_error( "Invalid seek offset" );
+            }
+            
+            pos = this->impl->_size - numeric_cast< size_t >( abs( offset ) );
+        }
+        else if( offset < 0 )
+        {
+            pos = this->impl->_pos - numeric_cast< size_t >( abs( offset ) );
+        }
+        else
+        {
+            pos = this->impl->_pos + numeric_cast< size_t >( offset );
+        }
+        
+        if( pos > this->impl->_size )
+        {
+            throw std::runtime_error( "Invalid seek offset" );
+        }
+        
+        this->impl->_pos = pos;
+    }
+    
+    size_t BinaryMappedFileStream::Tell() const
+    {
+        return this->impl->_pos;
+    }
+    
+    const uint8_t * BinaryMappedFileStream::GetBytes() const
+    {
+        return this->impl->_bytes;
+    }
+
+    #ifdef _WIN32
+    
+    BinaryMappedFileStream::IMPL::IMPL( const std::string & path ):
+        _path( path ),
+        _bytes( nullptr ),
+        _size( 0 ),
+        _pos( 0 ),
+        _file( INVALID_HANDLE_VALUE ),
+        _mapping( nullptr )
+    {
+        LARGE_INTEGER size;
+        
+        this->_file = CreateFileW( ISOBMFF::StringToWideString( path ).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        
+        if( this->_file == INVALID_HANDLE_VALUE || GetFileSizeEx( this->_file, &size ) == FALSE )
+        {
+            if( this->_file != INVALID_HANDLE_VALUE )
+            {
+                CloseHandle( this->_file );
+            }
+            
+            throw std::runtime_error( "Cannot open file: " + path );
+        }
+        
+        this->_size = numeric_cast< size_t >( static_cast< uint64_t >( size.QuadPart ) );
+        
+        if( this->_size == 0 )
+        {
+            return;
+        }
+        
+        this->_mapping = CreateFileMappingW( this->_file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        
+        if( this->_mapping != nullptr )
+        {
+            this->_bytes = static_cast< const uint8_t * >( MapViewOfFile( this->_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+        }
+        
+        if( this->_bytes == nullptr )
+        {
+            if( this->_mapping != nullptr )
+            {
+                CloseHandle( this->_mapping );
+            }
+            
+            CloseHandle( this->_file );
+            
+            throw std::runtime_error( "Cannot map file: " + path );
+        }
+    }
+    
+    BinaryMappedFileStream::IMPL::~IMPL()
+    {
+        if( this->_bytes != nullptr )
+        {
+            UnmapViewOfFile( this->_bytes );
+        }
+        
+        if( this->_mapping != nullptr )
+        {
+            CloseHandle( this->_mapping );
+        }
+        
+        if( this->_file != INVALID_HANDLE_VALUE )
+        {
+            CloseHandle( this->_file );
+        }
+    }
+
+    #else
+    
+    BinaryMappedFileStream::IMPL::IMPL( const std::string & path ):
+        _path( path ),
+        _bytes( nullptr ),
+        _size( 0 ),
+        _pos( 0 )
+    {
+        int         fd;
+        struct stat st;
+        void      * p;
+        
+        fd = open( path.c_str(), O_RDONLY );
+        
+        if( fd == -1 )
+        {
+            throw std::runtime_error( "Cannot open file: " + path );
+        }
+        
+        if( fstat( fd, &st ) != 0 )
+        {
+            close( fd );
+            
+            throw std::runtime_error( "Cannot open file: " + path );
+        }
+        
+        this->_size = numeric_cast< size_t >( st.st_size );
+        
+        if( this->_size == 0 )
+        {
+            close( fd );
+            
+            return;
+        }
+        
+        p = mmap( nullptr, this->_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        
+        /*
+         * The mapping holds its own reference to the file, so the descriptor
+         * is not needed anymore.
+         */
+        close( fd );
+        
+        if( p == MAP_FAILED )
+        {
+            throw std::runtime_error( "Cannot map file: " + path );
+        }
+        
+        this->_bytes = static_cast< const uint8_t * >( p );
+    }
+    
+    BinaryMappedFileStream::IMPL::~IMPL()
+    {
+        if( this->_bytes != nullptr )
+        {
+            munmap( const_cast< uint8_t * >( this->_bytes ), this->_size );
+        }
+    }
+
+    #endif
+}
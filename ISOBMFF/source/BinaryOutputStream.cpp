@@ -0,0 +1,277 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BinaryOutputStream.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/BinaryOutputStream.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <cmath>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class BinaryOutputStream::IMPL
+    {
+        public:
+            
+            IMPL();
+            ~IMPL();
+            
+            BinaryStream * _source;
+    };
+    
+    BinaryOutputStream::BinaryOutputStream():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    BinaryOutputStream::~BinaryOutputStream()
+    {}
+    
+    void BinaryOutputStream::Flush()
+    {}
+    
+    BinaryStream * BinaryOutputStream::GetSource() const
+    {
+        return this->impl->_source;
+    }
+    
+    void BinaryOutputStream::SetSource( BinaryStream * source )
+    {
+        this->impl->_source = source;
+    }
+    
+    void BinaryOutputStream::Copy( BinaryStream & stream, uint64_t offset, uint64_t size )
+    {
+        const uint8_t        * bytes;
+        uint64_t               end;
+        size_t                 length;
+        std::vector< uint8_t > buf;
+        
+        bytes = stream.GetBytes();
+        
+        stream.Seek( 0, BinaryStream::SeekDirection::End );
+        
+        end = stream.Tell();
+        
+        if( offset > end || size > end - offset )
+        {
+            throw std::runtime_error( "Invalid copy - Not enough data available" );
+        }
+        
+        if( bytes != nullptr )
+        {
+            this->Write( bytes + offset, numeric_cast< size_t >( size ) );
+            
+            return;
+        }
+        
+        stream.Seek( offset, BinaryStream::SeekDirection::Begin );
+        
+        buf.resize( numeric_cast< size_t >( std::min< uint64_t >( size, 1024 * 1024 ) ) );
+        
+        while( size > 0 )
+        {
+            length = numeric_cast< size_t >( std::min< uint64_t >( size, buf.size() ) );
+            
+            stream.Read( buf.data(), length );
+            this->Write( buf.data(), length );
+            
+            size -= length;
+        }
+    }
+    
+    void BinaryOutputStream::Write( const std::vector< uint8_t > & data )
+    {
+        if( data.size() > 0 )
+        {
+            this->Write( data.data(), data.size() );
+        }
+    }
+    
+    void BinaryOutputStream::WriteUInt8( uint8_t value )
+    {
+        this->Write( &value, 1 );
+    }
+    
+    void BinaryOutputStream::WriteBigEndianUInt16( uint16_t value )
+    {
+        uint8_t n[ 2 ];
+        
+        n[ 0 ] = static_cast< uint8_t >( value >> 8 );
+        n[ 1 ] = static_cast< uint8_t >( value );
+        
+        this->Write( n, sizeof( n ) );
+    }
+    
+    void BinaryOutputStream::WriteBigEndianUInt32( uint32_t value )
+    {
+        uint8_t n[ 4 ];
+        
+        n[ 0 ] = static_cast< uint8_t >( value >> 24 );
+        n[ 1 ] = static_cast< uint8_t >( value >> 16 );
+        n[ 2 ] = static_cast< uint8_t >( value >>  8 );
+        n[ 3 ] = static_cast< uint8_t >( value );
+        
+        this->Write( n, sizeof( n ) );
+    }
+    
+    void BinaryOutputStream::WriteBigEndianUInt64( uint64_t value )
+    {
+        uint8_t n[ 8 ];
+        
+        for( size_t i = 0; i < 8; i++ )
+        {
+            n[ i ] = static_cast< uint8_t >( value >> ( 56 - i * 8 ) );
+        }
+        
+        this->Write( n, sizeof( n ) );
+    }
+    
+    void BinaryOutputStream::WriteBigEndianUInt32Array( const std::vector< uint32_t > & values )
+    {
+        uint8_t buf[ 4096 ];
+        size_t  n;
+        
+        n = 0;
+        
+        for( uint32_t value: values )
+        {
+            buf[ n++ ] = static_cast< uint8_t >( value >> 24 );
+            buf[ n++ ] = static_cast< uint8_t >( value >> 16 );
+            buf[ n++ ] = static_cast< uint8_t >( value >>  8 );
+            buf[ n++ ] = static_cast< uint8_t >( value );
+            
+            if( n == sizeof( buf ) )
+            {
+                this->Write( buf, n );
+                
+                n = 0;
+            }
+        }
+        
+        if( n > 0 )
+        {
+            this->Write( buf, n );
+        }
+    }
+    
+    void BinaryOutputStream::WriteBigEndianUInt64Array( const std::vector< uint64_t > & values )
+    {
+        uint8_t buf[ 4096 ];
+        size_t  n;
+        
+        n = 0;
+        
+        for( uint64_t value: values )
+        {
+            for( size_t i = 0; i < 8; i++ )
+            {
+                buf[ n++ ] = static_cast< uint8_t >( value >> ( 56 - i * 8 ) );
+            }
+            
+            if( n == sizeof( buf ) )
+            {
+                this->Write( buf, n );
+                
+                n = 0;
+            }
+        }
+        
+        if( n > 0 )
+        {
+            this->Write( buf, n );
+        }
+    }
+    
+    void BinaryOutputStream::WriteBigEndianFixedPoint( float value, unsigned int integerLength, unsigned int fractionalLength )
+    {
+        uint32_t n;
+        
+        n = static_cast< uint32_t >( std::llround( static_cast< double >( value ) * pow( 2, fractionalLength ) ) );
+        
+        if( integerLength + fractionalLength == 16 )
+        {
+            this->WriteBigEndianUInt16( static_cast< uint16_t >( n ) );
+        }
+        else
+        {
+            this->WriteBigEndianUInt32( n );
+        }
+    }
+    
+    void BinaryOutputStream::WriteFourCC( const std::string & value )
+    {
+        this->WriteString( value, 4 );
+    }
+    
+    void BinaryOutputStream::WritePascalString( const std::string & value )
+    {
+        if( value.size() > 255 )
+        {
+            throw std::runtime_error( "Invalid Pascal string - String is too long" );
+        }
+        
+        this->WriteUInt8( static_cast< uint8_t >( value.size() ) );
+        this->WriteString( value, value.size() );
+    }
+    
+    void BinaryOutputStream::WriteString( const std::string & value, size_t length )
+    {
+        std::vector< uint8_t > buf( length, 0 );
+        
+        std::copy_n( value.begin(), std::min( value.size(), length ), buf.begin() );
+        
+        this->Write( buf );
+    }
+    
+    void BinaryOutputStream::WriteNULLTerminatedString( const std::string & value )
+    {
+        this->WriteString( value, value.size() );
+        this->WriteUInt8( 0 );
+    }
+    
+    void BinaryOutputStream::WriteMatrix( const Matrix & value )
+    {
+        this->WriteBigEndianUInt32( value.GetA() );
+        this->WriteBigEndianUInt32( value.GetB() );
+        this->WriteBigEndianUInt32( value.GetU() );
+        this->WriteBigEndianUInt32( value.GetC() );
+        this->WriteBigEndianUInt32( value.GetD() );
+        this->WriteBigEndianUInt32( value.GetV() );
+        this->WriteBigEndianUInt32( value.GetX() );
+        this->WriteBigEndianUInt32( value.GetY() );
+        this->WriteBigEndianUInt32( value.GetW() );
+    }
+    
+    BinaryOutputStream::IMPL::IMPL():
+        _source( nullptr )
+    {}
+    
+    BinaryOutputStream::IMPL::~IMPL()
+    {}
+}
@@ -31,6 +31,7 @@
 
 #include <fstream>
 #include <cmath>
+#include <stdexcept>
 #include <ISOBMFF/BinaryStream.hpp>
 
 namespace ISOBMFF
@@ -54,6 +55,11 @@ namespace ISOBMFF
         return pos - cur;
     }
     
+    const uint8_t * BinaryStream::GetBytes() const
+    {
+        return nullptr;
+    }
+    
     void BinaryStream::Seek( std::streamoff offset )
     {
         this->Seek( offset, SeekDirection::Current );
@@ -330,6 +336,78 @@ namespace ISOBMFF
         return n;
     }
     
+    std::vector< uint32_t > BinaryStream::ReadBigEndianUInt32Array( size_t count )
+    {
+        std::vector< uint32_t > values;
+        uint8_t               * p;
+        
+        /*
+         * Counts come from the file, so they are checked against the
+         * available data before allocating anything.
+         */
+        if( count > this->AvailableBytes() / 4 )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        if( count == 0 )
+        {
+            return values;
+        }
+        
+        values.resize( count );
+        
+        p = reinterpret_cast< uint8_t * >( values.data() );
+        
+        this->Read( p, count * 4 );
+        
+        for( size_t i = 0; i < count; i++, p += 4 )
+        {
+            values[ i ] = ( static_cast< uint32_t >( p[ 0 ] ) << 24 )
+                        | ( static_cast< uint32_t >( p[ 1 ] ) << 16 )
+                        | ( static_cast< uint32_t >( p[ 2 ] ) << 8 )
+                        |   static_cast< uint32_t >( p[ 3 ] );
+        }
+        
+        return values;
+    }
+    
+    std::vector< uint64_t > BinaryStream::ReadBigEndianUInt64Array( size_t count )
+    {
+        std::vector< uint64_t > values;
+        uint8_t               * p;
+        
+        if( count > this->AvailableBytes() / 8 )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        if( count == 0 )
+        {
+            return values;
+        }
+        
+        values.resize( count );
+        
+        p = reinterpret_cast< uint8_t * >( values.data() );
+        
+        this->Read( p, count * 8 );
+        
+        for( size_t i = 0; i < count; i++, p += 8 )
+        {
+            values[ i ] = ( static_cast< uint64_t >( p[ 0 ] ) << 56 )
+                        | ( static_cast< uint64_t >( p[ 1 ] ) << 48 )
+                        | ( static_cast< uint64_t >( p[ 2 ] ) << 40 )
+                        | ( static_cast< uint64_t >( p[ 3 ] ) << 32 )
+                        | ( static_cast< uint64_t >( p[ 4 ] ) << 24 )
+                        | ( static_cast< uint64_t >( p[ 5 ] ) << 16 )
+                        | ( static_cast< uint64_t >( p[ 6 ] ) << 8 )
+                        |   static_cast< uint64_t >( p[ 7 ] );
+        }
+        
+        return values;
+    }
+    
     float BinaryStream::ReadBigEndianFixedPoint( unsigned int integerLength, unsigned int fractionalLength )
     {
         uint32_t     n;
@@ -437,17 +515,25 @@ namespace ISOBMFF
     
     Matrix BinaryStream::ReadMatrix()
     {
+        uint32_t values[ 9 ];
+        
+        /* Reads must be sequenced - argument evaluation order is unspecified */
+        for( uint32_t & value: values )
+        {
+            value = this->ReadBigEndianUInt32();
+        }
+        
         return Matrix
         (
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32(),
-            this->ReadBigEndianUInt32()
+            values[ 0 ],
+            values[ 1 ],
+            values[ 2 ],
+            values[ 3 ],
+            values[ 4 ],
+            values[ 5 ],
+            values[ 6 ],
+            values[ 7 ],
+            values[ 8 ]
         );
     }
 }
@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BitReader.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/BitReader.hpp>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ISOBMFF
+{
+    static unsigned int CountLeadingZeros( uint64_t value );
+    
+    BitReader::BitReader( const uint8_t * data, size_t size ):
+        _data( data ),
+        _size( size ),
+        _pos( 0 )
+    {}
+    
+    uint32_t BitReader::ReadBits( unsigned int count )
+    {
+        uint64_t value;
+        
+        if( count == 0 )
+        {
+            return 0;
+        }
+        
+        if( count > 32 )
+        {
+            throw std::runtime_error( "Cannot read more than 32 bits at once" );
+        }
+        
+        if( count > this->GetRemainingBits() )
+        {
+            throw std::runtime_error( "Invalid read - Not enough bits available" );
+        }
+        
+        value       = this->Peek64() >> ( 64 - count );
+        this->_pos += count;
+        
+        return static_cast< uint32_t >( value );
+    }
+    
+    bool BitReader::ReadFlag()
+    {
+        return this->ReadBits( 1 ) != 0;
+    }
+    
+    uint32_t BitReader::ReadUE()
+    {
+        uint64_t     window;
+        unsigned int zeros;
+        
+        /*
+         * The window holds at least 57 valid bits, which is enough for
+         * the 32 leading zeros of the largest valid code.
+         */
+        window = this->Peek64();
+        
+        if( window == 0 )
+        {
+            throw std::runtime_error( "Invalid exp-Golomb code" );
+        }
+        
+        zeros = CountLeadingZeros( window );
+        
+        if( zeros > 31 || 2 * static_cast< size_t >( zeros ) + 1 > this->GetRemainingBits() )
+        {
+            throw std::runtime_error( "Invalid exp-Golomb code" );
+        }
+        
+        this->_pos += zeros;
+        
+        return static_cast< uint32_t >( static_cast< uint64_t >( this->ReadBits( zeros + 1 ) ) - 1 );
+    }
+    
+    int32_t BitReader::ReadSE()
+    {
+        uint64_t value;
+        
+        value = this->ReadUE();
+        
+        if( value & 1 )
+        {
+            return static_cast< int32_t >( ( value + 1 ) / 2 );
+        }
+        
+        return -static_cast< int32_t >( value / 2 );
+    }
+    
+    void BitReader::SkipBits( size_t count )
+    {
+        if( count > this->GetRemainingBits() )
+        {
+            throw std::runtime_error( "Invalid skip - Not enough bits available" );
+        }
+        
+        this->_pos += count;
+    }
+    
+    size_t BitReader::GetPosition() const
+    {
+        return this->_pos;
+    }
+    
+    size_t BitReader::GetRemainingBits() const
+    {
+        return this->_size * 8 - this->_pos;
+    }
+    
+    bool BitReader::IsByteAligned() const
+    {
+        return ( this->_pos % 8 ) == 0;
+    }
+    
+    uint64_t BitReader::Peek64() const
+    {
+        uint64_t value;
+        size_t   byte;
+        
+        value = 0;
+        byte  = this->_pos / 8;
+        
+        /*
+         * Bytes past the end of the buffer are read as zeros.
+         */
+        for( size_t i = 0; i < 8; i++ )
+        {
+            value <<= 8;
+            
+            if( byte + i < this->_size )
+            {
+                value |= this->_data[ byte + i ];
+            }
+        }
+        
+        return value << ( this->_pos % 8 );
+    }
+    
+    static unsigned int CountLeadingZeros( uint64_t value )
+    {
+        #if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_ARM64 ) )
+        
+        unsigned long i;
+        
+        _BitScanReverse64( &i, value );
+        
+        return 63 - static_cast< unsigned int >( i );
+
+        #elif defined( __GNUC__ ) || defined( __clang__ )
+        
+        return static_cast< unsigned int >( __builtin_clzll( value ) );
+
+        #else
+        
+        unsigned int n;
+        
+        for( n = 0; ( value & ( static_cast< uint64_t >( 1 ) << 63 ) ) == 0; n++ )
+        {
+            value <<= 1;
+        }
+        
+        return n;
+
+        #endif
+    }
+}
@@ -32,6 +32,8 @@
 #include <ISOBMFF/Utils.hpp>
 #include <ISOBMFF/DisplayableObjectContainer.hpp>
 #include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/Container.hpp>
+#include <limits>
 
 namespace ISOBMFF
 {
@@ -46,6 +48,14 @@ namespace ISOBMFF
             std::string            _name;
             std::vector< uint8_t > _data;
             bool                   _hasData;
+            bool                   _modified;
+            bool                   _hasSource;
+            uint64_t               _sourceOffset;
+            uint64_t               _sourceSize;
+            uint64_t               _serializedSize;
+            bool                   _copy;
+            bool                   _encode;
+            bool                   _largeSize;
     };
     
     Box::Box( const std::string & name ):
@@ -97,6 +107,191 @@ namespace ISOBMFF
         return this->impl->_data;
     }
     
+    void Box::SetData( const std::vector< uint8_t > & value )
+    {
+        this->impl->_data = value;
+        
+        this->SetModified( true );
+    }
+    
+    uint64_t Box::GetDataSize() const
+    {
+        return this->impl->_data.size();
+    }
+    
+    void Box::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.Write( this->impl->_data );
+    }
+    
+    uint64_t Box::GetSerializedSize() const
+    {
+        uint64_t size;
+        
+        this->impl->_copy = this->impl->_encode == false && this->HasSource() && this->IsModified() == false;
+        
+        if( this->impl->_copy )
+        {
+            size = this->impl->_sourceSize;
+        }
+        else
+        {
+            size = this->GetDataSize() + 8;
+            
+            if( this->impl->_largeSize || size > ( std::numeric_limits< uint32_t >::max )() )
+            {
+                size += 8;
+            }
+        }
+        
+        this->impl->_serializedSize = size;
+        
+        return size;
+    }
+    
+    void Box::Write( BinaryOutputStream & stream ) const
+    {
+        /*
+         * Without a source, unmodified boxes cannot be copied, so all
+         * nested boxes are encoded for this write.
+         */
+        if( stream.GetSource() == nullptr )
+        {
+            this->SetEncode( true );
+        }
+        
+        try
+        {
+            this->GetSerializedSize();
+            this->WriteBox( stream );
+        }
+        catch( ... )
+        {
+            this->SetEncode( false );
+            
+            throw;
+        }
+        
+        this->SetEncode( false );
+    }
+    
+    void Box::SetEncode( bool value ) const
+    {
+        const Container * container;
+        
+        this->impl->_encode = value;
+        
+        container = dynamic_cast< const Container * >( this );
+        
+        if( container != nullptr )
+        {
+            for( const auto & box: container->GetBoxes() )
+            {
+                box->SetEncode( value );
+            }
+        }
+    }
+    
+    void Box::WriteBox( BinaryOutputStream & stream ) const
+    {
+        uint64_t size;
+        size_t   start;
+        
+        size = this->impl->_serializedSize;
+        
+        if( this->impl->_copy )
+        {
+            if( stream.GetSource() == nullptr )
+            {
+                throw std::runtime_error( "Cannot copy box " + this->impl->_name + " - No source stream" );
+            }
+            
+            stream.Copy( *( stream.GetSource() ), this->impl->_sourceOffset, size );
+            
+            return;
+        }
+        
+        start = stream.Tell();
+        
+        if( this->impl->_largeSize || size > ( std::numeric_limits< uint32_t >::max )() )
+        {
+            stream.WriteBigEndianUInt32( 1 );
+            stream.WriteFourCC( this->impl->_name );
+            stream.WriteBigEndianUInt64( size );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( size ) );
+            stream.WriteFourCC( this->impl->_name );
+        }
+        
+        this->WriteData( stream );
+        
+        if( stream.Tell() - start != size )
+        {
+            throw std::runtime_error( "Invalid write - Size mismatch for box " + this->impl->_name );
+        }
+    }
+    
+    bool Box::IsModified() const
+    {
+        const Container * container;
+        
+        if( this->impl->_modified )
+        {
+            return true;
+        }
+        
+        container = dynamic_cast< const Container * >( this );
+        
+        if( container != nullptr )
+        {
+            for( const auto & box: container->GetBoxes() )
+            {
+                if( box->IsModified() )
+                {
+                    return true;
+                }
+            }
+        }
+        
+        return false;
+    }
+    
+    void Box::SetModified( bool value )
+    {
+        this->impl->_modified = value;
+    }
+    
+    bool Box::HasModifiedFields() const
+    {
+        return this->impl->_modified;
+    }
+    
+    bool Box::HasSource() const
+    {
+        return this->impl->_hasSource;
+    }
+    
+    uint64_t Box::GetSourceOffset() const
+    {
+        return this->impl->_sourceOffset;
+    }
+    
+    uint64_t Box::GetSourceSize() const
+    {
+        return this->impl->_sourceSize;
+    }
+    
+    void Box::SetSource( uint64_t offset, uint64_t size, uint64_t header )
+    {
+        this->impl->_hasSource    = true;
+        this->impl->_sourceOffset = offset;
+        this->impl->_sourceSize   = size;
+        this->impl->_largeSize    = header == 16;
+        this->impl->_modified     = false;
+    }
+    
     std::vector< std::pair< std::string, std::string > > Box::GetDisplayableProperties() const
     {
         return {};
@@ -104,13 +299,29 @@ namespace ISOBMFF
     
     Box::IMPL::IMPL( const std::string & name ):
         _name( name ),
-        _hasData( false )
+        _hasData( false ),
+        _modified( false ),
+        _hasSource( false ),
+        _sourceOffset( 0 ),
+        _sourceSize( 0 ),
+        _serializedSize( 0 ),
+        _copy( false ),
+        _encode( false ),
+        _largeSize( false )
     {}
 
     Box::IMPL::IMPL( const IMPL & o ):
         _name( o._name ),
         _data( o._data ),
-        _hasData( o._hasData )
+        _hasData( o._hasData ),
+        _modified( o._modified ),
+        _hasSource( o._hasSource ),
+        _sourceOffset( o._sourceOffset ),
+        _sourceSize( o._sourceSize ),
+        _serializedSize( o._serializedSize ),
+        _copy( o._copy ),
+        _encode( false ),
+        _largeSize( o._largeSize )
     {}
 
     Box::IMPL::~IMPL()
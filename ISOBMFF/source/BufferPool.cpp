@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        BufferPool.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/BufferPool.hpp>
+#include <mutex>
+
+namespace ISOBMFF
+{
+    class BufferPool::IMPL
+    {
+        public:
+            
+            IMPL( size_t maxBuffers );
+            ~IMPL();
+            
+            void Release( std::vector< uint8_t > * buffer );
+            
+            size_t                                                   _maxBuffers;
+            std::vector< std::unique_ptr< std::vector< uint8_t > > > _buffers;
+            std::mutex                                               _mutex;
+    };
+    
+    BufferPool::BufferPool( size_t maxBuffers ):
+        impl( std::make_shared< IMPL >( maxBuffers ) )
+    {}
+    
+    BufferPool::~BufferPool()
+    {}
+    
+    std::shared_ptr< std::vector< uint8_t > > BufferPool::Acquire( size_t size )
+    {
+        std::unique_ptr< std::vector< uint8_t > > buffer;
+        std::shared_ptr< IMPL >                   pool( this->impl );
+        
+        {
+            std::lock_guard< std::mutex > lock( this->impl->_mutex );
+            
+            /*
+             * The smallest idle buffer large enough is preferred, so large
+             * buffers stay available for large requests.
+             */
+            auto it = std::end( this->impl->_buffers );
+            
+            for( auto i = std::begin( this->impl->_buffers ); i != std::end( this->impl->_buffers ); ++i )
+            {
+                if( ( *( i ) )->capacity() >= size && ( it == std::end( this->impl->_buffers ) || ( *( i ) )->capacity() < ( *( it ) )->capacity() ) )
+                {
+                    it = i;
+                }
+            }
+            
+            if( it == std::end( this->impl->_buffers ) && this->impl->_buffers.size() > 0 )
+            {
+                it = std::begin( this->impl->_buffers );
+            }
+            
+            if( it != std::end( this->impl->_buffers ) )
+            {
+                buffer = std::move( *( it ) );
+                
+                this->impl->_buffers.erase( it );
+            }
+        }
+        
+        if( buffer == nullptr )
+        {
+            buffer = std::make_unique< std::vector< uint8_t > >();
+        }
+        
+        buffer->resize( size );
+        
+        return std::shared_ptr< std::vector< uint8_t > >( buffer.release(), [ pool ]( std::vector< uint8_t > * p ) { pool->Release( p ); } );
+    }
+    
+    size_t BufferPool::GetMaxBuffers() const
+    {
+        return this->impl->_maxBuffers;
+    }
+    
+    size_t BufferPool::GetIdleBuffers() const
+    {
+        std::lock_guard< std::mutex > lock( this->impl->_mutex );
+        
+        return this->impl->_buffers.size();
+    }
+    
+    BufferPool::IMPL::IMPL( size_t maxBuffers ):
+        _maxBuffers( maxBuffers )
+    {}
+    
+    BufferPool::IMPL::~IMPL()
+    {}
+    
+    void BufferPool::IMPL::Release( std::vector< uint8_t > * buffer )
+    {
+        std::unique_ptr< std::vector< uint8_t > > p( buffer );
+        std::lock_guard< std::mutex >             lock( this->_mutex );
+        
+        if( this->_buffers.size() < this->_maxBuffers )
+        {
+            this->_buffers.push_back( std::move( p ) );
+        }
+    }
+}
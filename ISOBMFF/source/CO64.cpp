@@ -0,0 +1,147 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        CO64.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/CO64.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class CO64::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::vector< uint64_t > _chunkOffsets;
+    };
+    
+    CO64::CO64():
+        FullBox( "co64" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    CO64::CO64( const CO64 & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    CO64::CO64( CO64 && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    CO64::~CO64()
+    {}
+    
+    CO64 & CO64::operator =( CO64 o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( CO64 & o1, CO64 & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void CO64::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        this->impl->_chunkOffsets = stream.ReadBigEndianUInt64Array( stream.ReadBigEndianUInt32() );
+    }
+    
+    uint64_t CO64::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + this->impl->_chunkOffsets.size() * 8;
+    }
+    
+    void CO64::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_chunkOffsets.size() ) );
+        stream.WriteBigEndianUInt64Array( this->impl->_chunkOffsets );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > CO64::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        for( uint64_t offset: this->impl->_chunkOffsets )
+        {
+            props.push_back( { "Chunk offset", std::to_string( offset ) } );
+        }
+        
+        return props;
+    }
+    
+    size_t CO64::GetEntryCount() const
+    {
+        return this->impl->_chunkOffsets.size();
+    }
+    
+    uint64_t CO64::GetChunkOffset( size_t index ) const
+    {
+        return this->impl->_chunkOffsets[ index ];
+    }
+    
+    const std::vector< uint64_t > & CO64::GetChunkOffsets() const
+    {
+        return this->impl->_chunkOffsets;
+    }
+    
+    void CO64::SetChunkOffsets( const std::vector< uint64_t > & value )
+    {
+        this->impl->_chunkOffsets = value;
+        
+        this->SetModified( true );
+    }
+    
+    CO64::IMPL::IMPL()
+    {}
+    
+    CO64::IMPL::IMPL( const IMPL & o ):
+        _chunkOffsets( o._chunkOffsets )
+    {}
+    
+    CO64::IMPL::~IMPL()
+    {}
+}
@@ -97,6 +97,13 @@ namespace ISOBMFF
             this->SetMatrixCoefficients( stream.ReadBigEndianUInt16() );
             this->SetFullRangeFlag( ( stream.ReadUInt8() & 0x80 ) != 0 );
         }
+        else if( this->GetColourType() == "nclc" )
+        {
+            /* QuickTime variant, without the full range flag */
+            this->SetColourPrimaries( stream.ReadBigEndianUInt16() );
+            this->SetTransferCharacteristics( stream.ReadBigEndianUInt16() );
+            this->SetMatrixCoefficients( stream.ReadBigEndianUInt16() );
+        }
         else if( this->GetColourType() == "rICC" || this->GetColourType() == "prof" )
         {
             this->SetICCProfile( stream.ReadAllData() );
@@ -107,6 +114,53 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t COLR::GetDataSize() const
+    {
+        if( this->GetColourType() == "nclx" )
+        {
+            return 11;
+        }
+        else if( this->GetColourType() == "nclc" )
+        {
+            return 10;
+        }
+        else if( this->GetColourType() == "rICC" || this->GetColourType() == "prof" )
+        {
+            return 4 + this->impl->_iccProfile.size();
+        }
+        
+        return 4 + Box::GetDataSize();
+    }
+    
+    void COLR::WriteData( BinaryOutputStream & stream ) const
+    {
+        if( this->GetColourType() == "nclx" )
+        {
+            stream.WriteFourCC( this->GetColourType() );
+            stream.WriteBigEndianUInt16( this->GetColourPrimaries() );
+            stream.WriteBigEndianUInt16( this->GetTransferCharacteristics() );
+            stream.WriteBigEndianUInt16( this->GetMatrixCoefficients() );
+            stream.WriteUInt8( ( this->GetFullRangeFlag() ) ? 0x80 : 0x00 );
+        }
+        else if( this->GetColourType() == "nclc" )
+        {
+            stream.WriteFourCC( this->GetColourType() );
+            stream.WriteBigEndianUInt16( this->GetColourPrimaries() );
+            stream.WriteBigEndianUInt16( this->GetTransferCharacteristics() );
+            stream.WriteBigEndianUInt16( this->GetMatrixCoefficients() );
+        }
+        else if( this->GetColourType() == "rICC" || this->GetColourType() == "prof" )
+        {
+            stream.WriteFourCC( this->GetColourType() );
+            stream.Write( this->GetICCProfile() );
+        }
+        else
+        {
+            stream.WriteFourCC( this->GetColourType() );
+            Box::WriteData( stream );
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > COLR::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
@@ -120,6 +174,12 @@ namespace ISOBMFF
             props.push_back( { "Matrix coefficients",      std::to_string( this->GetMatrixCoefficients() ) } );
             props.push_back( { "Full range flag",          ( this->GetFullRangeFlag() ) ? "yes" : "no" } );
         }
+        else if( this->GetColourType() == "nclc" )
+        {
+            props.push_back( { "Colour primaries",         std::to_string( this->GetColourPrimaries() ) } );
+            props.push_back( { "Transfer characteristics", std::to_string( this->GetTransferCharacteristics() ) } );
+            props.push_back( { "Matrix coefficients",      std::to_string( this->GetMatrixCoefficients() ) } );
+        }
         else if( this->GetColourType() == "rICC" || this->GetColourType() == "prof" )
         {
             {
@@ -185,31 +245,37 @@ namespace ISOBMFF
     void COLR::SetColourType( const std::string & value )
     {
         this->impl->_colourType = value;
+        this->SetModified( true );
     }
     
     void COLR::SetColourPrimaries( uint16_t value )
     {
         this->impl->_colourPrimaries = value;
+        this->SetModified( true );
     }
     
     void COLR::SetTransferCharacteristics( uint16_t value )
     {
         this->impl->_transferCharacteristics = value;
+        this->SetModified( true );
     }
     
     void COLR::SetMatrixCoefficients( uint16_t value )
     {
         this->impl->_matrixCoefficients = value;
+        this->SetModified( true );
     }
     
     void COLR::SetFullRangeFlag( bool value )
     {
         this->impl->_fullRangeFlag = value;
+        this->SetModified( true );
     }
     
     void COLR::SetICCProfile( const std::vector< uint8_t > & value )
     {
         this->impl->_iccProfile = value;
+        this->SetModified( true );
     }
 
     COLR::IMPL::IMPL():
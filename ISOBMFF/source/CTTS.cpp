@@ -0,0 +1,237 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        CTTS.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/CTTS.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+#include <mutex>
+
+namespace ISOBMFF
+{
+    class CTTS::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void BuildIndex();
+            
+            std::vector< uint32_t > _sampleCount;
+            std::vector< int32_t >  _sampleOffset;
+            
+            /*
+             * First sample of each entry, built on first lookup.
+             */
+            std::once_flag          _indexOnce;
+            std::vector< uint64_t > _indexSample;
+            uint64_t                _totalSamples;
+    };
+    
+    CTTS::CTTS():
+        FullBox( "ctts" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    CTTS::CTTS( const CTTS & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    CTTS::CTTS( CTTS && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    CTTS::~CTTS()
+    {}
+    
+    CTTS & CTTS::operator =( CTTS o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( CTTS & o1, CTTS & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void CTTS::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint32_t                count;
+        std::vector< uint32_t > entries;
+        
+        count = stream.ReadBigEndianUInt32();
+        
+        if( count > stream.AvailableBytes() / 8 )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        entries = stream.ReadBigEndianUInt32Array( static_cast< size_t >( count ) * 2 );
+        
+        this->impl->_sampleCount.resize( count );
+        this->impl->_sampleOffset.resize( count );
+        
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            this->impl->_sampleCount[ i ]  = entries[ i * 2 ];
+            this->impl->_sampleOffset[ i ] = static_cast< int32_t >( entries[ i * 2 + 1 ] );
+        }
+    }
+    
+    uint64_t CTTS::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + this->impl->_sampleCount.size() * 8;
+    }
+    
+    void CTTS::WriteData( BinaryOutputStream & stream ) const
+    {
+        std::vector< uint32_t > entries;
+        
+        FullBox::WriteData( stream );
+        
+        entries.resize( this->impl->_sampleCount.size() * 2 );
+        
+        for( size_t i = 0; i < this->impl->_sampleCount.size(); i++ )
+        {
+            entries[ i * 2 ]     = this->impl->_sampleCount[ i ];
+            entries[ i * 2 + 1 ] = static_cast< uint32_t >( this->impl->_sampleOffset[ i ] );
+        }
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sampleCount.size() ) );
+        stream.WriteBigEndianUInt32Array( entries );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > CTTS::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        for( size_t i = 0; i < this->GetEntryCount(); i++ )
+        {
+            props.push_back( { "Sample count",  std::to_string( this->GetSampleCount( i ) ) } );
+            props.push_back( { "Sample offset", std::to_string( this->GetSampleOffset( i ) ) } );
+        }
+        
+        return props;
+    }
+    
+    size_t CTTS::GetEntryCount() const
+    {
+        return this->impl->_sampleCount.size();
+    }
+    
+    uint32_t CTTS::GetSampleCount( size_t index ) const
+    {
+        return this->impl->_sampleCount[ index ];
+    }
+    
+    int32_t CTTS::GetSampleOffset( size_t index ) const
+    {
+        return this->impl->_sampleOffset[ index ];
+    }
+    
+    uint64_t CTTS::GetTotalSampleCount() const
+    {
+        std::call_once( this->impl->_indexOnce, [ this ] { this->impl->BuildIndex(); } );
+        
+        return this->impl->_totalSamples;
+    }
+    
+    int32_t CTTS::GetCompositionOffset( uint64_t sample ) const
+    {
+        size_t i;
+        
+        std::call_once( this->impl->_indexOnce, [ this ] { this->impl->BuildIndex(); } );
+        
+        if( sample >= this->impl->_totalSamples )
+        {
+            return 0;
+        }
+        
+        i = static_cast< size_t >( std::upper_bound( this->impl->_indexSample.begin(), this->impl->_indexSample.end(), sample ) - this->impl->_indexSample.begin() ) - 1;
+        
+        return this->impl->_sampleOffset[ i ];
+    }
+    
+    size_t CTTS::GetEntryForSample( uint64_t sample ) const
+    {
+        std::call_once( this->impl->_indexOnce, [ this ] { this->impl->BuildIndex(); } );
+        
+        if( sample >= this->impl->_totalSamples )
+        {
+            throw std::runtime_error( "Invalid sample index" );
+        }
+        
+        return static_cast< size_t >( std::upper_bound( this->impl->_indexSample.begin(), this->impl->_indexSample.end(), sample ) - this->impl->_indexSample.begin() ) - 1;
+    }
+    
+    uint64_t CTTS::GetEntryFirstSample( size_t index ) const
+    {
+        std::call_once( this->impl->_indexOnce, [ this ] { this->impl->BuildIndex(); } );
+        
+        return this->impl->_indexSample[ index ];
+    }
+    
+    void CTTS::IMPL::BuildIndex()
+    {
+        this->_indexSample.resize( this->_sampleCount.size() );
+        
+        for( size_t i = 0; i < this->_sampleCount.size(); i++ )
+        {
+            this->_indexSample[ i ]  = this->_totalSamples;
+            this->_totalSamples     += this->_sampleCount[ i ];
+        }
+    }
+    
+    CTTS::IMPL::IMPL():
+        _totalSamples( 0 )
+    {}
+    
+    CTTS::IMPL::IMPL( const IMPL & o ):
+        _sampleCount( o._sampleCount ),
+        _sampleOffset( o._sampleOffset ),
+        _totalSamples( 0 )
+    {}
+    
+    CTTS::IMPL::~IMPL()
+    {}
+}
@@ -63,6 +63,28 @@ namespace ISOBMFF
         Container::WriteBoxes( this->GetBoxes(), os, indentLevel );
     }
     
+    uint64_t Container::GetBoxesSize() const
+    {
+        uint64_t size;
+        
+        size = 0;
+        
+        for( const auto & box: this->GetBoxes() )
+        {
+            size += box->GetSerializedSize();
+        }
+        
+        return size;
+    }
+    
+    void Container::WriteBoxes( BinaryOutputStream & stream ) const
+    {
+        for( const auto & box: this->GetBoxes() )
+        {
+            box->WriteBox( stream );
+        }
+    }
+    
     std::vector< std::shared_ptr< Box > > Container::GetBoxes( const std::string & name ) const
     {
         std::vector< std::shared_ptr< Box > > boxes;
@@ -31,6 +31,7 @@
 #include <ISOBMFF/ContainerBox.hpp>
 #include <ISOBMFF/Parser.hpp>
 #include <ISOBMFF/BinaryDataStream.hpp>
+#include <stdexcept>
 
 namespace ISOBMFF
 {
@@ -43,6 +44,7 @@ namespace ISOBMFF
             ~IMPL();
             
             std::vector< std::shared_ptr< Box > > _boxes;
+            std::vector< uint8_t >                _trailingData;
     };
     
     ContainerBox::ContainerBox( const std::string & name ):
@@ -84,23 +86,36 @@ namespace ISOBMFF
     void ContainerBox::ReadData( Parser & parser, BinaryStream & stream )
     {
         uint64_t               length;
+        uint64_t               header;
+        uint64_t               start;
+        uint64_t               base;
         std::string            name;
         std::shared_ptr< Box > box;
         BinaryDataStream     * content;
         
         this->impl->_boxes.clear();
+        this->impl->_trailingData.clear();
         
-        while( stream.HasBytesAvailable() )
+        base = parser.GetStreamOffset();
+        
+        /*
+         * QuickTime sample entries may end with a 32-bit zero terminator,
+         * so trailing data too small to hold a box header is kept as is.
+         */
+        while( stream.AvailableBytes() >= 8 )
         {
             ( void )parser;
             
+            start    = stream.Tell();
             length   = stream.ReadBigEndianUInt32();
             name     = stream.ReadFourCC();
+            header   = 8;
             content  = nullptr;
             
             if( length == 1 )
             {
                 length = stream.ReadBigEndianUInt64();
+                header = 16;
                 
                 if
                 (
@@ -133,9 +148,12 @@ namespace ISOBMFF
             {
                 if( content )
                 {
+                    parser.SetStreamOffset( base + start + header );
                     box->ReadData( parser, *content );
+                    parser.SetStreamOffset( base );
                 }
                 
+                box->SetSource( base + start, length, header );
                 this->AddBox( box );
             }
             if( content )
@@ -143,6 +161,19 @@ namespace ISOBMFF
                 delete( content );
             }
         }
+        
+        this->impl->_trailingData = stream.ReadAllData();
+    }
+    
+    uint64_t ContainerBox::GetDataSize() const
+    {
+        return this->GetBoxesSize() + this->impl->_trailingData.size();
+    }
+    
+    void ContainerBox::WriteData( BinaryOutputStream & stream ) const
+    {
+        this->WriteBoxes( stream );
+        stream.Write( this->impl->_trailingData );
     }
     
     void ContainerBox::AddBox( std::shared_ptr< Box > box )
@@ -151,6 +182,8 @@ namespace ISOBMFF
         {
             this->impl->_boxes.push_back( box );
         }
+        
+        this->SetModified( true );
     }
     
     std::vector< std::shared_ptr< Box > > ContainerBox::GetBoxes() const
@@ -158,6 +191,32 @@ namespace ISOBMFF
         return this->impl->_boxes;
     }
     
+    void ContainerBox::ReplaceBox( std::shared_ptr< Box > box, std::shared_ptr< Box > replacement )
+    {
+        auto it = std::find( this->impl->_boxes.begin(), this->impl->_boxes.end(), box );
+        
+        if( it == this->impl->_boxes.end() || replacement == nullptr )
+        {
+            throw std::runtime_error( "Cannot replace box - Not a child of " + this->GetName() );
+        }
+        
+        *( it ) = replacement;
+        
+        this->SetModified( true );
+    }
+    
+    std::vector< uint8_t > ContainerBox::GetTrailingData() const
+    {
+        return this->impl->_trailingData;
+    }
+    
+    void ContainerBox::SetTrailingData( const std::vector< uint8_t > & data )
+    {
+        this->impl->_trailingData = data;
+        
+        this->SetModified( true );
+    }
+    
     void ContainerBox::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         Box::WriteDescription( os, indentLevel );
@@ -168,7 +227,8 @@ namespace ISOBMFF
     {}
 
     ContainerBox::IMPL::IMPL( const IMPL & o ):
-        _boxes( o._boxes )
+        _boxes( o._boxes ),
+        _trailingData( o._trailingData )
     {}
 
     ContainerBox::IMPL::~IMPL()
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Demuxer-Packet.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Demuxer.hpp>
+
+namespace ISOBMFF
+{
+    class Demuxer::Packet::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t            _trackID;
+            TrackReader::Sample _sample;
+    };
+    
+    Demuxer::Packet::Packet():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    Demuxer::Packet::Packet( const Packet & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Demuxer::Packet::Packet( Packet && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Demuxer::Packet::~Packet()
+    {}
+    
+    Demuxer::Packet & Demuxer::Packet::operator =( Packet o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( Demuxer::Packet & o1, Demuxer::Packet & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint32_t Demuxer::Packet::GetTrackID() const
+    {
+        return this->impl->_trackID;
+    }
+    
+    uint64_t Demuxer::Packet::GetSampleIndex() const
+    {
+        return this->impl->_sample.GetIndex();
+    }
+    
+    uint64_t Demuxer::Packet::GetOffset() const
+    {
+        return this->impl->_sample.GetOffset();
+    }
+    
+    uint64_t Demuxer::Packet::GetDecodeTime() const
+    {
+        return this->impl->_sample.GetDecodeTime();
+    }
+    
+    int64_t Demuxer::Packet::GetCompositionTime() const
+    {
+        return this->impl->_sample.GetCompositionTime();
+    }
+    
+    uint32_t Demuxer::Packet::GetDuration() const
+    {
+        return this->impl->_sample.GetDuration();
+    }
+    
+    bool Demuxer::Packet::IsSync() const
+    {
+        return this->impl->_sample.IsSync();
+    }
+    
+    uint32_t Demuxer::Packet::GetSampleDescriptionIndex() const
+    {
+        return this->impl->_sample.GetSampleDescriptionIndex();
+    }
+    
+    const uint8_t * Demuxer::Packet::GetData() const
+    {
+        return this->impl->_sample.GetData();
+    }
+    
+    size_t Demuxer::Packet::GetSize() const
+    {
+        return this->impl->_sample.GetSize();
+    }
+    
+    void Demuxer::Packet::Set( uint32_t trackID, TrackReader::Sample & sample )
+    {
+        using std::swap;
+        
+        /*
+         * The sample objects are exchanged, so the caller gets back the
+         * previous sample and can reuse it without allocating.
+         */
+        this->impl->_trackID = trackID;
+        
+        swap( this->impl->_sample, sample );
+    }
+    
+    Demuxer::Packet::IMPL::IMPL():
+        _trackID( 0 )
+    {}
+    
+    Demuxer::Packet::IMPL::IMPL( const IMPL & o ):
+        _trackID( o._trackID ),
+        _sample( o._sample )
+    {}
+    
+    Demuxer::Packet::IMPL::~IMPL()
+    {}
+}
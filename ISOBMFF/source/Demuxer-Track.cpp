@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Demuxer-Track.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Demuxer.hpp>
+
+namespace ISOBMFF
+{
+    class Demuxer::Track::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t                              _trackID;
+            std::string                           _handlerType;
+            uint32_t                              _timescale;
+            uint64_t                              _duration;
+            float                                 _width;
+            float                                 _height;
+            uint64_t                              _sampleCount;
+            std::vector< std::shared_ptr< Box > > _sampleEntries;
+    };
+    
+    Demuxer::Track::Track():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    Demuxer::Track::Track( const Track & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Demuxer::Track::Track( Track && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Demuxer::Track::~Track()
+    {}
+    
+    Demuxer::Track & Demuxer::Track::operator =( Track o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( Demuxer::Track & o1, Demuxer::Track & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint32_t Demuxer::Track::GetTrackID() const
+    {
+        return this->impl->_trackID;
+    }
+    
+    std::string Demuxer::Track::GetHandlerType() const
+    {
+        return this->impl->_handlerType;
+    }
+    
+    uint32_t Demuxer::Track::GetTimescale() const
+    {
+        return this->impl->_timescale;
+    }
+    
+    uint64_t Demuxer::Track::GetDuration() const
+    {
+        return this->impl->_duration;
+    }
+    
+    float Demuxer::Track::GetWidth() const
+    {
+        return this->impl->_width;
+    }
+    
+    float Demuxer::Track::GetHeight() const
+    {
+        return this->impl->_height;
+    }
+    
+    uint64_t Demuxer::Track::GetSampleCount() const
+    {
+        return this->impl->_sampleCount;
+    }
+    
+    std::vector< std::shared_ptr< Box > > Demuxer::Track::GetSampleEntries() const
+    {
+        return this->impl->_sampleEntries;
+    }
+    
+    std::string Demuxer::Track::GetCodec() const
+    {
+        if( this->impl->_sampleEntries.size() == 0 || this->impl->_sampleEntries[ 0 ] == nullptr )
+        {
+            return "";
+        }
+        
+        return this->impl->_sampleEntries[ 0 ]->GetName();
+    }
+    
+    void Demuxer::Track::SetTrackID( uint32_t value )
+    {
+        this->impl->_trackID = value;
+    }
+    
+    void Demuxer::Track::SetHandlerType( const std::string & value )
+    {
+        this->impl->_handlerType = value;
+    }
+    
+    void Demuxer::Track::SetTimescale( uint32_t value )
+    {
+        this->impl->_timescale = value;
+    }
+    
+    void Demuxer::Track::SetDuration( uint64_t value )
+    {
+        this->impl->_duration = value;
+    }
+    
+    void Demuxer::Track::SetWidth( float value )
+    {
+        this->impl->_width = value;
+    }
+    
+    void Demuxer::Track::SetHeight( float value )
+    {
+        this->impl->_height = value;
+    }
+    
+    void Demuxer::Track::SetSampleCount( uint64_t value )
+    {
+        this->impl->_sampleCount = value;
+    }
+    
+    void Demuxer::Track::SetSampleEntries( const std::vector< std::shared_ptr< Box > > & value )
+    {
+        this->impl->_sampleEntries = value;
+    }
+    
+    Demuxer::Track::IMPL::IMPL():
+        _trackID( 0 ),
+        _timescale( 0 ),
+        _duration( 0 ),
+        _width( 0 ),
+        _height( 0 ),
+        _sampleCount( 0 )
+    {}
+    
+    Demuxer::Track::IMPL::IMPL( const IMPL & o ):
+        _trackID( o._trackID ),
+        _handlerType( o._handlerType ),
+        _timescale( o._timescale ),
+        _duration( o._duration ),
+        _width( o._width ),
+        _height( o._height ),
+        _sampleCount( o._sampleCount ),
+        _sampleEntries( o._sampleEntries )
+    {}
+    
+    Demuxer::Track::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,239 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Demuxer.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Demuxer.hpp>
+#include <ISOBMFF/Container.hpp>
+#include <ISOBMFF/TKHD.hpp>
+#include <ISOBMFF/MDHD.hpp>
+#include <ISOBMFF/HDLR.hpp>
+#include <ISOBMFF/STSD.hpp>
+#include <stdexcept>
+#include <cmath>
+
+namespace ISOBMFF
+{
+    class Demuxer::IMPL
+    {
+        public:
+            
+            IMPL( const File & file, BinaryStream & stream );
+            ~IMPL();
+            
+            size_t GetTrackIndex( uint32_t trackID ) const;
+            
+            std::shared_ptr< BufferPool >                 _pool;
+            std::vector< Track >                          _tracks;
+            std::vector< std::unique_ptr< TrackReader > > _readers;
+            std::vector< TrackReader::Sample >            _next;
+            std::vector< bool >                           _hasNext;
+            std::vector< bool >                           _primed;
+            std::vector< bool >                           _selected;
+    };
+    
+    Demuxer::Demuxer( const File & file, BinaryStream & stream ):
+        impl( std::make_unique< IMPL >( file, stream ) )
+    {}
+    
+    Demuxer::~Demuxer()
+    {}
+    
+    std::vector< Demuxer::Track > Demuxer::GetTracks() const
+    {
+        return this->impl->_tracks;
+    }
+    
+    bool Demuxer::IsTrackSelected( uint32_t trackID ) const
+    {
+        return this->impl->_selected[ this->impl->GetTrackIndex( trackID ) ];
+    }
+    
+    void Demuxer::SelectTrack( uint32_t trackID, bool selected )
+    {
+        this->impl->_selected[ this->impl->GetTrackIndex( trackID ) ] = selected;
+    }
+    
+    void Demuxer::SetPrefetchChunks( size_t value )
+    {
+        for( const auto & reader: this->impl->_readers )
+        {
+            reader->SetPrefetchChunks( value );
+        }
+    }
+    
+    uint64_t Demuxer::GetReadCount() const
+    {
+        uint64_t count( 0 );
+        
+        for( const auto & reader: this->impl->_readers )
+        {
+            count += reader->GetReadCount();
+        }
+        
+        return count;
+    }
+    
+    void Demuxer::Seek( double seconds )
+    {
+        for( size_t i = 0; i < this->impl->_readers.size(); i++ )
+        {
+            const SampleTable & table( this->impl->_readers[ i ]->GetSampleTable() );
+            double              time( std::max( seconds, 0.0 ) * this->impl->_tracks[ i ].GetTimescale() );
+            
+            if( table.GetSampleCount() == 0 )
+            {
+                continue;
+            }
+            
+            this->impl->_readers[ i ]->Seek( table.GetSyncSampleAtOrBeforeTime( static_cast< uint64_t >( std::floor( time ) ) ) );
+            
+            this->impl->_primed[ i ] = false;
+        }
+    }
+    
+    bool Demuxer::ReadPacket( Packet & packet )
+    {
+        size_t   found( this->impl->_readers.size() );
+        uint64_t offset( 0 );
+        
+        for( size_t i = 0; i < this->impl->_readers.size(); i++ )
+        {
+            if( this->impl->_selected[ i ] == false )
+            {
+                continue;
+            }
+            
+            if( this->impl->_primed[ i ] == false )
+            {
+                this->impl->_hasNext[ i ] = this->impl->_readers[ i ]->ReadSample( this->impl->_next[ i ] );
+                this->impl->_primed[ i ]  = true;
+            }
+            
+            if( this->impl->_hasNext[ i ] && ( found == this->impl->_readers.size() || this->impl->_next[ i ].GetOffset() < offset ) )
+            {
+                found  = i;
+                offset = this->impl->_next[ i ].GetOffset();
+            }
+        }
+        
+        if( found == this->impl->_readers.size() )
+        {
+            return false;
+        }
+        
+        packet.Set( this->impl->_tracks[ found ].GetTrackID(), this->impl->_next[ found ] );
+        
+        this->impl->_primed[ found ] = false;
+        
+        return true;
+    }
+    
+    Demuxer::IMPL::IMPL( const File & file, BinaryStream & stream ):
+        _pool( std::make_shared< BufferPool >() )
+    {
+        std::shared_ptr< Container > moov( file.GetTypedBox< Container >( "moov" ) );
+        
+        if( moov == nullptr )
+        {
+            return;
+        }
+        
+        for( const auto & box: moov->GetBoxes( "trak" ) )
+        {
+            std::shared_ptr< Container >   trak( std::dynamic_pointer_cast< Container >( box ) );
+            std::shared_ptr< TKHD >        tkhd;
+            std::shared_ptr< Container >   mdia;
+            std::shared_ptr< MDHD >        mdhd;
+            std::shared_ptr< HDLR >        hdlr;
+            std::shared_ptr< Container >   minf;
+            std::shared_ptr< Container >   stbl;
+            std::shared_ptr< STSD >        stsd;
+            std::unique_ptr< TrackReader > reader;
+            Track                          track;
+            
+            tkhd = ( trak == nullptr ) ? nullptr : trak->GetTypedBox< TKHD >( "tkhd" );
+            mdia = ( trak == nullptr ) ? nullptr : trak->GetTypedBox< Container >( "mdia" );
+            mdhd = ( mdia == nullptr ) ? nullptr : mdia->GetTypedBox< MDHD >( "mdhd" );
+            hdlr = ( mdia == nullptr ) ? nullptr : mdia->GetTypedBox< HDLR >( "hdlr" );
+            minf = ( mdia == nullptr ) ? nullptr : mdia->GetTypedBox< Container >( "minf" );
+            stbl = ( minf == nullptr ) ? nullptr : minf->GetTypedBox< Container >( "stbl" );
+            stsd = ( stbl == nullptr ) ? nullptr : stbl->GetTypedBox< STSD >( "stsd" );
+            
+            if( tkhd == nullptr || mdhd == nullptr || stbl == nullptr )
+            {
+                continue;
+            }
+            
+            try
+            {
+                reader = std::make_unique< TrackReader >( *( trak ), stream, this->_pool );
+            }
+            catch( const std::runtime_error & )
+            {
+                continue;
+            }
+            
+            track.SetTrackID( tkhd->GetTrackID() );
+            track.SetHandlerType( ( hdlr == nullptr ) ? "" : hdlr->GetHandlerType() );
+            track.SetTimescale( mdhd->GetTimescale() );
+            track.SetDuration( mdhd->GetDuration() );
+            track.SetWidth( tkhd->GetWidth() );
+            track.SetHeight( tkhd->GetHeight() );
+            track.SetSampleCount( reader->GetSampleTable().GetSampleCount() );
+            
+            if( stsd != nullptr )
+            {
+                track.SetSampleEntries( stsd->GetBoxes() );
+            }
+            
+            this->_tracks.push_back( track );
+            this->_readers.push_back( std::move( reader ) );
+            this->_next.push_back( TrackReader::Sample() );
+            this->_hasNext.push_back( false );
+            this->_primed.push_back( false );
+            this->_selected.push_back( true );
+        }
+    }
+    
+    Demuxer::IMPL::~IMPL()
+    {}
+    
+    size_t Demuxer::IMPL::GetTrackIndex( uint32_t trackID ) const
+    {
+        for( size_t i = 0; i < this->_tracks.size(); i++ )
+        {
+            if( this->_tracks[ i ].GetTrackID() == trackID )
+            {
+                return i;
+            }
+        }
+        
+        throw std::runtime_error( "Unknown track ID" );
+    }
+}
@@ -0,0 +1,204 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ELST.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/ELST.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class ELST::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::vector< uint64_t > _segmentDuration;
+            std::vector< int64_t >  _mediaTime;
+            std::vector< int16_t >  _mediaRateInteger;
+            std::vector< int16_t >  _mediaRateFraction;
+    };
+    
+    ELST::ELST():
+        FullBox( "elst" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    ELST::ELST( const ELST & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    ELST::ELST( ELST && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    ELST::~ELST()
+    {}
+    
+    ELST & ELST::operator =( ELST o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( ELST & o1, ELST & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void ELST::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint32_t count;
+        
+        count = stream.ReadBigEndianUInt32();
+        
+        if( count > stream.AvailableBytes() / ( ( this->GetVersion() == 1 ) ? 20 : 12 ) )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        this->impl->_segmentDuration.resize( count );
+        this->impl->_mediaTime.resize( count );
+        this->impl->_mediaRateInteger.resize( count );
+        this->impl->_mediaRateFraction.resize( count );
+        
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            if( this->GetVersion() == 1 )
+            {
+                this->impl->_segmentDuration[ i ] = stream.ReadBigEndianUInt64();
+                this->impl->_mediaTime[ i ]       = static_cast< int64_t >( stream.ReadBigEndianUInt64() );
+            }
+            else
+            {
+                this->impl->_segmentDuration[ i ] = stream.ReadBigEndianUInt32();
+                this->impl->_mediaTime[ i ]       = static_cast< int32_t >( stream.ReadBigEndianUInt32() );
+            }
+            
+            this->impl->_mediaRateInteger[ i ]  = static_cast< int16_t >( stream.ReadBigEndianUInt16() );
+            this->impl->_mediaRateFraction[ i ] = static_cast< int16_t >( stream.ReadBigEndianUInt16() );
+        }
+    }
+    
+    uint64_t ELST::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + this->impl->_segmentDuration.size() * ( ( this->GetVersion() == 1 ) ? 20 : 12 );
+    }
+    
+    void ELST::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_segmentDuration.size() ) );
+        
+        for( size_t i = 0; i < this->impl->_segmentDuration.size(); i++ )
+        {
+            if( this->GetVersion() == 1 )
+            {
+                stream.WriteBigEndianUInt64( this->impl->_segmentDuration[ i ] );
+                stream.WriteBigEndianUInt64( static_cast< uint64_t >( this->impl->_mediaTime[ i ] ) );
+            }
+            else
+            {
+                stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_segmentDuration[ i ] ) );
+                stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_mediaTime[ i ] ) );
+            }
+            
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->impl->_mediaRateInteger[ i ] ) );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->impl->_mediaRateFraction[ i ] ) );
+        }
+    }
+    
+    std::vector< std::pair< std::string, std::string > > ELST::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        for( size_t i = 0; i < this->GetEntryCount(); i++ )
+        {
+            props.push_back( { "Segment duration",    std::to_string( this->GetSegmentDuration( i ) ) } );
+            props.push_back( { "Media time",          std::to_string( this->GetMediaTime( i ) ) } );
+            props.push_back( { "Media rate integer",  std::to_string( this->GetMediaRateInteger( i ) ) } );
+            props.push_back( { "Media rate fraction", std::to_string( this->GetMediaRateFraction( i ) ) } );
+        }
+        
+        return props;
+    }
+    
+    size_t ELST::GetEntryCount() const
+    {
+        return this->impl->_segmentDuration.size();
+    }
+    
+    uint64_t ELST::GetSegmentDuration( size_t index ) const
+    {
+        return this->impl->_segmentDuration[ index ];
+    }
+    
+    int64_t ELST::GetMediaTime( size_t index ) const
+    {
+        return this->impl->_mediaTime[ index ];
+    }
+    
+    int16_t ELST::GetMediaRateInteger( size_t index ) const
+    {
+        return this->impl->_mediaRateInteger[ index ];
+    }
+    
+    int16_t ELST::GetMediaRateFraction( size_t index ) const
+    {
+        return this->impl->_mediaRateFraction[ index ];
+    }
+    
+    ELST::IMPL::IMPL()
+    {}
+    
+    ELST::IMPL::IMPL( const IMPL & o ):
+        _segmentDuration( o._segmentDuration ),
+        _mediaTime( o._mediaTime ),
+        _mediaRateInteger( o._mediaRateInteger ),
+        _mediaRateFraction( o._mediaRateFraction )
+    {}
+    
+    ELST::IMPL::~IMPL()
+    {}
+}
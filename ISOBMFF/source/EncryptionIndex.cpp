@@ -0,0 +1,473 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        EncryptionIndex.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/EncryptionIndex.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <ISOBMFF/SampleTable.hpp>
+#include <ISOBMFF/SENC.hpp>
+#include <ISOBMFF/SAIZ.hpp>
+#include <ISOBMFF/SAIO.hpp>
+#include <ISOBMFF/SBGP.hpp>
+#include <ISOBMFF/TRUN.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class EncryptionIndex::IMPL
+    {
+        public:
+            
+            struct Key
+            {
+                bool                   _protected;
+                uint8_t                _ivSize;
+                uint8_t                _cryptByteBlock;
+                uint8_t                _skipByteBlock;
+                std::vector< uint8_t > _kid;
+                std::vector< uint8_t > _constantIV;
+            };
+            
+            IMPL( const Container & container, BinaryStream * stream, uint64_t baseOffset, std::shared_ptr< TENC > tenc, std::shared_ptr< SGPD > trackGroups );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            static std::shared_ptr< SGPD > GetGroups( const Container & container );
+            static Key                     ReadKey( const uint8_t * data, size_t size );
+            
+            void LoadKeys( const Container & container, size_t count, std::shared_ptr< TENC > tenc, std::shared_ptr< SGPD > trackGroups );
+            void LoadAuxInfo( const Container & container, BinaryStream & stream, uint64_t baseOffset );
+            void AddSample( BinaryStream & stream, bool subsamples );
+            
+            const Key & GetKey( size_t sample ) const;
+            
+            std::vector< Key >      _keys;
+            std::vector< uint32_t > _sampleKeys;
+            std::vector< uint8_t >  _ivs;
+            std::vector< size_t >   _ivOffsets;
+            std::vector< size_t >   _subsampleOffsets;
+            std::vector< uint16_t > _clearBytes;
+            std::vector< uint32_t > _encryptedBytes;
+    };
+    
+    EncryptionIndex::EncryptionIndex( const Container & container, std::shared_ptr< TENC > tenc, std::shared_ptr< SGPD > trackGroups ):
+        impl( std::make_unique< IMPL >( container, nullptr, 0, tenc, trackGroups ) )
+    {}
+    
+    EncryptionIndex::EncryptionIndex( const Container & container, BinaryStream & stream, uint64_t baseOffset, std::shared_ptr< TENC > tenc, std::shared_ptr< SGPD > trackGroups ):
+        impl( std::make_unique< IMPL >( container, &stream, baseOffset, tenc, trackGroups ) )
+    {}
+    
+    EncryptionIndex::EncryptionIndex( const EncryptionIndex & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    EncryptionIndex::EncryptionIndex( EncryptionIndex && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    EncryptionIndex::~EncryptionIndex()
+    {}
+    
+    EncryptionIndex & EncryptionIndex::operator =( EncryptionIndex o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( EncryptionIndex & o1, EncryptionIndex & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    size_t EncryptionIndex::GetSampleCount() const
+    {
+        return this->impl->_sampleKeys.size();
+    }
+    
+    bool EncryptionIndex::IsProtected( size_t sample ) const
+    {
+        return this->impl->GetKey( sample )._protected;
+    }
+    
+    uint8_t EncryptionIndex::GetCryptByteBlock( size_t sample ) const
+    {
+        return this->impl->GetKey( sample )._cryptByteBlock;
+    }
+    
+    uint8_t EncryptionIndex::GetSkipByteBlock( size_t sample ) const
+    {
+        return this->impl->GetKey( sample )._skipByteBlock;
+    }
+    
+    std::vector< uint8_t > EncryptionIndex::GetKID( size_t sample ) const
+    {
+        return this->impl->GetKey( sample )._kid;
+    }
+    
+    std::vector< uint8_t > EncryptionIndex::GetIV( size_t sample ) const
+    {
+        size_t start( this->impl->_ivOffsets.at( sample ) );
+        size_t end(   this->impl->_ivOffsets.at( sample + 1 ) );
+        
+        if( start == end )
+        {
+            return this->impl->GetKey( sample )._constantIV;
+        }
+        
+        return std::vector< uint8_t >( this->impl->_ivs.begin() + numeric_cast< std::ptrdiff_t >( start ), this->impl->_ivs.begin() + numeric_cast< std::ptrdiff_t >( end ) );
+    }
+    
+    size_t EncryptionIndex::GetSubsampleCount( size_t sample ) const
+    {
+        return this->impl->_subsampleOffsets.at( sample + 1 ) - this->impl->_subsampleOffsets.at( sample );
+    }
+    
+    uint16_t EncryptionIndex::GetSubsampleClearBytes( size_t sample, size_t subsample ) const
+    {
+        if( subsample >= this->GetSubsampleCount( sample ) )
+        {
+            throw std::out_of_range( "Invalid subsample index" );
+        }
+        
+        return this->impl->_clearBytes[ this->impl->_subsampleOffsets[ sample ] + subsample ];
+    }
+    
+    uint32_t EncryptionIndex::GetSubsampleEncryptedBytes( size_t sample, size_t subsample ) const
+    {
+        if( subsample >= this->GetSubsampleCount( sample ) )
+        {
+            throw std::out_of_range( "Invalid subsample index" );
+        }
+        
+        return this->impl->_encryptedBytes[ this->impl->_subsampleOffsets[ sample ] + subsample ];
+    }
+    
+    EncryptionIndex::IMPL::IMPL( const Container & container, BinaryStream * stream, uint64_t baseOffset, std::shared_ptr< TENC > tenc, std::shared_ptr< SGPD > trackGroups ):
+        _ivOffsets( 1, 0 ),
+        _subsampleOffsets( 1, 0 )
+    {
+        std::shared_ptr< SENC > senc( container.GetTypedBox< SENC >( "senc" ) );
+        std::shared_ptr< SAIZ > saiz( container.GetTypedBox< SAIZ >( "saiz" ) );
+        
+        if( tenc == nullptr )
+        {
+            throw std::runtime_error( "Missing TENC box" );
+        }
+        
+        if( senc != nullptr )
+        {
+            BinaryDataStream data( senc->GetSampleData() );
+            
+            this->LoadKeys( container, senc->GetSampleCount(), tenc, trackGroups );
+            
+            for( size_t i = 0; i < senc->GetSampleCount(); i++ )
+            {
+                this->AddSample( data, senc->HasSubsamples() );
+            }
+        }
+        else if( saiz != nullptr && stream != nullptr )
+        {
+            this->LoadKeys( container, saiz->GetSampleCount(), tenc, trackGroups );
+            this->LoadAuxInfo( container, *( stream ), baseOffset );
+        }
+        else
+        {
+            throw std::runtime_error( "Missing sample encryption information" );
+        }
+    }
+    
+    std::shared_ptr< SGPD > EncryptionIndex::IMPL::GetGroups( const Container & container )
+    {
+        for( const auto & box: container.GetBoxes( "sgpd" ) )
+        {
+            std::shared_ptr< SGPD > sgpd( std::dynamic_pointer_cast< SGPD >( box ) );
+            
+            if( sgpd != nullptr && sgpd->GetGroupingType() == "seig" )
+            {
+                return sgpd;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    EncryptionIndex::IMPL::Key EncryptionIndex::IMPL::ReadKey( const uint8_t * data, size_t size )
+    {
+        Key key;
+        
+        if( size < 20 )
+        {
+            throw std::runtime_error( "Invalid 'seig' sample group entry" );
+        }
+        
+        key._cryptByteBlock = static_cast< uint8_t >( data[ 1 ] >> 4 );
+        key._skipByteBlock  = static_cast< uint8_t >( data[ 1 ] & 0x0F );
+        key._protected      = data[ 2 ] != 0;
+        key._ivSize         = data[ 3 ];
+        
+        key._kid.assign( data + 4, data + 20 );
+        
+        if( key._protected && key._ivSize == 0 )
+        {
+            if( size < 21 || size < 21 + static_cast< size_t >( data[ 20 ] ) )
+            {
+                throw std::runtime_error( "Invalid 'seig' sample group entry" );
+            }
+            
+            key._constantIV.assign( data + 21, data + 21 + data[ 20 ] );
+        }
+        
+        return key;
+    }
+    
+    void EncryptionIndex::IMPL::LoadKeys( const Container & container, size_t count, std::shared_ptr< TENC > tenc, std::shared_ptr< SGPD > trackGroups )
+    {
+        std::shared_ptr< SGPD > localGroups( GetGroups( container ) );
+        std::shared_ptr< SBGP > sbgp;
+        Key                     key;
+        size_t                  sample;
+        bool                    fragment;
+        
+        fragment = container.GetBox( "tfhd" ) != nullptr;
+        
+        if( fragment == false && trackGroups == nullptr )
+        {
+            trackGroups = localGroups;
+            localGroups = nullptr;
+        }
+        
+        key._protected      = tenc->GetDefaultIsProtected();
+        key._ivSize         = tenc->GetDefaultPerSampleIVSize();
+        key._cryptByteBlock = tenc->GetDefaultCryptByteBlock();
+        key._skipByteBlock  = tenc->GetDefaultSkipByteBlock();
+        key._kid            = tenc->GetDefaultKID();
+        key._constantIV     = tenc->GetDefaultConstantIV();
+        
+        this->_keys.push_back( key );
+        
+        for( size_t i = 0; trackGroups != nullptr && i < trackGroups->GetEntryCount(); i++ )
+        {
+            this->_keys.push_back( ReadKey( trackGroups->GetEntryData( i ), trackGroups->GetEntrySize( i ) ) );
+        }
+        
+        for( size_t i = 0; localGroups != nullptr && i < localGroups->GetEntryCount(); i++ )
+        {
+            this->_keys.push_back( ReadKey( localGroups->GetEntryData( i ), localGroups->GetEntrySize( i ) ) );
+        }
+        
+        for( const auto & box: container.GetBoxes( "sbgp" ) )
+        {
+            std::shared_ptr< SBGP > group( std::dynamic_pointer_cast< SBGP >( box ) );
+            
+            if( group != nullptr && group->GetGroupingType() == "seig" )
+            {
+                sbgp = group;
+                
+                break;
+            }
+        }
+        
+        this->_sampleKeys.resize( count, 0 );
+        
+        sample = 0;
+        
+        for( size_t i = 0; sbgp != nullptr && i < sbgp->GetEntryCount() && sample < count; i++ )
+        {
+            uint32_t index( sbgp->GetGroupDescriptionIndex( i ) );
+            size_t   trackCount( ( trackGroups == nullptr ) ? 0 : trackGroups->GetEntryCount() );
+            size_t   localCount( ( localGroups == nullptr ) ? 0 : localGroups->GetEntryCount() );
+            uint32_t keyIndex;
+            
+            if( index == 0 )
+            {
+                keyIndex = 0;
+            }
+            else if( fragment && index > 0x10000 && index - 0x10000 <= localCount )
+            {
+                keyIndex = static_cast< uint32_t >( 1 + trackCount + ( index - 0x10001 ) );
+            }
+            else if( index <= trackCount )
+            {
+                keyIndex = index;
+            }
+            else
+            {
+                throw std::runtime_error( "Invalid 'seig' group description index" );
+            }
+            
+            for( uint32_t j = 0; j < sbgp->GetSampleCount( i ) && sample < count; j++ )
+            {
+                this->_sampleKeys[ sample++ ] = keyIndex;
+            }
+        }
+        
+        this->_ivOffsets.reserve( count + 1 );
+        this->_subsampleOffsets.reserve( count + 1 );
+    }
+    
+    void EncryptionIndex::IMPL::LoadAuxInfo( const Container & container, BinaryStream & stream, uint64_t baseOffset )
+    {
+        std::shared_ptr< SAIZ > saiz( container.GetTypedBox< SAIZ >( "saiz" ) );
+        std::shared_ptr< SAIO > saio( container.GetTypedBox< SAIO >( "saio" ) );
+        std::vector< uint64_t > runs;
+        size_t                  sample;
+        
+        if( saio == nullptr || saio->GetEntryCount() == 0 )
+        {
+            throw std::runtime_error( "Missing SAIO box" );
+        }
+        
+        if( saio->GetEntryCount() == 1 )
+        {
+            runs.push_back( saiz->GetSampleCount() );
+        }
+        else if( container.GetBox( "tfhd" ) != nullptr )
+        {
+            for( const auto & box: container.GetBoxes( "trun" ) )
+            {
+                std::shared_ptr< TRUN > trun( std::dynamic_pointer_cast< TRUN >( box ) );
+                
+                runs.push_back( ( trun == nullptr ) ? 0 : trun->GetSampleCount() );
+            }
+        }
+        else
+        {
+            SampleTable table( container );
+            
+            for( uint64_t i = 0; i < table.GetChunkCount(); i++ )
+            {
+                uint64_t end( ( i + 1 < table.GetChunkCount() ) ? table.GetChunkFirstSample( i + 1 ) : table.GetSampleCount() );
+                
+                runs.push_back( end - table.GetChunkFirstSample( i ) );
+            }
+        }
+        
+        if( runs.size() != saio->GetEntryCount() )
+        {
+            throw std::runtime_error( "SAIO entry count does not match the sample runs" );
+        }
+        
+        sample = 0;
+        
+        for( size_t i = 0; i < runs.size() && sample < this->_sampleKeys.size(); i++ )
+        {
+            uint64_t length( 0 );
+            size_t   end( static_cast< size_t >( std::min< uint64_t >( sample + runs[ i ], this->_sampleKeys.size() ) ) );
+            
+            for( size_t j = sample; j < end; j++ )
+            {
+                length += saiz->GetSampleInfoSize( j );
+            }
+            
+            stream.Seek( baseOffset + saio->GetOffset( i ) );
+            
+            BinaryDataStream run( stream.Read( numeric_cast< size_t >( length ) ) );
+            
+            for( ; sample < end; sample++ )
+            {
+                size_t size(      saiz->GetSampleInfoSize( sample ) );
+                size_t available( run.AvailableBytes() );
+                size_t used;
+                
+                this->AddSample( run, size > this->GetKey( sample )._ivSize );
+                
+                used = available - run.AvailableBytes();
+                
+                if( used > size )
+                {
+                    throw std::runtime_error( "Invalid sample auxiliary information size" );
+                }
+                
+                run.Seek( numeric_cast< std::streamoff >( size - used ), BinaryStream::SeekDirection::Current );
+            }
+        }
+        
+        if( sample != this->_sampleKeys.size() )
+        {
+            throw std::runtime_error( "Missing sample auxiliary information" );
+        }
+    }
+    
+    void EncryptionIndex::IMPL::AddSample( BinaryStream & stream, bool subsamples )
+    {
+        const Key & key( this->GetKey( this->_ivOffsets.size() - 1 ) );
+        
+        if( key._ivSize > 0 )
+        {
+            std::vector< uint8_t > iv( stream.Read( key._ivSize ) );
+            
+            this->_ivs.insert( this->_ivs.end(), iv.begin(), iv.end() );
+        }
+        
+        this->_ivOffsets.push_back( this->_ivs.size() );
+        
+        if( subsamples )
+        {
+            uint16_t count( stream.ReadBigEndianUInt16() );
+            
+            if( count > stream.AvailableBytes() / 6 )
+            {
+                throw std::runtime_error( "Invalid read - Not enough data available" );
+            }
+            
+            for( uint16_t i = 0; i < count; i++ )
+            {
+                this->_clearBytes.push_back( stream.ReadBigEndianUInt16() );
+                this->_encryptedBytes.push_back( stream.ReadBigEndianUInt32() );
+            }
+        }
+        
+        this->_subsampleOffsets.push_back( this->_clearBytes.size() );
+    }
+    
+    const EncryptionIndex::IMPL::Key & EncryptionIndex::IMPL::GetKey( size_t sample ) const
+    {
+        return this->_keys[ this->_sampleKeys.at( sample ) ];
+    }
+    
+    EncryptionIndex::IMPL::IMPL( const IMPL & o ):
+        _keys( o._keys ),
+        _sampleKeys( o._sampleKeys ),
+        _ivs( o._ivs ),
+        _ivOffsets( o._ivOffsets ),
+        _subsampleOffsets( o._subsampleOffsets ),
+        _clearBytes( o._clearBytes ),
+        _encryptedBytes( o._encryptedBytes )
+    {}
+    
+    EncryptionIndex::IMPL::~IMPL()
+    {}
+}
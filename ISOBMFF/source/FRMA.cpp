@@ -88,6 +88,16 @@ namespace ISOBMFF
         this->SetDataFormat( stream.ReadFourCC() );
     }
     
+    uint64_t FRMA::GetDataSize() const
+    {
+        return 4;
+    }
+    
+    void FRMA::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteFourCC( this->GetDataFormat() );
+    }
+    
     std::vector< std::pair< std::string, std::string > > FRMA::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
@@ -105,6 +115,7 @@ namespace ISOBMFF
     void FRMA::SetDataFormat( const std::string & value )
     {
         this->impl->_dataFormat = value;
+        this->SetModified( true );
     }
     
     FRMA::IMPL::IMPL()
@@ -103,6 +103,22 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t FTYP::GetDataSize() const
+    {
+        return 8 + this->impl->_compatibleBrands.size() * 4;
+    }
+    
+    void FTYP::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteFourCC( this->GetMajorBrand() );
+        stream.WriteBigEndianUInt32( this->GetMinorVersion() );
+        
+        for( const auto & brand: this->GetCompatibleBrands() )
+        {
+            stream.WriteFourCC( brand );
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > FTYP::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
@@ -132,21 +148,25 @@ namespace ISOBMFF
     void FTYP::SetMajorBrand( const std::string & value )
     {
         this->impl->_majorBrand = value;
+        this->SetModified( true );
     }
     
     void FTYP::SetMinorVersion( uint32_t value )
     {
         this->impl->_minorVersion = value;
+        this->SetModified( true );
     }
     
     void FTYP::SetCompatibleBrands( const std::vector< std::string > & value )
     {
         this->impl->_compatibleBrands = value;
+        this->SetModified( true );
     }
     
     void FTYP::AddCompatibleBrand( const std::string & value )
     {
         this->impl->_compatibleBrands.push_back( value );
+        this->SetModified( true );
     }
     
     FTYP::IMPL::IMPL():
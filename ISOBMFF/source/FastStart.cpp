@@ -0,0 +1,619 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        FastStart.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/FastStart.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/File.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/STCO.hpp>
+#include <ISOBMFF/CO64.hpp>
+#include <ISOBMFF/ILOC.hpp>
+#include <ISOBMFF/BinaryFileStream.hpp>
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+#include <ISOBMFF/BinaryFileOutputStream.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/sendfile.h>
+#endif
+
+namespace ISOBMFF
+{
+    class FastStart::IMPL
+    {
+        public:
+            
+            struct ChunkOffsets
+            {
+                std::shared_ptr< ContainerBox > _stbl;
+                std::shared_ptr< Box >          _box;
+                std::vector< uint64_t >         _offsets;
+            };
+            
+            struct ItemLocations
+            {
+                std::shared_ptr< ILOC >                  _iloc;
+                uint8_t                                  _offsetSize;
+                uint8_t                                  _baseOffsetSize;
+                std::vector< uint64_t >                  _baseOffsets;
+                std::vector< std::vector< uint64_t > >   _extentOffsets;
+            };
+            
+            struct Piece
+            {
+                uint64_t               _offset;
+                uint64_t               _size;
+                std::vector< uint8_t > _data;
+            };
+            
+            IMPL( const std::string & path );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::shared_ptr< File > Parse() const;
+            
+            static void     FindBoxes( const Container & container, const std::string & name, std::vector< std::shared_ptr< Box > > & boxes );
+            static uint64_t Relocate( const std::vector< std::shared_ptr< Box > > & boxes, const std::map< std::shared_ptr< Box >, uint64_t > & layout, uint64_t offset );
+            static void     Relocate( ChunkOffsets & offsets, const std::vector< std::shared_ptr< Box > > & boxes, const std::map< std::shared_ptr< Box >, uint64_t > & layout );
+            static void     Relocate( ItemLocations & locations, const std::vector< std::shared_ptr< Box > > & boxes, const std::map< std::shared_ptr< Box >, uint64_t > & layout );
+            static void     Output( const std::string & input, const std::string & output, const std::vector< Piece > & pieces );
+            
+            std::string             _path;
+            std::shared_ptr< File > _file;
+    };
+    
+    FastStart::FastStart( const std::string & path ):
+        impl( std::make_unique< IMPL >( path ) )
+    {}
+    
+    FastStart::FastStart( const FastStart & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    FastStart::FastStart( FastStart && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    FastStart::~FastStart()
+    {}
+    
+    FastStart & FastStart::operator =( FastStart o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( FastStart & o1, FastStart & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    std::string FastStart::GetPath() const
+    {
+        return this->impl->_path;
+    }
+    
+    bool FastStart::IsRequired() const
+    {
+        for( const auto & box: this->impl->_file->GetBoxes() )
+        {
+            if( box->GetName() == "moov" )
+            {
+                return false;
+            }
+            
+            if( box->GetName() == "mdat" )
+            {
+                return this->impl->_file->GetBox( "moov" ) != nullptr;
+            }
+        }
+        
+        return false;
+    }
+    
+    void FastStart::Write( const std::string & path ) const
+    {
+        std::shared_ptr< File >                       file;
+        std::shared_ptr< Box >                        moov;
+        std::vector< std::shared_ptr< Box > >         boxes;
+        std::vector< std::shared_ptr< Box > >         order;
+        std::vector< std::shared_ptr< Box > >         found;
+        std::vector< IMPL::ChunkOffsets >             chunkOffsets;
+        std::vector< IMPL::ItemLocations >            itemLocations;
+        std::map< std::shared_ptr< Box >, uint64_t >  layout;
+        std::map< std::shared_ptr< Box >, uint64_t >  sizes;
+        std::vector< IMPL::Piece >                    pieces;
+        bool                                          stable;
+        
+        if( path == this->impl->_path )
+        {
+            throw std::runtime_error( "Cannot write to the source file: " + path );
+        }
+        
+        /* The tree is modified, so it is parsed again for each write */
+        file  = this->impl->Parse();
+        boxes = file->GetBoxes();
+        moov  = file->GetBox( "moov" );
+        
+        if( moov == nullptr )
+        {
+            throw std::runtime_error( "Cannot remux - No MOOV box" );
+        }
+        
+        if( file->GetBox( "moof" ) != nullptr )
+        {
+            throw std::runtime_error( "Cannot remux - Fragmented files are not supported" );
+        }
+        
+        for( const auto & box: boxes )
+        {
+            if( box == moov )
+            {
+                continue;
+            }
+            
+            if( box->GetName() == "mdat" && std::find( order.begin(), order.end(), moov ) == order.end() )
+            {
+                order.push_back( moov );
+            }
+            
+            order.push_back( box );
+        }
+        
+        if( std::find( order.begin(), order.end(), moov ) == order.end() )
+        {
+            order.push_back( moov );
+        }
+        
+        for( const auto & trak: std::dynamic_pointer_cast< Container >( moov )->GetBoxes( "trak" ) )
+        {
+            std::shared_ptr< ContainerBox > mdia;
+            std::shared_ptr< ContainerBox > minf;
+            std::shared_ptr< ContainerBox > stbl;
+            std::shared_ptr< STCO >         stco;
+            std::shared_ptr< CO64 >         co64;
+            
+            mdia = std::dynamic_pointer_cast< ContainerBox >( trak )->GetTypedBox< ContainerBox >( "mdia" );
+            minf = ( mdia ) ? mdia->GetTypedBox< ContainerBox >( "minf" ) : nullptr;
+            stbl = ( minf ) ? minf->GetTypedBox< ContainerBox >( "stbl" ) : nullptr;
+            
+            if( stbl == nullptr )
+            {
+                continue;
+            }
+            
+            stco = stbl->GetTypedBox< STCO >( "stco" );
+            co64 = stbl->GetTypedBox< CO64 >( "co64" );
+            
+            if( stco != nullptr )
+            {
+                chunkOffsets.push_back( { stbl, stco, std::vector< uint64_t >( stco->GetChunkOffsets().begin(), stco->GetChunkOffsets().end() ) } );
+            }
+            else if( co64 != nullptr )
+            {
+                chunkOffsets.push_back( { stbl, co64, co64->GetChunkOffsets() } );
+            }
+        }
+        
+        IMPL::FindBoxes( *( file ), "iloc", found );
+        
+        for( const auto & box: found )
+        {
+            IMPL::ItemLocations locations;
+            
+            locations._iloc           = std::dynamic_pointer_cast< ILOC >( box );
+            locations._offsetSize     = locations._iloc->GetOffsetSize();
+            locations._baseOffsetSize = locations._iloc->GetBaseOffsetSize();
+            
+            for( const auto & item: locations._iloc->GetItems() )
+            {
+                std::vector< uint64_t > offsets;
+                
+                for( const auto & extent: item->GetExtents() )
+                {
+                    offsets.push_back( extent->GetOffset() );
+                }
+                
+                locations._baseOffsets.push_back( item->GetBaseOffset() );
+                locations._extentOffsets.push_back( offsets );
+            }
+            
+            itemLocations.push_back( locations );
+        }
+        
+        /*
+         * Relocated offsets may change the size of modified boxes (STCO
+         * promotion, wider ILOC fields), which changes the layout. Sizes
+         * only grow, so this converges.
+         */
+        do
+        {
+            uint64_t offset;
+            
+            offset = 0;
+            
+            for( const auto & box: order )
+            {
+                layout[ box ] = offset;
+                offset       += box->GetSerializedSize();
+            }
+            
+            for( auto & offsets: chunkOffsets )
+            {
+                IMPL::Relocate( offsets, boxes, layout );
+            }
+            
+            for( auto & locations: itemLocations )
+            {
+                IMPL::Relocate( locations, boxes, layout );
+            }
+            
+            stable = true;
+            
+            for( const auto & box: order )
+            {
+                uint64_t size;
+                
+                size = box->GetSerializedSize();
+                
+                if( sizes[ box ] != size )
+                {
+                    stable = false;
+                }
+                
+                sizes[ box ] = size;
+            }
+        }
+        while( stable == false );
+        
+        {
+            BinaryFileStream source( this->impl->_path );
+            
+            for( const auto & box: order )
+            {
+                if( box->IsModified() )
+                {
+                    BinaryDataOutputStream output;
+                    
+                    output.SetSource( &source );
+                    box->Write( output );
+                    
+                    pieces.push_back( { 0, 0, output.GetData() } );
+                }
+                else
+                {
+                    pieces.push_back( { box->GetSourceOffset(), box->GetSourceSize(), {} } );
+                }
+            }
+        }
+        
+        IMPL::Output( this->impl->_path, path, pieces );
+    }
+    
+    FastStart::IMPL::IMPL( const std::string & path ):
+        _path( path ),
+        _file( this->Parse() )
+    {}
+    
+    FastStart::IMPL::IMPL( const IMPL & o ):
+        _path( o._path ),
+        _file( o._file )
+    {}
+    
+    FastStart::IMPL::~IMPL()
+    {}
+    
+    std::shared_ptr< File > FastStart::IMPL::Parse() const
+    {
+        Parser parser;
+        
+        parser.AddOption( Parser::Options::SkipMDATData );
+        parser.Parse( this->_path );
+        
+        return parser.GetFile();
+    }
+    
+    void FastStart::IMPL::FindBoxes( const Container & container, const std::string & name, std::vector< std::shared_ptr< Box > > & boxes )
+    {
+        for( const auto & box: container.GetBoxes() )
+        {
+            std::shared_ptr< Container > c;
+            
+            if( box->GetName() == name )
+            {
+                boxes.push_back( box );
+            }
+            
+            c = std::dynamic_pointer_cast< Container >( box );
+            
+            if( c != nullptr )
+            {
+                FindBoxes( *( c ), name, boxes );
+            }
+        }
+    }
+    
+    uint64_t FastStart::IMPL::Relocate( const std::vector< std::shared_ptr< Box > > & boxes, const std::map< std::shared_ptr< Box >, uint64_t > & layout, uint64_t offset )
+    {
+        for( const auto & box: boxes )
+        {
+            if( offset < box->GetSourceOffset() || offset >= box->GetSourceOffset() + box->GetSourceSize() )
+            {
+                continue;
+            }
+            
+            if( box->IsModified() )
+            {
+                break;
+            }
+            
+            return layout.at( box ) + ( offset - box->GetSourceOffset() );
+        }
+        
+        throw std::runtime_error( "Cannot remux - Cannot relocate offset " + std::to_string( offset ) );
+    }
+    
+    void FastStart::IMPL::Relocate( ChunkOffsets & offsets, const std::vector< std::shared_ptr< Box > > & boxes, const std::map< std::shared_ptr< Box >, uint64_t > & layout )
+    {
+        std::vector< uint64_t > values;
+        std::shared_ptr< STCO > stco;
+        std::shared_ptr< CO64 > co64;
+        bool                    large;
+        
+        large = false;
+        
+        for( uint64_t offset: offsets._offsets )
+        {
+            values.push_back( Relocate( boxes, layout, offset ) );
+            
+            large = large || values.back() > ( std::numeric_limits< uint32_t >::max )();
+        }
+        
+        stco = std::dynamic_pointer_cast< STCO >( offsets._box );
+        co64 = std::dynamic_pointer_cast< CO64 >( offsets._box );
+        
+        if( stco != nullptr && large == false )
+        {
+            stco->SetChunkOffsets( std::vector< uint32_t >( values.begin(), values.end() ) );
+            
+            return;
+        }
+        
+        if( co64 == nullptr )
+        {
+            co64 = std::make_shared< CO64 >();
+            
+            offsets._stbl->ReplaceBox( offsets._box, co64 );
+            
+            offsets._box = co64;
+        }
+        
+        co64->SetChunkOffsets( values );
+    }
+    
+    void FastStart::IMPL::Relocate( ItemLocations & locations, const std::vector< std::shared_ptr< Box > > & boxes, const std::map< std::shared_ptr< Box >, uint64_t > & layout )
+    {
+        std::vector< std::shared_ptr< ILOC::Item > > items;
+        uint8_t                                      offsetSize;
+        uint8_t                                      baseOffsetSize;
+        
+        items          = locations._iloc->GetItems();
+        offsetSize     = locations._offsetSize;
+        baseOffsetSize = locations._baseOffsetSize;
+        
+        for( size_t i = 0; i < items.size(); i++ )
+        {
+            std::vector< std::shared_ptr< ILOC::Item::Extent > > extents;
+            uint64_t                                             base;
+            uint64_t                                             newBase;
+            
+            /* Only data stored in this file, at absolute offsets, moves */
+            if( items[ i ]->GetConstructionMethod() != 0 || items[ i ]->GetDataReferenceIndex() != 0 )
+            {
+                continue;
+            }
+            
+            extents = items[ i ]->GetExtents();
+            base    = locations._baseOffsets[ i ];
+            newBase = ( base == 0 ) ? 0 : Relocate( boxes, layout, base );
+            
+            items[ i ]->SetBaseOffset( newBase );
+            
+            if( newBase > ( std::numeric_limits< uint32_t >::max )() )
+            {
+                baseOffsetSize = 8;
+            }
+            
+            for( size_t j = 0; j < extents.size(); j++ )
+            {
+                uint64_t offset;
+                
+                offset = Relocate( boxes, layout, base + locations._extentOffsets[ i ][ j ] ) - newBase;
+                
+                extents[ j ]->SetOffset( offset );
+                
+                if( offset > ( std::numeric_limits< uint32_t >::max )() )
+                {
+                    offsetSize = 8;
+                }
+                else if( offset != 0 && offsetSize == 0 )
+                {
+                    offsetSize = 4;
+                }
+            }
+        }
+        
+        locations._iloc->SetOffsetSize( offsetSize );
+        locations._iloc->SetBaseOffsetSize( baseOffsetSize );
+        locations._iloc->SetModified( true );
+    }
+    
+    void FastStart::IMPL::Output( const std::string & input, const std::string & output, const std::vector< Piece > & pieces )
+    {
+        #ifdef __linux__
+        
+        int in;
+        int out;
+        
+        in  = open( input.c_str(), O_RDONLY );
+        out = open( output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+        
+        try
+        {
+            if( in < 0 )
+            {
+                throw std::runtime_error( "Cannot open file: " + input );
+            }
+            
+            if( out < 0 )
+            {
+                throw std::runtime_error( "Cannot open file for writing: " + output );
+            }
+            
+            for( const auto & piece: pieces )
+            {
+                const uint8_t * data;
+                size_t          size;
+                off_t           offset;
+                uint64_t        remaining;
+                
+                data = piece._data.data();
+                size = piece._data.size();
+                
+                while( size > 0 )
+                {
+                    ssize_t n;
+                    
+                    n = write( out, data, size );
+                    
+                    if( n <= 0 )
+                    {
+                        throw std::runtime_error( "Invalid write - Cannot write to file" );
+                    }
+                    
+                    data += n;
+                    size -= static_cast< size_t >( n );
+                }
+                
+                offset    = numeric_cast< off_t >( piece._offset );
+                remaining = piece._size;
+                
+                /* Kernel copies first, user space as a last resort */
+                while( remaining > 0 )
+                {
+                    ssize_t n;
+                    size_t  length;
+                    
+                    length = static_cast< size_t >( std::min< uint64_t >( remaining, 1 << 30 ) );
+                    n      = copy_file_range( in, &offset, out, nullptr, length, 0 );
+                    
+                    if( n < 0 && ( errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP ) )
+                    {
+                        n = sendfile( out, in, &offset, length );
+                    }
+                    
+                    if( n < 0 && ( errno == ENOSYS || errno == EINVAL ) )
+                    {
+                        std::vector< uint8_t > buffer( std::min< size_t >( length, 1024 * 1024 ) );
+                        
+                        n = pread( in, buffer.data(), buffer.size(), offset );
+                        
+                        if( n > 0 && write( out, buffer.data(), static_cast< size_t >( n ) ) != n )
+                        {
+                            n = -1;
+                        }
+                        
+                        if( n > 0 )
+                        {
+                            offset += n;
+                        }
+                    }
+                    
+                    if( n <= 0 )
+                    {
+                        throw std::runtime_error( "Invalid write - Cannot copy from " + input );
+                    }
+                    
+                    remaining -= static_cast< uint64_t >( n );
+                }
+            }
+            
+            if( close( out ) != 0 )
+            {
+                out = -1;
+                
+                throw std::runtime_error( "Invalid write - Cannot write to file" );
+            }
+            
+            close( in );
+        }
+        catch( ... )
+        {
+            if( in >= 0 )
+            {
+                close( in );
+            }
+            
+            if( out >= 0 )
+            {
+                close( out );
+            }
+            
+            throw;
+        }
+
+        #else
+        
+        BinaryFileStream       source( input );
+        BinaryFileOutputStream stream( output );
+        
+        for( const auto & piece: pieces )
+        {
+            stream.Write( piece._data );
+            stream.Copy( source, piece._offset, piece._size );
+        }
+        
+        stream.Flush();
+
+        #endif
+    }
+}
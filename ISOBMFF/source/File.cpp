@@ -82,6 +82,33 @@ namespace ISOBMFF
         return "ISOBMFF::File";
     }
     
+    uint64_t File::GetSerializedSize() const
+    {
+        return this->GetDataSize();
+    }
+    
+    void File::Write( BinaryOutputStream & stream ) const
+    {
+        if( stream.GetSource() == nullptr )
+        {
+            this->SetEncode( true );
+        }
+        
+        try
+        {
+            this->GetSerializedSize();
+            this->WriteData( stream );
+        }
+        catch( ... )
+        {
+            this->SetEncode( false );
+            
+            throw;
+        }
+        
+        this->SetEncode( false );
+    }
+    
     File::IMPL::IMPL()
     {}
 
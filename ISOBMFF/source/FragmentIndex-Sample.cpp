@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        FragmentIndex-Sample.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/FragmentIndex.hpp>
+
+namespace ISOBMFF
+{
+    class FragmentIndex::Sample::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            size_t   _fragment;
+            uint64_t _offset;
+            uint32_t _size;
+            uint64_t _decodeTime;
+            int64_t  _compositionTime;
+            uint32_t _duration;
+            uint32_t _flags;
+            uint32_t _sampleDescriptionIndex;
+    };
+    
+    FragmentIndex::Sample::Sample():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    FragmentIndex::Sample::Sample( const Sample & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    FragmentIndex::Sample::Sample( Sample && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    FragmentIndex::Sample::~Sample()
+    {}
+    
+    FragmentIndex::Sample & FragmentIndex::Sample::operator =( Sample o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( FragmentIndex::Sample & o1, FragmentIndex::Sample & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    size_t FragmentIndex::Sample::GetFragment() const
+    {
+        return this->impl->_fragment;
+    }
+    
+    uint64_t FragmentIndex::Sample::GetOffset() const
+    {
+        return this->impl->_offset;
+    }
+    
+    uint32_t FragmentIndex::Sample::GetSize() const
+    {
+        return this->impl->_size;
+    }
+    
+    uint64_t FragmentIndex::Sample::GetDecodeTime() const
+    {
+        return this->impl->_decodeTime;
+    }
+    
+    int64_t FragmentIndex::Sample::GetCompositionTime() const
+    {
+        return this->impl->_compositionTime;
+    }
+    
+    uint32_t FragmentIndex::Sample::GetDuration() const
+    {
+        return this->impl->_duration;
+    }
+    
+    uint32_t FragmentIndex::Sample::GetFlags() const
+    {
+        return this->impl->_flags;
+    }
+    
+    uint32_t FragmentIndex::Sample::GetSampleDescriptionIndex() const
+    {
+        return this->impl->_sampleDescriptionIndex;
+    }
+    
+    bool FragmentIndex::Sample::IsSync() const
+    {
+        /*
+         * sample_is_non_sync_sample, in the sample flags (ISO/IEC 14496-12 8.8.3.1).
+         */
+        return ( this->impl->_flags & 0x00010000 ) == 0;
+    }
+    
+    void FragmentIndex::Sample::SetFragment( size_t value )
+    {
+        this->impl->_fragment = value;
+    }
+    
+    void FragmentIndex::Sample::SetOffset( uint64_t value )
+    {
+        this->impl->_offset = value;
+    }
+    
+    void FragmentIndex::Sample::SetSize( uint32_t value )
+    {
+        this->impl->_size = value;
+    }
+    
+    void FragmentIndex::Sample::SetDecodeTime( uint64_t value )
+    {
+        this->impl->_decodeTime = value;
+    }
+    
+    void FragmentIndex::Sample::SetCompositionTime( int64_t value )
+    {
+        this->impl->_compositionTime = value;
+    }
+    
+    void FragmentIndex::Sample::SetDuration( uint32_t value )
+    {
+        this->impl->_duration = value;
+    }
+    
+    void FragmentIndex::Sample::SetFlags( uint32_t value )
+    {
+        this->impl->_flags = value;
+    }
+    
+    void FragmentIndex::Sample::SetSampleDescriptionIndex( uint32_t value )
+    {
+        this->impl->_sampleDescriptionIndex = value;
+    }
+    
+    FragmentIndex::Sample::IMPL::IMPL():
+        _fragment( 0 ),
+        _offset( 0 ),
+        _size( 0 ),
+        _decodeTime( 0 ),
+        _compositionTime( 0 ),
+        _duration( 0 ),
+        _flags( 0 ),
+        _sampleDescriptionIndex( 0 )
+    {}
+    
+    FragmentIndex::Sample::IMPL::IMPL( const IMPL & o ):
+        _fragment( o._fragment ),
+        _offset( o._offset ),
+        _size( o._size ),
+        _decodeTime( o._decodeTime ),
+        _compositionTime( o._compositionTime ),
+        _duration( o._duration ),
+        _flags( o._flags ),
+        _sampleDescriptionIndex( o._sampleDescriptionIndex )
+    {}
+    
+    FragmentIndex::Sample::IMPL::~IMPL()
+    {}
+}
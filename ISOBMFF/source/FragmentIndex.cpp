@@ -0,0 +1,502 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        FragmentIndex.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/FragmentIndex.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/Container.hpp>
+#include <ISOBMFF/MFHD.hpp>
+#include <ISOBMFF/TFHD.hpp>
+#include <ISOBMFF/TFDT.hpp>
+#include <ISOBMFF/TRUN.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <stdexcept>
+#include <map>
+
+namespace ISOBMFF
+{
+    class FragmentIndex::IMPL
+    {
+        public:
+            
+            struct Run
+            {
+                size_t                  _fragment;
+                std::shared_ptr< TRUN > _trun;
+                uint64_t                _firstSample;
+                uint64_t                _decodeTime;
+                uint64_t                _offset;
+                uint32_t                _sampleDescriptionIndex;
+                uint32_t                _defaultDuration;
+                uint32_t                _defaultSize;
+                uint32_t                _defaultFlags;
+            };
+            
+            struct Track
+            {
+                std::vector< Run > _runs;
+                uint64_t           _sampleCount;
+                uint64_t           _decodeTime;
+            };
+            
+            IMPL( BinaryStream & stream );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void          AddFragment( const Container & moof, uint64_t offset, uint64_t size );
+            const Track & GetTrack( uint32_t trackID ) const;
+            
+            static uint32_t GetDuration( const Run & run, size_t index );
+            static uint32_t GetSize( const Run & run, size_t index );
+            static uint32_t GetFlags( const Run & run, size_t index );
+            
+            std::vector< uint64_t >                        _offsets;
+            std::vector< uint64_t >                        _sizes;
+            std::vector< uint32_t >                        _sequenceNumbers;
+            std::map< uint32_t, std::shared_ptr< TREX > >  _trex;
+            std::map< uint32_t, Track >                    _tracks;
+    };
+    
+    FragmentIndex::FragmentIndex( BinaryStream & stream ):
+        impl( std::make_unique< IMPL >( stream ) )
+    {}
+    
+    FragmentIndex::FragmentIndex( const FragmentIndex & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    FragmentIndex::FragmentIndex( FragmentIndex && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    FragmentIndex::~FragmentIndex()
+    {}
+    
+    FragmentIndex & FragmentIndex::operator =( FragmentIndex o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( FragmentIndex & o1, FragmentIndex & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    size_t FragmentIndex::GetFragmentCount() const
+    {
+        return this->impl->_offsets.size();
+    }
+    
+    uint64_t FragmentIndex::GetFragmentOffset( size_t fragment ) const
+    {
+        return this->impl->_offsets[ fragment ];
+    }
+    
+    uint64_t FragmentIndex::GetFragmentSize( size_t fragment ) const
+    {
+        return this->impl->_sizes[ fragment ];
+    }
+    
+    uint32_t FragmentIndex::GetSequenceNumber( size_t fragment ) const
+    {
+        return this->impl->_sequenceNumbers[ fragment ];
+    }
+    
+    std::vector< uint32_t > FragmentIndex::GetTrackIDs() const
+    {
+        std::vector< uint32_t > ids;
+        
+        for( const auto & p: this->impl->_tracks )
+        {
+            ids.push_back( p.first );
+        }
+        
+        return ids;
+    }
+    
+    std::shared_ptr< TREX > FragmentIndex::GetTREX( uint32_t trackID ) const
+    {
+        auto it( this->impl->_trex.find( trackID ) );
+        
+        return ( it == this->impl->_trex.end() ) ? nullptr : it->second;
+    }
+    
+    uint64_t FragmentIndex::GetSampleCount( uint32_t trackID ) const
+    {
+        auto it( this->impl->_tracks.find( trackID ) );
+        
+        return ( it == this->impl->_tracks.end() ) ? 0 : it->second._sampleCount;
+    }
+    
+    uint64_t FragmentIndex::GetSampleAtTime( uint32_t trackID, uint64_t time ) const
+    {
+        const IMPL::Track & track( this->impl->GetTrack( trackID ) );
+        size_t              index;
+        uint64_t            t;
+        
+        if( track._sampleCount == 0 )
+        {
+            throw std::runtime_error( "No samples" );
+        }
+        
+        index = static_cast< size_t >
+        (
+            std::upper_bound
+            (
+                track._runs.begin(),
+                track._runs.end(),
+                time,
+                []( uint64_t value, const IMPL::Run & run ) -> bool
+                {
+                    return value < run._decodeTime;
+                }
+            )
+            - track._runs.begin()
+        );
+        
+        index = ( index == 0 ) ? 0 : index - 1;
+        
+        /*
+         * Runs may be empty, but a run holding the last sample always
+         * exists, so move back to a non-empty run.
+         */
+        while( index > 0 && track._runs[ index ]._trun->GetSampleCount() == 0 )
+        {
+            index--;
+        }
+        
+        const IMPL::Run & run( track._runs[ index ] );
+        
+        t = run._decodeTime;
+        
+        for( size_t i = 0; i < run._trun->GetSampleCount(); i++ )
+        {
+            t += IMPL::GetDuration( run, i );
+            
+            if( t > time )
+            {
+                return run._firstSample + i;
+            }
+        }
+        
+        return ( run._trun->GetSampleCount() == 0 ) ? run._firstSample : run._firstSample + run._trun->GetSampleCount() - 1;
+    }
+    
+    size_t FragmentIndex::GetFragmentAtTime( uint32_t trackID, uint64_t time ) const
+    {
+        return this->GetSample( trackID, this->GetSampleAtTime( trackID, time ) ).GetFragment();
+    }
+    
+    FragmentIndex::Sample FragmentIndex::GetSample( uint32_t trackID, uint64_t sample ) const
+    {
+        const IMPL::Track & track( this->impl->GetTrack( trackID ) );
+        size_t              index;
+        uint64_t            offset;
+        uint64_t            time;
+        size_t              n;
+        Sample              s;
+        
+        if( sample >= track._sampleCount )
+        {
+            throw std::runtime_error( "Invalid sample index" );
+        }
+        
+        index = static_cast< size_t >
+        (
+            std::upper_bound
+            (
+                track._runs.begin(),
+                track._runs.end(),
+                sample,
+                []( uint64_t value, const IMPL::Run & run ) -> bool
+                {
+                    return value < run._firstSample;
+                }
+            )
+            - track._runs.begin()
+        ) - 1;
+        
+        /*
+         * Empty runs share their first sample with the next run, so the
+         * last run starting at or before the sample holds it.
+         */
+        const IMPL::Run & run( track._runs[ index ] );
+        
+        n      = static_cast< size_t >( sample - run._firstSample );
+        offset = run._offset;
+        time   = run._decodeTime;
+        
+        for( size_t i = 0; i < n; i++ )
+        {
+            offset += IMPL::GetSize( run, i );
+            time   += IMPL::GetDuration( run, i );
+        }
+        
+        s.SetFragment( run._fragment );
+        s.SetOffset( offset );
+        s.SetSize( IMPL::GetSize( run, n ) );
+        s.SetDecodeTime( time );
+        s.SetCompositionTime( static_cast< int64_t >( time ) + ( ( run._trun->HasSampleCompositionTimeOffset() ) ? run._trun->GetSampleCompositionTimeOffset( n ) : 0 ) );
+        s.SetDuration( IMPL::GetDuration( run, n ) );
+        s.SetFlags( IMPL::GetFlags( run, n ) );
+        s.SetSampleDescriptionIndex( run._sampleDescriptionIndex );
+        
+        return s;
+    }
+    
+    FragmentIndex::IMPL::IMPL( BinaryStream & stream )
+    {
+        Parser                 parser;
+        uint64_t               available;
+        uint64_t               offset;
+        uint64_t               length;
+        uint64_t               header;
+        std::string            name;
+        std::shared_ptr< Box > box;
+        
+        stream.Seek( 0, BinaryStream::SeekDirection::Begin );
+        
+        /*
+         * Only top-level box headers are read, skipping everything but the
+         * MOOV and MOOF boxes.
+         */
+        while( stream.AvailableBytes() >= 8 )
+        {
+            offset    = stream.Tell();
+            available = stream.AvailableBytes();
+            length    = stream.ReadBigEndianUInt32();
+            name      = stream.ReadFourCC();
+            header    = 8;
+            
+            if( length == 1 )
+            {
+                length = stream.ReadBigEndianUInt64();
+                header = 16;
+            }
+            else if( length == 0 )
+            {
+                length = available;
+            }
+            
+            if( length < header || length > available )
+            {
+                throw std::runtime_error( "Invalid box size: " + name );
+            }
+            
+            if( name != "moov" && name != "moof" )
+            {
+                stream.Seek( numeric_cast< std::streamoff >( length - header ), BinaryStream::SeekDirection::Current );
+                
+                continue;
+            }
+            
+            BinaryDataStream content( stream.Read( numeric_cast< size_t >( length - header ) ) );
+            
+            box = parser.CreateBox( name );
+            
+            box->ReadData( parser, content );
+            
+            std::shared_ptr< Container > container( std::dynamic_pointer_cast< Container >( box ) );
+            
+            if( container == nullptr )
+            {
+                continue;
+            }
+            
+            if( name == "moof" )
+            {
+                this->AddFragment( *( container ), offset, length );
+                
+                continue;
+            }
+            
+            std::shared_ptr< Container > mvex( container->GetTypedBox< Container >( "mvex" ) );
+            
+            if( mvex == nullptr )
+            {
+                continue;
+            }
+            
+            for( const auto & b: mvex->GetBoxes( "trex" ) )
+            {
+                std::shared_ptr< TREX > trex( std::dynamic_pointer_cast< TREX >( b ) );
+                
+                if( trex != nullptr )
+                {
+                    this->_trex[ trex->GetTrackID() ] = trex;
+                    
+                    this->_tracks.insert( { trex->GetTrackID(), Track() } );
+                }
+            }
+        }
+    }
+    
+    FragmentIndex::IMPL::IMPL( const IMPL & o ):
+        _offsets( o._offsets ),
+        _sizes( o._sizes ),
+        _sequenceNumbers( o._sequenceNumbers ),
+        _trex( o._trex ),
+        _tracks( o._tracks )
+    {}
+    
+    FragmentIndex::IMPL::~IMPL()
+    {}
+    
+    void FragmentIndex::IMPL::AddFragment( const Container & moof, uint64_t offset, uint64_t size )
+    {
+        std::shared_ptr< MFHD > mfhd( moof.GetTypedBox< MFHD >( "mfhd" ) );
+        size_t                  fragment( this->_offsets.size() );
+        uint64_t                end( offset );
+        bool                    first( true );
+        
+        this->_offsets.push_back( offset );
+        this->_sizes.push_back( size );
+        this->_sequenceNumbers.push_back( ( mfhd == nullptr ) ? 0 : mfhd->GetSequenceNumber() );
+        
+        for( const auto & box: moof.GetBoxes( "traf" ) )
+        {
+            std::shared_ptr< Container > traf( std::dynamic_pointer_cast< Container >( box ) );
+            std::shared_ptr< TFHD >      tfhd( ( traf == nullptr ) ? nullptr : traf->GetTypedBox< TFHD >( "tfhd" ) );
+            std::shared_ptr< TFDT >      tfdt;
+            std::shared_ptr< TREX >      trex;
+            uint64_t                     base;
+            bool                         firstRun;
+            
+            if( tfhd == nullptr )
+            {
+                continue;
+            }
+            
+            tfdt = traf->GetTypedBox< TFDT >( "tfdt" );
+            trex  = ( this->_trex.count( tfhd->GetTrackID() ) > 0 ) ? this->_trex[ tfhd->GetTrackID() ] : nullptr;
+            
+            Track & track( this->_tracks[ tfhd->GetTrackID() ] );
+            
+            /*
+             * Base data offset (ISO/IEC 14496-12 8.8.7.1): explicit, or the
+             * MOOF box for the first track fragment (and for all of them
+             * with default-base-is-moof), or the end of the previous track
+             * fragment's data.
+             */
+            if( tfhd->HasBaseDataOffset() )
+            {
+                base = tfhd->GetBaseDataOffset();
+            }
+            else if( first || tfhd->IsDefaultBaseMOOF() )
+            {
+                base = offset;
+            }
+            else
+            {
+                base = end;
+            }
+            
+            if( tfdt != nullptr )
+            {
+                track._decodeTime = tfdt->GetBaseMediaDecodeTime();
+            }
+            
+            first    = false;
+            firstRun = true;
+            end      = base;
+            
+            for( const auto & b: traf->GetBoxes( "trun" ) )
+            {
+                std::shared_ptr< TRUN > trun( std::dynamic_pointer_cast< TRUN >( b ) );
+                Run                     run;
+                
+                if( trun == nullptr )
+                {
+                    continue;
+                }
+                
+                run._fragment               = fragment;
+                run._trun                   = trun;
+                run._firstSample            = track._sampleCount;
+                run._decodeTime             = track._decodeTime;
+                run._offset                 = ( trun->HasDataOffset() ) ? static_cast< uint64_t >( static_cast< int64_t >( base ) + trun->GetDataOffset() ) : ( firstRun ? base : end );
+                run._sampleDescriptionIndex = ( tfhd->HasSampleDescriptionIndex() ) ? tfhd->GetSampleDescriptionIndex() : ( ( trex == nullptr ) ? 0 : trex->GetDefaultSampleDescriptionIndex() );
+                run._defaultDuration        = ( tfhd->HasDefaultSampleDuration() )   ? tfhd->GetDefaultSampleDuration()  : ( ( trex == nullptr ) ? 0 : trex->GetDefaultSampleDuration() );
+                run._defaultSize            = ( tfhd->HasDefaultSampleSize() )       ? tfhd->GetDefaultSampleSize()      : ( ( trex == nullptr ) ? 0 : trex->GetDefaultSampleSize() );
+                run._defaultFlags           = ( tfhd->HasDefaultSampleFlags() )      ? tfhd->GetDefaultSampleFlags()     : ( ( trex == nullptr ) ? 0 : trex->GetDefaultSampleFlags() );
+                firstRun                    = false;
+                end                         = run._offset;
+                
+                for( size_t i = 0; i < trun->GetSampleCount(); i++ )
+                {
+                    end               += GetSize( run, i );
+                    track._decodeTime += GetDuration( run, i );
+                }
+                
+                track._sampleCount += trun->GetSampleCount();
+                
+                track._runs.push_back( run );
+            }
+        }
+    }
+    
+    const FragmentIndex::IMPL::Track & FragmentIndex::IMPL::GetTrack( uint32_t trackID ) const
+    {
+        auto it( this->_tracks.find( trackID ) );
+        
+        if( it == this->_tracks.end() )
+        {
+            throw std::runtime_error( "Unknown track ID" );
+        }
+        
+        return it->second;
+    }
+    
+    uint32_t FragmentIndex::IMPL::GetDuration( const Run & run, size_t index )
+    {
+        return ( run._trun->HasSampleDuration() ) ? run._trun->GetSampleDuration( index ) : run._defaultDuration;
+    }
+    
+    uint32_t FragmentIndex::IMPL::GetSize( const Run & run, size_t index )
+    {
+        return ( run._trun->HasSampleSize() ) ? run._trun->GetSampleSize( index ) : run._defaultSize;
+    }
+    
+    uint32_t FragmentIndex::IMPL::GetFlags( const Run & run, size_t index )
+    {
+        if( index == 0 && run._trun->HasFirstSampleFlags() )
+        {
+            return run._trun->GetFirstSampleFlags();
+        }
+        
+        return ( run._trun->HasSampleFlags() ) ? run._trun->GetSampleFlags( index ) : run._defaultFlags;
+    }
+}
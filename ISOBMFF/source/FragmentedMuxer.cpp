@@ -0,0 +1,524 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        FragmentedMuxer.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/FragmentedMuxer.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/FTYP.hpp>
+#include <ISOBMFF/MVHD.hpp>
+#include <ISOBMFF/TKHD.hpp>
+#include <ISOBMFF/MDHD.hpp>
+#include <ISOBMFF/HDLR.hpp>
+#include <ISOBMFF/DREF.hpp>
+#include <ISOBMFF/URL.hpp>
+#include <ISOBMFF/STSD.hpp>
+#include <ISOBMFF/STTS.hpp>
+#include <ISOBMFF/STSC.hpp>
+#include <ISOBMFF/STSZ.hpp>
+#include <ISOBMFF/STCO.hpp>
+#include <ISOBMFF/AVC1.hpp>
+#include <ISOBMFF/HVC1.hpp>
+#include <ISOBMFF/TREX.hpp>
+#include <ISOBMFF/MFHD.hpp>
+#include <ISOBMFF/TFHD.hpp>
+#include <ISOBMFF/TFDT.hpp>
+#include <ISOBMFF/TRUN.hpp>
+#include <ISOBMFF/Matrix.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <limits>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class FragmentedMuxer::IMPL
+    {
+        public:
+            
+            struct Sample
+            {
+                uint32_t _duration;
+                uint32_t _size;
+                uint32_t _flags;
+                int32_t  _compositionOffset;
+            };
+            
+            struct Track
+            {
+                uint32_t                        _trackID;
+                std::string                     _handlerType;
+                uint32_t                        _timescale;
+                uint16_t                        _width;
+                uint16_t                        _height;
+                std::shared_ptr< Box >          _sampleEntry;
+                std::vector< Sample >           _samples;
+                std::vector< uint8_t >          _data;
+                uint64_t                        _decodeTime;
+                uint64_t                        _lastDecodeTime;
+                uint64_t                        _endTime;
+                std::shared_ptr< ContainerBox > _traf;
+                std::shared_ptr< TFDT >         _tfdt;
+                std::shared_ptr< TRUN >         _trun;
+            };
+            
+            IMPL( BinaryOutputStream & stream );
+            ~IMPL();
+            
+            Track & GetTrack( uint32_t trackID );
+            
+            std::shared_ptr< ContainerBox > CreateTrack( const Track & track ) const;
+            
+            BinaryOutputStream    & _stream;
+            std::vector< Track >    _tracks;
+            std::shared_ptr< MFHD > _mfhd;
+            uint32_t                _sequenceNumber;
+            bool                    _initialized;
+    };
+    
+    FragmentedMuxer::FragmentedMuxer( BinaryOutputStream & stream ):
+        impl( std::make_unique< IMPL >( stream ) )
+    {}
+    
+    FragmentedMuxer::~FragmentedMuxer()
+    {}
+    
+    uint32_t FragmentedMuxer::AddTrack( const std::string & handlerType, uint32_t timescale, std::shared_ptr< Box > sampleEntry )
+    {
+        IMPL::Track track;
+        
+        if( this->impl->_initialized )
+        {
+            throw std::runtime_error( "Cannot add track - Init segment already written" );
+        }
+        
+        if( sampleEntry == nullptr || timescale == 0 )
+        {
+            throw std::runtime_error( "Cannot add track - Invalid sample entry or timescale" );
+        }
+        
+        track._trackID        = static_cast< uint32_t >( this->impl->_tracks.size() + 1 );
+        track._handlerType    = handlerType;
+        track._timescale      = timescale;
+        track._width          = 0;
+        track._height         = 0;
+        track._sampleEntry    = sampleEntry;
+        track._decodeTime     = 0;
+        track._lastDecodeTime = 0;
+        track._endTime        = 0;
+        track._traf           = std::make_shared< ContainerBox >( "traf" );
+        track._tfdt           = std::make_shared< TFDT >();
+        track._trun           = std::make_shared< TRUN >();
+        
+        {
+            std::shared_ptr< TFHD > tfhd;
+            
+            tfhd = std::make_shared< TFHD >();
+            
+            /* default-base-is-moof */
+            tfhd->SetFlags( 0x020000 );
+            tfhd->SetTrackID( track._trackID );
+            track._tfdt->SetVersion( 1 );
+            track._traf->AddBox( tfhd );
+            track._traf->AddBox( track._tfdt );
+            track._traf->AddBox( track._trun );
+        }
+        
+        this->impl->_tracks.push_back( track );
+        
+        return track._trackID;
+    }
+    
+    uint32_t FragmentedMuxer::AddVideoTrack( const std::string & codec, uint32_t timescale, uint16_t width, uint16_t height, const std::vector< uint8_t > & config )
+    {
+        std::shared_ptr< Box > entry;
+        std::shared_ptr< Box > box;
+        uint32_t               trackID;
+        
+        if( codec == "avc1" )
+        {
+            std::shared_ptr< AVC1 > avc1;
+            
+            avc1 = std::make_shared< AVC1 >();
+            box  = std::make_shared< Box >( "avcC" );
+            
+            avc1->SetDataReferenceIndex( 1 );
+            avc1->SetWidth( width );
+            avc1->SetHeight( height );
+            avc1->SetHorizResolution( 0x00480000 );
+            avc1->SetVertResolution( 0x00480000 );
+            avc1->SetFrameCount( 1 );
+            avc1->SetDepth( 0x18 );
+            avc1->AddBox( box );
+            
+            entry = avc1;
+        }
+        else if( codec == "hvc1" )
+        {
+            std::shared_ptr< HVC1 > hvc1;
+            
+            hvc1 = std::make_shared< HVC1 >();
+            box  = std::make_shared< Box >( "hvcC" );
+            
+            hvc1->SetDataReferenceIndex( 1 );
+            hvc1->SetWidth( width );
+            hvc1->SetHeight( height );
+            hvc1->SetHorizResolution( 0x00480000 );
+            hvc1->SetVertResolution( 0x00480000 );
+            hvc1->SetFrameCount( 1 );
+            hvc1->SetDepth( 0x18 );
+            hvc1->AddBox( box );
+            
+            entry = hvc1;
+        }
+        else
+        {
+            throw std::runtime_error( "Cannot add track - Unsupported codec: " + codec );
+        }
+        
+        box->SetData( config );
+        
+        trackID = this->AddTrack( "vide", timescale, entry );
+        
+        this->impl->_tracks.back()._width  = width;
+        this->impl->_tracks.back()._height = height;
+        
+        return trackID;
+    }
+    
+    void FragmentedMuxer::Reserve( uint32_t trackID, size_t samples, size_t size )
+    {
+        IMPL::Track & track = this->impl->GetTrack( trackID );
+        
+        track._samples.reserve( samples );
+        track._data.reserve( size );
+    }
+    
+    void FragmentedMuxer::AddSample( uint32_t trackID, const uint8_t * data, size_t size, uint64_t decodeTime, uint32_t duration, int32_t compositionOffset, bool sync )
+    {
+        IMPL::Track & track = this->impl->GetTrack( trackID );
+        
+        if( track._samples.size() > 0 )
+        {
+            if( decodeTime <= track._lastDecodeTime )
+            {
+                throw std::runtime_error( "Invalid sample - Decode times must increase" );
+            }
+            
+            track._samples.back()._duration = numeric_cast< uint32_t >( decodeTime - track._lastDecodeTime );
+        }
+        else
+        {
+            if( decodeTime < track._endTime )
+            {
+                throw std::runtime_error( "Invalid sample - Decode times must increase" );
+            }
+            
+            track._decodeTime = decodeTime;
+        }
+        
+        /* Sample flags: depends on no other sample, or non-sync and depends on others */
+        track._samples.push_back( { duration, numeric_cast< uint32_t >( size ), ( sync ) ? 0x02000000U : 0x01010000U, compositionOffset } );
+        track._data.insert( track._data.end(), data, data + size );
+        
+        track._lastDecodeTime = decodeTime;
+        track._endTime        = decodeTime + duration;
+    }
+    
+    uint64_t FragmentedMuxer::GetPendingDuration( uint32_t trackID ) const
+    {
+        IMPL::Track & track = this->impl->GetTrack( trackID );
+        
+        if( track._samples.size() == 0 )
+        {
+            return 0;
+        }
+        
+        return track._endTime - track._decodeTime;
+    }
+    
+    uint32_t FragmentedMuxer::GetSequenceNumber() const
+    {
+        return this->impl->_sequenceNumber;
+    }
+    
+    void FragmentedMuxer::WriteInitSegment()
+    {
+        std::shared_ptr< FTYP >         ftyp;
+        std::shared_ptr< MVHD >         mvhd;
+        std::shared_ptr< ContainerBox > moov;
+        std::shared_ptr< ContainerBox > mvex;
+        
+        if( this->impl->_initialized )
+        {
+            return;
+        }
+        
+        if( this->impl->_tracks.size() == 0 )
+        {
+            throw std::runtime_error( "Cannot write init segment - No tracks" );
+        }
+        
+        ftyp = std::make_shared< FTYP >();
+        mvhd = std::make_shared< MVHD >();
+        moov = std::make_shared< ContainerBox >( "moov" );
+        mvex = std::make_shared< ContainerBox >( "mvex" );
+        
+        ftyp->SetMajorBrand( "iso6" );
+        ftyp->SetMinorVersion( 0 );
+        ftyp->AddCompatibleBrand( "iso6" );
+        ftyp->AddCompatibleBrand( "mp41" );
+        
+        mvhd->SetTimescale( 1000 );
+        mvhd->SetRate( 0x00010000 );
+        mvhd->SetVolume( 0x0100 );
+        mvhd->SetMatrix( Matrix( 0x00010000, 0, 0, 0, 0x00010000, 0, 0, 0, 0x40000000 ) );
+        mvhd->SetNextTrackID( static_cast< uint32_t >( this->impl->_tracks.size() + 1 ) );
+        moov->AddBox( mvhd );
+        
+        for( const auto & track: this->impl->_tracks )
+        {
+            std::shared_ptr< TREX > trex;
+            
+            trex = std::make_shared< TREX >();
+            
+            trex->SetTrackID( track._trackID );
+            trex->SetDefaultSampleDescriptionIndex( 1 );
+            mvex->AddBox( trex );
+            moov->AddBox( this->impl->CreateTrack( track ) );
+        }
+        
+        moov->AddBox( mvex );
+        ftyp->Write( this->impl->_stream );
+        moov->Write( this->impl->_stream );
+        
+        this->impl->_initialized = true;
+    }
+    
+    void FragmentedMuxer::Flush()
+    {
+        std::shared_ptr< ContainerBox > moof;
+        uint64_t                        size;
+        uint64_t                        header;
+        uint64_t                        offset;
+        
+        this->WriteInitSegment();
+        
+        moof = std::make_shared< ContainerBox >( "moof" );
+        size = 0;
+        
+        moof->AddBox( this->impl->_mfhd );
+        
+        for( auto & track: this->impl->_tracks )
+        {
+            bool offsets;
+            
+            if( track._samples.size() == 0 )
+            {
+                continue;
+            }
+            
+            offsets = false;
+            
+            track._trun->ClearSamples();
+            
+            for( const auto & sample: track._samples )
+            {
+                track._trun->AddSample( sample._duration, sample._size, sample._flags, sample._compositionOffset );
+                
+                offsets = offsets || sample._compositionOffset != 0;
+            }
+            
+            /* data-offset, sample duration, size, flags, and composition time offset if needed */
+            track._trun->SetVersion( ( offsets ) ? 1 : 0 );
+            track._trun->SetFlags( ( offsets ) ? 0x000F01 : 0x000701 );
+            track._tfdt->SetBaseMediaDecodeTime( track._decodeTime );
+            moof->AddBox( track._traf );
+            
+            size += track._data.size();
+        }
+        
+        if( moof->GetBoxes().size() == 1 )
+        {
+            this->impl->_stream.Flush();
+            
+            return;
+        }
+        
+        this->impl->_mfhd->SetSequenceNumber( ++( this->impl->_sequenceNumber ) );
+        
+        /* The data offset field has a fixed size, so the MOOF size is known */
+        header = ( size + 8 > ( std::numeric_limits< uint32_t >::max )() ) ? 16 : 8;
+        offset = moof->GetSerializedSize() + header;
+        
+        for( auto & track: this->impl->_tracks )
+        {
+            if( track._samples.size() > 0 )
+            {
+                track._trun->SetDataOffset( numeric_cast< int32_t >( offset ) );
+                
+                offset += track._data.size();
+            }
+        }
+        
+        moof->Write( this->impl->_stream );
+        
+        if( header == 16 )
+        {
+            this->impl->_stream.WriteBigEndianUInt32( 1 );
+            this->impl->_stream.WriteFourCC( "mdat" );
+            this->impl->_stream.WriteBigEndianUInt64( size + 16 );
+        }
+        else
+        {
+            this->impl->_stream.WriteBigEndianUInt32( static_cast< uint32_t >( size + 8 ) );
+            this->impl->_stream.WriteFourCC( "mdat" );
+        }
+        
+        /* Storage is kept for the next fragment */
+        for( auto & track: this->impl->_tracks )
+        {
+            if( track._data.size() > 0 )
+            {
+                this->impl->_stream.Write( track._data.data(), track._data.size() );
+            }
+            
+            track._samples.clear();
+            track._data.clear();
+        }
+        
+        this->impl->_stream.Flush();
+    }
+    
+    FragmentedMuxer::IMPL::IMPL( BinaryOutputStream & stream ):
+        _stream( stream ),
+        _mfhd( std::make_shared< MFHD >() ),
+        _sequenceNumber( 0 ),
+        _initialized( false )
+    {}
+    
+    FragmentedMuxer::IMPL::~IMPL()
+    {}
+    
+    FragmentedMuxer::IMPL::Track & FragmentedMuxer::IMPL::GetTrack( uint32_t trackID )
+    {
+        if( trackID == 0 || trackID > this->_tracks.size() )
+        {
+            throw std::runtime_error( "Invalid track ID: " + std::to_string( trackID ) );
+        }
+        
+        return this->_tracks[ trackID - 1 ];
+    }
+    
+    std::shared_ptr< ContainerBox > FragmentedMuxer::IMPL::CreateTrack( const Track & track ) const
+    {
+        std::shared_ptr< ContainerBox > trak;
+        std::shared_ptr< ContainerBox > mdia;
+        std::shared_ptr< ContainerBox > minf;
+        std::shared_ptr< ContainerBox > dinf;
+        std::shared_ptr< ContainerBox > stbl;
+        std::shared_ptr< TKHD >         tkhd;
+        std::shared_ptr< MDHD >         mdhd;
+        std::shared_ptr< HDLR >         hdlr;
+        std::shared_ptr< DREF >         dref;
+        std::shared_ptr< URL >          url;
+        std::shared_ptr< STSD >         stsd;
+        std::shared_ptr< Box >          header;
+        
+        trak = std::make_shared< ContainerBox >( "trak" );
+        mdia = std::make_shared< ContainerBox >( "mdia" );
+        minf = std::make_shared< ContainerBox >( "minf" );
+        dinf = std::make_shared< ContainerBox >( "dinf" );
+        stbl = std::make_shared< ContainerBox >( "stbl" );
+        tkhd = std::make_shared< TKHD >();
+        mdhd = std::make_shared< MDHD >();
+        hdlr = std::make_shared< HDLR >();
+        dref = std::make_shared< DREF >();
+        url  = std::make_shared< URL >();
+        stsd = std::make_shared< STSD >();
+        
+        /* Enabled, in movie */
+        tkhd->SetFlags( 0x000003 );
+        tkhd->SetTrackID( track._trackID );
+        tkhd->SetVolume( ( track._handlerType == "soun" ) ? 0x0100 : 0 );
+        tkhd->SetMatrix( Matrix( 0x00010000, 0, 0, 0, 0x00010000, 0, 0, 0, 0x40000000 ) );
+        tkhd->SetWidth( track._width );
+        tkhd->SetHeight( track._height );
+        
+        /* Language: und */
+        mdhd->SetTimescale( track._timescale );
+        mdhd->SetLanguage0( 'u' - 0x60 );
+        mdhd->SetLanguage1( 'n' - 0x60 );
+        mdhd->SetLanguage2( 'd' - 0x60 );
+        
+        hdlr->SetHandlerType( track._handlerType );
+        hdlr->SetHandlerName( "" );
+        
+        /* Media header boxes have no specific encoder: version, flags and fields */
+        if( track._handlerType == "vide" )
+        {
+            header = std::make_shared< Box >( "vmhd" );
+            
+            header->SetData( { 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0 } );
+        }
+        else if( track._handlerType == "soun" )
+        {
+            header = std::make_shared< Box >( "smhd" );
+            
+            header->SetData( { 0, 0, 0, 0, 0, 0, 0, 0 } );
+        }
+        else
+        {
+            header = std::make_shared< Box >( "nmhd" );
+            
+            header->SetData( { 0, 0, 0, 0 } );
+        }
+        
+        /* Media data is in the same file */
+        url->SetFlags( 0x000001 );
+        dref->AddBox( url );
+        dinf->AddBox( dref );
+        
+        stsd->AddBox( track._sampleEntry );
+        stbl->AddBox( stsd );
+        stbl->AddBox( std::make_shared< STTS >() );
+        stbl->AddBox( std::make_shared< STSC >() );
+        stbl->AddBox( std::make_shared< STSZ >() );
+        stbl->AddBox( std::make_shared< STCO >() );
+        
+        minf->AddBox( header );
+        minf->AddBox( dinf );
+        minf->AddBox( stbl );
+        mdia->AddBox( mdhd );
+        mdia->AddBox( hdlr );
+        mdia->AddBox( minf );
+        trak->AddBox( tkhd );
+        trak->AddBox( mdia );
+        
+        return trak;
+    }
+}
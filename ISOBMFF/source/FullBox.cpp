@@ -94,6 +94,16 @@ namespace ISOBMFF
         this->SetFlags( vf & 0x00FFFFFF );
     }
     
+    uint64_t FullBox::GetDataSize() const
+    {
+        return 4;
+    }
+    
+    void FullBox::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteBigEndianUInt32( ( static_cast< uint32_t >( this->GetVersion() ) << 24 ) | ( this->GetFlags() & 0x00FFFFFF ) );
+    }
+    
     std::vector< std::pair< std::string, std::string > > FullBox::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
@@ -117,11 +127,13 @@ namespace ISOBMFF
     void FullBox::SetVersion( uint8_t value )
     {
         this->impl->_version = value;
+        this->SetModified( true );
     }
     
     void FullBox::SetFlags( uint32_t value )
     {
         this->impl->_flags = value;
+        this->SetModified( true );
     }
 
     FullBox::IMPL::IMPL():
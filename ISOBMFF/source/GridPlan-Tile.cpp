@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        GridPlan-Tile.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/GridPlan.hpp>
+
+namespace ISOBMFF
+{
+    class GridPlan::Tile::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t                         _itemID;
+            uint32_t                         _row;
+            uint32_t                         _column;
+            uint64_t                         _x;
+            uint64_t                         _y;
+            uint32_t                         _width;
+            uint32_t                         _height;
+            std::vector< ItemReader::Range > _ranges;
+            uint64_t                         _dataOffset;
+            uint64_t                         _dataSize;
+    };
+    
+    GridPlan::Tile::Tile():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    GridPlan::Tile::Tile( const Tile & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    GridPlan::Tile::Tile( Tile && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    GridPlan::Tile::~Tile()
+    {}
+    
+    GridPlan::Tile & GridPlan::Tile::operator =( Tile o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( GridPlan::Tile & o1, GridPlan::Tile & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint32_t GridPlan::Tile::GetItemID() const
+    {
+        return this->impl->_itemID;
+    }
+    
+    uint32_t GridPlan::Tile::GetRow() const
+    {
+        return this->impl->_row;
+    }
+    
+    uint32_t GridPlan::Tile::GetColumn() const
+    {
+        return this->impl->_column;
+    }
+    
+    uint64_t GridPlan::Tile::GetX() const
+    {
+        return this->impl->_x;
+    }
+    
+    uint64_t GridPlan::Tile::GetY() const
+    {
+        return this->impl->_y;
+    }
+    
+    uint32_t GridPlan::Tile::GetWidth() const
+    {
+        return this->impl->_width;
+    }
+    
+    uint32_t GridPlan::Tile::GetHeight() const
+    {
+        return this->impl->_height;
+    }
+    
+    std::vector< ItemReader::Range > GridPlan::Tile::GetRanges() const
+    {
+        return this->impl->_ranges;
+    }
+    
+    uint64_t GridPlan::Tile::GetDataOffset() const
+    {
+        return this->impl->_dataOffset;
+    }
+    
+    uint64_t GridPlan::Tile::GetDataSize() const
+    {
+        return this->impl->_dataSize;
+    }
+    
+    void GridPlan::Tile::SetItemID( uint32_t value )
+    {
+        this->impl->_itemID = value;
+    }
+    
+    void GridPlan::Tile::SetRow( uint32_t value )
+    {
+        this->impl->_row = value;
+    }
+    
+    void GridPlan::Tile::SetColumn( uint32_t value )
+    {
+        this->impl->_column = value;
+    }
+    
+    void GridPlan::Tile::SetX( uint64_t value )
+    {
+        this->impl->_x = value;
+    }
+    
+    void GridPlan::Tile::SetY( uint64_t value )
+    {
+        this->impl->_y = value;
+    }
+    
+    void GridPlan::Tile::SetWidth( uint32_t value )
+    {
+        this->impl->_width = value;
+    }
+    
+    void GridPlan::Tile::SetHeight( uint32_t value )
+    {
+        this->impl->_height = value;
+    }
+    
+    void GridPlan::Tile::SetRanges( const std::vector< ItemReader::Range > & value )
+    {
+        this->impl->_ranges   = value;
+        this->impl->_dataSize = 0;
+        
+        for( const auto & range: value )
+        {
+            this->impl->_dataSize += range.GetLength();
+        }
+    }
+    
+    void GridPlan::Tile::SetDataOffset( uint64_t value )
+    {
+        this->impl->_dataOffset = value;
+    }
+    
+    GridPlan::Tile::IMPL::IMPL():
+        _itemID( 0 ),
+        _row( 0 ),
+        _column( 0 ),
+        _x( 0 ),
+        _y( 0 ),
+        _width( 0 ),
+        _height( 0 ),
+        _dataOffset( 0 ),
+        _dataSize( 0 )
+    {}
+    
+    GridPlan::Tile::IMPL::IMPL( const IMPL & o ):
+        _itemID( o._itemID ),
+        _row( o._row ),
+        _column( o._column ),
+        _x( o._x ),
+        _y( o._y ),
+        _width( o._width ),
+        _height( o._height ),
+        _ranges( o._ranges ),
+        _dataOffset( o._dataOffset ),
+        _dataSize( o._dataSize )
+    {}
+    
+    GridPlan::Tile::IMPL::~IMPL()
+    {}
+}
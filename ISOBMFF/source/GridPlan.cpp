@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        GridPlan.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/GridPlan.hpp>
+
+namespace ISOBMFF
+{
+    class GridPlan::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t            _itemID;
+            uint32_t            _rows;
+            uint32_t            _columns;
+            uint64_t            _outputWidth;
+            uint64_t            _outputHeight;
+            std::vector< Tile > _tiles;
+            uint64_t            _dataSize;
+    };
+    
+    GridPlan::GridPlan():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    GridPlan::GridPlan( const GridPlan & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    GridPlan::GridPlan( GridPlan && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    GridPlan::~GridPlan()
+    {}
+    
+    GridPlan & GridPlan::operator =( GridPlan o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( GridPlan & o1, GridPlan & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint32_t GridPlan::GetItemID() const
+    {
+        return this->impl->_itemID;
+    }
+    
+    uint32_t GridPlan::GetRows() const
+    {
+        return this->impl->_rows;
+    }
+    
+    uint32_t GridPlan::GetColumns() const
+    {
+        return this->impl->_columns;
+    }
+    
+    uint64_t GridPlan::GetOutputWidth() const
+    {
+        return this->impl->_outputWidth;
+    }
+    
+    uint64_t GridPlan::GetOutputHeight() const
+    {
+        return this->impl->_outputHeight;
+    }
+    
+    std::vector< GridPlan::Tile > GridPlan::GetTiles() const
+    {
+        return this->impl->_tiles;
+    }
+    
+    void GridPlan::SetItemID( uint32_t value )
+    {
+        this->impl->_itemID = value;
+    }
+    
+    void GridPlan::SetRows( uint32_t value )
+    {
+        this->impl->_rows = value;
+    }
+    
+    void GridPlan::SetColumns( uint32_t value )
+    {
+        this->impl->_columns = value;
+    }
+    
+    void GridPlan::SetOutputWidth( uint64_t value )
+    {
+        this->impl->_outputWidth = value;
+    }
+    
+    void GridPlan::SetOutputHeight( uint64_t value )
+    {
+        this->impl->_outputHeight = value;
+    }
+    
+    void GridPlan::AddTile( Tile tile )
+    {
+        tile.SetDataOffset( this->impl->_dataSize );
+        
+        this->impl->_dataSize += tile.GetDataSize();
+        
+        this->impl->_tiles.push_back( std::move( tile ) );
+    }
+    
+    uint64_t GridPlan::GetDataSize() const
+    {
+        return this->impl->_dataSize;
+    }
+    
+    GridPlan::IMPL::IMPL():
+        _itemID( 0 ),
+        _rows( 0 ),
+        _columns( 0 ),
+        _outputWidth( 0 ),
+        _outputHeight( 0 ),
+        _dataSize( 0 )
+    {}
+    
+    GridPlan::IMPL::IMPL( const IMPL & o ):
+        _itemID( o._itemID ),
+        _rows( o._rows ),
+        _columns( o._columns ),
+        _outputWidth( o._outputWidth ),
+        _outputHeight( o._outputHeight ),
+        _tiles( o._tiles ),
+        _dataSize( o._dataSize )
+    {}
+    
+    GridPlan::IMPL::~IMPL()
+    {}
+}
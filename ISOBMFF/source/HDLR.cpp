@@ -47,6 +47,9 @@ namespace ISOBMFF
             std::string _handlerType;
             uint32_t    _reserved[ 3 ];
             std::string _handlerName;
+            bool        _pascalString;
+            
+            std::vector< uint8_t > _trailingData;
     };
     
     HDLR::HDLR():
@@ -107,16 +110,60 @@ namespace ISOBMFF
             )
             {
                 this->SetHandlerName( stream.ReadPascalString() );
+                
+                this->impl->_pascalString = true;
             }
             else
             {
                 this->SetHandlerName( stream.ReadNULLTerminatedString() );
+                
+                this->impl->_pascalString = false;
             }
         }
         else
         {
             this->SetHandlerName( "" );
         }
+        
+        /* Some writers pad the name, eg. with a second terminator */
+        this->impl->_trailingData = stream.ReadAllData();
+    }
+    
+    uint64_t HDLR::GetDataSize() const
+    {
+        uint64_t size;
+        
+        size = FullBox::GetDataSize() + 20 + this->impl->_trailingData.size();
+        
+        if( this->impl->_pascalString )
+        {
+            return size + 1 + this->impl->_handlerName.size();
+        }
+        
+        return size + this->impl->_handlerName.size() + 1;
+    }
+    
+    void HDLR::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( this->impl->_predefined );
+        stream.WriteFourCC( this->GetHandlerType() );
+        stream.WriteBigEndianUInt32( this->impl->_reserved[ 0 ] );
+        stream.WriteBigEndianUInt32( this->impl->_reserved[ 1 ] );
+        stream.WriteBigEndianUInt32( this->impl->_reserved[ 2 ] );
+        
+        /* The name is written in the format it was read in */
+        if( this->impl->_pascalString )
+        {
+            stream.WritePascalString( this->GetHandlerName() );
+        }
+        else
+        {
+            stream.WriteNULLTerminatedString( this->GetHandlerName() );
+        }
+        
+        stream.Write( this->impl->_trailingData );
     }
     
     std::vector< std::pair< std::string, std::string > > HDLR::GetDisplayableProperties() const
@@ -142,15 +189,18 @@ namespace ISOBMFF
     void HDLR::SetHandlerType( const std::string & value )
     {
         this->impl->_handlerType = value;
+        this->SetModified( true );
     }
     
     void HDLR::SetHandlerName( const std::string & value )
     {
         this->impl->_handlerName = value;
+        this->SetModified( true );
     }
 
     HDLR::IMPL::IMPL():
-        _predefined( 0 )
+        _predefined( 0 ),
+        _pascalString( false )
     {
         memset( this->_reserved, 0, sizeof( this->_reserved ) );
     }
@@ -158,7 +208,9 @@ namespace ISOBMFF
     HDLR::IMPL::IMPL( const IMPL & o ):
         _predefined( o._predefined ),
         _handlerType( o._handlerType ),
-        _handlerName( o._handlerName )
+        _handlerName( o._handlerName ),
+        _pascalString( o._pascalString ),
+        _trailingData( o._trailingData )
     {
         memcpy( this->_reserved, o._reserved, sizeof( this->_reserved ) );
     }
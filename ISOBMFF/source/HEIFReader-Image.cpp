@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        HEIFReader-Image.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/HEIFReader.hpp>
+
+namespace ISOBMFF
+{
+    class HEIFReader::Image::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t                _itemID;
+            std::string             _itemType;
+            std::vector< uint8_t >  _data;
+            std::shared_ptr< HVCC > _hvcC;
+            std::shared_ptr< ISPE > _ispe;
+    };
+    
+    HEIFReader::Image::Image():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    HEIFReader::Image::Image( const Image & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    HEIFReader::Image::Image( Image && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    HEIFReader::Image::~Image()
+    {}
+    
+    HEIFReader::Image & HEIFReader::Image::operator =( Image o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( HEIFReader::Image & o1, HEIFReader::Image & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint32_t HEIFReader::Image::GetItemID() const
+    {
+        return this->impl->_itemID;
+    }
+    
+    std::string HEIFReader::Image::GetItemType() const
+    {
+        return this->impl->_itemType;
+    }
+    
+    std::vector< uint8_t > HEIFReader::Image::GetData() const
+    {
+        return this->impl->_data;
+    }
+    
+    std::shared_ptr< HVCC > HEIFReader::Image::GetHVCC() const
+    {
+        return this->impl->_hvcC;
+    }
+    
+    std::shared_ptr< ISPE > HEIFReader::Image::GetISPE() const
+    {
+        return this->impl->_ispe;
+    }
+    
+    void HEIFReader::Image::SetItemID( uint32_t value )
+    {
+        this->impl->_itemID = value;
+    }
+    
+    void HEIFReader::Image::SetItemType( const std::string & value )
+    {
+        this->impl->_itemType = value;
+    }
+    
+    void HEIFReader::Image::SetData( const std::vector< uint8_t > & value )
+    {
+        this->impl->_data = value;
+    }
+    
+    void HEIFReader::Image::SetHVCC( std::shared_ptr< HVCC > value )
+    {
+        this->impl->_hvcC = value;
+    }
+    
+    void HEIFReader::Image::SetISPE( std::shared_ptr< ISPE > value )
+    {
+        this->impl->_ispe = value;
+    }
+    
+    HEIFReader::Image::IMPL::IMPL():
+        _itemID( 0 )
+    {}
+    
+    HEIFReader::Image::IMPL::IMPL( const IMPL & o ):
+        _itemID( o._itemID ),
+        _itemType( o._itemType ),
+        _data( o._data ),
+        _hvcC( o._hvcC ),
+        _ispe( o._ispe )
+    {}
+    
+    HEIFReader::Image::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,703 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        HEIFReader.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/HEIFReader.hpp>
+#include <ISOBMFF/BinaryFileStream.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/PITM.hpp>
+#include <ISOBMFF/IINF.hpp>
+#include <ISOBMFF/INFE.hpp>
+#include <ISOBMFF/IREF.hpp>
+#include <ISOBMFF/IPCO.hpp>
+#include <ISOBMFF/IPMA.hpp>
+#include <ISOBMFF/ImageGrid.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <stdexcept>
+#include <exception>
+#include <thread>
+#include <cstring>
+
+namespace ISOBMFF
+{
+    class HEIFReader::IMPL
+    {
+        public:
+            
+            struct Transfer
+            {
+                uint64_t _offset;
+                uint64_t _length;
+                size_t   _destination;
+            };
+            
+            IMPL( const std::string & path );
+            IMPL( BinaryStream & stream );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void Load();
+            
+            static void ReadTransfers( BinaryStream & stream, const std::vector< Transfer > & transfers, size_t begin, size_t end, uint8_t * buffer );
+            
+            std::shared_ptr< BinaryStream > _ownedStream;
+            BinaryStream                  * _stream;
+            std::string                     _path;
+            std::shared_ptr< FTYP >         _ftyp;
+            std::shared_ptr< META >         _meta;
+            std::shared_ptr< ItemReader >   _reader;
+            ItemReferenceGraph              _references;
+    };
+    
+    HEIFReader::HEIFReader( const std::string & path ):
+        impl( std::make_unique< IMPL >( path ) )
+    {}
+    
+    HEIFReader::HEIFReader( BinaryStream & stream ):
+        impl( std::make_unique< IMPL >( stream ) )
+    {}
+    
+    HEIFReader::HEIFReader( const HEIFReader & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    HEIFReader::HEIFReader( HEIFReader && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    HEIFReader::~HEIFReader()
+    {}
+    
+    HEIFReader & HEIFReader::operator =( HEIFReader o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( HEIFReader & o1, HEIFReader & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    std::shared_ptr< FTYP > HEIFReader::GetFTYP() const
+    {
+        return this->impl->_ftyp;
+    }
+    
+    std::shared_ptr< META > HEIFReader::GetMETA() const
+    {
+        return this->impl->_meta;
+    }
+    
+    const ItemReader & HEIFReader::GetItemReader() const
+    {
+        return *( this->impl->_reader );
+    }
+    
+    uint32_t HEIFReader::GetPrimaryItemID() const
+    {
+        std::shared_ptr< PITM > pitm( this->impl->_meta->GetTypedBox< PITM >( "pitm" ) );
+        
+        if( pitm == nullptr )
+        {
+            throw std::runtime_error( "No primary item" );
+        }
+        
+        return pitm->GetItemID();
+    }
+    
+    std::string HEIFReader::GetItemType( uint32_t itemID ) const
+    {
+        std::shared_ptr< IINF > iinf( this->impl->_meta->GetTypedBox< IINF >( "iinf" ) );
+        std::shared_ptr< INFE > infe;
+        
+        if( iinf == nullptr )
+        {
+            return "";
+        }
+        
+        infe = iinf->GetItemInfo( itemID );
+        
+        return ( infe == nullptr ) ? "" : infe->GetItemType();
+    }
+    
+    std::vector< uint32_t > HEIFReader::GetThumbnailItemIDs( uint32_t itemID ) const
+    {
+        return this->impl->_references.GetReferencingItemIDs( "thmb", itemID );
+    }
+    
+    std::vector< uint32_t > HEIFReader::GetMetadataItemIDs( uint32_t itemID ) const
+    {
+        return this->impl->_references.GetReferencingItemIDs( "cdsc", itemID );
+    }
+    
+    const ItemReferenceGraph & HEIFReader::GetItemReferences() const
+    {
+        return this->impl->_references;
+    }
+    
+    std::shared_ptr< Box > HEIFReader::GetItemProperty( uint32_t itemID, const std::string & type ) const
+    {
+        std::shared_ptr< ContainerBox > iprp( this->impl->_meta->GetTypedBox< ContainerBox >( "iprp" ) );
+        std::shared_ptr< IPCO >         ipco;
+        
+        if( iprp == nullptr )
+        {
+            return nullptr;
+        }
+        
+        ipco = iprp->GetTypedBox< IPCO >( "ipco" );
+        
+        if( ipco == nullptr )
+        {
+            return nullptr;
+        }
+        
+        for( const auto & box: iprp->Container::GetBoxes( "ipma" ) )
+        {
+            std::shared_ptr< IPMA >        ipma( std::dynamic_pointer_cast< IPMA >( box ) );
+            std::shared_ptr< IPMA::Entry > entry;
+            
+            if( ipma == nullptr )
+            {
+                continue;
+            }
+            
+            entry = ipma->GetEntry( itemID );
+            
+            if( entry == nullptr )
+            {
+                continue;
+            }
+            
+            for( const auto & property: ipco->GetProperties( *( entry ) ) )
+            {
+                if( property != nullptr && property->GetName() == type )
+                {
+                    return property;
+                }
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    HEIFReader::Image HEIFReader::GetImage( uint32_t itemID ) const
+    {
+        Image image;
+        
+        image.SetItemID( itemID );
+        image.SetItemType( this->GetItemType( itemID ) );
+        image.SetData( this->impl->_reader->ReadItem( itemID ) );
+        image.SetHVCC( this->GetItemProperty< HVCC >( itemID, "hvcC" ) );
+        image.SetISPE( this->GetItemProperty< ISPE >( itemID, "ispe" ) );
+        
+        return image;
+    }
+    
+    std::shared_ptr< HEIFReader::Image > HEIFReader::GetThumbnail() const
+    {
+        for( auto id: this->GetThumbnailItemIDs( this->GetPrimaryItemID() ) )
+        {
+            if( this->impl->_reader->HasItem( id ) )
+            {
+                return std::make_shared< Image >( this->GetImage( id ) );
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    std::vector< uint8_t > HEIFReader::ReadItemAnnexB( uint32_t itemID ) const
+    {
+        std::shared_ptr< HVCC >            hvcC( this->GetItemProperty< HVCC >( itemID, "hvcC" ) );
+        std::shared_ptr< AVCC >            avcC;
+        std::unique_ptr< AnnexBAssembler > assembler;
+        std::vector< uint8_t >             data;
+        const uint8_t                    * bytes;
+        
+        if( hvcC != nullptr )
+        {
+            assembler = std::make_unique< AnnexBAssembler >( *( hvcC ) );
+        }
+        else
+        {
+            avcC = this->GetItemProperty< AVCC >( itemID, "avcC" );
+            
+            if( avcC == nullptr )
+            {
+                throw std::runtime_error( "Missing decoder configuration for item: " + std::to_string( itemID ) );
+            }
+            
+            assembler = std::make_unique< AnnexBAssembler >( *( avcC ) );
+        }
+        
+        bytes = this->impl->_reader->GetItemBytes( itemID );
+        
+        if( bytes != nullptr )
+        {
+            return assembler->Assemble( bytes, numeric_cast< size_t >( this->impl->_reader->GetItemSize( itemID ) ) );
+        }
+        
+        data = this->impl->_reader->ReadItem( itemID );
+        
+        return assembler->Assemble( data );
+    }
+    
+    std::vector< uint8_t > HEIFReader::GetExifData() const
+    {
+        std::vector< uint8_t > data;
+        uint32_t               offset;
+        
+        for( auto id: this->GetMetadataItemIDs( this->GetPrimaryItemID() ) )
+        {
+            if( this->GetItemType( id ) != "Exif" || this->impl->_reader->HasItem( id ) == false )
+            {
+                continue;
+            }
+            
+            data = this->impl->_reader->ReadItem( id );
+            
+            if( data.size() < 4 )
+            {
+                throw std::runtime_error( "Invalid Exif item: " + std::to_string( id ) );
+            }
+            
+            /*
+             * Exif items start with the offset to the TIFF header, which
+             * usually skips the 'Exif\0\0' marker.
+             */
+            offset = ( static_cast< uint32_t >( data[ 0 ] ) << 24 )
+                   | ( static_cast< uint32_t >( data[ 1 ] ) << 16 )
+                   | ( static_cast< uint32_t >( data[ 2 ] ) << 8 )
+                   |   static_cast< uint32_t >( data[ 3 ] );
+            
+            if( offset > data.size() - 4 )
+            {
+                throw std::runtime_error( "Invalid Exif item: " + std::to_string( id ) );
+            }
+            
+            data.erase( data.begin(), data.begin() + 4 + static_cast< std::ptrdiff_t >( offset ) );
+            
+            return data;
+        }
+        
+        return {};
+    }
+    
+    std::vector< uint8_t > HEIFReader::GetXMPData() const
+    {
+        std::shared_ptr< IINF > iinf( this->impl->_meta->GetTypedBox< IINF >( "iinf" ) );
+        std::shared_ptr< INFE > infe;
+        
+        if( iinf == nullptr )
+        {
+            return {};
+        }
+        
+        for( auto id: this->GetMetadataItemIDs( this->GetPrimaryItemID() ) )
+        {
+            infe = iinf->GetItemInfo( id );
+            
+            if
+            (
+                   infe == nullptr
+                || infe->GetItemType() != "mime"
+                || infe->GetContentType() != "application/rdf+xml"
+                || this->impl->_reader->HasItem( id ) == false
+            )
+            {
+                continue;
+            }
+            
+            return this->impl->_reader->ReadItem( id );
+        }
+        
+        return {};
+    }
+    
+    GridPlan HEIFReader::GetGridPlan( uint32_t itemID ) const
+    {
+        GridPlan                plan;
+        std::vector< uint32_t > ids;
+        std::shared_ptr< ISPE > ispe;
+        uint32_t                tileWidth;
+        uint32_t                tileHeight;
+        
+        if( this->GetItemType( itemID ) != "grid" )
+        {
+            throw std::runtime_error( "Item is not a grid image: " + std::to_string( itemID ) );
+        }
+        
+        BinaryDataStream data( this->impl->_reader->ReadItem( itemID ) );
+        ImageGrid        grid( data );
+        
+        /*
+         * ImageGrid stores the values from the item data, which are the
+         * number of rows and columns minus one.
+         */
+        plan.SetItemID( itemID );
+        plan.SetRows( static_cast< uint32_t >( grid.GetRows() ) + 1 );
+        plan.SetColumns( static_cast< uint32_t >( grid.GetColumns() ) + 1 );
+        plan.SetOutputWidth( grid.GetOutputWidth() );
+        plan.SetOutputHeight( grid.GetOutputHeight() );
+        
+        ids = this->impl->_references.GetReferencedItemIDs( "dimg", itemID );
+        
+        if( ids.size() != static_cast< size_t >( plan.GetRows() ) * plan.GetColumns() )
+        {
+            throw std::runtime_error( "Invalid number of tiles for grid image: " + std::to_string( itemID ) );
+        }
+        
+        tileWidth  = 0;
+        tileHeight = 0;
+        
+        for( size_t i = 0; i < ids.size(); i++ )
+        {
+            GridPlan::Tile tile;
+            
+            ispe = this->GetItemProperty< ISPE >( ids[ i ], "ispe" );
+            
+            if( ispe == nullptr )
+            {
+                throw std::runtime_error( "Missing size for tile: " + std::to_string( ids[ i ] ) );
+            }
+            
+            /*
+             * All tiles of a grid have the same size, so positions are
+             * computed from the first one.
+             */
+            if( i == 0 )
+            {
+                tileWidth  = ispe->GetDisplayWidth();
+                tileHeight = ispe->GetDisplayHeight();
+            }
+            
+            tile.SetItemID( ids[ i ] );
+            tile.SetRow( static_cast< uint32_t >( i / plan.GetColumns() ) );
+            tile.SetColumn( static_cast< uint32_t >( i % plan.GetColumns() ) );
+            tile.SetX( static_cast< uint64_t >( tile.GetColumn() ) * tileWidth );
+            tile.SetY( static_cast< uint64_t >( tile.GetRow() ) * tileHeight );
+            tile.SetWidth( ispe->GetDisplayWidth() );
+            tile.SetHeight( ispe->GetDisplayHeight() );
+            tile.SetRanges( this->impl->_reader->GetItemRanges( ids[ i ] ) );
+            
+            plan.AddTile( std::move( tile ) );
+        }
+        
+        return plan;
+    }
+    
+    void HEIFReader::ReadGridTiles( const GridPlan & plan, uint8_t * buffer, size_t size, unsigned int threads ) const
+    {
+        std::vector< IMPL::Transfer >     transfers;
+        std::vector< IMPL::Transfer >     merged;
+        std::vector< std::thread >        workers;
+        std::vector< std::exception_ptr > errors;
+        uint64_t                          destination;
+        size_t                            pos;
+        
+        if( plan.GetDataSize() > size )
+        {
+            throw std::runtime_error( "Buffer is too small for grid tiles" );
+        }
+        
+        for( const auto & tile: plan.GetTiles() )
+        {
+            destination = tile.GetDataOffset();
+            
+            for( const auto & range: tile.GetRanges() )
+            {
+                if( destination > size || range.GetLength() > size - destination )
+                {
+                    throw std::runtime_error( "Buffer is too small for grid tiles" );
+                }
+                
+                if( range.GetSource() == ItemReader::Range::Source::IDAT )
+                {
+                    this->impl->_reader->ReadRanges( { range }, buffer + destination, numeric_cast< size_t >( range.GetLength() ) );
+                }
+                else if( range.GetLength() > 0 )
+                {
+                    transfers.push_back( { range.GetOffset(), range.GetLength(), numeric_cast< size_t >( destination ) } );
+                }
+                
+                destination += range.GetLength();
+            }
+        }
+        
+        /*
+         * Tiles are usually stored one after the other, so extents that
+         * follow each other both in the file and in the arena are fetched
+         * with a single read.
+         */
+        std::sort
+        (
+            transfers.begin(),
+            transfers.end(),
+            []( const IMPL::Transfer & t1, const IMPL::Transfer & t2 ) -> bool
+            {
+                return t1._offset < t2._offset;
+            }
+        );
+        
+        for( const auto & transfer: transfers )
+        {
+            if
+            (
+                   merged.size() > 0
+                && merged.back()._offset      + merged.back()._length == transfer._offset
+                && merged.back()._destination + merged.back()._length == transfer._destination
+            )
+            {
+                merged.back()._length += transfer._length;
+            }
+            else
+            {
+                merged.push_back( transfer );
+            }
+        }
+        
+        if( threads == 0 )
+        {
+            threads = std::max( std::thread::hardware_concurrency(), 1U );
+        }
+        
+        /*
+         * Streams have a single position, so parallel reads either use the
+         * mapped bytes or a stream per thread, opened from the file's path.
+         */
+        if( this->impl->_stream->GetBytes() == nullptr && this->impl->_path.empty() )
+        {
+            threads = 1;
+        }
+        
+        threads = static_cast< unsigned int >( std::min( static_cast< size_t >( threads ), merged.size() ) );
+        
+        if( threads <= 1 )
+        {
+            pos = this->impl->_stream->Tell();
+            
+            IMPL::ReadTransfers( *( this->impl->_stream ), merged, 0, merged.size(), buffer );
+            
+            this->impl->_stream->Seek( numeric_cast< std::streamoff >( pos ), BinaryStream::SeekDirection::Begin );
+            
+            return;
+        }
+        
+        errors.resize( threads );
+        
+        for( unsigned int i = 0; i < threads; i++ )
+        {
+            size_t begin = ( merged.size() * i )       / threads;
+            size_t end   = ( merged.size() * ( i + 1 ) ) / threads;
+            
+            workers.push_back
+            (
+                std::thread
+                (
+                    [ =, &merged, &errors ]
+                    {
+                        try
+                        {
+                            if( this->impl->_stream->GetBytes() != nullptr )
+                            {
+                                IMPL::ReadTransfers( *( this->impl->_stream ), merged, begin, end, buffer );
+                            }
+                            else
+                            {
+                                BinaryFileStream stream( this->impl->_path );
+                                
+                                IMPL::ReadTransfers( stream, merged, begin, end, buffer );
+                            }
+                        }
+                        catch( ... )
+                        {
+                            errors[ i ] = std::current_exception();
+                        }
+                    }
+                )
+            );
+        }
+        
+        for( auto & worker: workers )
+        {
+            worker.join();
+        }
+        
+        for( const auto & error: errors )
+        {
+            if( error != nullptr )
+            {
+                std::rethrow_exception( error );
+            }
+        }
+    }
+    
+    std::vector< uint8_t > HEIFReader::ReadGridTiles( const GridPlan & plan, unsigned int threads ) const
+    {
+        std::vector< uint8_t > data( numeric_cast< size_t >( plan.GetDataSize() ) );
+        
+        if( data.size() > 0 )
+        {
+            this->ReadGridTiles( plan, &( data[ 0 ] ), data.size(), threads );
+        }
+        
+        return data;
+    }
+    
+    HEIFReader::IMPL::IMPL( const std::string & path ):
+        _ownedStream( std::make_shared< BinaryFileStream >( path ) ),
+        _stream( _ownedStream.get() ),
+        _path( path )
+    {
+        this->Load();
+    }
+    
+    HEIFReader::IMPL::IMPL( BinaryStream & stream ):
+        _stream( &stream )
+    {
+        this->Load();
+    }
+    
+    HEIFReader::IMPL::IMPL( const IMPL & o ):
+        _ownedStream( o._ownedStream ),
+        _stream( o._stream ),
+        _path( o._path ),
+        _ftyp( o._ftyp ),
+        _meta( o._meta ),
+        _reader( o._reader ),
+        _references( o._references )
+    {}
+    
+    HEIFReader::IMPL::~IMPL()
+    {}
+    
+    void HEIFReader::IMPL::Load()
+    {
+        Parser                  parser;
+        uint64_t                available;
+        uint64_t                length;
+        uint64_t                header;
+        std::string             name;
+        std::shared_ptr< Box >  box;
+        std::shared_ptr< IREF > iref;
+        
+        this->_stream->Seek( 0, BinaryStream::SeekDirection::Begin );
+        
+        /*
+         * Only top-level box headers are read, skipping everything but the
+         * FTYP and META boxes, which come first in HEIF files.
+         */
+        while( this->_meta == nullptr && this->_stream->AvailableBytes() >= 8 )
+        {
+            available = this->_stream->AvailableBytes();
+            length    = this->_stream->ReadBigEndianUInt32();
+            name      = this->_stream->ReadFourCC();
+            header    = 8;
+            
+            if( length == 1 )
+            {
+                length = this->_stream->ReadBigEndianUInt64();
+                header = 16;
+            }
+            else if( length == 0 )
+            {
+                length = available;
+            }
+            
+            if( length < header || length > available )
+            {
+                throw std::runtime_error( "Invalid box size: " + name );
+            }
+            
+            if( name != "ftyp" && name != "meta" )
+            {
+                this->_stream->Seek( numeric_cast< std::streamoff >( length - header ), BinaryStream::SeekDirection::Current );
+                
+                continue;
+            }
+            
+            BinaryDataStream content( this->_stream->Read( numeric_cast< size_t >( length - header ) ) );
+            
+            box = parser.CreateBox( name );
+            
+            box->ReadData( parser, content );
+            
+            if( name == "ftyp" )
+            {
+                this->_ftyp = std::dynamic_pointer_cast< FTYP >( box );
+            }
+            else
+            {
+                this->_meta = std::dynamic_pointer_cast< META >( box );
+            }
+        }
+        
+        if( this->_meta == nullptr )
+        {
+            throw std::runtime_error( "No META box found" );
+        }
+        
+        this->_reader = std::make_shared< ItemReader >( *( this->_meta ), *( this->_stream ) );
+        iref          = this->_meta->GetTypedBox< IREF >( "iref" );
+        
+        if( iref != nullptr )
+        {
+            this->_references = ItemReferenceGraph( *( iref ) );
+        }
+    }
+    
+    void HEIFReader::IMPL::ReadTransfers( BinaryStream & stream, const std::vector< Transfer > & transfers, size_t begin, size_t end, uint8_t * buffer )
+    {
+        const uint8_t * bytes( stream.GetBytes() );
+        
+        for( size_t i = begin; i < end; i++ )
+        {
+            const Transfer & transfer( transfers[ i ] );
+            
+            if( bytes != nullptr )
+            {
+                memcpy( buffer + transfer._destination, bytes + transfer._offset, numeric_cast< size_t >( transfer._length ) );
+            }
+            else
+            {
+                stream.Seek( numeric_cast< std::streamoff >( transfer._offset ), BinaryStream::SeekDirection::Begin );
+                stream.Read( buffer + transfer._destination, numeric_cast< size_t >( transfer._length ) );
+            }
+        }
+    }
+}
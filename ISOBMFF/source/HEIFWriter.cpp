@@ -0,0 +1,552 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        HEIFWriter.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/HEIFWriter.hpp>
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+#include <ISOBMFF/BinaryFileOutputStream.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/FTYP.hpp>
+#include <ISOBMFF/META.hpp>
+#include <ISOBMFF/HDLR.hpp>
+#include <ISOBMFF/PITM.hpp>
+#include <ISOBMFF/ILOC.hpp>
+#include <ISOBMFF/IINF.hpp>
+#include <ISOBMFF/INFE.hpp>
+#include <ISOBMFF/IREF.hpp>
+#include <ISOBMFF/SingleItemTypeReferenceBox.hpp>
+#include <ISOBMFF/IPCO.hpp>
+#include <ISOBMFF/IPMA.hpp>
+#include <ISOBMFF/ISPE.hpp>
+#include <ISOBMFF/ImageGrid.hpp>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class HEIFWriter::IMPL
+    {
+        public:
+            
+            struct Item
+            {
+                uint32_t                                 _itemID;
+                std::string                              _itemType;
+                bool                                     _hidden;
+                bool                                     _thumbnail;
+                std::vector< uint8_t >                   _data;
+                std::vector< std::pair< size_t, bool > > _properties;
+            };
+            
+            struct Reference
+            {
+                std::string             _type;
+                uint32_t                _fromItemID;
+                std::vector< uint32_t > _toItemIDs;
+            };
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            Item & GetItem( uint32_t itemID );
+            void   AddProperty( Item & item, std::shared_ptr< Box > property, bool essential );
+            
+            std::shared_ptr< META > CreateMeta( uint32_t primaryItemID, std::shared_ptr< ILOC > & iloc, std::vector< std::shared_ptr< ILOC::Item::Extent > > & extents ) const;
+            
+            std::vector< Item >                        _items;
+            std::vector< std::shared_ptr< Box > >      _properties;
+            std::map< std::vector< uint8_t >, size_t > _propertyIndices;
+            std::vector< Reference >                   _references;
+            uint32_t                                   _primaryItemID;
+    };
+    
+    HEIFWriter::HEIFWriter():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    HEIFWriter::HEIFWriter( const HEIFWriter & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    HEIFWriter::HEIFWriter( HEIFWriter && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    HEIFWriter::~HEIFWriter()
+    {}
+    
+    HEIFWriter & HEIFWriter::operator =( HEIFWriter o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( HEIFWriter & o1, HEIFWriter & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint32_t HEIFWriter::AddImage( const std::vector< uint8_t > & config, uint32_t width, uint32_t height )
+    {
+        IMPL::Item              item;
+        std::shared_ptr< Box >  hvcc;
+        std::shared_ptr< ISPE > ispe;
+        
+        item._itemID    = static_cast< uint32_t >( this->impl->_items.size() + 1 );
+        item._itemType  = "hvc1";
+        item._hidden    = false;
+        item._thumbnail = false;
+        hvcc            = std::make_shared< Box >( "hvcC" );
+        ispe            = std::make_shared< ISPE >();
+        
+        hvcc->SetData( config );
+        ispe->SetDisplayWidth( width );
+        ispe->SetDisplayHeight( height );
+        
+        this->impl->AddProperty( item, hvcc, true );
+        this->impl->AddProperty( item, ispe, false );
+        this->impl->_items.push_back( item );
+        
+        return item._itemID;
+    }
+    
+    uint32_t HEIFWriter::AddGrid( uint32_t rows, uint32_t columns, uint32_t width, uint32_t height, const std::vector< uint32_t > & tiles )
+    {
+        IMPL::Item              item;
+        IMPL::Reference         reference;
+        ImageGrid               grid;
+        BinaryDataOutputStream  stream;
+        std::shared_ptr< ISPE > ispe;
+        
+        if( rows == 0 || rows > 256 || columns == 0 || columns > 256 )
+        {
+            throw std::runtime_error( "Cannot add grid - Invalid number of rows or columns" );
+        }
+        
+        if( tiles.size() != static_cast< size_t >( rows ) * columns )
+        {
+            throw std::runtime_error( "Cannot add grid - Number of tiles does not match the grid" );
+        }
+        
+        for( uint32_t tile: tiles )
+        {
+            if( this->impl->GetItem( tile )._itemType != "hvc1" )
+            {
+                throw std::runtime_error( "Cannot add grid - Tile is not an image item: " + std::to_string( tile ) );
+            }
+        }
+        
+        /* Rows and columns are stored minus one */
+        grid.SetVersion( 0 );
+        grid.SetFlags( ( width > 0xFFFF || height > 0xFFFF ) ? 1 : 0 );
+        grid.SetRows( static_cast< uint8_t >( rows - 1 ) );
+        grid.SetColumns( static_cast< uint8_t >( columns - 1 ) );
+        grid.SetOutputWidth( width );
+        grid.SetOutputHeight( height );
+        grid.Write( stream );
+        
+        item._itemID    = static_cast< uint32_t >( this->impl->_items.size() + 1 );
+        item._itemType  = "grid";
+        item._hidden    = false;
+        item._thumbnail = false;
+        item._data      = stream.GetData();
+        ispe            = std::make_shared< ISPE >();
+        
+        ispe->SetDisplayWidth( width );
+        ispe->SetDisplayHeight( height );
+        
+        this->impl->AddProperty( item, ispe, false );
+        
+        for( uint32_t tile: tiles )
+        {
+            this->impl->GetItem( tile )._hidden = true;
+        }
+        
+        reference._type       = "dimg";
+        reference._fromItemID = item._itemID;
+        reference._toItemIDs  = tiles;
+        
+        this->impl->_references.push_back( reference );
+        this->impl->_items.push_back( item );
+        
+        return item._itemID;
+    }
+    
+    void HEIFWriter::AddThumbnail( uint32_t thumbnailID, uint32_t itemID )
+    {
+        IMPL::Reference reference;
+        
+        this->impl->GetItem( itemID );
+        this->impl->GetItem( thumbnailID )._thumbnail = true;
+        
+        reference._type       = "thmb";
+        reference._fromItemID = thumbnailID;
+        reference._toItemIDs  = { itemID };
+        
+        this->impl->_references.push_back( reference );
+    }
+    
+    void HEIFWriter::AddProperty( uint32_t itemID, std::shared_ptr< Box > property, bool essential )
+    {
+        if( property == nullptr )
+        {
+            throw std::runtime_error( "Cannot add property - No property" );
+        }
+        
+        this->impl->AddProperty( this->impl->GetItem( itemID ), property, essential );
+    }
+    
+    void HEIFWriter::SetItemData( uint32_t itemID, std::vector< uint8_t > data )
+    {
+        IMPL::Item & item = this->impl->GetItem( itemID );
+        
+        if( item._itemType != "hvc1" )
+        {
+            throw std::runtime_error( "Cannot set item data - Not an image item: " + std::to_string( itemID ) );
+        }
+        
+        item._data = std::move( data );
+    }
+    
+    uint32_t HEIFWriter::GetPrimaryItemID() const
+    {
+        if( this->impl->_primaryItemID != 0 )
+        {
+            return this->impl->_primaryItemID;
+        }
+        
+        for( auto it = this->impl->_items.rbegin(); it != this->impl->_items.rend(); ++it )
+        {
+            if( it->_hidden == false && it->_thumbnail == false )
+            {
+                return it->_itemID;
+            }
+        }
+        
+        return 0;
+    }
+    
+    void HEIFWriter::SetPrimaryItemID( uint32_t itemID )
+    {
+        this->impl->GetItem( itemID );
+        
+        this->impl->_primaryItemID = itemID;
+    }
+    
+    void HEIFWriter::Write( BinaryOutputStream & stream ) const
+    {
+        std::shared_ptr< FTYP >                              ftyp;
+        std::shared_ptr< META >                              meta;
+        std::shared_ptr< ILOC >                              iloc;
+        std::vector< std::shared_ptr< ILOC::Item::Extent > > extents;
+        uint32_t                                             primaryItemID;
+        uint64_t                                             size;
+        uint64_t                                             length;
+        uint64_t                                             header;
+        uint64_t                                             offset;
+        
+        primaryItemID = this->GetPrimaryItemID();
+        
+        if( primaryItemID == 0 )
+        {
+            throw std::runtime_error( "Cannot write - No primary item" );
+        }
+        
+        size   = 0;
+        length = 0;
+        
+        for( const auto & item: this->impl->_items )
+        {
+            if( item._data.size() == 0 )
+            {
+                throw std::runtime_error( "Cannot write - No data for item " + std::to_string( item._itemID ) );
+            }
+            
+            size  += item._data.size();
+            length = std::max< uint64_t >( length, item._data.size() );
+        }
+        
+        ftyp = std::make_shared< FTYP >();
+        
+        ftyp->SetMajorBrand( "heic" );
+        ftyp->SetMinorVersion( 0 );
+        ftyp->AddCompatibleBrand( "mif1" );
+        ftyp->AddCompatibleBrand( "heic" );
+        
+        meta   = this->impl->CreateMeta( primaryItemID, iloc, extents );
+        header = ( size + 8 > ( std::numeric_limits< uint32_t >::max )() ) ? 16 : 8;
+        
+        /* First pass: sizes the META box with the final field sizes */
+        iloc->SetLengthSize( ( length > ( std::numeric_limits< uint32_t >::max )() ) ? 8 : 4 );
+        iloc->SetOffsetSize( 4 );
+        
+        if( ftyp->GetSerializedSize() + meta->GetSerializedSize() + header + size > ( std::numeric_limits< uint32_t >::max )() )
+        {
+            iloc->SetOffsetSize( 8 );
+        }
+        
+        /* Second pass: the offset fields have a fixed size, so the META size is final */
+        offset = ftyp->GetSerializedSize() + meta->GetSerializedSize() + header;
+        
+        for( size_t i = 0; i < extents.size(); i++ )
+        {
+            extents[ i ]->SetOffset( offset );
+            
+            offset += this->impl->_items[ i ]._data.size();
+        }
+        
+        ftyp->Write( stream );
+        meta->Write( stream );
+        
+        if( header == 16 )
+        {
+            stream.WriteBigEndianUInt32( 1 );
+            stream.WriteFourCC( "mdat" );
+            stream.WriteBigEndianUInt64( size + 16 );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( size + 8 ) );
+            stream.WriteFourCC( "mdat" );
+        }
+        
+        for( const auto & item: this->impl->_items )
+        {
+            stream.Write( item._data.data(), item._data.size() );
+        }
+        
+        stream.Flush();
+    }
+    
+    void HEIFWriter::Write( const std::string & path ) const
+    {
+        BinaryFileOutputStream stream( path );
+        
+        this->Write( stream );
+    }
+    
+    HEIFWriter::IMPL::IMPL():
+        _primaryItemID( 0 )
+    {}
+    
+    HEIFWriter::IMPL::IMPL( const IMPL & o ):
+        _items( o._items ),
+        _properties( o._properties ),
+        _propertyIndices( o._propertyIndices ),
+        _references( o._references ),
+        _primaryItemID( o._primaryItemID )
+    {}
+    
+    HEIFWriter::IMPL::~IMPL()
+    {}
+    
+    HEIFWriter::IMPL::Item & HEIFWriter::IMPL::GetItem( uint32_t itemID )
+    {
+        if( itemID == 0 || itemID > this->_items.size() )
+        {
+            throw std::runtime_error( "Invalid item ID: " + std::to_string( itemID ) );
+        }
+        
+        return this->_items[ itemID - 1 ];
+    }
+    
+    void HEIFWriter::IMPL::AddProperty( Item & item, std::shared_ptr< Box > property, bool essential )
+    {
+        BinaryDataOutputStream stream;
+        std::shared_ptr< Box > encoded;
+        size_t                 index;
+        size_t                 header;
+        
+        property->Write( stream );
+        
+        /* Identical properties are shared */
+        {
+            auto it = this->_propertyIndices.find( stream.GetData() );
+            
+            if( it == this->_propertyIndices.end() )
+            {
+                /*
+                 * The property is kept as encoded now, so a property read
+                 * from a file is never copied from it, and the size of
+                 * the META box cannot change before it is written.
+                 */
+                header  = ( stream.GetData().size() > ( std::numeric_limits< uint32_t >::max )() ) ? 16 : 8;
+                encoded = std::make_shared< Box >( property->GetName() );
+                
+                encoded->SetData( std::vector< uint8_t >( stream.GetData().begin() + static_cast< std::ptrdiff_t >( header ), stream.GetData().end() ) );
+                
+                this->_properties.push_back( encoded );
+                
+                index = this->_properties.size();
+                
+                this->_propertyIndices[ stream.GetData() ] = index;
+            }
+            else
+            {
+                index = it->second;
+            }
+        }
+        
+        if( index > 0x7FFF || item._properties.size() == 0xFF )
+        {
+            throw std::runtime_error( "Cannot add property - Too many properties" );
+        }
+        
+        item._properties.push_back( { index, essential } );
+    }
+    
+    std::shared_ptr< META > HEIFWriter::IMPL::CreateMeta( uint32_t primaryItemID, std::shared_ptr< ILOC > & iloc, std::vector< std::shared_ptr< ILOC::Item::Extent > > & extents ) const
+    {
+        std::shared_ptr< META >         meta;
+        std::shared_ptr< HDLR >         hdlr;
+        std::shared_ptr< PITM >         pitm;
+        std::shared_ptr< IINF >         iinf;
+        std::shared_ptr< IREF >         iref;
+        std::shared_ptr< ContainerBox > iprp;
+        std::shared_ptr< IPCO >         ipco;
+        std::shared_ptr< IPMA >         ipma;
+        bool                            large;
+        
+        /* Item IDs are sequential, so the last one is the largest */
+        large = this->_items.size() > 0xFFFF;
+        meta  = std::make_shared< META >();
+        hdlr  = std::make_shared< HDLR >();
+        pitm  = std::make_shared< PITM >();
+        iloc  = std::make_shared< ILOC >();
+        iinf  = std::make_shared< IINF >();
+        iprp  = std::make_shared< ContainerBox >( "iprp" );
+        ipco  = std::make_shared< IPCO >();
+        ipma  = std::make_shared< IPMA >();
+        
+        extents.clear();
+        
+        hdlr->SetHandlerType( "pict" );
+        hdlr->SetHandlerName( "" );
+        pitm->SetVersion( ( large ) ? 1 : 0 );
+        pitm->SetItemID( primaryItemID );
+        iloc->SetVersion( ( large ) ? 2 : 0 );
+        iinf->SetVersion( ( large ) ? 1 : 0 );
+        ipma->SetVersion( ( large ) ? 1 : 0 );
+        ipma->SetFlags( ( this->_properties.size() > 0x7F ) ? 1 : 0 );
+        
+        for( const auto & item: this->_items )
+        {
+            std::shared_ptr< ILOC::Item >         location;
+            std::shared_ptr< ILOC::Item::Extent > extent;
+            std::shared_ptr< INFE >               infe;
+            std::shared_ptr< IPMA::Entry >        entry;
+            
+            location = std::make_shared< ILOC::Item >();
+            extent   = std::make_shared< ILOC::Item::Extent >();
+            infe     = std::make_shared< INFE >();
+            entry    = std::make_shared< IPMA::Entry >();
+            
+            extent->SetLength( item._data.size() );
+            location->SetItemID( item._itemID );
+            location->SetDataReferenceIndex( 0 );
+            location->AddExtent( extent );
+            iloc->AddItem( location );
+            extents.push_back( extent );
+            
+            /* Flag 1: hidden item */
+            infe->SetVersion( ( large ) ? 3 : 2 );
+            infe->SetFlags( ( item._hidden ) ? 1 : 0 );
+            infe->SetItemID( item._itemID );
+            infe->SetItemType( item._itemType );
+            iinf->AddEntry( infe );
+            
+            entry->SetItemID( item._itemID );
+            
+            for( const auto & property: item._properties )
+            {
+                std::shared_ptr< IPMA::Entry::Association > association;
+                
+                association = std::make_shared< IPMA::Entry::Association >();
+                
+                association->SetPropertyIndex( static_cast< uint16_t >( property.first ) );
+                association->SetEssential( property.second );
+                entry->AddAssociation( association );
+            }
+            
+            if( item._properties.size() > 0 )
+            {
+                ipma->AddEntry( entry );
+            }
+        }
+        
+        for( const auto & property: this->_properties )
+        {
+            ipco->AddBox( property );
+        }
+        
+        iprp->AddBox( ipco );
+        iprp->AddBox( ipma );
+        meta->AddBox( hdlr );
+        meta->AddBox( pitm );
+        meta->AddBox( iloc );
+        meta->AddBox( iinf );
+        
+        if( this->_references.size() > 0 )
+        {
+            iref = std::make_shared< IREF >();
+            
+            iref->SetVersion( ( large ) ? 1 : 0 );
+            
+            for( const auto & reference: this->_references )
+            {
+                std::shared_ptr< SingleItemTypeReferenceBox > box;
+                
+                box = std::make_shared< SingleItemTypeReferenceBox >( reference._type );
+                
+                box->SetVersion( ( large ) ? 1 : 0 );
+                box->SetFromItemID( reference._fromItemID );
+                
+                for( uint32_t id: reference._toItemIDs )
+                {
+                    box->AddToItemID( id );
+                }
+                
+                iref->AddBox( box );
+            }
+            
+            meta->AddBox( iref );
+        }
+        
+        meta->AddBox( iprp );
+        
+        return meta;
+    }
+}
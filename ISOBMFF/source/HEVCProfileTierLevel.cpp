@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        HEVCProfileTierLevel.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/HEVCProfileTierLevel.hpp>
+
+namespace ISOBMFF
+{
+    class HEVCProfileTierLevel::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint8_t  _generalProfileSpace;
+            bool     _generalTierFlag;
+            uint8_t  _generalProfileIDC;
+            uint32_t _generalProfileCompatibilityFlags;
+            uint64_t _generalConstraintIndicatorFlags;
+            uint8_t  _generalLevelIDC;
+    };
+    
+    HEVCProfileTierLevel::HEVCProfileTierLevel():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    HEVCProfileTierLevel::HEVCProfileTierLevel( BitReader & reader, uint8_t maxSubLayersMinusOne ):
+        impl( std::make_unique< IMPL >() )
+    {
+        bool profilePresent[ 8 ] = {};
+        bool levelPresent[ 8 ]   = {};
+        
+        this->impl->_generalProfileSpace              = static_cast< uint8_t >( reader.ReadBits( 2 ) );
+        this->impl->_generalTierFlag                  = reader.ReadFlag();
+        this->impl->_generalProfileIDC                = static_cast< uint8_t >( reader.ReadBits( 5 ) );
+        this->impl->_generalProfileCompatibilityFlags = reader.ReadBits( 32 );
+        this->impl->_generalConstraintIndicatorFlags  = ( static_cast< uint64_t >( reader.ReadBits( 16 ) ) << 32 ) | reader.ReadBits( 32 );
+        this->impl->_generalLevelIDC                  = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+        
+        for( uint8_t i = 0; i < maxSubLayersMinusOne && i < 8; i++ )
+        {
+            profilePresent[ i ] = reader.ReadFlag();
+            levelPresent[ i ]   = reader.ReadFlag();
+        }
+        
+        if( maxSubLayersMinusOne > 0 )
+        {
+            for( uint8_t i = maxSubLayersMinusOne; i < 8; i++ )
+            {
+                reader.SkipBits( 2 );
+            }
+        }
+        
+        for( uint8_t i = 0; i < maxSubLayersMinusOne && i < 8; i++ )
+        {
+            if( profilePresent[ i ] )
+            {
+                reader.SkipBits( 88 );
+            }
+            
+            if( levelPresent[ i ] )
+            {
+                reader.SkipBits( 8 );
+            }
+        }
+    }
+    
+    HEVCProfileTierLevel::HEVCProfileTierLevel( const HEVCProfileTierLevel & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    HEVCProfileTierLevel::HEVCProfileTierLevel( HEVCProfileTierLevel && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    HEVCProfileTierLevel::~HEVCProfileTierLevel()
+    {}
+    
+    HEVCProfileTierLevel & HEVCProfileTierLevel::operator =( HEVCProfileTierLevel o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( HEVCProfileTierLevel & o1, HEVCProfileTierLevel & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint8_t HEVCProfileTierLevel::GetGeneralProfileSpace() const
+    {
+        return this->impl->_generalProfileSpace;
+    }
+    
+    bool HEVCProfileTierLevel::GetGeneralTierFlag() const
+    {
+        return this->impl->_generalTierFlag;
+    }
+    
+    uint8_t HEVCProfileTierLevel::GetGeneralProfileIDC() const
+    {
+        return this->impl->_generalProfileIDC;
+    }
+    
+    uint32_t HEVCProfileTierLevel::GetGeneralProfileCompatibilityFlags() const
+    {
+        return this->impl->_generalProfileCompatibilityFlags;
+    }
+    
+    uint64_t HEVCProfileTierLevel::GetGeneralConstraintIndicatorFlags() const
+    {
+        return this->impl->_generalConstraintIndicatorFlags;
+    }
+    
+    uint8_t HEVCProfileTierLevel::GetGeneralLevelIDC() const
+    {
+        return this->impl->_generalLevelIDC;
+    }
+    
+    HEVCProfileTierLevel::IMPL::IMPL():
+        _generalProfileSpace( 0 ),
+        _generalTierFlag( false ),
+        _generalProfileIDC( 0 ),
+        _generalProfileCompatibilityFlags( 0 ),
+        _generalConstraintIndicatorFlags( 0 ),
+        _generalLevelIDC( 0 )
+    {}
+    
+    HEVCProfileTierLevel::IMPL::IMPL( const IMPL & o ):
+        _generalProfileSpace( o._generalProfileSpace ),
+        _generalTierFlag( o._generalTierFlag ),
+        _generalProfileIDC( o._generalProfileIDC ),
+        _generalProfileCompatibilityFlags( o._generalProfileCompatibilityFlags ),
+        _generalConstraintIndicatorFlags( o._generalConstraintIndicatorFlags ),
+        _generalLevelIDC( o._generalLevelIDC )
+    {}
+    
+    HEVCProfileTierLevel::IMPL::~IMPL()
+    {}
+}
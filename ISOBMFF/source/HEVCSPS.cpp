@@ -0,0 +1,597 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        HEVCSPS.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/HEVCSPS.hpp>
+#include <ISOBMFF/BitReader.hpp>
+#include <ISOBMFF/NAL.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace ISOBMFF
+{
+    class HEVCSPS::IMPL
+    {
+        public:
+            
+            IMPL( const uint8_t * data, size_t size );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void ReadScalingListData( BitReader & reader );
+            void ReadShortTermRefPicSets( BitReader & reader, uint32_t count );
+            void ReadVUI( BitReader & reader );
+            
+            static std::vector< uint8_t > GetNALUnit( const HVCC & hvcC );
+            
+            uint8_t              _vpsID;
+            uint8_t              _maxSubLayersMinusOne;
+            HEVCProfileTierLevel _profileTierLevel;
+            uint32_t             _spsID;
+            uint32_t             _chromaFormatIDC;
+            bool                 _separateColourPlaneFlag;
+            uint32_t             _picWidthInLumaSamples;
+            uint32_t             _picHeightInLumaSamples;
+            uint32_t             _conformanceWindowLeftOffset;
+            uint32_t             _conformanceWindowRightOffset;
+            uint32_t             _conformanceWindowTopOffset;
+            uint32_t             _conformanceWindowBottomOffset;
+            uint8_t              _bitDepthLuma;
+            uint8_t              _bitDepthChroma;
+            bool                 _hasVUI;
+            uint16_t             _sarWidth;
+            uint16_t             _sarHeight;
+            bool                 _hasColourDescription;
+            bool                 _videoFullRangeFlag;
+            uint8_t              _colourPrimaries;
+            uint8_t              _transferCharacteristics;
+            uint8_t              _matrixCoefficients;
+            bool                 _hasTimingInfo;
+            uint32_t             _numUnitsInTick;
+            uint32_t             _timeScale;
+    };
+    
+    HEVCSPS::HEVCSPS( const uint8_t * data, size_t size ):
+        impl( std::make_unique< IMPL >( data, size ) )
+    {}
+    
+    HEVCSPS::HEVCSPS( const HVCC & hvcC ):
+        impl( nullptr )
+    {
+        std::vector< uint8_t > data( IMPL::GetNALUnit( hvcC ) );
+        
+        this->impl = std::make_unique< IMPL >( data.data(), data.size() );
+    }
+    
+    HEVCSPS::HEVCSPS( const HEVCSPS & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    HEVCSPS::HEVCSPS( HEVCSPS && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    HEVCSPS::~HEVCSPS()
+    {}
+    
+    HEVCSPS & HEVCSPS::operator =( HEVCSPS o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( HEVCSPS & o1, HEVCSPS & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint8_t HEVCSPS::GetVPSID() const
+    {
+        return this->impl->_vpsID;
+    }
+    
+    uint8_t HEVCSPS::GetMaxSubLayersMinusOne() const
+    {
+        return this->impl->_maxSubLayersMinusOne;
+    }
+    
+    HEVCProfileTierLevel HEVCSPS::GetProfileTierLevel() const
+    {
+        return this->impl->_profileTierLevel;
+    }
+    
+    uint32_t HEVCSPS::GetSPSID() const
+    {
+        return this->impl->_spsID;
+    }
+    
+    uint32_t HEVCSPS::GetChromaFormatIDC() const
+    {
+        return this->impl->_chromaFormatIDC;
+    }
+    
+    bool HEVCSPS::GetSeparateColourPlaneFlag() const
+    {
+        return this->impl->_separateColourPlaneFlag;
+    }
+    
+    uint32_t HEVCSPS::GetPicWidthInLumaSamples() const
+    {
+        return this->impl->_picWidthInLumaSamples;
+    }
+    
+    uint32_t HEVCSPS::GetPicHeightInLumaSamples() const
+    {
+        return this->impl->_picHeightInLumaSamples;
+    }
+    
+    uint32_t HEVCSPS::GetConformanceWindowLeftOffset() const
+    {
+        return this->impl->_conformanceWindowLeftOffset;
+    }
+    
+    uint32_t HEVCSPS::GetConformanceWindowRightOffset() const
+    {
+        return this->impl->_conformanceWindowRightOffset;
+    }
+    
+    uint32_t HEVCSPS::GetConformanceWindowTopOffset() const
+    {
+        return this->impl->_conformanceWindowTopOffset;
+    }
+    
+    uint32_t HEVCSPS::GetConformanceWindowBottomOffset() const
+    {
+        return this->impl->_conformanceWindowBottomOffset;
+    }
+    
+    uint8_t HEVCSPS::GetBitDepthLuma() const
+    {
+        return this->impl->_bitDepthLuma;
+    }
+    
+    uint8_t HEVCSPS::GetBitDepthChroma() const
+    {
+        return this->impl->_bitDepthChroma;
+    }
+    
+    bool HEVCSPS::HasVUI() const
+    {
+        return this->impl->_hasVUI;
+    }
+    
+    uint16_t HEVCSPS::GetSARWidth() const
+    {
+        return this->impl->_sarWidth;
+    }
+    
+    uint16_t HEVCSPS::GetSARHeight() const
+    {
+        return this->impl->_sarHeight;
+    }
+    
+    bool HEVCSPS::HasColourDescription() const
+    {
+        return this->impl->_hasColourDescription;
+    }
+    
+    bool HEVCSPS::GetVideoFullRangeFlag() const
+    {
+        return this->impl->_videoFullRangeFlag;
+    }
+    
+    uint8_t HEVCSPS::GetColourPrimaries() const
+    {
+        return this->impl->_colourPrimaries;
+    }
+    
+    uint8_t HEVCSPS::GetTransferCharacteristics() const
+    {
+        return this->impl->_transferCharacteristics;
+    }
+    
+    uint8_t HEVCSPS::GetMatrixCoefficients() const
+    {
+        return this->impl->_matrixCoefficients;
+    }
+    
+    bool HEVCSPS::HasTimingInfo() const
+    {
+        return this->impl->_hasTimingInfo;
+    }
+    
+    uint32_t HEVCSPS::GetNumUnitsInTick() const
+    {
+        return this->impl->_numUnitsInTick;
+    }
+    
+    uint32_t HEVCSPS::GetTimeScale() const
+    {
+        return this->impl->_timeScale;
+    }
+    
+    uint32_t HEVCSPS::GetWidth() const
+    {
+        uint32_t subWidth;
+        uint64_t crop;
+        
+        subWidth = ( this->impl->_chromaFormatIDC == 1 || this->impl->_chromaFormatIDC == 2 ) && this->impl->_separateColourPlaneFlag == false ? 2 : 1;
+        crop     = static_cast< uint64_t >( subWidth ) * ( static_cast< uint64_t >( this->impl->_conformanceWindowLeftOffset ) + this->impl->_conformanceWindowRightOffset );
+        
+        return ( crop >= this->impl->_picWidthInLumaSamples ) ? 0 : this->impl->_picWidthInLumaSamples - static_cast< uint32_t >( crop );
+    }
+    
+    uint32_t HEVCSPS::GetHeight() const
+    {
+        uint32_t subHeight;
+        uint64_t crop;
+        
+        subHeight = ( this->impl->_chromaFormatIDC == 1 && this->impl->_separateColourPlaneFlag == false ) ? 2 : 1;
+        crop      = static_cast< uint64_t >( subHeight ) * ( static_cast< uint64_t >( this->impl->_conformanceWindowTopOffset ) + this->impl->_conformanceWindowBottomOffset );
+        
+        return ( crop >= this->impl->_picHeightInLumaSamples ) ? 0 : this->impl->_picHeightInLumaSamples - static_cast< uint32_t >( crop );
+    }
+    
+    double HEVCSPS::GetFrameRate() const
+    {
+        if( this->impl->_hasTimingInfo == false || this->impl->_numUnitsInTick == 0 )
+        {
+            return 0;
+        }
+        
+        return static_cast< double >( this->impl->_timeScale ) / static_cast< double >( this->impl->_numUnitsInTick );
+    }
+    
+    HEVCSPS::IMPL::IMPL( const uint8_t * data, size_t size ):
+        _vpsID( 0 ),
+        _maxSubLayersMinusOne( 0 ),
+        _spsID( 0 ),
+        _chromaFormatIDC( 0 ),
+        _separateColourPlaneFlag( false ),
+        _picWidthInLumaSamples( 0 ),
+        _picHeightInLumaSamples( 0 ),
+        _conformanceWindowLeftOffset( 0 ),
+        _conformanceWindowRightOffset( 0 ),
+        _conformanceWindowTopOffset( 0 ),
+        _conformanceWindowBottomOffset( 0 ),
+        _bitDepthLuma( 8 ),
+        _bitDepthChroma( 8 ),
+        _hasVUI( false ),
+        _sarWidth( 0 ),
+        _sarHeight( 0 ),
+        _hasColourDescription( false ),
+        _videoFullRangeFlag( false ),
+        _colourPrimaries( 2 ),
+        _transferCharacteristics( 2 ),
+        _matrixCoefficients( 2 ),
+        _hasTimingInfo( false ),
+        _numUnitsInTick( 0 ),
+        _timeScale( 0 )
+    {
+        std::vector< uint8_t > rbsp;
+        bool                   subLayerOrderingInfoPresent;
+        uint32_t               log2MaxPicOrderCntLSB;
+        uint32_t               numShortTermRefPicSets;
+        uint32_t               numLongTermRefPics;
+        
+        if( size < 2 || ( ( data[ 0 ] >> 1 ) & 0x3F ) != 33 )
+        {
+            throw std::runtime_error( "Data is not an HEVC SPS NAL unit" );
+        }
+        
+        rbsp.resize( size - 2 );
+        rbsp.resize( NAL::RemoveEmulationPrevention( data + 2, size - 2, rbsp.data() ) );
+        
+        BitReader reader( rbsp.data(), rbsp.size() );
+        
+        this->_vpsID                = static_cast< uint8_t >( reader.ReadBits( 4 ) );
+        this->_maxSubLayersMinusOne = static_cast< uint8_t >( reader.ReadBits( 3 ) );
+        
+        reader.SkipBits( 1 );
+        
+        this->_profileTierLevel = HEVCProfileTierLevel( reader, this->_maxSubLayersMinusOne );
+        this->_spsID            = reader.ReadUE();
+        this->_chromaFormatIDC  = reader.ReadUE();
+        
+        if( this->_chromaFormatIDC == 3 )
+        {
+            this->_separateColourPlaneFlag = reader.ReadFlag();
+        }
+        
+        this->_picWidthInLumaSamples  = reader.ReadUE();
+        this->_picHeightInLumaSamples = reader.ReadUE();
+        
+        if( reader.ReadFlag() )
+        {
+            this->_conformanceWindowLeftOffset   = reader.ReadUE();
+            this->_conformanceWindowRightOffset  = reader.ReadUE();
+            this->_conformanceWindowTopOffset    = reader.ReadUE();
+            this->_conformanceWindowBottomOffset = reader.ReadUE();
+        }
+        
+        this->_bitDepthLuma         = static_cast< uint8_t >( reader.ReadUE() + 8 );
+        this->_bitDepthChroma       = static_cast< uint8_t >( reader.ReadUE() + 8 );
+        log2MaxPicOrderCntLSB       = reader.ReadUE() + 4;
+        subLayerOrderingInfoPresent = reader.ReadFlag();
+        
+        if( log2MaxPicOrderCntLSB > 16 )
+        {
+            throw std::runtime_error( "Invalid HEVC SPS" );
+        }
+        
+        for( uint8_t i = ( subLayerOrderingInfoPresent ) ? 0 : this->_maxSubLayersMinusOne; i <= this->_maxSubLayersMinusOne; i++ )
+        {
+            reader.ReadUE();
+            reader.ReadUE();
+            reader.ReadUE();
+        }
+        
+        /*
+         * Coding block and transform sizes.
+         */
+        for( int i = 0; i < 6; i++ )
+        {
+            reader.ReadUE();
+        }
+        
+        if( reader.ReadFlag() && reader.ReadFlag() )
+        {
+            this->ReadScalingListData( reader );
+        }
+        
+        reader.SkipBits( 2 );
+        
+        if( reader.ReadFlag() )
+        {
+            reader.SkipBits( 8 );
+            reader.ReadUE();
+            reader.ReadUE();
+            reader.SkipBits( 1 );
+        }
+        
+        numShortTermRefPicSets = reader.ReadUE();
+        
+        this->ReadShortTermRefPicSets( reader, numShortTermRefPicSets );
+        
+        if( reader.ReadFlag() )
+        {
+            numLongTermRefPics = reader.ReadUE();
+            
+            if( numLongTermRefPics > 32 )
+            {
+                throw std::runtime_error( "Invalid HEVC SPS" );
+            }
+            
+            for( uint32_t i = 0; i < numLongTermRefPics; i++ )
+            {
+                reader.SkipBits( log2MaxPicOrderCntLSB + 1 );
+            }
+        }
+        
+        reader.SkipBits( 2 );
+        
+        this->_hasVUI = reader.ReadFlag();
+        
+        if( this->_hasVUI )
+        {
+            this->ReadVUI( reader );
+        }
+    }
+    
+    HEVCSPS::IMPL::IMPL( const IMPL & o ):
+        _vpsID( o._vpsID ),
+        _maxSubLayersMinusOne( o._maxSubLayersMinusOne ),
+        _profileTierLevel( o._profileTierLevel ),
+        _spsID( o._spsID ),
+        _chromaFormatIDC( o._chromaFormatIDC ),
+        _separateColourPlaneFlag( o._separateColourPlaneFlag ),
+        _picWidthInLumaSamples( o._picWidthInLumaSamples ),
+        _picHeightInLumaSamples( o._picHeightInLumaSamples ),
+        _conformanceWindowLeftOffset( o._conformanceWindowLeftOffset ),
+        _conformanceWindowRightOffset( o._conformanceWindowRightOffset ),
+        _conformanceWindowTopOffset( o._conformanceWindowTopOffset ),
+        _conformanceWindowBottomOffset( o._conformanceWindowBottomOffset ),
+        _bitDepthLuma( o._bitDepthLuma ),
+        _bitDepthChroma( o._bitDepthChroma ),
+        _hasVUI( o._hasVUI ),
+        _sarWidth( o._sarWidth ),
+        _sarHeight( o._sarHeight ),
+        _hasColourDescription( o._hasColourDescription ),
+        _videoFullRangeFlag( o._videoFullRangeFlag ),
+        _colourPrimaries( o._colourPrimaries ),
+        _transferCharacteristics( o._transferCharacteristics ),
+        _matrixCoefficients( o._matrixCoefficients ),
+        _hasTimingInfo( o._hasTimingInfo ),
+        _numUnitsInTick( o._numUnitsInTick ),
+        _timeScale( o._timeScale )
+    {}
+    
+    HEVCSPS::IMPL::~IMPL()
+    {}
+    
+    void HEVCSPS::IMPL::ReadScalingListData( BitReader & reader )
+    {
+        size_t coefficients;
+        
+        for( unsigned int sizeID = 0; sizeID < 4; sizeID++ )
+        {
+            for( unsigned int matrixID = 0; matrixID < 6; matrixID += ( sizeID == 3 ) ? 3 : 1 )
+            {
+                if( reader.ReadFlag() == false )
+                {
+                    reader.ReadUE();
+                    
+                    continue;
+                }
+                
+                coefficients = std::min< size_t >( 64, static_cast< size_t >( 1 ) << ( 4 + ( sizeID << 1 ) ) );
+                
+                if( sizeID > 1 )
+                {
+                    reader.ReadSE();
+                }
+                
+                for( size_t i = 0; i < coefficients; i++ )
+                {
+                    reader.ReadSE();
+                }
+            }
+        }
+    }
+    
+    void HEVCSPS::IMPL::ReadShortTermRefPicSets( BitReader & reader, uint32_t count )
+    {
+        std::vector< uint32_t > numDeltaPOCs;
+        uint32_t                negative;
+        uint32_t                positive;
+        uint32_t                n;
+        
+        if( count > 64 )
+        {
+            throw std::runtime_error( "Invalid HEVC SPS" );
+        }
+        
+        /*
+         * Sets may be predicted from the previous one, in which case their
+         * size depends on the number of pictures in the reference set.
+         */
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            if( i != 0 && reader.ReadFlag() )
+            {
+                reader.SkipBits( 1 );
+                reader.ReadUE();
+                
+                n = 0;
+                
+                for( uint32_t j = 0; j <= numDeltaPOCs[ i - 1 ]; j++ )
+                {
+                    if( reader.ReadFlag() || reader.ReadFlag() )
+                    {
+                        n++;
+                    }
+                }
+                
+                numDeltaPOCs.push_back( n );
+            }
+            else
+            {
+                negative = reader.ReadUE();
+                positive = reader.ReadUE();
+                
+                if( negative > 16 || positive > 16 )
+                {
+                    throw std::runtime_error( "Invalid HEVC SPS" );
+                }
+                
+                for( uint32_t j = 0; j < negative + positive; j++ )
+                {
+                    reader.ReadUE();
+                    reader.SkipBits( 1 );
+                }
+                
+                numDeltaPOCs.push_back( negative + positive );
+            }
+        }
+    }
+    
+    void HEVCSPS::IMPL::ReadVUI( BitReader & reader )
+    {
+        if( reader.ReadFlag() )
+        {
+            if( reader.ReadBits( 8 ) == 255 )
+            {
+                this->_sarWidth  = static_cast< uint16_t >( reader.ReadBits( 16 ) );
+                this->_sarHeight = static_cast< uint16_t >( reader.ReadBits( 16 ) );
+            }
+        }
+        
+        if( reader.ReadFlag() )
+        {
+            reader.SkipBits( 1 );
+        }
+        
+        if( reader.ReadFlag() )
+        {
+            reader.SkipBits( 3 );
+            
+            this->_videoFullRangeFlag   = reader.ReadFlag();
+            this->_hasColourDescription = reader.ReadFlag();
+            
+            if( this->_hasColourDescription )
+            {
+                this->_colourPrimaries         = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+                this->_transferCharacteristics = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+                this->_matrixCoefficients      = static_cast< uint8_t >( reader.ReadBits( 8 ) );
+            }
+        }
+        
+        if( reader.ReadFlag() )
+        {
+            reader.ReadUE();
+            reader.ReadUE();
+        }
+        
+        reader.SkipBits( 3 );
+        
+        if( reader.ReadFlag() )
+        {
+            reader.ReadUE();
+            reader.ReadUE();
+            reader.ReadUE();
+            reader.ReadUE();
+        }
+        
+        this->_hasTimingInfo = reader.ReadFlag();
+        
+        if( this->_hasTimingInfo )
+        {
+            this->_numUnitsInTick = reader.ReadBits( 32 );
+            this->_timeScale      = reader.ReadBits( 32 );
+        }
+    }
+    
+    std::vector< uint8_t > HEVCSPS::IMPL::GetNALUnit( const HVCC & hvcC )
+    {
+        for( const auto & array: hvcC.GetArrays() )
+        {
+            if( array->GetNALUnitType() == 33 && array->GetNALUnits().size() > 0 )
+            {
+                return array->GetNALUnits()[ 0 ]->GetData();
+            }
+        }
+        
+        throw std::runtime_error( "No SPS in HEVC decoder configuration" );
+    }
+}
@@ -0,0 +1,240 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        HEVCVPS.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/HEVCVPS.hpp>
+#include <ISOBMFF/BitReader.hpp>
+#include <ISOBMFF/NAL.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace ISOBMFF
+{
+    class HEVCVPS::IMPL
+    {
+        public:
+            
+            IMPL( const uint8_t * data, size_t size );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            static std::vector< uint8_t > GetNALUnit( const HVCC & hvcC );
+            
+            uint8_t              _vpsID;
+            uint8_t              _maxLayersMinusOne;
+            uint8_t              _maxSubLayersMinusOne;
+            bool                 _temporalIDNesting;
+            HEVCProfileTierLevel _profileTierLevel;
+            bool                 _hasTimingInfo;
+            uint32_t             _numUnitsInTick;
+            uint32_t             _timeScale;
+    };
+    
+    HEVCVPS::HEVCVPS( const uint8_t * data, size_t size ):
+        impl( std::make_unique< IMPL >( data, size ) )
+    {}
+    
+    HEVCVPS::HEVCVPS( const HVCC & hvcC ):
+        impl( nullptr )
+    {
+        std::vector< uint8_t > data( IMPL::GetNALUnit( hvcC ) );
+        
+        this->impl = std::make_unique< IMPL >( data.data(), data.size() );
+    }
+    
+    HEVCVPS::HEVCVPS( const HEVCVPS & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    HEVCVPS::HEVCVPS( HEVCVPS && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    HEVCVPS::~HEVCVPS()
+    {}
+    
+    HEVCVPS & HEVCVPS::operator =( HEVCVPS o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( HEVCVPS & o1, HEVCVPS & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint8_t HEVCVPS::GetVPSID() const
+    {
+        return this->impl->_vpsID;
+    }
+    
+    uint8_t HEVCVPS::GetMaxLayersMinusOne() const
+    {
+        return this->impl->_maxLayersMinusOne;
+    }
+    
+    uint8_t HEVCVPS::GetMaxSubLayersMinusOne() const
+    {
+        return this->impl->_maxSubLayersMinusOne;
+    }
+    
+    bool HEVCVPS::GetTemporalIDNesting() const
+    {
+        return this->impl->_temporalIDNesting;
+    }
+    
+    HEVCProfileTierLevel HEVCVPS::GetProfileTierLevel() const
+    {
+        return this->impl->_profileTierLevel;
+    }
+    
+    bool HEVCVPS::HasTimingInfo() const
+    {
+        return this->impl->_hasTimingInfo;
+    }
+    
+    uint32_t HEVCVPS::GetNumUnitsInTick() const
+    {
+        return this->impl->_numUnitsInTick;
+    }
+    
+    uint32_t HEVCVPS::GetTimeScale() const
+    {
+        return this->impl->_timeScale;
+    }
+    
+    double HEVCVPS::GetFrameRate() const
+    {
+        if( this->impl->_hasTimingInfo == false || this->impl->_numUnitsInTick == 0 )
+        {
+            return 0;
+        }
+        
+        return static_cast< double >( this->impl->_timeScale ) / static_cast< double >( this->impl->_numUnitsInTick );
+    }
+    
+    HEVCVPS::IMPL::IMPL( const uint8_t * data, size_t size ):
+        _vpsID( 0 ),
+        _maxLayersMinusOne( 0 ),
+        _maxSubLayersMinusOne( 0 ),
+        _temporalIDNesting( false ),
+        _hasTimingInfo( false ),
+        _numUnitsInTick( 0 ),
+        _timeScale( 0 )
+    {
+        std::vector< uint8_t > rbsp;
+        bool                   subLayerOrderingInfoPresent;
+        uint8_t                maxLayerID;
+        uint32_t               numLayerSetsMinusOne;
+        
+        if( size < 2 || ( ( data[ 0 ] >> 1 ) & 0x3F ) != 32 )
+        {
+            throw std::runtime_error( "Data is not an HEVC VPS NAL unit" );
+        }
+        
+        rbsp.resize( size - 2 );
+        rbsp.resize( NAL::RemoveEmulationPrevention( data + 2, size - 2, rbsp.data() ) );
+        
+        BitReader reader( rbsp.data(), rbsp.size() );
+        
+        this->_vpsID                = static_cast< uint8_t >( reader.ReadBits( 4 ) );
+        
+        reader.SkipBits( 2 );
+        
+        this->_maxLayersMinusOne    = static_cast< uint8_t >( reader.ReadBits( 6 ) );
+        this->_maxSubLayersMinusOne = static_cast< uint8_t >( reader.ReadBits( 3 ) );
+        this->_temporalIDNesting    = reader.ReadFlag();
+        
+        reader.SkipBits( 16 );
+        
+        this->_profileTierLevel     = HEVCProfileTierLevel( reader, this->_maxSubLayersMinusOne );
+        subLayerOrderingInfoPresent = reader.ReadFlag();
+        
+        for( uint8_t i = ( subLayerOrderingInfoPresent ) ? 0 : this->_maxSubLayersMinusOne; i <= this->_maxSubLayersMinusOne; i++ )
+        {
+            reader.ReadUE();
+            reader.ReadUE();
+            reader.ReadUE();
+        }
+        
+        maxLayerID           = static_cast< uint8_t >( reader.ReadBits( 6 ) );
+        numLayerSetsMinusOne = reader.ReadUE();
+        
+        if( numLayerSetsMinusOne > 1023 )
+        {
+            throw std::runtime_error( "Invalid HEVC VPS" );
+        }
+        
+        for( uint32_t i = 1; i <= numLayerSetsMinusOne; i++ )
+        {
+            reader.SkipBits( static_cast< size_t >( maxLayerID ) + 1 );
+        }
+        
+        this->_hasTimingInfo = reader.ReadFlag();
+        
+        if( this->_hasTimingInfo )
+        {
+            this->_numUnitsInTick = reader.ReadBits( 32 );
+            this->_timeScale      = reader.ReadBits( 32 );
+        }
+    }
+    
+    HEVCVPS::IMPL::IMPL( const IMPL & o ):
+        _vpsID( o._vpsID ),
+        _maxLayersMinusOne( o._maxLayersMinusOne ),
+        _maxSubLayersMinusOne( o._maxSubLayersMinusOne ),
+        _temporalIDNesting( o._temporalIDNesting ),
+        _profileTierLevel( o._profileTierLevel ),
+        _hasTimingInfo( o._hasTimingInfo ),
+        _numUnitsInTick( o._numUnitsInTick ),
+        _timeScale( o._timeScale )
+    {}
+    
+    HEVCVPS::IMPL::~IMPL()
+    {}
+    
+    std::vector< uint8_t > HEVCVPS::IMPL::GetNALUnit( const HVCC & hvcC )
+    {
+        for( const auto & array: hvcC.GetArrays() )
+        {
+            if( array->GetNALUnitType() == 32 && array->GetNALUnits().size() > 0 )
+            {
+                return array->GetNALUnits()[ 0 ]->GetData();
+            }
+        }
+        
+        throw std::runtime_error( "No VPS in HEVC decoder configuration" );
+    }
+}
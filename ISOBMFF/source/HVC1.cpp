@@ -30,6 +30,7 @@
 
 #include <ISOBMFF/HVC1.hpp>
 #include <ISOBMFF/ContainerBox.hpp>
+#include <cstring>
 
 namespace ISOBMFF
 {
@@ -50,7 +51,15 @@ namespace ISOBMFF
             std::string _compressorname;
             uint16_t _depth;
 
+            /* Kept as read, as QuickTime stores version and quality values there */
+            uint16_t _pre_defined1;
+            uint16_t _reserved1;
+            uint32_t _pre_defined2[ 3 ];
+            uint32_t _reserved2;
+            uint16_t _pre_defined3;
+            
             std::vector< std::shared_ptr< Box > > _boxes;
+            std::vector< uint8_t >                _trailingData;
     };
 
     HVC1::HVC1():
@@ -105,28 +114,66 @@ namespace ISOBMFF
         this->SetDataReferenceIndex( stream.ReadBigEndianUInt16() );
         // VisualSampleEntry
         // pre_defined1
-        stream.ReadBigEndianUInt16();
+        this->impl->_pre_defined1 = stream.ReadBigEndianUInt16();
         // reserved1
-        stream.ReadBigEndianUInt16();
+        this->impl->_reserved1 = stream.ReadBigEndianUInt16();
         // pre_defined2
-        stream.ReadBigEndianUInt32();
-        stream.ReadBigEndianUInt32();
-        stream.ReadBigEndianUInt32();
+        this->impl->_pre_defined2[ 0 ] = stream.ReadBigEndianUInt32();
+        this->impl->_pre_defined2[ 1 ] = stream.ReadBigEndianUInt32();
+        this->impl->_pre_defined2[ 2 ] = stream.ReadBigEndianUInt32();
         this->SetWidth( stream.ReadBigEndianUInt16() );
         this->SetHeight( stream.ReadBigEndianUInt16() );
         this->SetHorizResolution( stream.ReadBigEndianUInt32() );
         this->SetVertResolution( stream.ReadBigEndianUInt32() );
         // reserved2
-        stream.ReadBigEndianUInt32();
+        this->impl->_reserved2 = stream.ReadBigEndianUInt32();
         this->SetFrameCount( stream.ReadBigEndianUInt16() );
         this->SetCompressorName( stream.ReadString(32) );
         this->SetDepth( stream.ReadBigEndianUInt16() );
         // pre_defined3
-        stream.ReadBigEndianUInt16();
+        this->impl->_pre_defined3 = stream.ReadBigEndianUInt16();
 
         container.ReadData( parser, stream );
 
-        this->impl->_boxes = container.GetBoxes();
+        this->impl->_boxes        = container.GetBoxes();
+        this->impl->_trailingData = container.GetTrailingData();
+    }
+    
+    uint64_t HVC1::GetDataSize() const
+    {
+        return 78 + this->GetBoxesSize() + this->impl->_trailingData.size();
+    }
+    
+    void HVC1::WriteData( BinaryOutputStream & stream ) const
+    {
+        // SampleEntry
+        // reserved[]
+        stream.WriteBigEndianUInt32( 0 );
+        stream.WriteBigEndianUInt16( 0 );
+        // data_reference_index
+        stream.WriteBigEndianUInt16( this->GetDataReferenceIndex() );
+        
+        // VisualSampleEntry
+        // pre_defined1, reserved1, pre_defined2
+        stream.WriteBigEndianUInt16( this->impl->_pre_defined1 );
+        stream.WriteBigEndianUInt16( this->impl->_reserved1 );
+        stream.WriteBigEndianUInt32( this->impl->_pre_defined2[ 0 ] );
+        stream.WriteBigEndianUInt32( this->impl->_pre_defined2[ 1 ] );
+        stream.WriteBigEndianUInt32( this->impl->_pre_defined2[ 2 ] );
+        stream.WriteBigEndianUInt16( this->GetWidth() );
+        stream.WriteBigEndianUInt16( this->GetHeight() );
+        stream.WriteBigEndianUInt32( this->GetHorizResolution() );
+        stream.WriteBigEndianUInt32( this->GetVertResolution() );
+        // reserved2
+        stream.WriteBigEndianUInt32( this->impl->_reserved2 );
+        stream.WriteBigEndianUInt16( this->GetFrameCount() );
+        stream.WriteString( this->GetCompressorName(), 32 );
+        stream.WriteBigEndianUInt16( this->GetDepth() );
+        // pre_defined3
+        stream.WriteBigEndianUInt16( this->impl->_pre_defined3 );
+        
+        this->WriteBoxes( stream );
+        stream.Write( this->impl->_trailingData );
     }
 
     std::vector< std::pair< std::string, std::string > > HVC1::GetDisplayableProperties() const
@@ -195,41 +242,49 @@ namespace ISOBMFF
     void HVC1::SetDataReferenceIndex( uint16_t value )
     {
         this->impl->_data_reference_index = value;
+        this->SetModified( true );
     }
 
     void HVC1::SetWidth( uint16_t value )
     {
         this->impl->_width = value;
+        this->SetModified( true );
     }
 
     void HVC1::SetHeight( uint16_t value )
     {
         this->impl->_height = value;
+        this->SetModified( true );
     }
 
     void HVC1::SetHorizResolution( uint32_t value )
     {
         this->impl->_horizresolution = value;
+        this->SetModified( true );
     }
 
     void HVC1::SetVertResolution( uint32_t value )
     {
         this->impl->_vertresolution = value;
+        this->SetModified( true );
     }
 
     void HVC1::SetFrameCount( uint16_t value )
     {
         this->impl->_frame_count = value;
+        this->SetModified( true );
     }
 
     void HVC1::SetCompressorName( std::string value )
     {
         this->impl->_compressorname = value;
+        this->SetModified( true );
     }
 
     void HVC1::SetDepth( uint16_t value )
     {
         this->impl->_depth = value;
+        this->SetModified( true );
     }
 
     void HVC1::AddBox( std::shared_ptr< Box > box )
@@ -238,6 +293,8 @@ namespace ISOBMFF
         {
             this->impl->_boxes.push_back( box );
         }
+        
+        this->SetModified( true );
     }
 
     std::vector< std::shared_ptr< Box > > HVC1::GetBoxes() const
@@ -253,8 +310,14 @@ namespace ISOBMFF
         _vertresolution( 0 ),
         _frame_count( 0 ),
         _compressorname( "" ),
-        _depth( 0 )
-    {}
+        _depth( 0 ),
+        _pre_defined1( 0 ),
+        _reserved1( 0 ),
+        _reserved2( 0 ),
+        _pre_defined3( 0xFFFF )
+    {
+        memset( this->_pre_defined2, 0, sizeof( this->_pre_defined2 ) );
+    }
 
     HVC1::IMPL::IMPL( const IMPL & o ):
         _data_reference_index( o._data_reference_index ),
@@ -265,8 +328,15 @@ namespace ISOBMFF
         _frame_count( o._frame_count ),
         _compressorname( o._compressorname ),
         _depth( o._depth ),
-        _boxes( o._boxes )
-    {}
+        _pre_defined1( o._pre_defined1 ),
+        _reserved1( o._reserved1 ),
+        _reserved2( o._reserved2 ),
+        _pre_defined3( o._pre_defined3 ),
+        _boxes( o._boxes ),
+        _trailingData( o._trailingData )
+    {
+        memcpy( this->_pre_defined2, o._pre_defined2, sizeof( this->_pre_defined2 ) );
+    }
 
     HVC1::IMPL::~IMPL()
     {}
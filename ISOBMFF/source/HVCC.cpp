@@ -169,6 +169,82 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t HVCC::GetDataSize() const
+    {
+        uint64_t size;
+        
+        size = 23;
+        
+        for( const auto & array: this->GetArrays() )
+        {
+            size += 3;
+            
+            for( const auto & nal: array->GetNALUnits() )
+            {
+                size += 2 + nal->GetData().size();
+            }
+        }
+        
+        return size;
+    }
+    
+    void HVCC::WriteData( BinaryOutputStream & stream ) const
+    {
+        std::vector< std::shared_ptr< Array > > arrays;
+        uint64_t                                flags;
+        
+        arrays = this->GetArrays();
+        flags  = this->GetGeneralConstraintIndicatorFlags();
+        
+        stream.WriteUInt8( this->GetConfigurationVersion() );
+        stream.WriteUInt8
+        (
+            static_cast< uint8_t >
+            (
+                  ( ( this->GetGeneralProfileSpace() & 0x03 ) << 6 )
+                | ( ( this->GetGeneralTierFlag()     & 0x01 ) << 5 )
+                | ( ( this->GetGeneralProfileIDC()   & 0x1F ) )
+            )
+        );
+        stream.WriteBigEndianUInt32( this->GetGeneralProfileCompatibilityFlags() );
+        stream.WriteBigEndianUInt16( static_cast< uint16_t >( flags >> 32 ) );
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( flags ) );
+        stream.WriteUInt8( this->GetGeneralLevelIDC() );
+        stream.WriteBigEndianUInt16( static_cast< uint16_t >( 0xF000 | ( this->GetMinSpatialSegmentationIDC() & 0x0FFF ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xFC | ( this->GetParallelismType() & 0x03 ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xFC | ( this->GetChromaFormat() & 0x03 ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xF8 | ( this->GetBitDepthLumaMinus8() & 0x07 ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( 0xF8 | ( this->GetBitDepthChromaMinus8() & 0x07 ) ) );
+        stream.WriteBigEndianUInt16( this->GetAvgFrameRate() );
+        stream.WriteUInt8
+        (
+            static_cast< uint8_t >
+            (
+                  ( ( this->GetConstantFrameRate()  & 0x03 ) << 6 )
+                | ( ( this->GetNumTemporalLayers()  & 0x07 ) << 3 )
+                | ( ( this->GetTemporalIdNested()   & 0x01 ) << 2 )
+                | ( ( this->GetLengthSizeMinusOne() & 0x03 ) )
+            )
+        );
+        stream.WriteUInt8( static_cast< uint8_t >( arrays.size() ) );
+        
+        for( const auto & array: arrays )
+        {
+            std::vector< std::shared_ptr< Array::NALUnit > > units( array->GetNALUnits() );
+            
+            stream.WriteUInt8( static_cast< uint8_t >( ( ( array->GetArrayCompleteness() ) ? 0x80 : 0x00 ) | ( array->GetNALUnitType() & 0x3F ) ) );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( units.size() ) );
+            
+            for( const auto & nal: units )
+            {
+                std::vector< uint8_t > data( nal->GetData() );
+                
+                stream.WriteBigEndianUInt16( static_cast< uint16_t >( data.size() ) );
+                stream.Write( data );
+            }
+        }
+    }
+    
     void HVCC::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         Box::WriteDescription( os, indentLevel );
@@ -296,86 +372,103 @@ namespace ISOBMFF
     void HVCC::SetConfigurationVersion( uint8_t value )
     {
         this->impl->_configurationVersion = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetGeneralProfileSpace( uint8_t value )
     {
         this->impl->_generalProfileSpace = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetGeneralTierFlag( uint8_t value )
     {
         this->impl->_generalTierFlag = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetGeneralProfileIDC( uint8_t value )
     {
         this->impl->_generalProfileIDC = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetGeneralProfileCompatibilityFlags( uint32_t value )
     {
         this->impl->_generalProfileCompatibilityFlags = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetGeneralConstraintIndicatorFlags( uint64_t value )
     {
         this->impl->_generalConstraintIndicatorFlags = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetGeneralLevelIDC( uint8_t value )
     {
         this->impl->_generalLevelIDC = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetMinSpatialSegmentationIDC( uint16_t value )
     {
         this->impl->_minSpatialSegmentationIDC = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetParallelismType( uint8_t value )
     {
         this->impl->_parallelismType = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetChromaFormat( uint8_t value )
     {
         this->impl->_chromaFormat = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetBitDepthLumaMinus8( uint8_t value )
     {
         this->impl->_bitDepthLumaMinus8 = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetBitDepthChromaMinus8( uint8_t value )
     {
         this->impl->_bitDepthChromaMinus8 = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetAvgFrameRate( uint16_t value )
     {
         this->impl->_avgFrameRate = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetConstantFrameRate( uint8_t value )
     {
         this->impl->_constantFrameRate = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetNumTemporalLayers( uint8_t value )
     {
         this->impl->_numTemporalLayers = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetTemporalIdNested( uint8_t value )
     {
         this->impl->_temporalIdNested = value;
+        this->SetModified( true );
     }
     
     void HVCC::SetLengthSizeMinusOne( uint8_t value )
     {
         this->impl->_lengthSizeMinusOne = value;
+        this->SetModified( true );
     }
     
     std::vector< std::shared_ptr< HVCC::Array > > HVCC::GetArrays() const
@@ -386,6 +479,7 @@ namespace ISOBMFF
     void HVCC::AddArray( std::shared_ptr< Array > array )
     {
         this->impl->_arrays.push_back( array );
+        this->SetModified( true );
     }
 
     HVCC::IMPL::IMPL():
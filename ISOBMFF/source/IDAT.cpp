@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        IDAT.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/IDAT.hpp>
+
+namespace ISOBMFF
+{
+    class IDAT::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::vector< uint8_t > _data;
+    };
+    
+    IDAT::IDAT():
+        Box( "idat" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    IDAT::IDAT( const IDAT & o ):
+        Box( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    IDAT::IDAT( IDAT && o ) noexcept:
+        Box( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    IDAT::~IDAT()
+    {}
+    
+    IDAT & IDAT::operator =( IDAT o )
+    {
+        Box::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( IDAT & o1, IDAT & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< Box & >( o1 ), static_cast< Box & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void IDAT::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        ( void )parser;
+        
+        this->SetData( stream.ReadAllData() );
+    }
+    
+    uint64_t IDAT::GetDataSize() const
+    {
+        return this->impl->_data.size();
+    }
+    
+    void IDAT::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.Write( this->impl->_data );
+    }
+    
+    std::vector< uint8_t > IDAT::GetData() const
+    {
+        return this->impl->_data;
+    }
+    
+    std::vector< std::pair< std::string, std::string > > IDAT::GetDisplayableProperties() const
+    {
+        auto props( Box::GetDisplayableProperties() );
+        
+        props.push_back( { "Data size", std::to_string( this->GetDataSize() ) } );
+        
+        return props;
+    }
+    
+    const uint8_t * IDAT::GetDataBytes() const
+    {
+        if( this->impl->_data.size() == 0 )
+        {
+            return nullptr;
+        }
+        
+        return &( this->impl->_data[ 0 ] );
+    }
+    
+    void IDAT::SetData( const std::vector< uint8_t > & value )
+    {
+        this->impl->_data = value;
+        this->SetModified( true );
+    }
+    
+    IDAT::IMPL::IMPL()
+    {}
+    
+    IDAT::IMPL::IMPL( const IMPL & o ):
+        _data( o._data )
+    {}
+    
+    IDAT::IMPL::~IMPL()
+    {}
+}
@@ -108,6 +108,27 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t IINF::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + ( ( this->GetVersion() == 0 ) ? 2 : 4 ) + this->GetBoxesSize();
+    }
+    
+    void IINF::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetVersion() == 0 )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->impl->_entries.size() ) );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_entries.size() ) );
+        }
+        
+        this->WriteBoxes( stream );
+    }
+    
     void IINF::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         FullBox::WriteDescription( os, indentLevel );
@@ -120,6 +141,8 @@ namespace ISOBMFF
         {
             this->impl->_entries.push_back( entry );
         }
+        
+        this->SetModified( true );
     }
     
     std::vector< std::shared_ptr< INFE > > IINF::GetEntries() const
@@ -143,6 +166,7 @@ namespace ISOBMFF
     void IINF::AddBox( std::shared_ptr< Box > box )
     {
         this->AddEntry( std::dynamic_pointer_cast< INFE >( box ) );
+        this->SetModified( true );
     }
     
     std::vector< std::shared_ptr< Box > > IINF::GetBoxes() const
@@ -32,6 +32,18 @@
 
 namespace ISOBMFF
 {
+    /*
+     * Writes a big endian unsigned integer of 0 to 8 bytes, as used for
+     * the variable size fields of items and extents.
+     */
+    static void WriteBigEndian( BinaryOutputStream & stream, uint64_t value, size_t size )
+    {
+        for( size_t i = size; i > 0; i-- )
+        {
+            stream.WriteUInt8( static_cast< uint8_t >( value >> ( ( i - 1 ) * 8 ) ) );
+        }
+    }
+    
     class ILOC::IMPL
     {
         public:
@@ -118,6 +130,81 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t ILOC::GetDataSize() const
+    {
+        uint64_t size;
+        uint64_t extentSize;
+        
+        size       = FullBox::GetDataSize() + 2 + ( ( this->GetVersion() < 2 ) ? 2 : 4 );
+        extentSize = this->GetOffsetSize() + this->GetLengthSize();
+        
+        if( this->GetVersion() == 1 || this->GetVersion() == 2 )
+        {
+            extentSize += this->GetIndexSize();
+        }
+        
+        for( const auto & item: this->impl->_items )
+        {
+            size += ( this->GetVersion() < 2 ) ? 2 : 4;
+            size += ( this->GetVersion() == 1 || this->GetVersion() == 2 ) ? 2 : 0;
+            size += 2 + this->GetBaseOffsetSize() + 2;
+            size += extentSize * item->GetExtents().size();
+        }
+        
+        return size;
+    }
+    
+    void ILOC::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteUInt8( static_cast< uint8_t >( ( this->GetOffsetSize() << 4 ) | ( this->GetLengthSize() & 0xF ) ) );
+        stream.WriteUInt8( static_cast< uint8_t >( ( this->GetBaseOffsetSize() << 4 ) | ( this->GetIndexSize() & 0xF ) ) );
+        
+        if( this->GetVersion() < 2 )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->impl->_items.size() ) );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_items.size() ) );
+        }
+        
+        for( const auto & item: this->impl->_items )
+        {
+            std::vector< std::shared_ptr< Item::Extent > > extents( item->GetExtents() );
+            
+            if( this->GetVersion() < 2 )
+            {
+                stream.WriteBigEndianUInt16( static_cast< uint16_t >( item->GetItemID() ) );
+            }
+            else
+            {
+                stream.WriteBigEndianUInt32( item->GetItemID() );
+            }
+            
+            if( this->GetVersion() == 1 || this->GetVersion() == 2 )
+            {
+                stream.WriteBigEndianUInt16( item->GetConstructionMethod() & 0xF );
+            }
+            
+            stream.WriteBigEndianUInt16( item->GetDataReferenceIndex() );
+            WriteBigEndian( stream, item->GetBaseOffset(), this->GetBaseOffsetSize() );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( extents.size() ) );
+            
+            for( const auto & extent: extents )
+            {
+                if( this->GetVersion() == 1 || this->GetVersion() == 2 )
+                {
+                    WriteBigEndian( stream, extent->GetIndex(), this->GetIndexSize() );
+                }
+                
+                WriteBigEndian( stream, extent->GetOffset(), this->GetOffsetSize() );
+                WriteBigEndian( stream, extent->GetLength(), this->GetLengthSize() );
+            }
+        }
+    }
+    
     void ILOC::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         FullBox::WriteDescription( os, indentLevel );
@@ -172,21 +259,25 @@ namespace ISOBMFF
     void ILOC::SetOffsetSize( uint8_t value )
     {
         this->impl->_offsetSize = value;
+        this->SetModified( true );
     }
     
     void ILOC::SetLengthSize( uint8_t value )
     {
         this->impl->_lengthSize = value;
+        this->SetModified( true );
     }
     
     void ILOC::SetBaseOffsetSize( uint8_t value )
     {
         this->impl->_baseOffsetSize = value;
+        this->SetModified( true );
     }
     
     void ILOC::SetIndexSize( uint8_t value )
     {
         this->impl->_indexSize = value;
+        this->SetModified( true );
     }
     
     std::vector< std::shared_ptr< ILOC::Item > > ILOC::GetItems() const
@@ -210,6 +301,7 @@ namespace ISOBMFF
     void ILOC::AddItem( std::shared_ptr< Item > item )
     {
         this->impl->_items.push_back( item );
+        this->SetModified( true );
     }
 
     ILOC::IMPL::IMPL():
@@ -150,6 +150,8 @@ namespace ISOBMFF
             
             if( parser.GetPreferredStringType() == Parser::StringType::Pascal )
             {
+                this->SetItemName( stream.ReadPascalString() );
+                
                 if( this->GetItemType() == "mime" )
                 {
                     this->SetContentType( stream.ReadPascalString() );
@@ -162,6 +164,8 @@ namespace ISOBMFF
             }
             else
             {
+                this->SetItemName( stream.ReadNULLTerminatedString() );
+                
                 if( this->GetItemType() == "mime" )
                 {
                     this->SetContentType( stream.ReadNULLTerminatedString() );
@@ -175,6 +179,77 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t INFE::GetDataSize() const
+    {
+        uint64_t size;
+        
+        size = FullBox::GetDataSize();
+        
+        if( this->GetVersion() == 0 || this->GetVersion() == 1 )
+        {
+            size += 4;
+            size += this->impl->_itemName.size() + 1;
+            size += this->impl->_contentType.size() + 1;
+            size += this->impl->_contentEncoding.size() + 1;
+        }
+        else if( this->GetVersion() == 2 || this->GetVersion() == 3 )
+        {
+            size += ( this->GetVersion() == 2 ) ? 8 : 10;
+            size += this->impl->_itemName.size() + 1;
+            
+            if( this->GetItemType() == "mime" )
+            {
+                size += this->impl->_contentType.size() + 1;
+                size += this->impl->_contentEncoding.size() + 1;
+            }
+            else if( this->GetItemType() == "uri " )
+            {
+                size += this->impl->_itemURIType.size() + 1;
+            }
+        }
+        
+        return size;
+    }
+    
+    void INFE::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetVersion() == 0 || this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->GetItemID() ) );
+            stream.WriteBigEndianUInt16( this->GetItemProtectionIndex() );
+            stream.WriteNULLTerminatedString( this->GetItemName() );
+            stream.WriteNULLTerminatedString( this->GetContentType() );
+            stream.WriteNULLTerminatedString( this->GetContentEncoding() );
+        }
+        else if( this->GetVersion() == 2 || this->GetVersion() == 3 )
+        {
+            if( this->GetVersion() == 2 )
+            {
+                stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->GetItemID() ) );
+            }
+            else
+            {
+                stream.WriteBigEndianUInt32( this->GetItemID() );
+            }
+            
+            stream.WriteBigEndianUInt16( this->GetItemProtectionIndex() );
+            stream.WriteFourCC( this->GetItemType() );
+            stream.WriteNULLTerminatedString( this->GetItemName() );
+            
+            if( this->GetItemType() == "mime" )
+            {
+                stream.WriteNULLTerminatedString( this->GetContentType() );
+                stream.WriteNULLTerminatedString( this->GetContentEncoding() );
+            }
+            else if( this->GetItemType() == "uri " )
+            {
+                stream.WriteNULLTerminatedString( this->GetItemURIType() );
+            }
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > INFE::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -228,36 +303,43 @@ namespace ISOBMFF
     void INFE::SetItemID( uint32_t value )
     {
         this->impl->_itemID = value;
+        this->SetModified( true );
     }
     
     void INFE::SetItemProtectionIndex( uint16_t value )
     {
         this->impl->_itemProtectionIndex = value;
+        this->SetModified( true );
     }
     
     void INFE::SetItemType( const std::string & value )
     {
         this->impl->_itemType = value;
+        this->SetModified( true );
     }
     
     void INFE::SetItemName( const std::string & value )
     {
         this->impl->_itemName = value;
+        this->SetModified( true );
     }
     
     void INFE::SetContentType( const std::string & value )
     {
         this->impl->_contentType = value;
+        this->SetModified( true );
     }
     
     void INFE::SetContentEncoding( const std::string & value )
     {
         this->impl->_contentEncoding = value;
+        this->SetModified( true );
     }
     
     void INFE::SetItemURIType( const std::string & value )
     {
         this->impl->_itemURIType = value;
+        this->SetModified( true );
     }
     
     INFE::IMPL::IMPL():
@@ -94,6 +94,56 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t IPMA::GetDataSize() const
+    {
+        uint64_t size;
+        
+        size = FullBox::GetDataSize() + 4;
+        
+        for( const auto & entry: this->impl->_entries )
+        {
+            size += ( this->GetVersion() < 1 ) ? 3 : 5;
+            size += entry->GetAssociations().size() * ( ( this->GetFlags() & 0x01 ) ? 2 : 1 );
+        }
+        
+        return size;
+    }
+    
+    void IPMA::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_entries.size() ) );
+        
+        for( const auto & entry: this->impl->_entries )
+        {
+            std::vector< std::shared_ptr< Entry::Association > > associations( entry->GetAssociations() );
+            
+            if( this->GetVersion() < 1 )
+            {
+                stream.WriteBigEndianUInt16( static_cast< uint16_t >( entry->GetItemID() ) );
+            }
+            else
+            {
+                stream.WriteBigEndianUInt32( entry->GetItemID() );
+            }
+            
+            stream.WriteUInt8( static_cast< uint8_t >( associations.size() ) );
+            
+            for( const auto & association: associations )
+            {
+                if( this->GetFlags() & 0x01 )
+                {
+                    stream.WriteBigEndianUInt16( static_cast< uint16_t >( ( ( association->GetEssential() ) ? 0x8000 : 0 ) | ( association->GetPropertyIndex() & 0x7FFF ) ) );
+                }
+                else
+                {
+                    stream.WriteUInt8( static_cast< uint8_t >( ( ( association->GetEssential() ) ? 0x80 : 0 ) | ( association->GetPropertyIndex() & 0x7F ) ) );
+                }
+            }
+        }
+    }
+    
     void IPMA::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         FullBox::WriteDescription( os, indentLevel );
@@ -136,6 +186,7 @@ namespace ISOBMFF
     void IPMA::AddEntry( std::shared_ptr< Entry > entry )
     {
         this->impl->_entries.push_back( entry );
+        this->SetModified( true );
     }
 
     IPMA::IMPL::IMPL()
@@ -29,7 +29,8 @@
  */
 
 #include <ISOBMFF/IREF.hpp>
-#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/SingleItemTypeReferenceBox.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
 #include <ISOBMFF/Parser.hpp>
 
 namespace ISOBMFF
@@ -83,14 +84,73 @@ namespace ISOBMFF
     
     void IREF::ReadData( Parser & parser, BinaryStream & stream )
     {
-        ContainerBox container( "????" );
+        uint64_t               length;
+        uint64_t               header;
+        uint64_t               start;
+        uint64_t               base;
+        std::string            name;
+        std::shared_ptr< Box > box;
         
         FullBox::ReadData( parser, stream );
         parser.SetInfo( "iref", this );
-        container.ReadData( parser, stream );
+        
+        this->impl->_boxes.clear();
+        
+        base = parser.GetStreamOffset();
+        
+        while( stream.HasBytesAvailable() )
+        {
+            start  = stream.Tell();
+            length = stream.ReadBigEndianUInt32();
+            name   = stream.ReadFourCC();
+            header = 8;
+            
+            if( length == 1 )
+            {
+                length = stream.ReadBigEndianUInt64();
+                header = 16;
+            }
+            
+            if( length < header )
+            {
+                break;
+            }
+            
+            BinaryDataStream content( stream.Read( numeric_cast< size_t >( length - header ) ) );
+            
+            /*
+             * Reference types share their names with regular boxes (eg.
+             * 'iloc'), so anything that isn't a registered reference type
+             * is read as a generic item reference.
+             */
+            box = parser.CreateBox( name );
+            
+            if( std::dynamic_pointer_cast< SingleItemTypeReferenceBox >( box ) == nullptr )
+            {
+                box = std::make_shared< SingleItemTypeReferenceBox >( name );
+            }
+            
+            parser.SetStreamOffset( base + start + header );
+            box->ReadData( parser, content );
+            parser.SetStreamOffset( base );
+            
+            box->SetSource( base + start, length, header );
+            this->AddBox( box );
+        }
+        
         parser.SetInfo( "iref", nullptr );
+    }
+    
+    uint64_t IREF::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + this->GetBoxesSize();
+    }
+    
+    void IREF::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
         
-        this->impl->_boxes = container.GetBoxes();
+        this->WriteBoxes( stream );
     }
     
     void IREF::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
@@ -105,6 +165,8 @@ namespace ISOBMFF
         {
             this->impl->_boxes.push_back( box );
         }
+        
+        this->SetModified( true );
     }
     
     std::vector< std::shared_ptr< Box > > IREF::GetBoxes() const
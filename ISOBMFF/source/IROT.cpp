@@ -91,6 +91,16 @@ namespace ISOBMFF
         this->SetAngle( u8 & 0x3 );
     }
     
+    uint64_t IROT::GetDataSize() const
+    {
+        return 1;
+    }
+    
+    void IROT::WriteData( BinaryOutputStream & stream ) const
+    {
+        stream.WriteUInt8( this->GetAngle() & 0x3 );
+    }
+    
     std::vector< std::pair< std::string, std::string > > IROT::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
@@ -108,6 +118,7 @@ namespace ISOBMFF
     void IROT::SetAngle( uint8_t value )
     {
         this->impl->_angle = value;
+        this->SetModified( true );
     }
     
     IROT::IMPL::IMPL():
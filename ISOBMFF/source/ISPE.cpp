@@ -88,6 +88,19 @@ namespace ISOBMFF
         this->SetDisplayHeight( stream.ReadBigEndianUInt32() );
     }
     
+    uint64_t ISPE::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 8;
+    }
+    
+    void ISPE::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( this->GetDisplayWidth() );
+        stream.WriteBigEndianUInt32( this->GetDisplayHeight() );
+    }
+    
     std::vector< std::pair< std::string, std::string > > ISPE::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -111,11 +124,13 @@ namespace ISOBMFF
     void ISPE::SetDisplayWidth( uint32_t value )
     {
         this->impl->_displayWidth = value;
+        this->SetModified( true );
     }
     
     void ISPE::SetDisplayHeight( uint32_t value )
     {
         this->impl->_displayHeight = value;
+        this->SetModified( true );
     }
     
     ISPE::IMPL::IMPL():
@@ -178,6 +178,25 @@ namespace ISOBMFF
         this->impl->_outputHeight = value;
     }
     
+    void ImageGrid::Write( BinaryOutputStream & stream ) const
+    {
+        stream.WriteUInt8( this->GetVersion() );
+        stream.WriteUInt8( this->GetFlags() );
+        stream.WriteUInt8( this->GetRows() );
+        stream.WriteUInt8( this->GetColumns() );
+        
+        if( this->GetFlags() & 1 )
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetOutputWidth() ) );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetOutputHeight() ) );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->GetOutputWidth() ) );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->GetOutputHeight() ) );
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > ImageGrid::GetDisplayableProperties() const
     {
         return
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ItemReader-Range.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/ItemReader.hpp>
+
+namespace ISOBMFF
+{
+    class ItemReader::Range::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            Source   _source;
+            uint64_t _offset;
+            uint64_t _length;
+    };
+    
+    ItemReader::Range::Range():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    ItemReader::Range::Range( Source source, uint64_t offset, uint64_t length ):
+        impl( std::make_unique< IMPL >() )
+    {
+        this->SetSource( source );
+        this->SetOffset( offset );
+        this->SetLength( length );
+    }
+    
+    ItemReader::Range::Range( const ItemReader::Range & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    ItemReader::Range::Range( ItemReader::Range && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    ItemReader::Range::~Range()
+    {}
+    
+    ItemReader::Range & ItemReader::Range::operator =( ItemReader::Range o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( ItemReader::Range & o1, ItemReader::Range & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    ItemReader::Range::Source ItemReader::Range::GetSource() const
+    {
+        return this->impl->_source;
+    }
+    
+    uint64_t ItemReader::Range::GetOffset() const
+    {
+        return this->impl->_offset;
+    }
+    
+    uint64_t ItemReader::Range::GetLength() const
+    {
+        return this->impl->_length;
+    }
+    
+    void ItemReader::Range::SetSource( Source value )
+    {
+        this->impl->_source = value;
+    }
+    
+    void ItemReader::Range::SetOffset( uint64_t value )
+    {
+        this->impl->_offset = value;
+    }
+    
+    void ItemReader::Range::SetLength( uint64_t value )
+    {
+        this->impl->_length = value;
+    }
+    
+    ItemReader::Range::IMPL::IMPL():
+        _source( Source::File ),
+        _offset( 0 ),
+        _length( 0 )
+    {}
+
+    ItemReader::Range::IMPL::IMPL( const IMPL & o ):
+        _source( o._source ),
+        _offset( o._offset ),
+        _length( o._length )
+    {}
+
+    ItemReader::Range::IMPL::~IMPL()
+    {}
+}
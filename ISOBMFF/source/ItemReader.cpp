@@ -0,0 +1,454 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ItemReader.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/ItemReader.hpp>
+#include <ISOBMFF/ILOC.hpp>
+#include <ISOBMFF/IDAT.hpp>
+#include <ISOBMFF/IREF.hpp>
+#include <ISOBMFF/SingleItemTypeReferenceBox.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <map>
+#include <limits>
+#include <cstring>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class ItemReader::IMPL
+    {
+        public:
+            
+            IMPL( const META & meta, BinaryStream & stream );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::vector< Range > Resolve( uint32_t itemID, unsigned int depth ) const;
+            uint32_t             GetReferencedItemID( uint32_t itemID, uint64_t index ) const;
+            uint64_t             GetStreamSize() const;
+            
+            static void Append( std::vector< Range > & ranges, Range::Source source, uint64_t offset, uint64_t length );
+            
+            BinaryStream                                        * _stream;
+            std::shared_ptr< ILOC >                               _iloc;
+            std::shared_ptr< IDAT >                               _idat;
+            std::shared_ptr< IREF >                               _iref;
+            std::map< uint32_t, std::shared_ptr< ILOC::Item > >   _items;
+    };
+    
+    ItemReader::ItemReader( const META & meta, BinaryStream & stream ):
+        impl( std::make_unique< IMPL >( meta, stream ) )
+    {}
+    
+    ItemReader::ItemReader( const ItemReader & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    ItemReader::ItemReader( ItemReader && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    ItemReader::~ItemReader()
+    {}
+    
+    ItemReader & ItemReader::operator =( ItemReader o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( ItemReader & o1, ItemReader & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    bool ItemReader::HasItem( uint32_t itemID ) const
+    {
+        return this->impl->_items.find( itemID ) != this->impl->_items.end();
+    }
+    
+    std::vector< ItemReader::Range > ItemReader::GetItemRanges( uint32_t itemID ) const
+    {
+        return this->impl->Resolve( itemID, 0 );
+    }
+    
+    uint64_t ItemReader::GetItemSize( uint32_t itemID ) const
+    {
+        uint64_t size;
+        
+        size = 0;
+        
+        for( const auto & range: this->GetItemRanges( itemID ) )
+        {
+            size += range.GetLength();
+        }
+        
+        return size;
+    }
+    
+    size_t ItemReader::ReadItem( uint32_t itemID, uint8_t * buffer, size_t size ) const
+    {
+        return this->ReadRanges( this->GetItemRanges( itemID ), buffer, size );
+    }
+    
+    std::vector< uint8_t > ItemReader::ReadItem( uint32_t itemID ) const
+    {
+        std::vector< Range >   ranges( this->GetItemRanges( itemID ) );
+        std::vector< uint8_t > data;
+        uint64_t               size;
+        
+        size = 0;
+        
+        for( const auto & range: ranges )
+        {
+            size += range.GetLength();
+        }
+        
+        data.resize( numeric_cast< size_t >( size ) );
+        
+        if( data.size() > 0 )
+        {
+            this->ReadRanges( ranges, &( data[ 0 ] ), data.size() );
+        }
+        
+        return data;
+    }
+    
+    size_t ItemReader::ReadRanges( const std::vector< Range > & ranges, uint8_t * buffer, size_t size ) const
+    {
+        size_t total;
+        size_t length;
+        size_t pos;
+        
+        total = 0;
+        
+        for( const auto & range: ranges )
+        {
+            length = numeric_cast< size_t >( range.GetLength() );
+            
+            if( length > size - total )
+            {
+                throw std::runtime_error( "Buffer is too small for item data" );
+            }
+            
+            total += length;
+        }
+        
+        pos   = this->impl->_stream->Tell();
+        total = 0;
+        
+        for( const auto & range: ranges )
+        {
+            length = numeric_cast< size_t >( range.GetLength() );
+            
+            if( length == 0 )
+            {
+                continue;
+            }
+            
+            if( range.GetSource() == Range::Source::IDAT )
+            {
+                if
+                (
+                       this->impl->_idat == nullptr
+                    || range.GetOffset() > this->impl->_idat->GetDataSize()
+                    || length > this->impl->_idat->GetDataSize() - range.GetOffset()
+                )
+                {
+                    throw std::runtime_error( "Invalid IDAT range" );
+                }
+                
+                memcpy( buffer + total, this->impl->_idat->GetDataBytes() + range.GetOffset(), length );
+            }
+            else
+            {
+                this->impl->_stream->Seek( numeric_cast< std::streamoff >( range.GetOffset() ), BinaryStream::SeekDirection::Begin );
+                this->impl->_stream->Read( buffer + total, length );
+            }
+            
+            total += length;
+        }
+        
+        this->impl->_stream->Seek( numeric_cast< std::streamoff >( pos ), BinaryStream::SeekDirection::Begin );
+        
+        return total;
+    }
+    
+    const uint8_t * ItemReader::GetItemBytes( uint32_t itemID ) const
+    {
+        std::vector< Range > ranges( this->GetItemRanges( itemID ) );
+        const uint8_t      * bytes;
+        
+        if( ranges.size() != 1 )
+        {
+            return nullptr;
+        }
+        
+        if( ranges[ 0 ].GetSource() == Range::Source::IDAT )
+        {
+            bytes = this->impl->_idat->GetDataBytes();
+        }
+        else
+        {
+            bytes = this->impl->_stream->GetBytes();
+        }
+        
+        if( bytes == nullptr )
+        {
+            return nullptr;
+        }
+        
+        return bytes + ranges[ 0 ].GetOffset();
+    }
+    
+    ItemReader::IMPL::IMPL( const META & meta, BinaryStream & stream ):
+        _stream( &stream ),
+        _iloc( meta.GetTypedBox< ILOC >( "iloc" ) ),
+        _idat( meta.GetTypedBox< IDAT >( "idat" ) ),
+        _iref( meta.GetTypedBox< IREF >( "iref" ) )
+    {
+        if( this->_iloc == nullptr )
+        {
+            return;
+        }
+        
+        for( const auto & item: this->_iloc->GetItems() )
+        {
+            this->_items[ item->GetItemID() ] = item;
+        }
+    }
+    
+    ItemReader::IMPL::IMPL( const IMPL & o ):
+        _stream( o._stream ),
+        _iloc( o._iloc ),
+        _idat( o._idat ),
+        _iref( o._iref ),
+        _items( o._items )
+    {}
+    
+    ItemReader::IMPL::~IMPL()
+    {}
+    
+    std::vector< ItemReader::Range > ItemReader::IMPL::Resolve( uint32_t itemID, unsigned int depth ) const
+    {
+        std::vector< Range > ranges;
+        uint64_t             offset;
+        uint64_t             length;
+        uint64_t             size;
+        
+        auto it( this->_items.find( itemID ) );
+        
+        if( it == this->_items.end() )
+        {
+            throw std::runtime_error( "Cannot locate item: " + std::to_string( itemID ) );
+        }
+        
+        /*
+         * Items may reference other items (construction method 2), so guard
+         * against reference cycles in malformed files.
+         */
+        if( depth > 16 )
+        {
+            throw std::runtime_error( "Too many nested item references" );
+        }
+        
+        const ILOC::Item & item( *( it->second ) );
+        
+        if( item.GetDataReferenceIndex() != 0 )
+        {
+            throw std::runtime_error( "Item data located in external files is not supported" );
+        }
+        
+        size = 0;
+        
+        /* The size of the data source is the same for all extents */
+        if( item.GetConstructionMethod() == 0 )
+        {
+            size = this->GetStreamSize();
+        }
+        else if( item.GetConstructionMethod() == 1 )
+        {
+            if( this->_idat == nullptr )
+            {
+                throw std::runtime_error( "Missing IDAT box" );
+            }
+            
+            size = this->_idat->GetDataSize();
+        }
+        
+        for( const auto & extent: item.GetExtents() )
+        {
+            if( extent->GetOffset() > ( std::numeric_limits< uint64_t >::max )() - item.GetBaseOffset() )
+            {
+                throw std::runtime_error( "Invalid item extent" );
+            }
+            
+            offset = item.GetBaseOffset() + extent->GetOffset();
+            length = extent->GetLength();
+            
+            if( item.GetConstructionMethod() == 0 || item.GetConstructionMethod() == 1 )
+            {
+                /*
+                 * A zero length means the extent covers all the referenced
+                 * data, starting at the extent's offset.
+                 */
+                if( length == 0 && offset <= size )
+                {
+                    length = size - offset;
+                }
+                
+                if( offset > size || length > size - offset )
+                {
+                    throw std::runtime_error( "Invalid item extent" );
+                }
+                
+                Append( ranges, ( item.GetConstructionMethod() == 0 ) ? Range::Source::File : Range::Source::IDAT, offset, length );
+            }
+            else if( item.GetConstructionMethod() == 2 )
+            {
+                std::vector< Range > source( this->Resolve( this->GetReferencedItemID( itemID, extent->GetIndex() ), depth + 1 ) );
+                
+                if( length == 0 )
+                {
+                    length = ( std::numeric_limits< uint64_t >::max )();
+                }
+                
+                for( const auto & range: source )
+                {
+                    if( length == 0 )
+                    {
+                        break;
+                    }
+                    
+                    if( offset >= range.GetLength() )
+                    {
+                        offset -= range.GetLength();
+                        
+                        continue;
+                    }
+                    
+                    size    = std::min( range.GetLength() - offset, length );
+                    length -= size;
+                    
+                    Append( ranges, range.GetSource(), range.GetOffset() + offset, size );
+                    
+                    offset = 0;
+                }
+                
+                if( length != 0 && extent->GetLength() != 0 )
+                {
+                    throw std::runtime_error( "Invalid item extent" );
+                }
+            }
+            else
+            {
+                throw std::runtime_error( "Unsupported item construction method: " + std::to_string( item.GetConstructionMethod() ) );
+            }
+        }
+        
+        return ranges;
+    }
+    
+    uint32_t ItemReader::IMPL::GetReferencedItemID( uint32_t itemID, uint64_t index ) const
+    {
+        /*
+         * The extent index selects an 'iloc' item reference (1-based).
+         * When the ILOC box has no index field, the first one is used.
+         */
+        if( index == 0 )
+        {
+            index = 1;
+        }
+        
+        if( this->_iref != nullptr )
+        {
+            for( const auto & box: this->_iref->Container::GetBoxes( "iloc" ) )
+            {
+                std::shared_ptr< SingleItemTypeReferenceBox > ref( std::dynamic_pointer_cast< SingleItemTypeReferenceBox >( box ) );
+                
+                if( ref == nullptr || ref->GetFromItemID() != itemID )
+                {
+                    continue;
+                }
+                
+                std::vector< uint32_t > ids( ref->GetToItemIDs() );
+                
+                if( index <= ids.size() )
+                {
+                    return ids[ static_cast< size_t >( index - 1 ) ];
+                }
+            }
+        }
+        
+        throw std::runtime_error( "Missing item location reference for item: " + std::to_string( itemID ) );
+    }
+    
+    uint64_t ItemReader::IMPL::GetStreamSize() const
+    {
+        size_t cur;
+        size_t size;
+        
+        cur = this->_stream->Tell();
+        
+        this->_stream->Seek( 0, BinaryStream::SeekDirection::End );
+        
+        size = this->_stream->Tell();
+        
+        this->_stream->Seek( numeric_cast< std::streamoff >( cur ), BinaryStream::SeekDirection::Begin );
+        
+        return size;
+    }
+    
+    void ItemReader::IMPL::Append( std::vector< Range > & ranges, Range::Source source, uint64_t offset, uint64_t length )
+    {
+        if( length == 0 )
+        {
+            return;
+        }
+        
+        if( ranges.size() > 0 )
+        {
+            Range & last( ranges.back() );
+            
+            if( last.GetSource() == source && last.GetOffset() + last.GetLength() == offset )
+            {
+                last.SetLength( last.GetLength() + length );
+                
+                return;
+            }
+        }
+        
+        ranges.push_back( Range( source, offset, length ) );
+    }
+}
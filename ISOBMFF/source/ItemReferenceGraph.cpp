@@ -0,0 +1,168 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        ItemReferenceGraph.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/ItemReferenceGraph.hpp>
+#include <ISOBMFF/SingleItemTypeReferenceBox.hpp>
+#include <algorithm>
+#include <map>
+
+namespace ISOBMFF
+{
+    class ItemReferenceGraph::IMPL
+    {
+        public:
+            
+            typedef std::map< uint32_t, std::vector< uint32_t > > Adjacency;
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            static std::vector< uint32_t > Find( const std::map< std::string, Adjacency > & index, const std::string & type, uint32_t itemID );
+            
+            std::map< std::string, Adjacency > _forward;
+            std::map< std::string, Adjacency > _reverse;
+    };
+    
+    ItemReferenceGraph::ItemReferenceGraph():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    ItemReferenceGraph::ItemReferenceGraph( const IREF & iref ):
+        impl( std::make_unique< IMPL >() )
+    {
+        for( const auto & box: iref.GetBoxes() )
+        {
+            std::shared_ptr< SingleItemTypeReferenceBox > ref( std::dynamic_pointer_cast< SingleItemTypeReferenceBox >( box ) );
+            
+            if( ref == nullptr )
+            {
+                continue;
+            }
+            
+            for( auto id: ref->GetToItemIDs() )
+            {
+                this->AddReference( ref->GetName(), ref->GetFromItemID(), id );
+            }
+        }
+    }
+    
+    ItemReferenceGraph::ItemReferenceGraph( const ItemReferenceGraph & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    ItemReferenceGraph::ItemReferenceGraph( ItemReferenceGraph && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    ItemReferenceGraph::~ItemReferenceGraph()
+    {}
+    
+    ItemReferenceGraph & ItemReferenceGraph::operator =( ItemReferenceGraph o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( ItemReferenceGraph & o1, ItemReferenceGraph & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    void ItemReferenceGraph::AddReference( const std::string & type, uint32_t fromItemID, uint32_t toItemID )
+    {
+        this->impl->_forward[ type ][ fromItemID ].push_back( toItemID );
+        this->impl->_reverse[ type ][ toItemID ].push_back( fromItemID );
+    }
+    
+    std::vector< std::string > ItemReferenceGraph::GetReferenceTypes() const
+    {
+        std::vector< std::string > types;
+        
+        for( const auto & p: this->impl->_forward )
+        {
+            types.push_back( p.first );
+        }
+        
+        return types;
+    }
+    
+    std::vector< uint32_t > ItemReferenceGraph::GetReferencedItemIDs( const std::string & type, uint32_t fromItemID ) const
+    {
+        return IMPL::Find( this->impl->_forward, type, fromItemID );
+    }
+    
+    std::vector< uint32_t > ItemReferenceGraph::GetReferencingItemIDs( const std::string & type, uint32_t toItemID ) const
+    {
+        return IMPL::Find( this->impl->_reverse, type, toItemID );
+    }
+    
+    bool ItemReferenceGraph::HasReference( const std::string & type, uint32_t fromItemID, uint32_t toItemID ) const
+    {
+        std::vector< uint32_t > ids( this->GetReferencedItemIDs( type, fromItemID ) );
+        
+        return std::find( ids.begin(), ids.end(), toItemID ) != ids.end();
+    }
+    
+    ItemReferenceGraph::IMPL::IMPL()
+    {}
+    
+    ItemReferenceGraph::IMPL::IMPL( const IMPL & o ):
+        _forward( o._forward ),
+        _reverse( o._reverse )
+    {}
+    
+    ItemReferenceGraph::IMPL::~IMPL()
+    {}
+    
+    std::vector< uint32_t > ItemReferenceGraph::IMPL::Find( const std::map< std::string, Adjacency > & index, const std::string & type, uint32_t itemID )
+    {
+        auto i( index.find( type ) );
+        
+        if( i == index.end() )
+        {
+            return {};
+        }
+        
+        auto j( i->second.find( itemID ) );
+        
+        if( j == i->second.end() )
+        {
+            return {};
+        }
+        
+        return j->second;
+    }
+}
@@ -144,6 +144,44 @@ namespace ISOBMFF
        this->SetPredefined( u16 );
     }
 
+    uint64_t MDHD::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + ( ( this->GetVersion() == 1 ) ? 28 : 16 ) + 4;
+    }
+    
+    void MDHD::WriteData( BinaryOutputStream & stream ) const
+    {
+        uint16_t u16;
+        
+        FullBox::WriteData( stream );
+        
+        if( this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt64( this->GetCreationTime() );
+            stream.WriteBigEndianUInt64( this->GetModificationTime() );
+            stream.WriteBigEndianUInt32( this->GetTimescale() );
+            stream.WriteBigEndianUInt64( this->GetDuration() );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetCreationTime() ) );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetModificationTime() ) );
+            stream.WriteBigEndianUInt32( this->GetTimescale() );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetDuration() ) );
+        }
+        
+        u16 = static_cast< uint16_t >
+        (
+              ( ( this->GetPad()       & 0x01 )    << 15 )
+            | ( ( this->GetLanguage0() & 0b11111 ) << 10 )
+            | ( ( this->GetLanguage1() & 0b11111 ) <<  5 )
+            | ( ( this->GetLanguage2() & 0b11111 ) <<  0 )
+        );
+        
+        stream.WriteBigEndianUInt16( u16 );
+        stream.WriteBigEndianUInt16( this->GetPredefined() );
+    }
+    
     void MDHD::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         FullBox::WriteDescription( os, indentLevel );
@@ -220,46 +258,55 @@ namespace ISOBMFF
     void MDHD::SetCreationTime( uint64_t value )
     {
         this->impl->_creationTime = value;
+        this->SetModified( true );
     }
 
     void MDHD::SetModificationTime( uint64_t value )
     {
         this->impl->_modificationTime = value;
+        this->SetModified( true );
     }
 
     void MDHD::SetTimescale( uint32_t value )
     {
         this->impl->_timescale = value;
+        this->SetModified( true );
     }
 
     void MDHD::SetDuration( uint64_t value )
     {
         this->impl->_duration = value;
+        this->SetModified( true );
     }
 
     void MDHD::SetPad( uint8_t value )
     {
         this->impl->_pad = value;
+        this->SetModified( true );
     }
 
     void MDHD::SetLanguage0( uint8_t value )
     {
         this->impl->_language0 = value;
+        this->SetModified( true );
     }
 
     void MDHD::SetLanguage1( uint8_t value )
     {
         this->impl->_language1 = value;
+        this->SetModified( true );
     }
 
     void MDHD::SetLanguage2( uint8_t value )
     {
         this->impl->_language2 = value;
+        this->SetModified( true );
     }
 
     void MDHD::SetPredefined( uint16_t value )
     {
         this->impl->_predefined = value;
+        this->SetModified( true );
     }
 
 
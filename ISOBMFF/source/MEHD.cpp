@@ -0,0 +1,147 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        MEHD.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/MEHD.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class MEHD::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint64_t _fragmentDuration;
+    };
+    
+    MEHD::MEHD():
+        FullBox( "mehd" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    MEHD::MEHD( const MEHD & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    MEHD::MEHD( MEHD && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    MEHD::~MEHD()
+    {}
+    
+    MEHD & MEHD::operator =( MEHD o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( MEHD & o1, MEHD & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void MEHD::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        if( this->GetVersion() == 1 )
+        {
+            this->SetFragmentDuration( stream.ReadBigEndianUInt64() );
+        }
+        else
+        {
+            this->SetFragmentDuration( stream.ReadBigEndianUInt32() );
+        }
+    }
+    
+    uint64_t MEHD::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + ( ( this->GetVersion() == 1 ) ? 8 : 4 );
+    }
+    
+    void MEHD::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt64( this->GetFragmentDuration() );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetFragmentDuration() ) );
+        }
+    }
+    
+    std::vector< std::pair< std::string, std::string > > MEHD::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Fragment duration", std::to_string( this->GetFragmentDuration() ) } );
+        
+        return props;
+    }
+    
+    uint64_t MEHD::GetFragmentDuration() const
+    {
+        return this->impl->_fragmentDuration;
+    }
+    
+    void MEHD::SetFragmentDuration( uint64_t value )
+    {
+        this->impl->_fragmentDuration = value;
+        this->SetModified( true );
+    }
+    
+    MEHD::IMPL::IMPL():
+        _fragmentDuration( 0 )
+    {}
+    
+    MEHD::IMPL::IMPL( const IMPL & o ):
+        _fragmentDuration( o._fragmentDuration )
+    {}
+    
+    MEHD::IMPL::~IMPL()
+    {}
+}
@@ -101,6 +101,21 @@ namespace ISOBMFF
         this->impl->_boxes = container.GetBoxes();
     }
     
+    uint64_t META::GetDataSize() const
+    {
+        return ( ( this->impl->_isFullBox ) ? FullBox::GetDataSize() : 0 ) + this->GetBoxesSize();
+    }
+    
+    void META::WriteData( BinaryOutputStream & stream ) const
+    {
+        if( this->impl->_isFullBox )
+        {
+            FullBox::WriteData( stream );
+        }
+        
+        this->WriteBoxes( stream );
+    }
+    
     void META::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         if( this->impl->_isFullBox )
@@ -121,6 +136,8 @@ namespace ISOBMFF
         {
             this->impl->_boxes.push_back( box );
         }
+        
+        this->SetModified( true );
     }
     
     std::vector< std::shared_ptr< Box > > META::GetBoxes() const
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        MFHD.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/MFHD.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class MFHD::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t _sequenceNumber;
+    };
+    
+    MFHD::MFHD():
+        FullBox( "mfhd" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    MFHD::MFHD( const MFHD & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    MFHD::MFHD( MFHD && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    MFHD::~MFHD()
+    {}
+    
+    MFHD & MFHD::operator =( MFHD o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( MFHD & o1, MFHD & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void MFHD::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        this->SetSequenceNumber( stream.ReadBigEndianUInt32() );
+    }
+    
+    uint64_t MFHD::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4;
+    }
+    
+    void MFHD::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( this->GetSequenceNumber() );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > MFHD::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Sequence number", std::to_string( this->GetSequenceNumber() ) } );
+        
+        return props;
+    }
+    
+    uint32_t MFHD::GetSequenceNumber() const
+    {
+        return this->impl->_sequenceNumber;
+    }
+    
+    void MFHD::SetSequenceNumber( uint32_t value )
+    {
+        this->impl->_sequenceNumber = value;
+        this->SetModified( true );
+    }
+    
+    MFHD::IMPL::IMPL():
+        _sequenceNumber( 0 )
+    {}
+    
+    MFHD::IMPL::IMPL( const IMPL & o ):
+        _sequenceNumber( o._sequenceNumber )
+    {}
+    
+    MFHD::IMPL::~IMPL()
+    {}
+}
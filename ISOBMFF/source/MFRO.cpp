@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        MFRO.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/MFRO.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class MFRO::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t _size;
+    };
+    
+    MFRO::MFRO():
+        FullBox( "mfro" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    MFRO::MFRO( const MFRO & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    MFRO::MFRO( MFRO && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    MFRO::~MFRO()
+    {}
+    
+    MFRO & MFRO::operator =( MFRO o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( MFRO & o1, MFRO & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void MFRO::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        this->SetSize( stream.ReadBigEndianUInt32() );
+    }
+    
+    uint64_t MFRO::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4;
+    }
+    
+    void MFRO::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( this->GetSize() );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > MFRO::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Size", std::to_string( this->GetSize() ) } );
+        
+        return props;
+    }
+    
+    uint32_t MFRO::GetSize() const
+    {
+        return this->impl->_size;
+    }
+    
+    void MFRO::SetSize( uint32_t value )
+    {
+        this->impl->_size = value;
+        this->SetModified( true );
+    }
+    
+    MFRO::IMPL::IMPL():
+        _size( 0 )
+    {}
+    
+    MFRO::IMPL::IMPL( const IMPL & o ):
+        _size( o._size )
+    {}
+    
+    MFRO::IMPL::~IMPL()
+    {}
+}
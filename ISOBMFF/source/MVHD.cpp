@@ -128,6 +128,45 @@ namespace ISOBMFF
         this->SetNextTrackID( stream.ReadBigEndianUInt32() );
     }
     
+    uint64_t MVHD::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + ( ( this->GetVersion() == 1 ) ? 28 : 16 ) + 80;
+    }
+    
+    void MVHD::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt64( this->GetCreationTime() );
+            stream.WriteBigEndianUInt64( this->GetModificationTime() );
+            stream.WriteBigEndianUInt32( this->GetTimescale() );
+            stream.WriteBigEndianUInt64( this->GetDuration() );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetCreationTime() ) );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetModificationTime() ) );
+            stream.WriteBigEndianUInt32( this->GetTimescale() );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetDuration() ) );
+        }
+        
+        stream.WriteBigEndianUInt32( this->GetRate() );
+        stream.WriteBigEndianUInt16( this->GetVolume() );
+        stream.WriteBigEndianUInt16( this->impl->_reserved1 );
+        stream.WriteBigEndianUInt32( this->impl->_reserved2[ 0 ] );
+        stream.WriteBigEndianUInt32( this->impl->_reserved2[ 1 ] );
+        stream.WriteMatrix( this->GetMatrix() );
+        
+        for( uint32_t predefined: this->impl->_predefined )
+        {
+            stream.WriteBigEndianUInt32( predefined );
+        }
+        
+        stream.WriteBigEndianUInt32( this->GetNextTrackID() );
+    }
+    
     std::vector< std::pair< std::string, std::string > > MVHD::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -187,41 +226,49 @@ namespace ISOBMFF
     void MVHD::SetCreationTime( uint64_t value )
     {
         this->impl->_creationTime = value;
+        this->SetModified( true );
     }
     
     void MVHD::SetModificationTime( uint64_t value )
     {
         this->impl->_modificationTime = value;
+        this->SetModified( true );
     }
     
     void MVHD::SetTimescale( uint32_t value )
     {
         this->impl->_timescale = value;
+        this->SetModified( true );
     }
     
     void MVHD::SetDuration( uint64_t value )
     {
         this->impl->_duration = value;
+        this->SetModified( true );
     }
     
     void MVHD::SetRate( uint32_t value )
     {
         this->impl->_rate = value;
+        this->SetModified( true );
     }
     
     void MVHD::SetVolume( uint16_t value )
     {
         this->impl->_volume = value;
+        this->SetModified( true );
     }
     
     void MVHD::SetMatrix( const Matrix & value )
     {
         this->impl->_matrix = value;
+        this->SetModified( true );
     }
     
     void MVHD::SetNextTrackID( uint32_t value )
     {
         this->impl->_nextTrackID = value;
+        this->SetModified( true );
     }
     
     MVHD::IMPL::IMPL():
@@ -0,0 +1,382 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        MetadataEditor.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/MetadataEditor.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/Container.hpp>
+#include <ISOBMFF/BinaryFileStream.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#include <ISOBMFF/WIN32.hpp>
+#endif
+
+namespace ISOBMFF
+{
+    class MetadataEditor::IMPL
+    {
+        public:
+            
+            struct Patch
+            {
+                uint64_t               _offset;
+                std::vector< uint8_t > _data;
+            };
+            
+            IMPL( const std::string & path );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void Parse();
+            void Collect( BinaryStream & stream, const Container & parent, std::vector< Patch > & patches ) const;
+            void Encode( BinaryStream & stream, const std::vector< std::shared_ptr< Box > > & boxes, size_t index, std::vector< Patch > & patches ) const;
+            bool IsLossless( BinaryStream & stream, const Box & box ) const;
+            
+            std::string             _path;
+            std::shared_ptr< File > _file;
+    };
+    
+    MetadataEditor::MetadataEditor( const std::string & path ):
+        impl( std::make_unique< IMPL >( path ) )
+    {}
+    
+    MetadataEditor::MetadataEditor( const MetadataEditor & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    MetadataEditor::MetadataEditor( MetadataEditor && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    MetadataEditor::~MetadataEditor()
+    {}
+    
+    MetadataEditor & MetadataEditor::operator =( MetadataEditor o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( MetadataEditor & o1, MetadataEditor & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    std::string MetadataEditor::GetPath() const
+    {
+        return this->impl->_path;
+    }
+    
+    std::shared_ptr< File > MetadataEditor::GetFile() const
+    {
+        return this->impl->_file;
+    }
+    
+    uint64_t MetadataEditor::Save()
+    {
+        std::vector< IMPL::Patch > patches;
+        std::fstream               stream;
+        uint64_t                   written;
+        
+        /* All patches are computed before the first write */
+        {
+            BinaryFileStream source( this->impl->_path );
+            
+            this->impl->Collect( source, *( this->impl->_file ), patches );
+        }
+        
+        if( patches.size() == 0 )
+        {
+            return 0;
+        }
+
+        #ifdef _WIN32
+        stream.open( ISOBMFF::StringToWideString( this->impl->_path ), std::ios::binary | std::ios::in | std::ios::out );
+        #else
+        stream.open( this->impl->_path, std::ios::binary | std::ios::in | std::ios::out );
+        #endif
+        
+        if( stream.good() == false )
+        {
+            throw std::runtime_error( "Cannot open file for writing: " + this->impl->_path );
+        }
+        
+        written = 0;
+        
+        for( const auto & patch: patches )
+        {
+            stream.seekp( numeric_cast< std::streamoff >( patch._offset ), std::ios::beg );
+            stream.write( reinterpret_cast< const char * >( patch._data.data() ), numeric_cast< std::streamsize >( patch._data.size() ) );
+            
+            written += patch._data.size();
+        }
+        
+        stream.flush();
+        
+        if( stream.good() == false )
+        {
+            throw std::runtime_error( "Invalid write - Cannot write to file" );
+        }
+        
+        stream.close();
+        this->impl->Parse();
+        
+        return written;
+    }
+    
+    MetadataEditor::IMPL::IMPL( const std::string & path ):
+        _path( path )
+    {
+        this->Parse();
+    }
+    
+    MetadataEditor::IMPL::IMPL( const IMPL & o ):
+        _path( o._path ),
+        _file( o._file )
+    {}
+    
+    MetadataEditor::IMPL::~IMPL()
+    {}
+    
+    void MetadataEditor::IMPL::Parse()
+    {
+        Parser parser;
+        
+        parser.AddOption( Parser::Options::SkipMDATData );
+        parser.Parse( this->_path );
+        
+        this->_file = parser.GetFile();
+    }
+    
+    void MetadataEditor::IMPL::Collect( BinaryStream & stream, const Container & parent, std::vector< Patch > & patches ) const
+    {
+        std::vector< std::shared_ptr< Box > > boxes;
+        std::shared_ptr< Container >          container;
+        bool                                  nested;
+        
+        boxes = parent.GetBoxes();
+        
+        for( size_t i = 0; i < boxes.size(); i++ )
+        {
+            if( boxes[ i ]->IsModified() == false )
+            {
+                continue;
+            }
+            
+            if( boxes[ i ]->HasSource() == false )
+            {
+                throw std::runtime_error( "Cannot save - No room for added box " + boxes[ i ]->GetName() );
+            }
+            
+            container = std::dynamic_pointer_cast< Container >( boxes[ i ] );
+            nested    = container != nullptr && boxes[ i ]->HasModifiedFields() == false;
+            
+            /*
+             * If only nested boxes were modified (eg. in META or STSD
+             * boxes), the fields and header of the container stay valid
+             * as long as its children keep their total size, which
+             * patching them ensures.
+             */
+            if( container != nullptr )
+            {
+                for( const auto & box: container->GetBoxes() )
+                {
+                    if( box->HasSource() == false )
+                    {
+                        nested = false;
+                    }
+                }
+            }
+            
+            if( nested )
+            {
+                this->Collect( stream, *( container ), patches );
+            }
+            else
+            {
+                this->Encode( stream, boxes, i, patches );
+            }
+        }
+    }
+    
+    void MetadataEditor::IMPL::Encode( BinaryStream & stream, const std::vector< std::shared_ptr< Box > > & boxes, size_t index, std::vector< Patch > & patches ) const
+    {
+        BinaryDataOutputStream output;
+        std::shared_ptr< Box > box;
+        std::shared_ptr< Box > next;
+        std::vector< uint8_t > data;
+        std::vector< uint8_t > original;
+        uint64_t               offset;
+        uint64_t               available;
+        uint64_t               rest;
+        size_t                 i;
+        size_t                 start;
+        size_t                 end;
+        
+        box       = boxes[ index ];
+        next      = ( index + 1 < boxes.size() ) ? boxes[ index + 1 ] : nullptr;
+        offset    = box->GetSourceOffset();
+        available = box->GetSourceSize();
+        
+        /*
+         * Fields the box classes don't keep would be lost, so a box is
+         * only encoded if its original bytes can be encoded again
+         * exactly.
+         */
+        if( this->IsLossless( stream, *( box ) ) == false )
+        {
+            throw std::runtime_error( "Cannot save - Box " + box->GetName() + " cannot be encoded without losing data" );
+        }
+        
+        output.SetSource( &stream );
+        box->Write( output );
+        
+        data = output.GetData();
+        
+        if( data.size() != available )
+        {
+            if
+            (
+                   next != nullptr
+                && ( next->GetName() == "free" || next->GetName() == "skip" )
+                && next->HasSource()
+                && next->GetSourceOffset() == offset + available
+            )
+            {
+                available += next->GetSourceSize();
+            }
+            
+            if( data.size() > available )
+            {
+                throw std::runtime_error( "Cannot save - Not enough free space after box " + box->GetName() );
+            }
+            
+            rest = available - data.size();
+            
+            if( rest > 0 && rest < 8 )
+            {
+                throw std::runtime_error( "Cannot save - Cannot fill space left by box " + box->GetName() );
+            }
+            
+            if( rest > 0 )
+            {
+                BinaryDataOutputStream header;
+                
+                if( rest > ( std::numeric_limits< uint32_t >::max )() )
+                {
+                    header.WriteBigEndianUInt32( 1 );
+                    header.WriteFourCC( "free" );
+                    header.WriteBigEndianUInt64( rest );
+                }
+                else
+                {
+                    header.WriteBigEndianUInt32( static_cast< uint32_t >( rest ) );
+                    header.WriteFourCC( "free" );
+                }
+                
+                data.insert( data.end(), header.GetData().begin(), header.GetData().end() );
+            }
+        }
+        
+        stream.Seek( offset, BinaryStream::SeekDirection::Begin );
+        
+        original = stream.Read( data.size() );
+        
+        /* Only ranges that differ are written, merging close ones */
+        for( i = 0; i < data.size(); i++ )
+        {
+            if( data[ i ] == original[ i ] )
+            {
+                continue;
+            }
+            
+            start = i;
+            end   = i + 1;
+            
+            for( i = start + 1; i < data.size() && i - end < 16; i++ )
+            {
+                if( data[ i ] != original[ i ] )
+                {
+                    end = i + 1;
+                }
+            }
+            
+            i = end;
+            
+            patches.push_back( { offset + start, std::vector< uint8_t >( data.begin() + numeric_cast< std::ptrdiff_t >( start ), data.begin() + numeric_cast< std::ptrdiff_t >( end ) ) } );
+        }
+    }
+    
+    bool MetadataEditor::IMPL::IsLossless( BinaryStream & stream, const Box & box ) const
+    {
+        Parser                 parser;
+        BinaryDataOutputStream output;
+        std::shared_ptr< Box > copy;
+        std::vector< uint8_t > original;
+        uint64_t               header;
+        
+        stream.Seek( box.GetSourceOffset(), BinaryStream::SeekDirection::Begin );
+        
+        original = stream.Read( numeric_cast< size_t >( box.GetSourceSize() ) );
+        
+        BinaryDataStream data( original );
+        
+        header = ( data.ReadBigEndianUInt32() == 1 ) ? 16 : 8;
+        
+        if( original.size() < header )
+        {
+            return false;
+        }
+        
+        BinaryDataStream content( std::vector< uint8_t >( original.begin() + numeric_cast< std::ptrdiff_t >( header ), original.end() ) );
+        
+        copy = parser.CreateBox( box.GetName() );
+        
+        parser.SetStreamOffset( box.GetSourceOffset() + header );
+        copy->ReadData( parser, content );
+        copy->SetSource( box.GetSourceOffset(), box.GetSourceSize(), header );
+        
+        /* The output has no source, so nested boxes are encoded too */
+        copy->Write( output );
+        
+        return output.GetData() == original;
+    }
+}
@@ -0,0 +1,461 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        NAL.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/NAL.hpp>
+#include <stdexcept>
+#include <cstring>
+
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#define ISOBMFF_NAL_X86_64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace ISOBMFF
+{
+    namespace NAL
+    {
+        static size_t FindPatternScalar( const uint8_t * data, size_t size, size_t i );
+        
+        #ifdef ISOBMFF_NAL_X86_64
+        
+        static size_t FindPatternSSE2( const uint8_t * data, size_t size );
+        static size_t FindPatternAVX2( const uint8_t * data, size_t size );
+        static bool   HasAVX2();
+        static int    CountTrailingZeros( uint32_t mask );
+        
+        #endif
+        
+        size_t FindPattern( const uint8_t * data, size_t size )
+        {
+            #ifdef ISOBMFF_NAL_X86_64
+            
+            static const bool avx2 = HasAVX2();
+            
+            return ( avx2 ) ? FindPatternAVX2( data, size ) : FindPatternSSE2( data, size );
+            
+            #else
+            
+            return FindPatternScalar( data, size, 0 );
+            
+            #endif
+        }
+        
+        size_t FindStartCode( const uint8_t * data, size_t size, size_t * startCodeSize )
+        {
+            size_t i;
+            size_t p;
+            
+            i = 0;
+            
+            while( i < size )
+            {
+                p = i + FindPattern( data + i, size - i );
+                
+                if( p >= size )
+                {
+                    break;
+                }
+                
+                if( data[ p + 2 ] == 1 )
+                {
+                    if( p > 0 && data[ p - 1 ] == 0 )
+                    {
+                        if( startCodeSize != nullptr )
+                        {
+                            *( startCodeSize ) = 4;
+                        }
+                        
+                        return p - 1;
+                    }
+                    
+                    if( startCodeSize != nullptr )
+                    {
+                        *( startCodeSize ) = 3;
+                    }
+                    
+                    return p;
+                }
+                
+                i = p + 1;
+            }
+            
+            return size;
+        }
+        
+        std::vector< std::pair< size_t, size_t > > SplitAnnexB( const uint8_t * data, size_t size )
+        {
+            std::vector< std::pair< size_t, size_t > > units;
+            size_t                                     start;
+            size_t                                     next;
+            size_t                                     end;
+            size_t                                     length;
+            
+            start = FindStartCode( data, size, &length );
+            
+            while( start < size )
+            {
+                start += length;
+                next   = start + FindStartCode( data + start, size - start, &length );
+                end    = next;
+                
+                /*
+                 * NAL units never end with a zero byte, so zeros before the
+                 * next start code are trailing_zero_8bits.
+                 */
+                while( end > start && data[ end - 1 ] == 0 )
+                {
+                    end--;
+                }
+                
+                if( end > start )
+                {
+                    units.push_back( { start, end - start } );
+                }
+                
+                start = next;
+            }
+            
+            return units;
+        }
+        
+        std::vector< uint8_t > AnnexBToLengthPrefixed( const uint8_t * data, size_t size, uint8_t lengthSize )
+        {
+            std::vector< std::pair< size_t, size_t > > units( SplitAnnexB( data, size ) );
+            std::vector< uint8_t >                     out;
+            size_t                                     total;
+            size_t                                     pos;
+            
+            if( lengthSize != 1 && lengthSize != 2 && lengthSize != 4 )
+            {
+                throw std::runtime_error( "Unsupported NAL unit length size: " + std::to_string( lengthSize ) );
+            }
+            
+            total = 0;
+            
+            for( const auto & unit: units )
+            {
+                if( lengthSize < 4 && unit.second >= ( static_cast< size_t >( 1 ) << ( lengthSize * 8 ) ) )
+                {
+                    throw std::runtime_error( "NAL unit is too large for length size" );
+                }
+                
+                total += lengthSize + unit.second;
+            }
+            
+            out.resize( total );
+            
+            pos = 0;
+            
+            for( const auto & unit: units )
+            {
+                for( uint8_t i = 0; i < lengthSize; i++ )
+                {
+                    out[ pos + i ] = static_cast< uint8_t >( static_cast< uint64_t >( unit.second ) >> ( ( lengthSize - i - 1 ) * 8 ) );
+                }
+                
+                memcpy( &( out[ pos + lengthSize ] ), data + unit.first, unit.second );
+                
+                pos += lengthSize + unit.second;
+            }
+            
+            return out;
+        }
+        
+        size_t RemoveEmulationPrevention( const uint8_t * data, size_t size, uint8_t * out )
+        {
+            size_t i;
+            size_t p;
+            size_t start;
+            size_t total;
+            
+            i     = 0;
+            start = 0;
+            total = 0;
+            
+            while( i < size )
+            {
+                p = i + FindPattern( data + i, size - i );
+                
+                if( p >= size )
+                {
+                    break;
+                }
+                
+                if( data[ p + 2 ] == 3 )
+                {
+                    memmove( out + total, data + start, p + 2 - start );
+                    
+                    total += p + 2 - start;
+                    start  = p + 3;
+                    i      = p + 3;
+                }
+                else
+                {
+                    i = p + 1;
+                }
+            }
+            
+            memmove( out + total, data + start, size - start );
+            
+            return total + size - start;
+        }
+        
+        std::vector< uint8_t > RemoveEmulationPrevention( const std::vector< uint8_t > & data )
+        {
+            std::vector< uint8_t > out( data );
+            
+            if( out.size() > 0 )
+            {
+                out.resize( RemoveEmulationPrevention( &( out[ 0 ] ), out.size(), &( out[ 0 ] ) ) );
+            }
+            
+            return out;
+        }
+        
+        size_t GetEmulationPreventionSize( const uint8_t * data, size_t size )
+        {
+            return AddEmulationPrevention( data, size, nullptr, 0 );
+        }
+        
+        size_t AddEmulationPrevention( const uint8_t * data, size_t size, uint8_t * out, size_t outSize )
+        {
+            size_t i;
+            size_t p;
+            size_t total;
+            size_t length;
+            
+            i     = 0;
+            total = 0;
+            
+            /*
+             * When `out` is nullptr, only the output size is computed.
+             */
+            while( true )
+            {
+                p = i + FindPattern( data + i, size - i );
+                
+                /*
+                 * A final 0x03 is also added when the data ends with two
+                 * zero bytes (eg. cabac_zero_words).
+                 */
+                if( p >= size && size - i >= 2 && data[ size - 2 ] == 0 && data[ size - 1 ] == 0 )
+                {
+                    p = size - 2;
+                }
+                
+                length = ( p >= size ) ? size - i : p + 2 - i;
+                
+                if( out != nullptr )
+                {
+                    if( length > outSize - total || ( p < size && total + length >= outSize ) )
+                    {
+                        throw std::runtime_error( "Buffer is too small for EBSP data" );
+                    }
+                    
+                    memcpy( out + total, data + i, length );
+                    
+                    if( p < size )
+                    {
+                        out[ total + length ] = 3;
+                    }
+                }
+                
+                if( p >= size )
+                {
+                    return total + length;
+                }
+                
+                total += length + 1;
+                i      = p + 2;
+            }
+        }
+        
+        std::vector< uint8_t > AddEmulationPrevention( const std::vector< uint8_t > & data )
+        {
+            std::vector< uint8_t > out( GetEmulationPreventionSize( data.data(), data.size() ) );
+            
+            if( out.size() > 0 )
+            {
+                AddEmulationPrevention( data.data(), data.size(), &( out[ 0 ] ), out.size() );
+            }
+            
+            return out;
+        }
+        
+        static size_t FindPatternScalar( const uint8_t * data, size_t size, size_t i )
+        {
+            while( i + 2 < size )
+            {
+                /*
+                 * If the third byte is above 3, no pattern can start at any
+                 * of the three positions.
+                 */
+                if( data[ i + 2 ] > 3 )
+                {
+                    i += 3;
+                }
+                else if( data[ i ] == 0 && data[ i + 1 ] == 0 )
+                {
+                    return i;
+                }
+                else
+                {
+                    i++;
+                }
+            }
+            
+            return size;
+        }
+        
+        #ifdef ISOBMFF_NAL_X86_64
+        
+        static size_t FindPatternSSE2( const uint8_t * data, size_t size )
+        {
+            const __m128i zero = _mm_setzero_si128();
+            size_t        i;
+            uint32_t      mask;
+            
+            i = 0;
+            
+            /*
+             * Find pairs of zero bytes 16 positions at a time, then check
+             * the third byte of each candidate.
+             */
+            while( i + 18 <= size )
+            {
+                __m128i b0 = _mm_loadu_si128( reinterpret_cast< const __m128i * >( data + i ) );
+                __m128i b1 = _mm_loadu_si128( reinterpret_cast< const __m128i * >( data + i + 1 ) );
+                
+                mask = static_cast< uint32_t >( _mm_movemask_epi8( _mm_and_si128( _mm_cmpeq_epi8( b0, zero ), _mm_cmpeq_epi8( b1, zero ) ) ) );
+                
+                while( mask != 0 )
+                {
+                    size_t p = i + static_cast< size_t >( CountTrailingZeros( mask ) );
+                    
+                    if( data[ p + 2 ] <= 3 )
+                    {
+                        return p;
+                    }
+                    
+                    mask &= mask - 1;
+                }
+                
+                i += 16;
+            }
+            
+            return FindPatternScalar( data, size, i );
+        }
+        
+        #if defined( __GNUC__ ) || defined( __clang__ )
+        __attribute__( ( target( "avx2" ) ) )
+        #endif
+        static size_t FindPatternAVX2( const uint8_t * data, size_t size )
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            size_t        i;
+            uint32_t      mask;
+            
+            i = 0;
+            
+            while( i + 34 <= size )
+            {
+                __m256i b0 = _mm256_loadu_si256( reinterpret_cast< const __m256i * >( data + i ) );
+                __m256i b1 = _mm256_loadu_si256( reinterpret_cast< const __m256i * >( data + i + 1 ) );
+                
+                mask = static_cast< uint32_t >( _mm256_movemask_epi8( _mm256_and_si256( _mm256_cmpeq_epi8( b0, zero ), _mm256_cmpeq_epi8( b1, zero ) ) ) );
+                
+                while( mask != 0 )
+                {
+                    size_t p = i + static_cast< size_t >( CountTrailingZeros( mask ) );
+                    
+                    if( data[ p + 2 ] <= 3 )
+                    {
+                        return p;
+                    }
+                    
+                    mask &= mask - 1;
+                }
+                
+                i += 32;
+            }
+            
+            return FindPatternScalar( data, size, i );
+        }
+        
+        static bool HasAVX2()
+        {
+            #ifdef _MSC_VER
+            
+            int regs[ 4 ];
+            
+            __cpuid( regs, 1 );
+            
+            /*
+             * OSXSAVE and AVX, plus OS support for YMM registers.
+             */
+            if( ( regs[ 2 ] & ( 1 << 27 ) ) == 0 || ( regs[ 2 ] & ( 1 << 28 ) ) == 0 || ( _xgetbv( 0 ) & 6 ) != 6 )
+            {
+                return false;
+            }
+            
+            __cpuidex( regs, 7, 0 );
+            
+            return ( regs[ 1 ] & ( 1 << 5 ) ) != 0;
+            
+            #else
+            
+            return __builtin_cpu_supports( "avx2" ) != 0;
+            
+            #endif
+        }
+        
+        static int CountTrailingZeros( uint32_t mask )
+        {
+            #ifdef _MSC_VER
+            
+            unsigned long i;
+            
+            _BitScanForward( &i, mask );
+            
+            return static_cast< int >( i );
+            
+            #else
+            
+            return __builtin_ctz( mask );
+            
+            #endif
+        }
+        
+        #endif
+    }
+}
@@ -93,6 +93,25 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t PITM::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + ( ( this->GetVersion() == 0 ) ? 2 : 4 );
+    }
+    
+    void PITM::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetVersion() == 0 )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->GetItemID() ) );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( this->GetItemID() );
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > PITM::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -110,6 +129,7 @@ namespace ISOBMFF
     void PITM::SetItemID( uint32_t value )
     {
         this->impl->_itemID = value;
+        this->SetModified( true );
     }
     
     PITM::IMPL::IMPL():
@@ -30,6 +30,7 @@
 
 #include <ISOBMFF/PIXI.hpp>
 #include <ISOBMFF/Utils.hpp>
+#include <stdexcept>
 
 namespace ISOBMFF
 {
@@ -95,6 +96,23 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t PIXI::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 1 + this->impl->_channels.size();
+    }
+    
+    void PIXI::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteUInt8( static_cast< uint8_t >( this->impl->_channels.size() ) );
+        
+        for( const auto & channel: this->impl->_channels )
+        {
+            stream.WriteUInt8( channel->GetBitsPerChannel() );
+        }
+    }
+    
     void PIXI::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         FullBox::WriteDescription( os, indentLevel );
@@ -125,6 +143,18 @@ namespace ISOBMFF
     void PIXI::AddChannel( std::shared_ptr< Channel > array )
     {
         this->impl->_channels.push_back( array );
+        this->SetModified( true );
+    }
+    
+    void PIXI::SetBitsPerChannel( size_t index, uint8_t value )
+    {
+        if( index >= this->impl->_channels.size() )
+        {
+            throw std::runtime_error( "Invalid channel index" );
+        }
+        
+        this->impl->_channels[ index ]->SetBitsPerChannel( value );
+        this->SetModified( true );
     }
     
     PIXI::IMPL::IMPL()
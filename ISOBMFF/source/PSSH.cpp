@@ -0,0 +1,178 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        PSSH.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/PSSH.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/Utils.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class PSSH::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::vector< uint8_t > _systemID;
+            std::vector< uint8_t > _kids;
+            std::vector< uint8_t > _data;
+    };
+    
+    PSSH::PSSH():
+        FullBox( "pssh" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    PSSH::PSSH( const PSSH & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    PSSH::PSSH( PSSH && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    PSSH::~PSSH()
+    {}
+    
+    PSSH & PSSH::operator =( PSSH o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( PSSH & o1, PSSH & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void PSSH::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint32_t count;
+        
+        this->impl->_systemID = stream.Read( 16 );
+        
+        if( this->GetVersion() > 0 )
+        {
+            count = stream.ReadBigEndianUInt32();
+            
+            if( count > stream.AvailableBytes() / 16 )
+            {
+                throw std::runtime_error( "Invalid read - Not enough data available" );
+            }
+            
+            this->impl->_kids = stream.Read( static_cast< size_t >( count ) * 16 );
+        }
+        
+        this->impl->_data = stream.Read( stream.ReadBigEndianUInt32() );
+    }
+    
+    uint64_t PSSH::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 16 + ( ( this->GetVersion() > 0 ) ? 4 + this->impl->_kids.size() : 0 ) + 4 + this->impl->_data.size();
+    }
+    
+    void PSSH::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.Write( this->impl->_systemID );
+        
+        if( this->GetVersion() > 0 )
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_kids.size() / 16 ) );
+            stream.Write( this->impl->_kids );
+        }
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_data.size() ) );
+        stream.Write( this->impl->_data );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > PSSH::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "System ID", Utils::ToHexString( this->GetSystemID() ) } );
+        
+        for( size_t i = 0; i < this->GetKIDCount(); i++ )
+        {
+            props.push_back( { "KID", Utils::ToHexString( this->GetKID( i ) ) } );
+        }
+        
+        props.push_back( { "Data size", std::to_string( this->impl->_data.size() ) } );
+        
+        return props;
+    }
+    
+    std::vector< uint8_t > PSSH::GetSystemID() const
+    {
+        return this->impl->_systemID;
+    }
+    
+    size_t PSSH::GetKIDCount() const
+    {
+        return this->impl->_kids.size() / 16;
+    }
+    
+    std::vector< uint8_t > PSSH::GetKID( size_t index ) const
+    {
+        return std::vector< uint8_t >( this->impl->_kids.begin() + static_cast< std::ptrdiff_t >( index * 16 ), this->impl->_kids.begin() + static_cast< std::ptrdiff_t >( index * 16 + 16 ) );
+    }
+    
+    std::vector< uint8_t > PSSH::GetSystemData() const
+    {
+        return this->impl->_data;
+    }
+    
+    PSSH::IMPL::IMPL()
+    {}
+    
+    PSSH::IMPL::IMPL( const IMPL & o ):
+        _systemID( o._systemID ),
+        _kids( o._kids ),
+        _data( o._data )
+    {}
+    
+    PSSH::IMPL::~IMPL()
+    {}
+}
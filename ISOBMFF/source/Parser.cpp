@@ -44,6 +44,7 @@
 #include <ISOBMFF/URL.hpp>
 #include <ISOBMFF/URN.hpp>
 #include <ISOBMFF/ILOC.hpp>
+#include <ISOBMFF/IDAT.hpp>
 #include <ISOBMFF/IREF.hpp>
 #include <ISOBMFF/INFE.hpp>
 #include <ISOBMFF/IROT.hpp>
@@ -60,6 +61,29 @@
 #include <ISOBMFF/STSD.hpp>
 #include <ISOBMFF/STSS.hpp>
 #include <ISOBMFF/STTS.hpp>
+#include <ISOBMFF/STSZ.hpp>
+#include <ISOBMFF/STZ2.hpp>
+#include <ISOBMFF/STCO.hpp>
+#include <ISOBMFF/CO64.hpp>
+#include <ISOBMFF/STSC.hpp>
+#include <ISOBMFF/CTTS.hpp>
+#include <ISOBMFF/ELST.hpp>
+#include <ISOBMFF/MEHD.hpp>
+#include <ISOBMFF/TREX.hpp>
+#include <ISOBMFF/MFHD.hpp>
+#include <ISOBMFF/TFHD.hpp>
+#include <ISOBMFF/TFDT.hpp>
+#include <ISOBMFF/TRUN.hpp>
+#include <ISOBMFF/SIDX.hpp>
+#include <ISOBMFF/TFRA.hpp>
+#include <ISOBMFF/MFRO.hpp>
+#include <ISOBMFF/TENC.hpp>
+#include <ISOBMFF/PSSH.hpp>
+#include <ISOBMFF/SENC.hpp>
+#include <ISOBMFF/SAIZ.hpp>
+#include <ISOBMFF/SAIO.hpp>
+#include <ISOBMFF/SBGP.hpp>
+#include <ISOBMFF/SGPD.hpp>
 #include <ISOBMFF/FRMA.hpp>
 #include <ISOBMFF/SCHM.hpp>
 #include <ISOBMFF/HVC1.hpp>
@@ -88,6 +112,7 @@ namespace ISOBMFF
             Parser::StringType                                                 _stringType;
             uint64_t                                                           _options;
             std::map< std::string, void * >                                    _info;
+            uint64_t                                                           _streamOffset;
     };
     
     Parser::Parser():
@@ -209,8 +234,9 @@ namespace ISOBMFF
             throw std::runtime_error( std::string( "Data is not an ISO media file" ) );
         }
         
-        this->impl->_path = "";
-        this->impl->_file = std::make_shared< File >();
+        this->impl->_path         = "";
+        this->impl->_file         = std::make_shared< File >();
+        this->impl->_streamOffset = 0;
         
         if( stream.HasBytesAvailable() )
         {
@@ -280,9 +306,20 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t Parser::GetStreamOffset() const
+    {
+        return this->impl->_streamOffset;
+    }
+    
+    void Parser::SetStreamOffset( uint64_t value )
+    {
+        this->impl->_streamOffset = value;
+    }
+    
     Parser::IMPL::IMPL():
         _stringType( Parser::StringType::NULLTerminated ),
-        _options( 0 )
+        _options( 0 ),
+        _streamOffset( 0 )
     {
         this->RegisterDefaultBoxes();
     }
@@ -293,7 +330,8 @@ namespace ISOBMFF
         _types( o._types ),
         _stringType( o._stringType ),
         _options( o._options ),
-        _info( o._info )
+        _info( o._info ),
+        _streamOffset( o._streamOffset )
     {
         this->RegisterDefaultBoxes();
     }
@@ -359,6 +397,7 @@ namespace ISOBMFF
         this->RegisterBox( "url ", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< URL  >(); } );
         this->RegisterBox( "urn ", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< URN  >(); } );
         this->RegisterBox( "iloc", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< ILOC >(); } );
+        this->RegisterBox( "idat", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< IDAT >(); } );
         this->RegisterBox( "iref", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< IREF >(); } );
         this->RegisterBox( "infe", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< INFE >(); } );
         this->RegisterBox( "irot", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< IROT >(); } );
@@ -375,6 +414,29 @@ namespace ISOBMFF
         this->RegisterBox( "stsd", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STSD >(); } );
         this->RegisterBox( "stss", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STSS >(); } );
         this->RegisterBox( "stts", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STTS >(); } );
+        this->RegisterBox( "stsz", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STSZ >(); } );
+        this->RegisterBox( "stz2", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STZ2 >(); } );
+        this->RegisterBox( "stco", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STCO >(); } );
+        this->RegisterBox( "co64", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< CO64 >(); } );
+        this->RegisterBox( "stsc", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< STSC >(); } );
+        this->RegisterBox( "ctts", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< CTTS >(); } );
+        this->RegisterBox( "elst", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< ELST >(); } );
+        this->RegisterBox( "mehd", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< MEHD >(); } );
+        this->RegisterBox( "trex", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< TREX >(); } );
+        this->RegisterBox( "mfhd", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< MFHD >(); } );
+        this->RegisterBox( "tfhd", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< TFHD >(); } );
+        this->RegisterBox( "tfdt", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< TFDT >(); } );
+        this->RegisterBox( "trun", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< TRUN >(); } );
+        this->RegisterBox( "sidx", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< SIDX >(); } );
+        this->RegisterBox( "tfra", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< TFRA >(); } );
+        this->RegisterBox( "mfro", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< MFRO >(); } );
+        this->RegisterBox( "tenc", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< TENC >(); } );
+        this->RegisterBox( "pssh", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< PSSH >(); } );
+        this->RegisterBox( "senc", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< SENC >(); } );
+        this->RegisterBox( "saiz", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< SAIZ >(); } );
+        this->RegisterBox( "saio", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< SAIO >(); } );
+        this->RegisterBox( "sbgp", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< SBGP >(); } );
+        this->RegisterBox( "sgpd", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< SGPD >(); } );
         this->RegisterBox( "frma", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< FRMA >(); } );
         this->RegisterBox( "schm", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< SCHM >(); } );
         this->RegisterBox( "hvc1", [ = ]() -> std::shared_ptr< Box > { return std::make_shared< HVC1 >(); } );
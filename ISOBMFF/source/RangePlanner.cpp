@@ -0,0 +1,511 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        RangePlanner.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/RangePlanner.hpp>
+#include <ISOBMFF/BinaryDataStream.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/Container.hpp>
+#include <ISOBMFF/SIDX.hpp>
+#include <ISOBMFF/TFRA.hpp>
+#include <ISOBMFF/MFRO.hpp>
+#include <ISOBMFF/TKHD.hpp>
+#include <ISOBMFF/MDHD.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <stdexcept>
+#include <map>
+
+namespace ISOBMFF
+{
+    class RangePlanner::IMPL
+    {
+        public:
+            
+            struct Pending
+            {
+                std::shared_ptr< SIDX > _sidx;
+                size_t                  _index;
+                uint64_t                _offset;
+                uint64_t                _time;
+            };
+            
+            IMPL( BinaryStream & stream, uint32_t trackID );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            static std::shared_ptr< Box > ReadBox( Parser & parser, BinaryStream & stream, uint64_t offset, uint64_t & size );
+            
+            void AddEntry( uint64_t time, uint64_t duration, uint64_t offset, uint64_t size, bool sync );
+            void LoadSIDX( Parser & parser, BinaryStream & stream, std::shared_ptr< SIDX > sidx, uint64_t offset, uint64_t size );
+            bool LoadTFRA( Parser & parser, BinaryStream & stream );
+            
+            Source                          _source;
+            uint32_t                        _trackID;
+            uint32_t                        _timescale;
+            std::map< uint32_t, uint32_t >  _timescales;
+            std::vector< uint64_t >         _times;
+            std::vector< uint64_t >         _durations;
+            std::vector< uint64_t >         _offsets;
+            std::vector< uint64_t >         _sizes;
+            std::vector< bool >             _sync;
+    };
+    
+    RangePlanner::RangePlanner( BinaryStream & stream, uint32_t trackID ):
+        impl( std::make_unique< IMPL >( stream, trackID ) )
+    {}
+    
+    RangePlanner::RangePlanner( const RangePlanner & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    RangePlanner::RangePlanner( RangePlanner && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    RangePlanner::~RangePlanner()
+    {}
+    
+    RangePlanner & RangePlanner::operator =( RangePlanner o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( RangePlanner & o1, RangePlanner & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    RangePlanner::Source RangePlanner::GetSource() const
+    {
+        return this->impl->_source;
+    }
+    
+    uint32_t RangePlanner::GetTrackID() const
+    {
+        return this->impl->_trackID;
+    }
+    
+    uint32_t RangePlanner::GetTimescale() const
+    {
+        return this->impl->_timescale;
+    }
+    
+    size_t RangePlanner::GetEntryCount() const
+    {
+        return this->impl->_times.size();
+    }
+    
+    uint64_t RangePlanner::GetEntryTime( size_t index ) const
+    {
+        return this->impl->_times[ index ];
+    }
+    
+    uint64_t RangePlanner::GetEntryDuration( size_t index ) const
+    {
+        return this->impl->_durations[ index ];
+    }
+    
+    uint64_t RangePlanner::GetEntryOffset( size_t index ) const
+    {
+        return this->impl->_offsets[ index ];
+    }
+    
+    uint64_t RangePlanner::GetEntrySize( size_t index ) const
+    {
+        return this->impl->_sizes[ index ];
+    }
+    
+    bool RangePlanner::IsEntrySync( size_t index ) const
+    {
+        return this->impl->_sync[ index ];
+    }
+    
+    size_t RangePlanner::GetEntryAtTime( uint64_t time ) const
+    {
+        size_t index;
+        
+        if( this->impl->_times.size() == 0 )
+        {
+            throw std::runtime_error( "No entries" );
+        }
+        
+        index = static_cast< size_t >( std::upper_bound( this->impl->_times.begin(), this->impl->_times.end(), time ) - this->impl->_times.begin() );
+        
+        return ( index == 0 ) ? 0 : index - 1;
+    }
+    
+    std::vector< ItemReader::Range > RangePlanner::Plan( uint64_t start, uint64_t end ) const
+    {
+        std::vector< ItemReader::Range > ranges;
+        size_t                           first;
+        
+        if( this->impl->_times.size() == 0 || end <= start )
+        {
+            return ranges;
+        }
+        
+        first = this->GetEntryAtTime( start );
+        
+        while( first > 0 && this->impl->_sync[ first ] == false )
+        {
+            first--;
+        }
+        
+        for( size_t i = first; i < this->impl->_times.size() && ( i == first || this->impl->_times[ i ] < end ); i++ )
+        {
+            if( ranges.size() > 0 && ranges.back().GetOffset() + ranges.back().GetLength() == this->impl->_offsets[ i ] )
+            {
+                ranges.back().SetLength( ranges.back().GetLength() + this->impl->_sizes[ i ] );
+            }
+            else
+            {
+                ranges.push_back( ItemReader::Range( ItemReader::Range::Source::File, this->impl->_offsets[ i ], this->impl->_sizes[ i ] ) );
+            }
+        }
+        
+        return ranges;
+    }
+    
+    RangePlanner::IMPL::IMPL( BinaryStream & stream, uint32_t trackID ):
+        _source( Source::SIDX ),
+        _trackID( trackID ),
+        _timescale( 0 )
+    {
+        Parser                  parser;
+        uint64_t                available;
+        uint64_t                offset;
+        uint64_t                length;
+        uint64_t                header;
+        std::string             name;
+        std::shared_ptr< Box >  box;
+        std::shared_ptr< SIDX > sidx;
+        
+        stream.Seek( 0, BinaryStream::SeekDirection::Begin );
+        
+        /*
+         * Segment indexes come before the first movie fragment, so the
+         * scan stops at the first MOOF box.
+         */
+        while( stream.AvailableBytes() >= 8 )
+        {
+            offset    = stream.Tell();
+            available = stream.AvailableBytes();
+            length    = stream.ReadBigEndianUInt32();
+            name      = stream.ReadFourCC();
+            header    = 8;
+            
+            if( length == 1 )
+            {
+                length = stream.ReadBigEndianUInt64();
+                header = 16;
+            }
+            else if( length == 0 )
+            {
+                length = available;
+            }
+            
+            if( length < header || length > available )
+            {
+                throw std::runtime_error( "Invalid box size: " + name );
+            }
+            
+            if( name == "moof" || name == "mdat" )
+            {
+                break;
+            }
+            
+            if( name != "moov" && name != "sidx" )
+            {
+                stream.Seek( numeric_cast< std::streamoff >( length - header ), BinaryStream::SeekDirection::Current );
+                
+                continue;
+            }
+            
+            BinaryDataStream content( stream.Read( numeric_cast< size_t >( length - header ) ) );
+            
+            box = parser.CreateBox( name );
+            
+            box->ReadData( parser, content );
+            
+            if( name == "sidx" )
+            {
+                sidx = std::dynamic_pointer_cast< SIDX >( box );
+                
+                if( sidx != nullptr && ( trackID == 0 || sidx->GetReferenceID() == trackID ) )
+                {
+                    this->LoadSIDX( parser, stream, sidx, offset, length );
+                    
+                    return;
+                }
+                
+                continue;
+            }
+            
+            std::shared_ptr< Container > moov( std::dynamic_pointer_cast< Container >( box ) );
+            
+            if( moov == nullptr )
+            {
+                continue;
+            }
+            
+            for( const auto & b: moov->GetBoxes( "trak" ) )
+            {
+                std::shared_ptr< Container > trak( std::dynamic_pointer_cast< Container >( b ) );
+                std::shared_ptr< TKHD >      tkhd( ( trak == nullptr ) ? nullptr : trak->GetTypedBox< TKHD >( "tkhd" ) );
+                std::shared_ptr< Container > mdia( ( trak == nullptr ) ? nullptr : trak->GetTypedBox< Container >( "mdia" ) );
+                std::shared_ptr< MDHD >      mdhd( ( mdia == nullptr ) ? nullptr : mdia->GetTypedBox< MDHD >( "mdhd" ) );
+                
+                if( tkhd != nullptr && mdhd != nullptr )
+                {
+                    this->_timescales[ tkhd->GetTrackID() ] = mdhd->GetTimescale();
+                }
+            }
+        }
+        
+        if( this->LoadTFRA( parser, stream ) == false )
+        {
+            throw std::runtime_error( "No segment index found" );
+        }
+    }
+    
+    RangePlanner::IMPL::IMPL( const IMPL & o ):
+        _source( o._source ),
+        _trackID( o._trackID ),
+        _timescale( o._timescale ),
+        _timescales( o._timescales ),
+        _times( o._times ),
+        _durations( o._durations ),
+        _offsets( o._offsets ),
+        _sizes( o._sizes ),
+        _sync( o._sync )
+    {}
+    
+    RangePlanner::IMPL::~IMPL()
+    {}
+    
+    std::shared_ptr< Box > RangePlanner::IMPL::ReadBox( Parser & parser, BinaryStream & stream, uint64_t offset, uint64_t & size )
+    {
+        uint64_t               header;
+        std::string            name;
+        std::shared_ptr< Box > box;
+        
+        stream.Seek( numeric_cast< std::streamoff >( offset ), BinaryStream::SeekDirection::Begin );
+        
+        size   = stream.ReadBigEndianUInt32();
+        name   = stream.ReadFourCC();
+        header = 8;
+        
+        if( size == 1 )
+        {
+            size   = stream.ReadBigEndianUInt64();
+            header = 16;
+        }
+        
+        if( size < header || size - header > stream.AvailableBytes() )
+        {
+            throw std::runtime_error( "Invalid box size: " + name );
+        }
+        
+        BinaryDataStream content( stream.Read( numeric_cast< size_t >( size - header ) ) );
+        
+        box = parser.CreateBox( name );
+        
+        box->ReadData( parser, content );
+        
+        return box;
+    }
+    
+    void RangePlanner::IMPL::AddEntry( uint64_t time, uint64_t duration, uint64_t offset, uint64_t size, bool sync )
+    {
+        this->_times.push_back( time );
+        this->_durations.push_back( duration );
+        this->_offsets.push_back( offset );
+        this->_sizes.push_back( size );
+        this->_sync.push_back( sync );
+    }
+    
+    void RangePlanner::IMPL::LoadSIDX( Parser & parser, BinaryStream & stream, std::shared_ptr< SIDX > sidx, uint64_t offset, uint64_t size )
+    {
+        std::vector< Pending > pending;
+        
+        this->_source    = Source::SIDX;
+        this->_trackID   = sidx->GetReferenceID();
+        this->_timescale = sidx->GetTimescale();
+        
+        pending.push_back( { sidx, 0, offset + size + sidx->GetFirstOffset(), sidx->GetEarliestPresentationTime() } );
+        
+        /*
+         * Depth-first walk, keeping references in file order. An explicit
+         * stack is used, as daisy-chained indexes (each SIDX referencing
+         * the next one) can be arbitrarily deep.
+         */
+        while( pending.size() > 0 )
+        {
+            std::shared_ptr< SIDX > current( pending.back()._sidx );
+            size_t                  index( pending.back()._index );
+            uint64_t                position( pending.back()._offset );
+            uint64_t                time( pending.back()._time );
+            
+            if( index == current->GetReferenceCount() )
+            {
+                pending.pop_back();
+                
+                continue;
+            }
+            
+            pending.back()._index  += 1;
+            pending.back()._offset += current->GetReferencedSize( index );
+            pending.back()._time   += current->GetSubsegmentDuration( index );
+            
+            if( current->IsIndexReference( index ) )
+            {
+                uint64_t                childSize;
+                std::shared_ptr< SIDX > child( std::dynamic_pointer_cast< SIDX >( ReadBox( parser, stream, position, childSize ) ) );
+                
+                if( child == nullptr )
+                {
+                    throw std::runtime_error( "Invalid SIDX reference" );
+                }
+                
+                pending.push_back( { child, 0, position + childSize + child->GetFirstOffset(), child->GetEarliestPresentationTime() } );
+            }
+            else
+            {
+                this->AddEntry( time, current->GetSubsegmentDuration( index ), position, current->GetReferencedSize( index ), current->StartsWithSAP( index ) );
+            }
+        }
+    }
+    
+    bool RangePlanner::IMPL::LoadTFRA( Parser & parser, BinaryStream & stream )
+    {
+        uint64_t                     end;
+        uint64_t                     mfraOffset;
+        uint64_t                     size;
+        std::shared_ptr< MFRO >      mfro;
+        std::shared_ptr< Container > mfra;
+        std::shared_ptr< TFRA >      tfra;
+        
+        stream.Seek( 0, BinaryStream::SeekDirection::End );
+        
+        end = stream.Tell();
+        
+        /*
+         * The MFRO box is the last box of the MFRA box, and holds its
+         * size.
+         */
+        if( end < 16 )
+        {
+            return false;
+        }
+        
+        /*
+         * The trailing bytes can be anything when the file has no index,
+         * so the box headers are checked before reading the boxes.
+         */
+        stream.Seek( numeric_cast< std::streamoff >( end - 16 ), BinaryStream::SeekDirection::Begin );
+        
+        if( stream.ReadBigEndianUInt32() != 16 || stream.ReadFourCC() != "mfro" )
+        {
+            return false;
+        }
+        
+        mfro = std::dynamic_pointer_cast< MFRO >( ReadBox( parser, stream, end - 16, size ) );
+        
+        if( mfro == nullptr || mfro->GetSize() > end || mfro->GetSize() < 16 )
+        {
+            return false;
+        }
+        
+        mfraOffset = end - mfro->GetSize();
+        
+        stream.Seek( numeric_cast< std::streamoff >( mfraOffset ), BinaryStream::SeekDirection::Begin );
+        
+        if( stream.ReadBigEndianUInt32() != mfro->GetSize() || stream.ReadFourCC() != "mfra" )
+        {
+            return false;
+        }
+        
+        mfra = std::dynamic_pointer_cast< Container >( ReadBox( parser, stream, mfraOffset, size ) );
+        
+        if( mfra == nullptr )
+        {
+            return false;
+        }
+        
+        for( const auto & box: mfra->GetBoxes( "tfra" ) )
+        {
+            std::shared_ptr< TFRA > t( std::dynamic_pointer_cast< TFRA >( box ) );
+            
+            if( t != nullptr && ( this->_trackID == 0 || t->GetTrackID() == this->_trackID ) )
+            {
+                tfra = t;
+                
+                break;
+            }
+        }
+        
+        if( tfra == nullptr )
+        {
+            return false;
+        }
+        
+        this->_source    = Source::TFRA;
+        this->_trackID   = tfra->GetTrackID();
+        this->_timescale = ( this->_timescales.count( this->_trackID ) > 0 ) ? this->_timescales[ this->_trackID ] : 0;
+        
+        /*
+         * An entry spans from its MOOF box to the next entry's MOOF box.
+         * Several entries may point to the same fragment, in which case
+         * only the first one is kept.
+         */
+        for( size_t i = 0; i < tfra->GetEntryCount(); i++ )
+        {
+            if( this->_offsets.size() > 0 && this->_offsets.back() == tfra->GetMoofOffset( i ) )
+            {
+                continue;
+            }
+            
+            if( this->_offsets.size() > 0 )
+            {
+                this->_sizes.back()     = tfra->GetMoofOffset( i ) - this->_offsets.back();
+                this->_durations.back() = tfra->GetTime( i ) - this->_times.back();
+            }
+            
+            this->AddEntry( tfra->GetTime( i ), 0, tfra->GetMoofOffset( i ), mfraOffset - tfra->GetMoofOffset( i ), true );
+        }
+        
+        return true;
+    }
+}
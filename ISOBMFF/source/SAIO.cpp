@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SAIO.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/SAIO.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class SAIO::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::string             _auxInfoType;
+            uint32_t                _auxInfoTypeParameter;
+            std::vector< uint64_t > _offsets;
+    };
+    
+    SAIO::SAIO():
+        FullBox( "saio" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    SAIO::SAIO( const SAIO & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    SAIO::SAIO( SAIO && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    SAIO::~SAIO()
+    {}
+    
+    SAIO & SAIO::operator =( SAIO o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( SAIO & o1, SAIO & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void SAIO::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint32_t                count;
+        std::vector< uint32_t > offsets;
+        
+        if( this->GetFlags() & 0x000001 )
+        {
+            this->impl->_auxInfoType          = stream.ReadFourCC();
+            this->impl->_auxInfoTypeParameter = stream.ReadBigEndianUInt32();
+        }
+        
+        count = stream.ReadBigEndianUInt32();
+        
+        if( this->GetVersion() == 0 )
+        {
+            offsets = stream.ReadBigEndianUInt32Array( count );
+            
+            this->impl->_offsets.assign( offsets.begin(), offsets.end() );
+        }
+        else
+        {
+            this->impl->_offsets = stream.ReadBigEndianUInt64Array( count );
+        }
+    }
+    
+    uint64_t SAIO::GetDataSize() const
+    {
+        uint64_t size;
+        
+        size = FullBox::GetDataSize() + 4 + this->impl->_offsets.size() * ( ( this->GetVersion() == 0 ) ? 4 : 8 );
+        
+        if( this->GetFlags() & 0x000001 )
+        {
+            size += 8;
+        }
+        
+        return size;
+    }
+    
+    void SAIO::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetFlags() & 0x000001 )
+        {
+            stream.WriteFourCC( this->impl->_auxInfoType );
+            stream.WriteBigEndianUInt32( this->impl->_auxInfoTypeParameter );
+        }
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_offsets.size() ) );
+        
+        if( this->GetVersion() == 0 )
+        {
+            stream.WriteBigEndianUInt32Array( std::vector< uint32_t >( this->impl->_offsets.begin(), this->impl->_offsets.end() ) );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt64Array( this->impl->_offsets );
+        }
+    }
+    
+    std::vector< std::pair< std::string, std::string > > SAIO::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Aux info type",           this->GetAuxInfoType() } );
+        props.push_back( { "Aux info type parameter", std::to_string( this->GetAuxInfoTypeParameter() ) } );
+        
+        for( size_t i = 0; i < this->GetEntryCount(); i++ )
+        {
+            props.push_back( { "Offset", std::to_string( this->GetOffset( i ) ) } );
+        }
+        
+        return props;
+    }
+    
+    std::string SAIO::GetAuxInfoType() const
+    {
+        return this->impl->_auxInfoType;
+    }
+    
+    uint32_t SAIO::GetAuxInfoTypeParameter() const
+    {
+        return this->impl->_auxInfoTypeParameter;
+    }
+    
+    size_t SAIO::GetEntryCount() const
+    {
+        return this->impl->_offsets.size();
+    }
+    
+    uint64_t SAIO::GetOffset( size_t index ) const
+    {
+        return this->impl->_offsets[ index ];
+    }
+    
+    SAIO::IMPL::IMPL():
+        _auxInfoTypeParameter( 0 )
+    {}
+    
+    SAIO::IMPL::IMPL( const IMPL & o ):
+        _auxInfoType( o._auxInfoType ),
+        _auxInfoTypeParameter( o._auxInfoTypeParameter ),
+        _offsets( o._offsets )
+    {}
+    
+    SAIO::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,198 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SAIZ.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/SAIZ.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class SAIZ::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::string            _auxInfoType;
+            uint32_t               _auxInfoTypeParameter;
+            uint8_t                _defaultSampleInfoSize;
+            uint32_t               _sampleCount;
+            std::vector< uint8_t > _sizes;
+    };
+    
+    SAIZ::SAIZ():
+        FullBox( "saiz" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    SAIZ::SAIZ( const SAIZ & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    SAIZ::SAIZ( SAIZ && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    SAIZ::~SAIZ()
+    {}
+    
+    SAIZ & SAIZ::operator =( SAIZ o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( SAIZ & o1, SAIZ & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void SAIZ::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        if( this->GetFlags() & 0x000001 )
+        {
+            this->impl->_auxInfoType          = stream.ReadFourCC();
+            this->impl->_auxInfoTypeParameter = stream.ReadBigEndianUInt32();
+        }
+        
+        this->impl->_defaultSampleInfoSize = stream.ReadUInt8();
+        this->impl->_sampleCount           = stream.ReadBigEndianUInt32();
+        
+        if( this->impl->_defaultSampleInfoSize == 0 )
+        {
+            this->impl->_sizes = stream.Read( this->impl->_sampleCount );
+        }
+    }
+    
+    uint64_t SAIZ::GetDataSize() const
+    {
+        uint64_t size;
+        
+        size = FullBox::GetDataSize() + 5;
+        
+        if( this->GetFlags() & 0x000001 )
+        {
+            size += 8;
+        }
+        
+        if( this->impl->_defaultSampleInfoSize == 0 )
+        {
+            size += this->impl->_sizes.size();
+        }
+        
+        return size;
+    }
+    
+    void SAIZ::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetFlags() & 0x000001 )
+        {
+            stream.WriteFourCC( this->impl->_auxInfoType );
+            stream.WriteBigEndianUInt32( this->impl->_auxInfoTypeParameter );
+        }
+        
+        stream.WriteUInt8( this->impl->_defaultSampleInfoSize );
+        stream.WriteBigEndianUInt32( this->impl->_sampleCount );
+        
+        if( this->impl->_defaultSampleInfoSize == 0 )
+        {
+            stream.Write( this->impl->_sizes );
+        }
+    }
+    
+    std::vector< std::pair< std::string, std::string > > SAIZ::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Aux info type",            this->GetAuxInfoType() } );
+        props.push_back( { "Aux info type parameter",  std::to_string( this->GetAuxInfoTypeParameter() ) } );
+        props.push_back( { "Default sample info size", std::to_string( this->GetDefaultSampleInfoSize() ) } );
+        props.push_back( { "Sample count",             std::to_string( this->GetSampleCount() ) } );
+        
+        return props;
+    }
+    
+    std::string SAIZ::GetAuxInfoType() const
+    {
+        return this->impl->_auxInfoType;
+    }
+    
+    uint32_t SAIZ::GetAuxInfoTypeParameter() const
+    {
+        return this->impl->_auxInfoTypeParameter;
+    }
+    
+    uint8_t SAIZ::GetDefaultSampleInfoSize() const
+    {
+        return this->impl->_defaultSampleInfoSize;
+    }
+    
+    uint32_t SAIZ::GetSampleCount() const
+    {
+        return this->impl->_sampleCount;
+    }
+    
+    uint8_t SAIZ::GetSampleInfoSize( size_t index ) const
+    {
+        return ( this->impl->_defaultSampleInfoSize != 0 ) ? this->impl->_defaultSampleInfoSize : this->impl->_sizes[ index ];
+    }
+    
+    SAIZ::IMPL::IMPL():
+        _auxInfoTypeParameter( 0 ),
+        _defaultSampleInfoSize( 0 ),
+        _sampleCount( 0 )
+    {}
+    
+    SAIZ::IMPL::IMPL( const IMPL & o ):
+        _auxInfoType( o._auxInfoType ),
+        _auxInfoTypeParameter( o._auxInfoTypeParameter ),
+        _defaultSampleInfoSize( o._defaultSampleInfoSize ),
+        _sampleCount( o._sampleCount ),
+        _sizes( o._sizes )
+    {}
+    
+    SAIZ::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,204 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SBGP.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/SBGP.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class SBGP::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::string             _groupingType;
+            uint32_t                _groupingTypeParameter;
+            std::vector< uint32_t > _sampleCounts;
+            std::vector< uint32_t > _groupDescriptionIndices;
+    };
+    
+    SBGP::SBGP():
+        FullBox( "sbgp" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    SBGP::SBGP( const SBGP & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    SBGP::SBGP( SBGP && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    SBGP::~SBGP()
+    {}
+    
+    SBGP & SBGP::operator =( SBGP o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( SBGP & o1, SBGP & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void SBGP::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint32_t                count;
+        std::vector< uint32_t > entries;
+        
+        this->impl->_groupingType = stream.ReadFourCC();
+        
+        if( this->GetVersion() == 1 )
+        {
+            this->impl->_groupingTypeParameter = stream.ReadBigEndianUInt32();
+        }
+        
+        count = stream.ReadBigEndianUInt32();
+        
+        if( count > stream.AvailableBytes() / 8 )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        entries = stream.ReadBigEndianUInt32Array( static_cast< size_t >( count ) * 2 );
+        
+        this->impl->_sampleCounts.resize( count );
+        this->impl->_groupDescriptionIndices.resize( count );
+        
+        for( size_t i = 0; i < count; i++ )
+        {
+            this->impl->_sampleCounts[ i ]            = entries[ i * 2 ];
+            this->impl->_groupDescriptionIndices[ i ] = entries[ i * 2 + 1 ];
+        }
+    }
+    
+    uint64_t SBGP::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 8 + ( ( this->GetVersion() == 1 ) ? 4 : 0 ) + this->impl->_sampleCounts.size() * 8;
+    }
+    
+    void SBGP::WriteData( BinaryOutputStream & stream ) const
+    {
+        std::vector< uint32_t > entries;
+        
+        FullBox::WriteData( stream );
+        
+        stream.WriteFourCC( this->impl->_groupingType );
+        
+        if( this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt32( this->impl->_groupingTypeParameter );
+        }
+        
+        entries.resize( this->impl->_sampleCounts.size() * 2 );
+        
+        for( size_t i = 0; i < this->impl->_sampleCounts.size(); i++ )
+        {
+            entries[ i * 2 ]     = this->impl->_sampleCounts[ i ];
+            entries[ i * 2 + 1 ] = this->impl->_groupDescriptionIndices[ i ];
+        }
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sampleCounts.size() ) );
+        stream.WriteBigEndianUInt32Array( entries );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > SBGP::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Grouping type",           this->GetGroupingType() } );
+        props.push_back( { "Grouping type parameter", std::to_string( this->GetGroupingTypeParameter() ) } );
+        
+        for( size_t i = 0; i < this->GetEntryCount(); i++ )
+        {
+            props.push_back( { "Sample count",            std::to_string( this->GetSampleCount( i ) ) } );
+            props.push_back( { "Group description index", std::to_string( this->GetGroupDescriptionIndex( i ) ) } );
+        }
+        
+        return props;
+    }
+    
+    std::string SBGP::GetGroupingType() const
+    {
+        return this->impl->_groupingType;
+    }
+    
+    uint32_t SBGP::GetGroupingTypeParameter() const
+    {
+        return this->impl->_groupingTypeParameter;
+    }
+    
+    size_t SBGP::GetEntryCount() const
+    {
+        return this->impl->_sampleCounts.size();
+    }
+    
+    uint32_t SBGP::GetSampleCount( size_t index ) const
+    {
+        return this->impl->_sampleCounts[ index ];
+    }
+    
+    uint32_t SBGP::GetGroupDescriptionIndex( size_t index ) const
+    {
+        return this->impl->_groupDescriptionIndices[ index ];
+    }
+    
+    SBGP::IMPL::IMPL():
+        _groupingTypeParameter( 0 )
+    {}
+    
+    SBGP::IMPL::IMPL( const IMPL & o ):
+        _groupingType( o._groupingType ),
+        _groupingTypeParameter( o._groupingTypeParameter ),
+        _sampleCounts( o._sampleCounts ),
+        _groupDescriptionIndices( o._groupDescriptionIndices )
+    {}
+    
+    SBGP::IMPL::~IMPL()
+    {}
+}
@@ -103,6 +103,33 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t SCHM::GetDataSize() const
+    {
+        uint64_t size;
+        
+        size = FullBox::GetDataSize() + 8;
+        
+        if( this->GetFlags() & 0x000001 )
+        {
+            size += this->impl->_schemeURI.size() + 1;
+        }
+        
+        return size;
+    }
+    
+    void SCHM::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteFourCC( this->GetSchemeType() );
+        stream.WriteBigEndianUInt32( this->GetSchemeVersion() );
+        
+        if( this->GetFlags() & 0x000001 )
+        {
+            stream.WriteNULLTerminatedString( this->GetSchemeURI() );
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > SCHM::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -132,16 +159,19 @@ namespace ISOBMFF
     void SCHM::SetSchemeType( const std::string & value )
     {
         this->impl->_schemeType = value;
+        this->SetModified( true );
     }
     
     void SCHM::SetSchemeVersion( uint32_t value )
     {
         this->impl->_schemeVersion = value;
+        this->SetModified( true );
     }
     
     void SCHM::SetSchemeURI( const std::string & value )
     {
         this->impl->_schemeURI = value;
+        this->SetModified( true );
     }
     
     SCHM::IMPL::IMPL():
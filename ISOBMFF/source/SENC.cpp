@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SENC.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/SENC.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class SENC::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t               _sampleCount;
+            std::vector< uint8_t > _data;
+    };
+    
+    SENC::SENC():
+        FullBox( "senc" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    SENC::SENC( const SENC & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    SENC::SENC( SENC && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    SENC::~SENC()
+    {}
+    
+    SENC & SENC::operator =( SENC o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( SENC & o1, SENC & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void SENC::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        this->impl->_sampleCount = stream.ReadBigEndianUInt32();
+        this->impl->_data        = stream.ReadAllData();
+    }
+    
+    uint64_t SENC::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + this->impl->_data.size();
+    }
+    
+    void SENC::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( this->impl->_sampleCount );
+        stream.Write( this->impl->_data );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > SENC::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Sample count", std::to_string( this->GetSampleCount() ) } );
+        props.push_back( { "Subsamples",   ( this->HasSubsamples() ) ? "yes" : "no" } );
+        
+        return props;
+    }
+    
+    bool SENC::HasSubsamples() const
+    {
+        return ( this->GetFlags() & 0x000002 ) != 0;
+    }
+    
+    uint32_t SENC::GetSampleCount() const
+    {
+        return this->impl->_sampleCount;
+    }
+    
+    const std::vector< uint8_t > & SENC::GetSampleData() const
+    {
+        return this->impl->_data;
+    }
+    
+    SENC::IMPL::IMPL():
+        _sampleCount( 0 )
+    {}
+    
+    SENC::IMPL::IMPL( const IMPL & o ):
+        _sampleCount( o._sampleCount ),
+        _data( o._data )
+    {}
+    
+    SENC::IMPL::~IMPL()
+    {}
+}
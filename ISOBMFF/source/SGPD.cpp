@@ -0,0 +1,252 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SGPD.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/SGPD.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/Utils.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class SGPD::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::string             _groupingType;
+            uint32_t                _defaultLength;
+            uint32_t                _defaultSampleDescriptionIndex;
+            std::vector< size_t >   _offsets;
+            std::vector< uint8_t >  _data;
+    };
+    
+    SGPD::SGPD():
+        FullBox( "sgpd" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    SGPD::SGPD( const SGPD & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    SGPD::SGPD( SGPD && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    SGPD::~SGPD()
+    {}
+    
+    SGPD & SGPD::operator =( SGPD o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( SGPD & o1, SGPD & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void SGPD::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint32_t count;
+        uint32_t length;
+        
+        this->impl->_groupingType = stream.ReadFourCC();
+        
+        if( this->GetVersion() == 1 )
+        {
+            this->impl->_defaultLength = stream.ReadBigEndianUInt32();
+        }
+        
+        if( this->GetVersion() >= 2 )
+        {
+            this->impl->_defaultSampleDescriptionIndex = stream.ReadBigEndianUInt32();
+        }
+        
+        count = stream.ReadBigEndianUInt32();
+        
+        if( count > stream.AvailableBytes() )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        this->impl->_offsets.assign( 1, 0 );
+        this->impl->_data.clear();
+        
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            if( this->GetVersion() == 0 )
+            {
+                length = static_cast< uint32_t >( stream.AvailableBytes() / ( count - i ) );
+            }
+            else if( this->GetVersion() == 1 && this->impl->_defaultLength == 0 )
+            {
+                length = stream.ReadBigEndianUInt32();
+            }
+            else
+            {
+                length = this->impl->_defaultLength;
+            }
+            
+            std::vector< uint8_t > entry( stream.Read( length ) );
+            
+            this->impl->_data.insert( this->impl->_data.end(), entry.begin(), entry.end() );
+            this->impl->_offsets.push_back( this->impl->_data.size() );
+        }
+    }
+    
+    uint64_t SGPD::GetDataSize() const
+    {
+        uint64_t size;
+        
+        size  = FullBox::GetDataSize() + 8;
+        size += ( this->GetVersion() == 1 || this->GetVersion() >= 2 ) ? 4 : 0;
+        size += this->impl->_data.size();
+        
+        if( this->GetVersion() == 1 && this->impl->_defaultLength == 0 )
+        {
+            size += ( this->impl->_offsets.size() - 1 ) * 4;
+        }
+        
+        return size;
+    }
+    
+    void SGPD::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteFourCC( this->impl->_groupingType );
+        
+        if( this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt32( this->impl->_defaultLength );
+        }
+        
+        if( this->GetVersion() >= 2 )
+        {
+            stream.WriteBigEndianUInt32( this->impl->_defaultSampleDescriptionIndex );
+        }
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_offsets.size() - 1 ) );
+        
+        for( size_t i = 0; i + 1 < this->impl->_offsets.size(); i++ )
+        {
+            if( this->GetVersion() == 1 && this->impl->_defaultLength == 0 )
+            {
+                stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_offsets[ i + 1 ] - this->impl->_offsets[ i ] ) );
+            }
+            
+            stream.Write( this->impl->_data.data() + this->impl->_offsets[ i ], this->impl->_offsets[ i + 1 ] - this->impl->_offsets[ i ] );
+        }
+    }
+    
+    std::vector< std::pair< std::string, std::string > > SGPD::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Grouping type",                    this->GetGroupingType() } );
+        props.push_back( { "Default length",                   std::to_string( this->GetDefaultLength() ) } );
+        props.push_back( { "Default sample description index", std::to_string( this->GetDefaultSampleDescriptionIndex() ) } );
+        
+        for( size_t i = 0; i < this->GetEntryCount(); i++ )
+        {
+            props.push_back( { "Entry", Utils::ToHexString( this->GetEntry( i ) ) } );
+        }
+        
+        return props;
+    }
+    
+    std::string SGPD::GetGroupingType() const
+    {
+        return this->impl->_groupingType;
+    }
+    
+    uint32_t SGPD::GetDefaultLength() const
+    {
+        return this->impl->_defaultLength;
+    }
+    
+    uint32_t SGPD::GetDefaultSampleDescriptionIndex() const
+    {
+        return this->impl->_defaultSampleDescriptionIndex;
+    }
+    
+    size_t SGPD::GetEntryCount() const
+    {
+        return this->impl->_offsets.size() - 1;
+    }
+    
+    std::vector< uint8_t > SGPD::GetEntry( size_t index ) const
+    {
+        return std::vector< uint8_t >( this->GetEntryData( index ), this->GetEntryData( index ) + this->GetEntrySize( index ) );
+    }
+    
+    const uint8_t * SGPD::GetEntryData( size_t index ) const
+    {
+        return this->impl->_data.data() + this->impl->_offsets[ index ];
+    }
+    
+    size_t SGPD::GetEntrySize( size_t index ) const
+    {
+        return this->impl->_offsets[ index + 1 ] - this->impl->_offsets[ index ];
+    }
+    
+    SGPD::IMPL::IMPL():
+        _defaultLength( 0 ),
+        _defaultSampleDescriptionIndex( 0 ),
+        _offsets( 1, 0 )
+    {}
+    
+    SGPD::IMPL::IMPL( const IMPL & o ):
+        _groupingType( o._groupingType ),
+        _defaultLength( o._defaultLength ),
+        _defaultSampleDescriptionIndex( o._defaultSampleDescriptionIndex ),
+        _offsets( o._offsets ),
+        _data( o._data )
+    {}
+    
+    SGPD::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,264 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SIDX.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/SIDX.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class SIDX::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t                _referenceID;
+            uint32_t                _timescale;
+            uint64_t                _earliestPresentationTime;
+            uint64_t                _firstOffset;
+            std::vector< uint32_t > _references;
+            std::vector< uint32_t > _durations;
+            std::vector< uint32_t > _saps;
+    };
+    
+    SIDX::SIDX():
+        FullBox( "sidx" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    SIDX::SIDX( const SIDX & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    SIDX::SIDX( SIDX && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    SIDX::~SIDX()
+    {}
+    
+    SIDX & SIDX::operator =( SIDX o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( SIDX & o1, SIDX & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void SIDX::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint16_t                count;
+        std::vector< uint32_t > entries;
+        
+        this->impl->_referenceID = stream.ReadBigEndianUInt32();
+        this->impl->_timescale   = stream.ReadBigEndianUInt32();
+        
+        if( this->GetVersion() == 0 )
+        {
+            this->impl->_earliestPresentationTime = stream.ReadBigEndianUInt32();
+            this->impl->_firstOffset              = stream.ReadBigEndianUInt32();
+        }
+        else
+        {
+            this->impl->_earliestPresentationTime = stream.ReadBigEndianUInt64();
+            this->impl->_firstOffset              = stream.ReadBigEndianUInt64();
+        }
+        
+        stream.ReadBigEndianUInt16();
+        
+        count   = stream.ReadBigEndianUInt16();
+        entries = stream.ReadBigEndianUInt32Array( static_cast< size_t >( count ) * 3 );
+        
+        this->impl->_references.resize( count );
+        this->impl->_durations.resize( count );
+        this->impl->_saps.resize( count );
+        
+        for( size_t i = 0; i < count; i++ )
+        {
+            this->impl->_references[ i ] = entries[ i * 3 ];
+            this->impl->_durations[ i ]  = entries[ i * 3 + 1 ];
+            this->impl->_saps[ i ]       = entries[ i * 3 + 2 ];
+        }
+    }
+    
+    uint64_t SIDX::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 12 + ( ( this->GetVersion() == 0 ) ? 8 : 16 ) + this->impl->_references.size() * 12;
+    }
+    
+    void SIDX::WriteData( BinaryOutputStream & stream ) const
+    {
+        std::vector< uint32_t > entries;
+        
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( this->impl->_referenceID );
+        stream.WriteBigEndianUInt32( this->impl->_timescale );
+        
+        if( this->GetVersion() == 0 )
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_earliestPresentationTime ) );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_firstOffset ) );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt64( this->impl->_earliestPresentationTime );
+            stream.WriteBigEndianUInt64( this->impl->_firstOffset );
+        }
+        
+        stream.WriteBigEndianUInt16( 0 );
+        stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->impl->_references.size() ) );
+        
+        entries.resize( this->impl->_references.size() * 3 );
+        
+        for( size_t i = 0; i < this->impl->_references.size(); i++ )
+        {
+            entries[ i * 3 ]     = this->impl->_references[ i ];
+            entries[ i * 3 + 1 ] = this->impl->_durations[ i ];
+            entries[ i * 3 + 2 ] = this->impl->_saps[ i ];
+        }
+        
+        stream.WriteBigEndianUInt32Array( entries );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > SIDX::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Reference ID",               std::to_string( this->GetReferenceID() ) } );
+        props.push_back( { "Timescale",                  std::to_string( this->GetTimescale() ) } );
+        props.push_back( { "Earliest presentation time", std::to_string( this->GetEarliestPresentationTime() ) } );
+        props.push_back( { "First offset",               std::to_string( this->GetFirstOffset() ) } );
+        
+        for( size_t i = 0; i < this->GetReferenceCount(); i++ )
+        {
+            props.push_back( { "Reference type",      ( this->IsIndexReference( i ) ) ? "Index" : "Media" } );
+            props.push_back( { "Referenced size",     std::to_string( this->GetReferencedSize( i ) ) } );
+            props.push_back( { "Subsegment duration", std::to_string( this->GetSubsegmentDuration( i ) ) } );
+            props.push_back( { "Starts with SAP",     ( this->StartsWithSAP( i ) ) ? "yes" : "no" } );
+            props.push_back( { "SAP type",            std::to_string( this->GetSAPType( i ) ) } );
+            props.push_back( { "SAP delta time",      std::to_string( this->GetSAPDeltaTime( i ) ) } );
+        }
+        
+        return props;
+    }
+    
+    uint32_t SIDX::GetReferenceID() const
+    {
+        return this->impl->_referenceID;
+    }
+    
+    uint32_t SIDX::GetTimescale() const
+    {
+        return this->impl->_timescale;
+    }
+    
+    uint64_t SIDX::GetEarliestPresentationTime() const
+    {
+        return this->impl->_earliestPresentationTime;
+    }
+    
+    uint64_t SIDX::GetFirstOffset() const
+    {
+        return this->impl->_firstOffset;
+    }
+    
+    size_t SIDX::GetReferenceCount() const
+    {
+        return this->impl->_references.size();
+    }
+    
+    bool SIDX::IsIndexReference( size_t index ) const
+    {
+        return ( this->impl->_references[ index ] & 0x80000000 ) != 0;
+    }
+    
+    uint32_t SIDX::GetReferencedSize( size_t index ) const
+    {
+        return this->impl->_references[ index ] & 0x7FFFFFFF;
+    }
+    
+    uint32_t SIDX::GetSubsegmentDuration( size_t index ) const
+    {
+        return this->impl->_durations[ index ];
+    }
+    
+    bool SIDX::StartsWithSAP( size_t index ) const
+    {
+        return ( this->impl->_saps[ index ] & 0x80000000 ) != 0;
+    }
+    
+    uint8_t SIDX::GetSAPType( size_t index ) const
+    {
+        return static_cast< uint8_t >( ( this->impl->_saps[ index ] >> 28 ) & 0x07 );
+    }
+    
+    uint32_t SIDX::GetSAPDeltaTime( size_t index ) const
+    {
+        return this->impl->_saps[ index ] & 0x0FFFFFFF;
+    }
+    
+    SIDX::IMPL::IMPL():
+        _referenceID( 0 ),
+        _timescale( 0 ),
+        _earliestPresentationTime( 0 ),
+        _firstOffset( 0 )
+    {}
+    
+    SIDX::IMPL::IMPL( const IMPL & o ):
+        _referenceID( o._referenceID ),
+        _timescale( o._timescale ),
+        _earliestPresentationTime( o._earliestPresentationTime ),
+        _firstOffset( o._firstOffset ),
+        _references( o._references ),
+        _durations( o._durations ),
+        _saps( o._saps )
+    {}
+    
+    SIDX::IMPL::~IMPL()
+    {}
+}
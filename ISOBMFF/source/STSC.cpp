@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        STSC.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/STSC.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class STSC::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            std::vector< uint32_t > _firstChunk;
+            std::vector< uint32_t > _samplesPerChunk;
+            std::vector< uint32_t > _sampleDescriptionIndex;
+    };
+    
+    STSC::STSC():
+        FullBox( "stsc" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    STSC::STSC( const STSC & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    STSC::STSC( STSC && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    STSC::~STSC()
+    {}
+    
+    STSC & STSC::operator =( STSC o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( STSC & o1, STSC & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void STSC::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint32_t                count;
+        std::vector< uint32_t > entries;
+        
+        count = stream.ReadBigEndianUInt32();
+        
+        if( count > stream.AvailableBytes() / 12 )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        entries = stream.ReadBigEndianUInt32Array( static_cast< size_t >( count ) * 3 );
+        
+        this->impl->_firstChunk.resize( count );
+        this->impl->_samplesPerChunk.resize( count );
+        this->impl->_sampleDescriptionIndex.resize( count );
+        
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            this->impl->_firstChunk[ i ]             = entries[ i * 3 ];
+            this->impl->_samplesPerChunk[ i ]        = entries[ i * 3 + 1 ];
+            this->impl->_sampleDescriptionIndex[ i ] = entries[ i * 3 + 2 ];
+        }
+    }
+    
+    uint64_t STSC::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + this->impl->_firstChunk.size() * 12;
+    }
+    
+    void STSC::WriteData( BinaryOutputStream & stream ) const
+    {
+        std::vector< uint32_t > entries;
+        
+        FullBox::WriteData( stream );
+        
+        entries.resize( this->impl->_firstChunk.size() * 3 );
+        
+        for( size_t i = 0; i < this->impl->_firstChunk.size(); i++ )
+        {
+            entries[ i * 3 ]     = this->impl->_firstChunk[ i ];
+            entries[ i * 3 + 1 ] = this->impl->_samplesPerChunk[ i ];
+            entries[ i * 3 + 2 ] = this->impl->_sampleDescriptionIndex[ i ];
+        }
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_firstChunk.size() ) );
+        stream.WriteBigEndianUInt32Array( entries );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > STSC::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        for( size_t i = 0; i < this->GetEntryCount(); i++ )
+        {
+            props.push_back( { "First chunk",              std::to_string( this->GetFirstChunk( i ) ) } );
+            props.push_back( { "Samples per chunk",        std::to_string( this->GetSamplesPerChunk( i ) ) } );
+            props.push_back( { "Sample description index", std::to_string( this->GetSampleDescriptionIndex( i ) ) } );
+        }
+        
+        return props;
+    }
+    
+    size_t STSC::GetEntryCount() const
+    {
+        return this->impl->_firstChunk.size();
+    }
+    
+    uint32_t STSC::GetFirstChunk( size_t index ) const
+    {
+        return this->impl->_firstChunk[ index ];
+    }
+    
+    uint32_t STSC::GetSamplesPerChunk( size_t index ) const
+    {
+        return this->impl->_samplesPerChunk[ index ];
+    }
+    
+    uint32_t STSC::GetSampleDescriptionIndex( size_t index ) const
+    {
+        return this->impl->_sampleDescriptionIndex[ index ];
+    }
+    
+    STSC::IMPL::IMPL()
+    {}
+    
+    STSC::IMPL::IMPL( const IMPL & o ):
+        _firstChunk( o._firstChunk ),
+        _samplesPerChunk( o._samplesPerChunk ),
+        _sampleDescriptionIndex( o._sampleDescriptionIndex )
+    {}
+    
+    STSC::IMPL::~IMPL()
+    {}
+}
@@ -91,6 +91,20 @@ namespace ISOBMFF
         this->impl->_boxes = container.GetBoxes();
     }
     
+    uint64_t STSD::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + this->GetBoxesSize();
+    }
+    
+    void STSD::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_boxes.size() ) );
+        
+        this->WriteBoxes( stream );
+    }
+    
     void STSD::WriteDescription( std::ostream & os, std::size_t indentLevel ) const
     {
         FullBox::WriteDescription( os, indentLevel );
@@ -103,6 +117,8 @@ namespace ISOBMFF
         {
             this->impl->_boxes.push_back( box );
         }
+        
+        this->SetModified( true );
     }
     
     std::vector< std::shared_ptr< Box > > STSD::GetBoxes() const
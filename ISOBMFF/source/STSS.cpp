@@ -32,6 +32,7 @@
 #include <ISOBMFF/Parser.hpp>
 #include <cstdint>
 #include <cstring>
+#include <stdexcept>
 
 namespace ISOBMFF
 {
@@ -86,12 +87,20 @@ namespace ISOBMFF
     {
         FullBox::ReadData( parser, stream );
 
-        uint32_t entry_count = stream.ReadBigEndianUInt32();
+        this->impl->_sample_number = stream.ReadBigEndianUInt32Array( stream.ReadBigEndianUInt32() );
+    }
 
-        for( uint32_t i = 0; i < entry_count; i++ )
-        {
-            this->impl->_sample_number.push_back(  stream.ReadBigEndianUInt32() );
-        }
+    uint64_t STSS::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + this->impl->_sample_number.size() * 4;
+    }
+    
+    void STSS::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sample_number.size() ) );
+        stream.WriteBigEndianUInt32Array( this->impl->_sample_number );
     }
 
     std::vector< std::pair< std::string, std::string > > STSS::GetDisplayableProperties() const
@@ -116,6 +125,73 @@ namespace ISOBMFF
         return this->impl->_sample_number[ index ];
     }
 
+    bool STSS::IsSyncSample( uint64_t sample ) const
+    {
+        return std::binary_search( this->impl->_sample_number.begin(), this->impl->_sample_number.end(), sample + 1 );
+    }
+    
+    uint64_t STSS::GetSyncSampleAtOrBefore( uint64_t sample ) const
+    {
+        std::vector< uint32_t >::const_iterator it;
+        
+        if( this->impl->_sample_number.size() == 0 )
+        {
+            throw std::runtime_error( "No sync samples" );
+        }
+        
+        it = std::upper_bound( this->impl->_sample_number.begin(), this->impl->_sample_number.end(), sample + 1 );
+        it = ( it == this->impl->_sample_number.begin() ) ? it : it - 1;
+        
+        return static_cast< uint64_t >( *( it ) ) - 1;
+    }
+    
+    uint64_t STSS::GetSyncSampleAtOrAfter( uint64_t sample ) const
+    {
+        std::vector< uint32_t >::const_iterator it;
+        
+        if( this->impl->_sample_number.size() == 0 )
+        {
+            throw std::runtime_error( "No sync samples" );
+        }
+        
+        it = std::lower_bound( this->impl->_sample_number.begin(), this->impl->_sample_number.end(), sample + 1 );
+        it = ( it == this->impl->_sample_number.end() ) ? it - 1 : it;
+        
+        return static_cast< uint64_t >( *( it ) ) - 1;
+    }
+    
+    uint64_t STSS::GetSyncSampleAtOrBeforeTime( const STSS * stss, const STTS & stts, const CTTS * ctts, uint64_t time )
+    {
+        uint64_t sample;
+        uint64_t previous;
+        
+        auto presentation = [ & ]( uint64_t s ) -> int64_t
+        {
+            return static_cast< int64_t >( stts.GetDecodeTime( s ) ) + ( ( ctts == nullptr ) ? 0 : ctts->GetCompositionOffset( s ) );
+        };
+        
+        sample = stts.GetSampleAtTime( time );
+        sample = ( stss == nullptr ) ? sample : stss->GetSyncSampleAtOrBefore( sample );
+        
+        /*
+         * With composition offsets, a sample decoded before the time may
+         * still be presented after it, so earlier sync samples are tried.
+         */
+        while( presentation( sample ) > static_cast< int64_t >( time ) && sample > 0 )
+        {
+            previous = ( stss == nullptr ) ? sample - 1 : stss->GetSyncSampleAtOrBefore( sample - 1 );
+            
+            if( previous >= sample )
+            {
+                break;
+            }
+            
+            sample = previous;
+        }
+        
+        return sample;
+    }
+    
     STSS::IMPL::IMPL()
     {}
 
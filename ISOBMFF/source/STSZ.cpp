@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        STSZ.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/STSZ.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class STSZ::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t                _sampleSize;
+            uint32_t                _sampleCount;
+            std::vector< uint32_t > _entrySizes;
+    };
+    
+    STSZ::STSZ():
+        FullBox( "stsz" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    STSZ::STSZ( const STSZ & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    STSZ::STSZ( STSZ && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    STSZ::~STSZ()
+    {}
+    
+    STSZ & STSZ::operator =( STSZ o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( STSZ & o1, STSZ & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void STSZ::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        this->impl->_sampleSize  = stream.ReadBigEndianUInt32();
+        this->impl->_sampleCount = stream.ReadBigEndianUInt32();
+        
+        if( this->impl->_sampleSize == 0 )
+        {
+            this->impl->_entrySizes = stream.ReadBigEndianUInt32Array( this->impl->_sampleCount );
+        }
+    }
+    
+    uint64_t STSZ::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 8 + ( ( this->impl->_sampleSize == 0 ) ? this->impl->_entrySizes.size() * 4 : 0 );
+    }
+    
+    void STSZ::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( this->impl->_sampleSize );
+        stream.WriteBigEndianUInt32( this->impl->_sampleCount );
+        
+        if( this->impl->_sampleSize == 0 )
+        {
+            stream.WriteBigEndianUInt32Array( this->impl->_entrySizes );
+        }
+    }
+    
+    std::vector< std::pair< std::string, std::string > > STSZ::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Sample size",  std::to_string( this->GetSampleSize() ) } );
+        props.push_back( { "Sample count", std::to_string( this->GetSampleCount() ) } );
+        
+        for( uint32_t size: this->impl->_entrySizes )
+        {
+            props.push_back( { "Entry size", std::to_string( size ) } );
+        }
+        
+        return props;
+    }
+    
+    uint32_t STSZ::GetSampleSize() const
+    {
+        return this->impl->_sampleSize;
+    }
+    
+    uint32_t STSZ::GetSampleCount() const
+    {
+        return this->impl->_sampleCount;
+    }
+    
+    uint32_t STSZ::GetEntrySize( size_t index ) const
+    {
+        if( this->impl->_sampleSize != 0 )
+        {
+            return this->impl->_sampleSize;
+        }
+        
+        return this->impl->_entrySizes[ index ];
+    }
+    
+    const std::vector< uint32_t > & STSZ::GetEntrySizes() const
+    {
+        return this->impl->_entrySizes;
+    }
+    
+    STSZ::IMPL::IMPL():
+        _sampleSize( 0 ),
+        _sampleCount( 0 )
+    {}
+    
+    STSZ::IMPL::IMPL( const IMPL & o ):
+        _sampleSize( o._sampleSize ),
+        _sampleCount( o._sampleCount ),
+        _entrySizes( o._entrySizes )
+    {}
+    
+    STSZ::IMPL::~IMPL()
+    {}
+}
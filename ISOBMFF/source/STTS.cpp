@@ -32,6 +32,8 @@
 #include <ISOBMFF/Parser.hpp>
 #include <cstdint>
 #include <cstring>
+#include <stdexcept>
+#include <mutex>
 
 namespace ISOBMFF
 {
@@ -43,8 +45,21 @@ namespace ISOBMFF
             IMPL( const IMPL & o );
             ~IMPL();
 
+            void BuildIndex();
+            
             std::vector< uint32_t > _sample_count;
             std::vector< uint32_t > _sample_offset;
+            
+            /*
+             * Built on first lookup: first sample and decode time of each
+             * non-empty entry, so lookups are binary searches.
+             */
+            std::once_flag          _indexOnce;
+            std::vector< uint64_t > _indexSample;
+            std::vector< uint64_t > _indexTime;
+            std::vector< size_t >   _indexEntry;
+            uint64_t                _totalSamples;
+            uint64_t                _totalDuration;
     };
 
     STTS::STTS():
@@ -89,12 +104,46 @@ namespace ISOBMFF
 
         uint32_t entry_count = stream.ReadBigEndianUInt32();
 
+        if( entry_count > stream.AvailableBytes() / 8 )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        /* One bulk read, then the interleaved fields are split */
+        std::vector< uint32_t > entries = stream.ReadBigEndianUInt32Array( static_cast< size_t >( entry_count ) * 2 );
+        
+        this->impl->_sample_count.resize( entry_count );
+        this->impl->_sample_offset.resize( entry_count );
+        
         for( uint32_t i = 0; i < entry_count; i++ )
         {
-            this->impl->_sample_count.push_back(  stream.ReadBigEndianUInt32() );
-            this->impl->_sample_offset.push_back( stream.ReadBigEndianUInt32() );
+            this->impl->_sample_count[ i ]  = entries[ i * 2 ];
+            this->impl->_sample_offset[ i ] = entries[ i * 2 + 1 ];
         }
     }
+    
+    uint64_t STTS::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 4 + this->impl->_sample_count.size() * 8;
+    }
+    
+    void STTS::WriteData( BinaryOutputStream & stream ) const
+    {
+        std::vector< uint32_t > entries;
+        
+        FullBox::WriteData( stream );
+        
+        entries.resize( this->impl->_sample_count.size() * 2 );
+        
+        for( size_t i = 0; i < this->impl->_sample_count.size(); i++ )
+        {
+            entries[ i * 2 ]     = this->impl->_sample_count[ i ];
+            entries[ i * 2 + 1 ] = this->impl->_sample_offset[ i ];
+        }
+        
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_sample_count.size() ) );
+        stream.WriteBigEndianUInt32Array( entries );
+    }
 
     std::vector< std::pair< std::string, std::string > > STTS::GetDisplayableProperties() const
     {
@@ -124,10 +173,135 @@ namespace ISOBMFF
         return this->impl->_sample_offset[ index ];
     }
 
-    STTS::IMPL::IMPL()
+    uint64_t STTS::GetTotalSampleCount() const
+    {
+        std::call_once( this->impl->_indexOnce, [ this ] { this->impl->BuildIndex(); } );
+        
+        return this->impl->_totalSamples;
+    }
+    
+    uint64_t STTS::GetTotalDuration() const
+    {
+        std::call_once( this->impl->_indexOnce, [ this ] { this->impl->BuildIndex(); } );
+        
+        return this->impl->_totalDuration;
+    }
+    
+    uint64_t STTS::GetDecodeTime( uint64_t sample ) const
+    {
+        size_t i;
+        
+        std::call_once( this->impl->_indexOnce, [ this ] { this->impl->BuildIndex(); } );
+        
+        if( sample >= this->impl->_totalSamples )
+        {
+            throw std::runtime_error( "Invalid sample index" );
+        }
+        
+        i = static_cast< size_t >( std::upper_bound( this->impl->_indexSample.begin(), this->impl->_indexSample.end(), sample ) - this->impl->_indexSample.begin() ) - 1;
+        
+        return this->impl->_indexTime[ i ] + ( sample - this->impl->_indexSample[ i ] ) * this->impl->_sample_offset[ this->impl->_indexEntry[ i ] ];
+    }
+    
+    uint32_t STTS::GetSampleDuration( uint64_t sample ) const
+    {
+        size_t i;
+        
+        std::call_once( this->impl->_indexOnce, [ this ] { this->impl->BuildIndex(); } );
+        
+        if( sample >= this->impl->_totalSamples )
+        {
+            throw std::runtime_error( "Invalid sample index" );
+        }
+        
+        i = static_cast< size_t >( std::upper_bound( this->impl->_indexSample.begin(), this->impl->_indexSample.end(), sample ) - this->impl->_indexSample.begin() ) - 1;
+        
+        return this->impl->_sample_offset[ this->impl->_indexEntry[ i ] ];
+    }
+    
+    uint64_t STTS::GetSampleAtTime( uint64_t time ) const
+    {
+        size_t   i;
+        uint32_t delta;
+        uint64_t n;
+        
+        std::call_once( this->impl->_indexOnce, [ this ] { this->impl->BuildIndex(); } );
+        
+        if( this->impl->_totalSamples == 0 )
+        {
+            throw std::runtime_error( "No samples" );
+        }
+        
+        i     = static_cast< size_t >( std::upper_bound( this->impl->_indexTime.begin(), this->impl->_indexTime.end(), time ) - this->impl->_indexTime.begin() ) - 1;
+        delta = this->impl->_sample_offset[ this->impl->_indexEntry[ i ] ];
+        n     = this->impl->_sample_count[ this->impl->_indexEntry[ i ] ];
+        
+        /*
+         * Entries with a zero duration share their start time with the next
+         * one, so the search lands on the first sample of the later entry.
+         */
+        n = ( delta == 0 ) ? 0 : std::min( ( time - this->impl->_indexTime[ i ] ) / delta, n - 1 );
+        
+        return this->impl->_indexSample[ i ] + n;
+    }
+    
+    size_t STTS::GetEntryForSample( uint64_t sample ) const
+    {
+        size_t i;
+        
+        std::call_once( this->impl->_indexOnce, [ this ] { this->impl->BuildIndex(); } );
+        
+        if( sample >= this->impl->_totalSamples )
+        {
+            throw std::runtime_error( "Invalid sample index" );
+        }
+        
+        i = static_cast< size_t >( std::upper_bound( this->impl->_indexSample.begin(), this->impl->_indexSample.end(), sample ) - this->impl->_indexSample.begin() ) - 1;
+        
+        return this->impl->_indexEntry[ i ];
+    }
+    
+    uint64_t STTS::GetEntryFirstSample( size_t index ) const
+    {
+        size_t i;
+        
+        std::call_once( this->impl->_indexOnce, [ this ] { this->impl->BuildIndex(); } );
+        
+        i = static_cast< size_t >( std::lower_bound( this->impl->_indexEntry.begin(), this->impl->_indexEntry.end(), index ) - this->impl->_indexEntry.begin() );
+        
+        return ( i < this->impl->_indexSample.size() ) ? this->impl->_indexSample[ i ] : this->impl->_totalSamples;
+    }
+    
+    void STTS::IMPL::BuildIndex()
+    {
+        this->_indexSample.reserve( this->_sample_count.size() );
+        this->_indexTime.reserve( this->_sample_count.size() );
+        this->_indexEntry.reserve( this->_sample_count.size() );
+        
+        for( size_t i = 0; i < this->_sample_count.size(); i++ )
+        {
+            if( this->_sample_count[ i ] == 0 )
+            {
+                continue;
+            }
+            
+            this->_indexSample.push_back( this->_totalSamples );
+            this->_indexTime.push_back( this->_totalDuration );
+            this->_indexEntry.push_back( i );
+            
+            this->_totalSamples  += this->_sample_count[ i ];
+            this->_totalDuration += static_cast< uint64_t >( this->_sample_count[ i ] ) * this->_sample_offset[ i ];
+        }
+    }
+    
+    STTS::IMPL::IMPL():
+        _totalSamples( 0 ),
+        _totalDuration( 0 )
     {}
 
-    STTS::IMPL::IMPL( const IMPL & o )
+    STTS::IMPL::IMPL( const IMPL & o ):
+        _totalSamples( 0 ),
+        _totalDuration( 0 )
     {
         this->_sample_count  = o._sample_count;
         this->_sample_offset = o._sample_offset;
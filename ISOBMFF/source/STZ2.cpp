@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        STZ2.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/STZ2.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class STZ2::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint8_t                _fieldSize;
+            uint32_t               _sampleCount;
+            std::vector< uint8_t > _entries;
+    };
+    
+    STZ2::STZ2():
+        FullBox( "stz2" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    STZ2::STZ2( const STZ2 & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    STZ2::STZ2( STZ2 && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    STZ2::~STZ2()
+    {}
+    
+    STZ2 & STZ2::operator =( STZ2 o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( STZ2 & o1, STZ2 & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void STZ2::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint64_t size;
+        
+        stream.ReadBigEndianUInt16();
+        stream.ReadUInt8();
+        
+        this->impl->_fieldSize   = stream.ReadUInt8();
+        this->impl->_sampleCount = stream.ReadBigEndianUInt32();
+        
+        if( this->impl->_fieldSize != 4 && this->impl->_fieldSize != 8 && this->impl->_fieldSize != 16 )
+        {
+            throw std::runtime_error( "Invalid STZ2 field size" );
+        }
+        
+        size = ( static_cast< uint64_t >( this->impl->_sampleCount ) * this->impl->_fieldSize + 7 ) / 8;
+        
+        if( size > stream.AvailableBytes() )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        this->impl->_entries = stream.Read( static_cast< size_t >( size ) );
+    }
+    
+    uint64_t STZ2::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 8 + this->impl->_entries.size();
+    }
+    
+    void STZ2::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt16( 0 );
+        stream.WriteUInt8( 0 );
+        stream.WriteUInt8( this->impl->_fieldSize );
+        stream.WriteBigEndianUInt32( this->impl->_sampleCount );
+        stream.Write( this->impl->_entries );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > STZ2::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Field size",   std::to_string( this->GetFieldSize() ) } );
+        props.push_back( { "Sample count", std::to_string( this->GetSampleCount() ) } );
+        
+        for( uint32_t i = 0; i < this->GetSampleCount(); i++ )
+        {
+            props.push_back( { "Entry size", std::to_string( this->GetEntrySize( i ) ) } );
+        }
+        
+        return props;
+    }
+    
+    uint8_t STZ2::GetFieldSize() const
+    {
+        return this->impl->_fieldSize;
+    }
+    
+    uint32_t STZ2::GetSampleCount() const
+    {
+        return this->impl->_sampleCount;
+    }
+    
+    uint32_t STZ2::GetEntrySize( size_t index ) const
+    {
+        const uint8_t * entries( this->impl->_entries.data() );
+        
+        if( this->impl->_fieldSize == 4 )
+        {
+            return ( index % 2 == 0 ) ? entries[ index / 2 ] >> 4 : entries[ index / 2 ] & 0x0F;
+        }
+        else if( this->impl->_fieldSize == 8 )
+        {
+            return entries[ index ];
+        }
+        
+        return static_cast< uint32_t >( entries[ index * 2 ] << 8 ) | entries[ index * 2 + 1 ];
+    }
+    
+    STZ2::IMPL::IMPL():
+        _fieldSize( 0 ),
+        _sampleCount( 0 )
+    {}
+    
+    STZ2::IMPL::IMPL( const IMPL & o ):
+        _fieldSize( o._fieldSize ),
+        _sampleCount( o._sampleCount ),
+        _entries( o._entries )
+    {}
+    
+    STZ2::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,746 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SampleDecryptor.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/SampleDecryptor.hpp>
+#include <stdexcept>
+#include <cstring>
+
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#define ISOBMFF_AES_X86_64
+#include <wmmintrin.h>
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace ISOBMFF
+{
+    class SampleDecryptor::IMPL
+    {
+        public:
+            
+            IMPL( const std::string & scheme, const std::vector< uint8_t > & key );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void DecryptCTR( uint8_t * data, size_t size, uint8_t * counter, uint8_t * keystream, size_t & used ) const;
+            void DecryptPattern( uint8_t * data, size_t size, const uint8_t * iv, size_t crypt, size_t skip ) const;
+            
+            std::string _scheme;
+            uint8_t     _encryptionKeys[ 176 ];
+            uint8_t     _decryptionKeys[ 176 ];
+            bool        _hasAESNI;
+            bool        _accelerated;
+    };
+    
+    static void ExpandKey( const uint8_t * key, uint8_t * keys );
+    static void EncryptBlock( const uint8_t * keys, const uint8_t * in, uint8_t * out );
+    static void DecryptBlock( const uint8_t * keys, const uint8_t * in, uint8_t * out );
+    static void IncrementCounter( uint8_t * counter );
+    static void MixColumns( uint8_t * s );
+    static void InvMixColumns( uint8_t * s );
+    static void CTRScalar( const uint8_t * keys, uint8_t * counter, uint8_t * data, size_t blocks );
+    static void CBCScalar( const uint8_t * keys, uint8_t * iv, uint8_t * data, size_t blocks );
+
+    #ifdef ISOBMFF_AES_X86_64
+    
+    static bool HasAESNI();
+    static void InvertKeysAESNI( const uint8_t * keys, uint8_t * inverse );
+    static void CTRAESNI( const uint8_t * keys, uint8_t * counter, uint8_t * data, size_t blocks );
+    static void CBCAESNI( const uint8_t * keys, uint8_t * iv, uint8_t * data, size_t blocks );
+
+    #endif
+    
+    static const uint8_t SBox[ 256 ] =
+    {
+        0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+        0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+        0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+        0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+        0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+        0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+        0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+        0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+        0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+        0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+        0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+        0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+        0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+        0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+        0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+        0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+    };
+    
+    static const uint8_t InverseSBox[ 256 ] =
+    {
+        0x52, 0x09, 0x6A, 0xD5, 0x30, 0x36, 0xA5, 0x38, 0xBF, 0x40, 0xA3, 0x9E, 0x81, 0xF3, 0xD7, 0xFB,
+        0x7C, 0xE3, 0x39, 0x82, 0x9B, 0x2F, 0xFF, 0x87, 0x34, 0x8E, 0x43, 0x44, 0xC4, 0xDE, 0xE9, 0xCB,
+        0x54, 0x7B, 0x94, 0x32, 0xA6, 0xC2, 0x23, 0x3D, 0xEE, 0x4C, 0x95, 0x0B, 0x42, 0xFA, 0xC3, 0x4E,
+        0x08, 0x2E, 0xA1, 0x66, 0x28, 0xD9, 0x24, 0xB2, 0x76, 0x5B, 0xA2, 0x49, 0x6D, 0x8B, 0xD1, 0x25,
+        0x72, 0xF8, 0xF6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xD4, 0xA4, 0x5C, 0xCC, 0x5D, 0x65, 0xB6, 0x92,
+        0x6C, 0x70, 0x48, 0x50, 0xFD, 0xED, 0xB9, 0xDA, 0x5E, 0x15, 0x46, 0x57, 0xA7, 0x8D, 0x9D, 0x84,
+        0x90, 0xD8, 0xAB, 0x00, 0x8C, 0xBC, 0xD3, 0x0A, 0xF7, 0xE4, 0x58, 0x05, 0xB8, 0xB3, 0x45, 0x06,
+        0xD0, 0x2C, 0x1E, 0x8F, 0xCA, 0x3F, 0x0F, 0x02, 0xC1, 0xAF, 0xBD, 0x03, 0x01, 0x13, 0x8A, 0x6B,
+        0x3A, 0x91, 0x11, 0x41, 0x4F, 0x67, 0xDC, 0xEA, 0x97, 0xF2, 0xCF, 0xCE, 0xF0, 0xB4, 0xE6, 0x73,
+        0x96, 0xAC, 0x74, 0x22, 0xE7, 0xAD, 0x35, 0x85, 0xE2, 0xF9, 0x37, 0xE8, 0x1C, 0x75, 0xDF, 0x6E,
+        0x47, 0xF1, 0x1A, 0x71, 0x1D, 0x29, 0xC5, 0x89, 0x6F, 0xB7, 0x62, 0x0E, 0xAA, 0x18, 0xBE, 0x1B,
+        0xFC, 0x56, 0x3E, 0x4B, 0xC6, 0xD2, 0x79, 0x20, 0x9A, 0xDB, 0xC0, 0xFE, 0x78, 0xCD, 0x5A, 0xF4,
+        0x1F, 0xDD, 0xA8, 0x33, 0x88, 0x07, 0xC7, 0x31, 0xB1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xEC, 0x5F,
+        0x60, 0x51, 0x7F, 0xA9, 0x19, 0xB5, 0x4A, 0x0D, 0x2D, 0xE5, 0x7A, 0x9F, 0x93, 0xC9, 0x9C, 0xEF,
+        0xA0, 0xE0, 0x3B, 0x4D, 0xAE, 0x2A, 0xF5, 0xB0, 0xC8, 0xEB, 0xBB, 0x3C, 0x83, 0x53, 0x99, 0x61,
+        0x17, 0x2B, 0x04, 0x7E, 0xBA, 0x77, 0xD6, 0x26, 0xE1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0C, 0x7D
+    };
+    
+    SampleDecryptor::SampleDecryptor( const std::string & scheme, const std::vector< uint8_t > & key ):
+        impl( std::make_unique< IMPL >( scheme, key ) )
+    {}
+    
+    SampleDecryptor::SampleDecryptor( const SampleDecryptor & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    SampleDecryptor::SampleDecryptor( SampleDecryptor && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    SampleDecryptor::~SampleDecryptor()
+    {}
+    
+    SampleDecryptor & SampleDecryptor::operator =( SampleDecryptor o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( SampleDecryptor & o1, SampleDecryptor & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    std::string SampleDecryptor::GetScheme() const
+    {
+        return this->impl->_scheme;
+    }
+    
+    bool SampleDecryptor::IsAccelerated() const
+    {
+        return this->impl->_accelerated;
+    }
+    
+    void SampleDecryptor::SetAccelerated( bool value )
+    {
+        this->impl->_accelerated = value && this->impl->_hasAESNI;
+    }
+    
+    void SampleDecryptor::Decrypt( uint8_t * data, size_t size, const EncryptionIndex & index, size_t sample ) const
+    {
+        std::vector< uint8_t > iv;
+        uint8_t                block[ 16 ];
+        uint8_t                keystream[ 16 ];
+        size_t                 used;
+        size_t                 count;
+        size_t                 position;
+        
+        if( index.IsProtected( sample ) == false )
+        {
+            return;
+        }
+        
+        iv = index.GetIV( sample );
+        
+        if( iv.size() == 0 || iv.size() > 16 )
+        {
+            throw std::runtime_error( "Invalid initialization vector" );
+        }
+        
+        memset( block, 0, sizeof( block ) );
+        memcpy( block, iv.data(), iv.size() );
+        
+        count = index.GetSubsampleCount( sample );
+        used  = sizeof( keystream );
+        
+        if( count == 0 )
+        {
+            if( this->impl->_scheme == "cenc" )
+            {
+                this->impl->DecryptCTR( data, size, block, keystream, used );
+            }
+            else
+            {
+                this->impl->DecryptPattern( data, size, block, index.GetCryptByteBlock( sample ), index.GetSkipByteBlock( sample ) );
+            }
+            
+            return;
+        }
+        
+        position = 0;
+        
+        for( size_t i = 0; i < count; i++ )
+        {
+            size_t clear(     index.GetSubsampleClearBytes( sample, i ) );
+            size_t encrypted( index.GetSubsampleEncryptedBytes( sample, i ) );
+            
+            if( clear > size - position || encrypted > size - position - clear )
+            {
+                throw std::runtime_error( "Invalid subsample sizes" );
+            }
+            
+            position += clear;
+            
+            /*
+             * 'cenc' keeps a single key stream for the whole sample, while
+             * 'cbcs' restarts the CBC chain from the IV at each subsample.
+             */
+            if( this->impl->_scheme == "cenc" )
+            {
+                this->impl->DecryptCTR( data + position, encrypted, block, keystream, used );
+            }
+            else
+            {
+                this->impl->DecryptPattern( data + position, encrypted, block, index.GetCryptByteBlock( sample ), index.GetSkipByteBlock( sample ) );
+            }
+            
+            position += encrypted;
+        }
+    }
+    
+    SampleDecryptor::IMPL::IMPL( const std::string & scheme, const std::vector< uint8_t > & key ):
+        _scheme( scheme ),
+        _hasAESNI( false ),
+        _accelerated( false )
+    {
+        if( scheme != "cenc" && scheme != "cbcs" )
+        {
+            throw std::runtime_error( "Unsupported protection scheme: " + scheme );
+        }
+        
+        if( key.size() != 16 )
+        {
+            throw std::runtime_error( "Invalid key size" );
+        }
+        
+        ExpandKey( key.data(), this->_encryptionKeys );
+        memset( this->_decryptionKeys, 0, sizeof( this->_decryptionKeys ) );
+
+        #ifdef ISOBMFF_AES_X86_64
+        
+        this->_hasAESNI    = HasAESNI();
+        this->_accelerated = this->_hasAESNI;
+        
+        if( this->_hasAESNI )
+        {
+            InvertKeysAESNI( this->_encryptionKeys, this->_decryptionKeys );
+        }
+
+        #endif
+    }
+    
+    void SampleDecryptor::IMPL::DecryptCTR( uint8_t * data, size_t size, uint8_t * counter, uint8_t * keystream, size_t & used ) const
+    {
+        size_t blocks;
+        
+        /*
+         * Key stream bytes left from the previous subsample come first.
+         */
+        while( size > 0 && used < 16 )
+        {
+            *( data++ ) ^= keystream[ used++ ];
+            
+            size--;
+        }
+        
+        blocks = size / 16;
+
+        #ifdef ISOBMFF_AES_X86_64
+        
+        if( this->_accelerated )
+        {
+            CTRAESNI( this->_encryptionKeys, counter, data, blocks );
+        }
+        else
+        {
+            CTRScalar( this->_encryptionKeys, counter, data, blocks );
+        }
+
+        #else
+        
+        CTRScalar( this->_encryptionKeys, counter, data, blocks );
+
+        #endif
+        
+        data += blocks * 16;
+        size -= blocks * 16;
+        
+        if( size > 0 )
+        {
+            EncryptBlock( this->_encryptionKeys, counter, keystream );
+            IncrementCounter( counter );
+            
+            for( used = 0; used < size; used++ )
+            {
+                data[ used ] ^= keystream[ used ];
+            }
+        }
+    }
+    
+    void SampleDecryptor::IMPL::DecryptPattern( uint8_t * data, size_t size, const uint8_t * iv, size_t crypt, size_t skip ) const
+    {
+        uint8_t chain[ 16 ];
+        
+        memcpy( chain, iv, sizeof( chain ) );
+        
+        /*
+         * No pattern (0:0) means all blocks are encrypted. A trailing
+         * partial block is always left in the clear.
+         */
+        if( crypt == 0 )
+        {
+            crypt = 1;
+            skip  = 0;
+        }
+        
+        while( size >= 16 )
+        {
+            size_t blocks( std::min( crypt, size / 16 ) );
+
+            #ifdef ISOBMFF_AES_X86_64
+            
+            if( this->_accelerated )
+            {
+                CBCAESNI( this->_decryptionKeys, chain, data, blocks );
+            }
+            else
+            {
+                CBCScalar( this->_encryptionKeys, chain, data, blocks );
+            }
+
+            #else
+            
+            CBCScalar( this->_encryptionKeys, chain, data, blocks );
+
+            #endif
+            
+            data += blocks * 16;
+            size -= blocks * 16;
+            
+            blocks = std::min( skip * 16, size );
+            data  += blocks;
+            size  -= blocks;
+        }
+    }
+    
+    static uint8_t XTime( uint8_t a )
+    {
+        return static_cast< uint8_t >( ( a << 1 ) ^ ( ( a & 0x80 ) ? 0x1B : 0x00 ) );
+    }
+    
+    static void MixColumns( uint8_t * s )
+    {
+        for( size_t c = 0; c < 16; c += 4 )
+        {
+            uint8_t a0( s[ c ] );
+            uint8_t a1( s[ c + 1 ] );
+            uint8_t a2( s[ c + 2 ] );
+            uint8_t a3( s[ c + 3 ] );
+            uint8_t all( static_cast< uint8_t >( a0 ^ a1 ^ a2 ^ a3 ) );
+            
+            s[ c ]     = static_cast< uint8_t >( a0 ^ all ^ XTime( static_cast< uint8_t >( a0 ^ a1 ) ) );
+            s[ c + 1 ] = static_cast< uint8_t >( a1 ^ all ^ XTime( static_cast< uint8_t >( a1 ^ a2 ) ) );
+            s[ c + 2 ] = static_cast< uint8_t >( a2 ^ all ^ XTime( static_cast< uint8_t >( a2 ^ a3 ) ) );
+            s[ c + 3 ] = static_cast< uint8_t >( a3 ^ all ^ XTime( static_cast< uint8_t >( a3 ^ a0 ) ) );
+        }
+    }
+    
+    static void InvMixColumns( uint8_t * s )
+    {
+        /*
+         * InvMixColumns is MixColumns applied after a cheap
+         * pre-multiplication of each column.
+         */
+        for( size_t c = 0; c < 16; c += 4 )
+        {
+            uint8_t u( XTime( XTime( static_cast< uint8_t >( s[ c ] ^ s[ c + 2 ] ) ) ) );
+            uint8_t v( XTime( XTime( static_cast< uint8_t >( s[ c + 1 ] ^ s[ c + 3 ] ) ) ) );
+            
+            s[ c ]     ^= u;
+            s[ c + 1 ] ^= v;
+            s[ c + 2 ] ^= u;
+            s[ c + 3 ] ^= v;
+        }
+        
+        MixColumns( s );
+    }
+    
+    static void ExpandKey( const uint8_t * key, uint8_t * keys )
+    {
+        uint8_t rcon( 1 );
+        
+        memcpy( keys, key, 16 );
+        
+        for( size_t i = 16; i < 176; i += 4 )
+        {
+            uint8_t t[ 4 ];
+            
+            memcpy( t, keys + i - 4, 4 );
+            
+            if( i % 16 == 0 )
+            {
+                uint8_t u( t[ 0 ] );
+                
+                t[ 0 ] = static_cast< uint8_t >( SBox[ t[ 1 ] ] ^ rcon );
+                t[ 1 ] = SBox[ t[ 2 ] ];
+                t[ 2 ] = SBox[ t[ 3 ] ];
+                t[ 3 ] = SBox[ u ];
+                rcon   = XTime( rcon );
+            }
+            
+            for( size_t j = 0; j < 4; j++ )
+            {
+                keys[ i + j ] = static_cast< uint8_t >( keys[ i + j - 16 ] ^ t[ j ] );
+            }
+        }
+    }
+    
+    static void EncryptBlock( const uint8_t * keys, const uint8_t * in, uint8_t * out )
+    {
+        uint8_t s[ 16 ];
+        uint8_t t[ 16 ];
+        
+        for( size_t i = 0; i < 16; i++ )
+        {
+            s[ i ] = static_cast< uint8_t >( in[ i ] ^ keys[ i ] );
+        }
+        
+        for( size_t round = 1; round <= 10; round++ )
+        {
+            /*
+             * SubBytes and ShiftRows. The state is stored column by column.
+             */
+            for( size_t i = 0; i < 16; i++ )
+            {
+                t[ i ] = SBox[ s[ ( i + 4 * ( i % 4 ) ) % 16 ] ];
+            }
+            
+            if( round < 10 )
+            {
+                MixColumns( t );
+            }
+            
+            for( size_t i = 0; i < 16; i++ )
+            {
+                s[ i ] = static_cast< uint8_t >( t[ i ] ^ keys[ round * 16 + i ] );
+            }
+        }
+        
+        memcpy( out, s, 16 );
+    }
+    
+    static void DecryptBlock( const uint8_t * keys, const uint8_t * in, uint8_t * out )
+    {
+        uint8_t s[ 16 ];
+        uint8_t t[ 16 ];
+        
+        for( size_t i = 0; i < 16; i++ )
+        {
+            s[ i ] = static_cast< uint8_t >( in[ i ] ^ keys[ 160 + i ] );
+        }
+        
+        for( size_t round = 9; round < 10; round-- )
+        {
+            /*
+             * InvShiftRows and InvSubBytes.
+             */
+            for( size_t i = 0; i < 16; i++ )
+            {
+                t[ i ] = InverseSBox[ s[ ( i + 12 * ( i % 4 ) ) % 16 ] ];
+            }
+            
+            for( size_t i = 0; i < 16; i++ )
+            {
+                t[ i ] = static_cast< uint8_t >( t[ i ] ^ keys[ round * 16 + i ] );
+            }
+            
+            if( round > 0 )
+            {
+                InvMixColumns( t );
+            }
+            
+            memcpy( s, t, 16 );
+        }
+        
+        memcpy( out, s, 16 );
+    }
+    
+    static void IncrementCounter( uint8_t * counter )
+    {
+        /*
+         * The block counter is the low 64 bits of the counter block.
+         */
+        for( size_t i = 15; i >= 8; i-- )
+        {
+            if( ++counter[ i ] != 0 )
+            {
+                break;
+            }
+        }
+    }
+    
+    static void CTRScalar( const uint8_t * keys, uint8_t * counter, uint8_t * data, size_t blocks )
+    {
+        uint8_t keystream[ 16 ];
+        
+        for( size_t i = 0; i < blocks; i++ )
+        {
+            EncryptBlock( keys, counter, keystream );
+            IncrementCounter( counter );
+            
+            for( size_t j = 0; j < 16; j++ )
+            {
+                data[ i * 16 + j ] ^= keystream[ j ];
+            }
+        }
+    }
+    
+    static void CBCScalar( const uint8_t * keys, uint8_t * iv, uint8_t * data, size_t blocks )
+    {
+        uint8_t cipher[ 16 ];
+        
+        for( size_t i = 0; i < blocks; i++ )
+        {
+            memcpy( cipher, data + i * 16, 16 );
+            DecryptBlock( keys, cipher, data + i * 16 );
+            
+            for( size_t j = 0; j < 16; j++ )
+            {
+                data[ i * 16 + j ] ^= iv[ j ];
+            }
+            
+            memcpy( iv, cipher, 16 );
+        }
+    }
+
+    #ifdef ISOBMFF_AES_X86_64
+    
+    static bool HasAESNI()
+    {
+        #ifdef _MSC_VER
+        
+        int regs[ 4 ];
+        
+        __cpuid( regs, 1 );
+        
+        return ( regs[ 2 ] & ( 1 << 25 ) ) != 0;
+
+        #else
+        
+        return __builtin_cpu_supports( "aes" ) != 0;
+
+        #endif
+    }
+
+    #if defined( __GNUC__ ) || defined( __clang__ )
+    __attribute__( ( target( "aes" ) ) )
+    #endif
+    static void InvertKeysAESNI( const uint8_t * keys, uint8_t * inverse )
+    {
+        /*
+         * Round keys for the equivalent inverse cipher used by AESDEC: in
+         * reverse order, with InvMixColumns applied to the inner ones.
+         */
+        _mm_storeu_si128( reinterpret_cast< __m128i * >( inverse ), _mm_loadu_si128( reinterpret_cast< const __m128i * >( keys + 160 ) ) );
+        
+        for( size_t i = 1; i < 10; i++ )
+        {
+            __m128i k = _mm_loadu_si128( reinterpret_cast< const __m128i * >( keys + ( 10 - i ) * 16 ) );
+            
+            _mm_storeu_si128( reinterpret_cast< __m128i * >( inverse + i * 16 ), _mm_aesimc_si128( k ) );
+        }
+        
+        _mm_storeu_si128( reinterpret_cast< __m128i * >( inverse + 160 ), _mm_loadu_si128( reinterpret_cast< const __m128i * >( keys ) ) );
+    }
+
+    #if defined( __GNUC__ ) || defined( __clang__ )
+    __attribute__( ( target( "aes" ) ) )
+    #endif
+    static void CTRAESNI( const uint8_t * keys, uint8_t * counter, uint8_t * data, size_t blocks )
+    {
+        __m128i k[ 11 ];
+        uint8_t counters[ 64 ];
+        size_t  i;
+        
+        for( size_t r = 0; r < 11; r++ )
+        {
+            k[ r ] = _mm_loadu_si128( reinterpret_cast< const __m128i * >( keys + r * 16 ) );
+        }
+        
+        /*
+         * Four independent blocks per iteration, so the AESENC latencies
+         * overlap.
+         */
+        for( i = 0; i + 4 <= blocks; i += 4 )
+        {
+            for( size_t j = 0; j < 4; j++ )
+            {
+                memcpy( counters + j * 16, counter, 16 );
+                IncrementCounter( counter );
+            }
+            
+            __m128i b0 = _mm_xor_si128( _mm_loadu_si128( reinterpret_cast< const __m128i * >( counters ) ),      k[ 0 ] );
+            __m128i b1 = _mm_xor_si128( _mm_loadu_si128( reinterpret_cast< const __m128i * >( counters + 16 ) ), k[ 0 ] );
+            __m128i b2 = _mm_xor_si128( _mm_loadu_si128( reinterpret_cast< const __m128i * >( counters + 32 ) ), k[ 0 ] );
+            __m128i b3 = _mm_xor_si128( _mm_loadu_si128( reinterpret_cast< const __m128i * >( counters + 48 ) ), k[ 0 ] );
+            
+            for( size_t r = 1; r < 10; r++ )
+            {
+                b0 = _mm_aesenc_si128( b0, k[ r ] );
+                b1 = _mm_aesenc_si128( b1, k[ r ] );
+                b2 = _mm_aesenc_si128( b2, k[ r ] );
+                b3 = _mm_aesenc_si128( b3, k[ r ] );
+            }
+            
+            b0 = _mm_aesenclast_si128( b0, k[ 10 ] );
+            b1 = _mm_aesenclast_si128( b1, k[ 10 ] );
+            b2 = _mm_aesenclast_si128( b2, k[ 10 ] );
+            b3 = _mm_aesenclast_si128( b3, k[ 10 ] );
+            
+            __m128i * p = reinterpret_cast< __m128i * >( data + i * 16 );
+            
+            _mm_storeu_si128( p,     _mm_xor_si128( _mm_loadu_si128( p ),     b0 ) );
+            _mm_storeu_si128( p + 1, _mm_xor_si128( _mm_loadu_si128( p + 1 ), b1 ) );
+            _mm_storeu_si128( p + 2, _mm_xor_si128( _mm_loadu_si128( p + 2 ), b2 ) );
+            _mm_storeu_si128( p + 3, _mm_xor_si128( _mm_loadu_si128( p + 3 ), b3 ) );
+        }
+        
+        for( ; i < blocks; i++ )
+        {
+            __m128i b = _mm_xor_si128( _mm_loadu_si128( reinterpret_cast< const __m128i * >( counter ) ), k[ 0 ] );
+            
+            IncrementCounter( counter );
+            
+            for( size_t r = 1; r < 10; r++ )
+            {
+                b = _mm_aesenc_si128( b, k[ r ] );
+            }
+            
+            b = _mm_aesenclast_si128( b, k[ 10 ] );
+            
+            __m128i * p = reinterpret_cast< __m128i * >( data + i * 16 );
+            
+            _mm_storeu_si128( p, _mm_xor_si128( _mm_loadu_si128( p ), b ) );
+        }
+    }
+
+    #if defined( __GNUC__ ) || defined( __clang__ )
+    __attribute__( ( target( "aes" ) ) )
+    #endif
+    static void CBCAESNI( const uint8_t * keys, uint8_t * iv, uint8_t * data, size_t blocks )
+    {
+        __m128i k[ 11 ];
+        __m128i previous;
+        size_t  i;
+        
+        for( size_t r = 0; r < 11; r++ )
+        {
+            k[ r ] = _mm_loadu_si128( reinterpret_cast< const __m128i * >( keys + r * 16 ) );
+        }
+        
+        previous = _mm_loadu_si128( reinterpret_cast< const __m128i * >( iv ) );
+        
+        /*
+         * CBC decryption does not depend on previous outputs, so blocks
+         * are decrypted four at a time.
+         */
+        for( i = 0; i + 4 <= blocks; i += 4 )
+        {
+            __m128i * p  = reinterpret_cast< __m128i * >( data + i * 16 );
+            __m128i   c0 = _mm_loadu_si128( p );
+            __m128i   c1 = _mm_loadu_si128( p + 1 );
+            __m128i   c2 = _mm_loadu_si128( p + 2 );
+            __m128i   c3 = _mm_loadu_si128( p + 3 );
+            __m128i   b0 = _mm_xor_si128( c0, k[ 0 ] );
+            __m128i   b1 = _mm_xor_si128( c1, k[ 0 ] );
+            __m128i   b2 = _mm_xor_si128( c2, k[ 0 ] );
+            __m128i   b3 = _mm_xor_si128( c3, k[ 0 ] );
+            
+            for( size_t r = 1; r < 10; r++ )
+            {
+                b0 = _mm_aesdec_si128( b0, k[ r ] );
+                b1 = _mm_aesdec_si128( b1, k[ r ] );
+                b2 = _mm_aesdec_si128( b2, k[ r ] );
+                b3 = _mm_aesdec_si128( b3, k[ r ] );
+            }
+            
+            _mm_storeu_si128( p,     _mm_xor_si128( _mm_aesdeclast_si128( b0, k[ 10 ] ), previous ) );
+            _mm_storeu_si128( p + 1, _mm_xor_si128( _mm_aesdeclast_si128( b1, k[ 10 ] ), c0 ) );
+            _mm_storeu_si128( p + 2, _mm_xor_si128( _mm_aesdeclast_si128( b2, k[ 10 ] ), c1 ) );
+            _mm_storeu_si128( p + 3, _mm_xor_si128( _mm_aesdeclast_si128( b3, k[ 10 ] ), c2 ) );
+            
+            previous = c3;
+        }
+        
+        for( ; i < blocks; i++ )
+        {
+            __m128i * p = reinterpret_cast< __m128i * >( data + i * 16 );
+            __m128i   c = _mm_loadu_si128( p );
+            __m128i   b = _mm_xor_si128( c, k[ 0 ] );
+            
+            for( size_t r = 1; r < 10; r++ )
+            {
+                b = _mm_aesdec_si128( b, k[ r ] );
+            }
+            
+            _mm_storeu_si128( p, _mm_xor_si128( _mm_aesdeclast_si128( b, k[ 10 ] ), previous ) );
+            
+            previous = c;
+        }
+        
+        _mm_storeu_si128( reinterpret_cast< __m128i * >( iv ), previous );
+    }
+
+    #endif
+    
+    SampleDecryptor::IMPL::IMPL( const IMPL & o ):
+        _scheme( o._scheme ),
+        _hasAESNI( o._hasAESNI ),
+        _accelerated( o._accelerated )
+    {
+        memcpy( this->_encryptionKeys, o._encryptionKeys, sizeof( this->_encryptionKeys ) );
+        memcpy( this->_decryptionKeys, o._decryptionKeys, sizeof( this->_decryptionKeys ) );
+    }
+    
+    SampleDecryptor::IMPL::~IMPL()
+    {}
+}
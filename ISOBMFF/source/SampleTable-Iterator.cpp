@@ -0,0 +1,361 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SampleTable-Iterator.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/SampleTable.hpp>
+
+namespace ISOBMFF
+{
+    class SampleTable::Iterator::IMPL
+    {
+        public:
+            
+            IMPL( const SampleTable & table, uint64_t sample );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            void MoveToRun( size_t run );
+            void SkipEmptyRuns();
+            
+            const SampleTable     * _table;
+            std::shared_ptr< STTS > _stts;
+            std::shared_ptr< CTTS > _ctts;
+            std::shared_ptr< STSS > _stss;
+            std::shared_ptr< STSC > _stsc;
+            uint64_t                _sample;
+            uint64_t                _count;
+            uint64_t                _chunk;
+            size_t                  _run;
+            uint64_t                _runEndChunk;
+            uint32_t                _samplesPerChunk;
+            uint32_t                _sampleInChunk;
+            uint64_t                _offset;
+            uint32_t                _size;
+            size_t                  _sttsEntry;
+            uint64_t                _sttsRemaining;
+            uint64_t                _decodeTime;
+            size_t                  _cttsEntry;
+            uint64_t                _cttsRemaining;
+            size_t                  _stssEntry;
+    };
+    
+    SampleTable::Iterator::Iterator( const SampleTable & table, uint64_t sample ):
+        impl( std::make_unique< IMPL >( table, sample ) )
+    {}
+    
+    SampleTable::Iterator::Iterator( const Iterator & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    SampleTable::Iterator::Iterator( Iterator && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    SampleTable::Iterator::~Iterator()
+    {}
+    
+    SampleTable::Iterator & SampleTable::Iterator::operator =( Iterator o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( SampleTable::Iterator & o1, SampleTable::Iterator & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    bool SampleTable::Iterator::HasSample() const
+    {
+        return this->impl->_sample < this->impl->_count;
+    }
+    
+    void SampleTable::Iterator::Next()
+    {
+        if( this->HasSample() == false )
+        {
+            return;
+        }
+        
+        if( this->impl->_stss != nullptr && this->impl->_stssEntry < this->impl->_stss->GetEntryCount() && this->impl->_stss->GetSampleNumber( this->impl->_stssEntry ) == this->impl->_sample + 1 )
+        {
+            this->impl->_stssEntry++;
+        }
+        
+        this->impl->_sample++;
+        this->impl->_offset += this->impl->_size;
+        this->impl->_decodeTime += this->impl->_stts->GetSampleOffset( this->impl->_sttsEntry );
+        
+        this->impl->_sttsRemaining--;
+        
+        while( this->impl->_sttsRemaining == 0 && this->impl->_sttsEntry + 1 < this->impl->_stts->GetEntryCount() )
+        {
+            this->impl->_sttsEntry++;
+            
+            this->impl->_sttsRemaining = this->impl->_stts->GetSampleCount( this->impl->_sttsEntry );
+        }
+        
+        if( this->impl->_ctts != nullptr && this->impl->_cttsRemaining > 0 )
+        {
+            this->impl->_cttsRemaining--;
+            
+            while( this->impl->_cttsRemaining == 0 && this->impl->_cttsEntry + 1 < this->impl->_ctts->GetEntryCount() )
+            {
+                this->impl->_cttsEntry++;
+                
+                this->impl->_cttsRemaining = this->impl->_ctts->GetSampleCount( this->impl->_cttsEntry );
+            }
+        }
+        
+        if( this->HasSample() == false )
+        {
+            return;
+        }
+        
+        this->impl->_sampleInChunk++;
+        
+        if( this->impl->_sampleInChunk >= this->impl->_samplesPerChunk )
+        {
+            this->impl->_chunk++;
+            this->impl->_sampleInChunk = 0;
+            
+            this->impl->SkipEmptyRuns();
+            
+            this->impl->_offset = this->impl->_table->GetChunkOffset( this->impl->_chunk );
+        }
+        
+        this->impl->_size = this->impl->_table->GetSampleSize( this->impl->_sample );
+    }
+    
+    uint64_t SampleTable::Iterator::GetSample() const
+    {
+        return this->impl->_sample;
+    }
+    
+    uint64_t SampleTable::Iterator::GetChunk() const
+    {
+        return this->impl->_chunk;
+    }
+    
+    uint64_t SampleTable::Iterator::GetOffset() const
+    {
+        return this->impl->_offset;
+    }
+    
+    uint32_t SampleTable::Iterator::GetSize() const
+    {
+        return this->impl->_size;
+    }
+    
+    uint64_t SampleTable::Iterator::GetDecodeTime() const
+    {
+        return this->impl->_decodeTime;
+    }
+    
+    int64_t SampleTable::Iterator::GetCompositionTime() const
+    {
+        int64_t time;
+        
+        time = static_cast< int64_t >( this->impl->_decodeTime );
+        
+        if( this->impl->_ctts == nullptr || this->impl->_cttsRemaining == 0 )
+        {
+            return time;
+        }
+        
+        return time + this->impl->_ctts->GetSampleOffset( this->impl->_cttsEntry );
+    }
+    
+    uint32_t SampleTable::Iterator::GetDuration() const
+    {
+        return this->impl->_stts->GetSampleOffset( this->impl->_sttsEntry );
+    }
+    
+    bool SampleTable::Iterator::IsSync() const
+    {
+        if( this->impl->_stss == nullptr )
+        {
+            return true;
+        }
+        
+        return this->impl->_stssEntry < this->impl->_stss->GetEntryCount() && this->impl->_stss->GetSampleNumber( this->impl->_stssEntry ) == this->impl->_sample + 1;
+    }
+    
+    uint32_t SampleTable::Iterator::GetSampleDescriptionIndex() const
+    {
+        return this->impl->_stsc->GetSampleDescriptionIndex( this->impl->_run );
+    }
+    
+    SampleTable::Iterator::IMPL::IMPL( const SampleTable & table, uint64_t sample ):
+        _table( &table ),
+        _stts( table.GetSTTS() ),
+        _ctts( table.GetCTTS() ),
+        _stss( table.GetSTSS() ),
+        _stsc( table.GetSTSC() ),
+        _sample( sample ),
+        _count( table.GetSampleCount() ),
+        _chunk( 0 ),
+        _run( 0 ),
+        _runEndChunk( 0 ),
+        _samplesPerChunk( 0 ),
+        _sampleInChunk( 0 ),
+        _offset( 0 ),
+        _size( 0 ),
+        _sttsEntry( 0 ),
+        _sttsRemaining( 0 ),
+        _decodeTime( 0 ),
+        _cttsEntry( 0 ),
+        _cttsRemaining( 0 ),
+        _stssEntry( 0 )
+    {
+        size_t lower;
+        size_t upper;
+        size_t middle;
+        
+        if( sample >= this->_count )
+        {
+            this->_sample = this->_count;
+            
+            return;
+        }
+        
+        /*
+         * Positions in every box are found once with binary searches, then
+         * maintained incrementally by Next().
+         */
+        this->_chunk         = table.GetChunkForSample( sample );
+        this->_sampleInChunk = static_cast< uint32_t >( sample - table.GetChunkFirstSample( this->_chunk ) );
+        this->_offset        = table.GetSampleOffset( sample );
+        this->_size          = table.GetSampleSize( sample );
+        
+        lower = 0;
+        upper = this->_stsc->GetEntryCount();
+        
+        while( upper - lower > 1 )
+        {
+            middle = lower + ( upper - lower ) / 2;
+            
+            if( this->_stsc->GetFirstChunk( middle ) - 1 <= this->_chunk )
+            {
+                lower = middle;
+            }
+            else
+            {
+                upper = middle;
+            }
+        }
+        
+        this->MoveToRun( lower );
+        
+        this->_sttsEntry     = this->_stts->GetEntryForSample( sample );
+        this->_sttsRemaining = this->_stts->GetEntryFirstSample( this->_sttsEntry ) + this->_stts->GetSampleCount( this->_sttsEntry ) - sample;
+        this->_decodeTime    = this->_stts->GetDecodeTime( sample );
+        
+        if( this->_ctts != nullptr && sample < this->_ctts->GetTotalSampleCount() )
+        {
+            this->_cttsEntry     = this->_ctts->GetEntryForSample( sample );
+            this->_cttsRemaining = this->_ctts->GetEntryFirstSample( this->_cttsEntry ) + this->_ctts->GetSampleCount( this->_cttsEntry ) - sample;
+        }
+        
+        if( this->_stss != nullptr )
+        {
+            lower = 0;
+            upper = this->_stss->GetEntryCount();
+            
+            while( lower < upper )
+            {
+                middle = lower + ( upper - lower ) / 2;
+                
+                if( this->_stss->GetSampleNumber( middle ) < sample + 1 )
+                {
+                    lower = middle + 1;
+                }
+                else
+                {
+                    upper = middle;
+                }
+            }
+            
+            this->_stssEntry = lower;
+        }
+    }
+    
+    SampleTable::Iterator::IMPL::IMPL( const IMPL & o ):
+        _table( o._table ),
+        _stts( o._stts ),
+        _ctts( o._ctts ),
+        _stss( o._stss ),
+        _stsc( o._stsc ),
+        _sample( o._sample ),
+        _count( o._count ),
+        _chunk( o._chunk ),
+        _run( o._run ),
+        _runEndChunk( o._runEndChunk ),
+        _samplesPerChunk( o._samplesPerChunk ),
+        _sampleInChunk( o._sampleInChunk ),
+        _offset( o._offset ),
+        _size( o._size ),
+        _sttsEntry( o._sttsEntry ),
+        _sttsRemaining( o._sttsRemaining ),
+        _decodeTime( o._decodeTime ),
+        _cttsEntry( o._cttsEntry ),
+        _cttsRemaining( o._cttsRemaining ),
+        _stssEntry( o._stssEntry )
+    {}
+    
+    SampleTable::Iterator::IMPL::~IMPL()
+    {}
+    
+    void SampleTable::Iterator::IMPL::MoveToRun( size_t run )
+    {
+        this->_run             = run;
+        this->_samplesPerChunk = this->_stsc->GetSamplesPerChunk( run );
+        this->_runEndChunk     = ( run + 1 < this->_stsc->GetEntryCount() ) ? this->_stsc->GetFirstChunk( run + 1 ) - 1 : this->_table->GetChunkCount();
+    }
+    
+    void SampleTable::Iterator::IMPL::SkipEmptyRuns()
+    {
+        while( this->_run + 1 < this->_stsc->GetEntryCount() )
+        {
+            if( this->_chunk < this->_runEndChunk && this->_samplesPerChunk > 0 )
+            {
+                break;
+            }
+            
+            this->MoveToRun( this->_run + 1 );
+            
+            this->_chunk = std::max< uint64_t >( this->_chunk, this->_stsc->GetFirstChunk( this->_run ) - 1 );
+        }
+    }
+}
@@ -0,0 +1,417 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        SampleTable.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/SampleTable.hpp>
+#include <ISOBMFF/STSZ.hpp>
+#include <ISOBMFF/STZ2.hpp>
+#include <ISOBMFF/STCO.hpp>
+#include <ISOBMFF/CO64.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace ISOBMFF
+{
+    class SampleTable::IMPL
+    {
+        public:
+            
+            IMPL( const Container & stbl );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            size_t   GetRunForSample( uint64_t sample ) const;
+            size_t   GetRunForChunk( uint64_t chunk )   const;
+            uint32_t GetSampleSize( uint64_t sample )   const;
+            uint64_t GetSizeBefore( uint64_t sample )   const;
+            
+            std::shared_ptr< STTS > _stts;
+            std::shared_ptr< CTTS > _ctts;
+            std::shared_ptr< STSS > _stss;
+            std::shared_ptr< STSC > _stsc;
+            std::shared_ptr< STSZ > _stsz;
+            std::shared_ptr< STZ2 > _stz2;
+            std::shared_ptr< STCO > _stco;
+            std::shared_ptr< CO64 > _co64;
+            uint64_t                _sampleCount;
+            uint64_t                _chunkCount;
+            uint32_t                _constantSize;
+            std::vector< uint64_t > _runFirstSample;
+            std::vector< uint64_t > _sizeBlocks;
+    };
+    
+    /*
+     * Number of samples between two entries of the size prefix sums.
+     * Offsets inside a chunk are found by adding at most this number of
+     * sizes, for an eighth of a byte per sample.
+     */
+    static const uint64_t SizeBlockShift = 5;
+    
+    SampleTable::SampleTable( const Container & stbl ):
+        impl( std::make_unique< IMPL >( stbl ) )
+    {}
+    
+    SampleTable::SampleTable( const SampleTable & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    SampleTable::SampleTable( SampleTable && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    SampleTable::~SampleTable()
+    {}
+    
+    SampleTable & SampleTable::operator =( SampleTable o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( SampleTable & o1, SampleTable & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    std::shared_ptr< STTS > SampleTable::GetSTTS() const
+    {
+        return this->impl->_stts;
+    }
+    
+    std::shared_ptr< CTTS > SampleTable::GetCTTS() const
+    {
+        return this->impl->_ctts;
+    }
+    
+    std::shared_ptr< STSS > SampleTable::GetSTSS() const
+    {
+        return this->impl->_stss;
+    }
+    
+    std::shared_ptr< STSC > SampleTable::GetSTSC() const
+    {
+        return this->impl->_stsc;
+    }
+    
+    uint64_t SampleTable::GetSampleCount() const
+    {
+        return this->impl->_sampleCount;
+    }
+    
+    uint64_t SampleTable::GetChunkCount() const
+    {
+        return this->impl->_chunkCount;
+    }
+    
+    uint64_t SampleTable::GetChunkOffset( uint64_t chunk ) const
+    {
+        if( chunk >= this->impl->_chunkCount )
+        {
+            throw std::runtime_error( "Invalid chunk index" );
+        }
+        
+        if( this->impl->_stco != nullptr )
+        {
+            return this->impl->_stco->GetChunkOffset( static_cast< size_t >( chunk ) );
+        }
+        
+        return this->impl->_co64->GetChunkOffset( static_cast< size_t >( chunk ) );
+    }
+    
+    uint64_t SampleTable::GetChunkForSample( uint64_t sample ) const
+    {
+        size_t run;
+        
+        if( sample >= this->impl->_sampleCount )
+        {
+            throw std::runtime_error( "Invalid sample index" );
+        }
+        
+        run = this->impl->GetRunForSample( sample );
+        
+        return ( this->impl->_stsc->GetFirstChunk( run ) - 1 ) + ( sample - this->impl->_runFirstSample[ run ] ) / this->impl->_stsc->GetSamplesPerChunk( run );
+    }
+    
+    uint64_t SampleTable::GetChunkFirstSample( uint64_t chunk ) const
+    {
+        size_t run;
+        
+        if( chunk >= this->impl->_chunkCount )
+        {
+            throw std::runtime_error( "Invalid chunk index" );
+        }
+        
+        if( this->impl->_stsc->GetEntryCount() == 0 )
+        {
+            return 0;
+        }
+        
+        run = this->impl->GetRunForChunk( chunk );
+        
+        return std::min( this->impl->_sampleCount, this->impl->_runFirstSample[ run ] + ( chunk - ( this->impl->_stsc->GetFirstChunk( run ) - 1 ) ) * this->impl->_stsc->GetSamplesPerChunk( run ) );
+    }
+    
+    uint64_t SampleTable::GetSampleOffset( uint64_t sample ) const
+    {
+        uint64_t chunk;
+        uint64_t first;
+        
+        chunk = this->GetChunkForSample( sample );
+        first = this->GetChunkFirstSample( chunk );
+        
+        return this->GetChunkOffset( chunk ) + this->impl->GetSizeBefore( sample ) - this->impl->GetSizeBefore( first );
+    }
+    
+    uint32_t SampleTable::GetSampleSize( uint64_t sample ) const
+    {
+        if( sample >= this->impl->_sampleCount )
+        {
+            throw std::runtime_error( "Invalid sample index" );
+        }
+        
+        return this->impl->GetSampleSize( sample );
+    }
+    
+    uint64_t SampleTable::GetDecodeTime( uint64_t sample ) const
+    {
+        return this->impl->_stts->GetDecodeTime( sample );
+    }
+    
+    int64_t SampleTable::GetCompositionTime( uint64_t sample ) const
+    {
+        int64_t time;
+        
+        time = static_cast< int64_t >( this->impl->_stts->GetDecodeTime( sample ) );
+        
+        return ( this->impl->_ctts == nullptr ) ? time : time + this->impl->_ctts->GetCompositionOffset( sample );
+    }
+    
+    uint32_t SampleTable::GetSampleDuration( uint64_t sample ) const
+    {
+        return this->impl->_stts->GetSampleDuration( sample );
+    }
+    
+    bool SampleTable::IsSyncSample( uint64_t sample ) const
+    {
+        return this->impl->_stss == nullptr || this->impl->_stss->IsSyncSample( sample );
+    }
+    
+    uint32_t SampleTable::GetSampleDescriptionIndex( uint64_t sample ) const
+    {
+        if( sample >= this->impl->_sampleCount )
+        {
+            throw std::runtime_error( "Invalid sample index" );
+        }
+        
+        return this->impl->_stsc->GetSampleDescriptionIndex( this->impl->GetRunForSample( sample ) );
+    }
+    
+    uint64_t SampleTable::GetSampleAtTime( uint64_t time ) const
+    {
+        if( this->impl->_sampleCount == 0 )
+        {
+            throw std::runtime_error( "No samples" );
+        }
+        
+        return std::min( this->impl->_stts->GetSampleAtTime( time ), this->impl->_sampleCount - 1 );
+    }
+    
+    uint64_t SampleTable::GetSyncSampleAtOrBeforeTime( uint64_t time ) const
+    {
+        if( this->impl->_sampleCount == 0 )
+        {
+            throw std::runtime_error( "No samples" );
+        }
+        
+        return std::min( STSS::GetSyncSampleAtOrBeforeTime( this->impl->_stss.get(), *( this->impl->_stts ), this->impl->_ctts.get(), time ), this->impl->_sampleCount - 1 );
+    }
+    
+    SampleTable::Iterator SampleTable::GetIterator( uint64_t sample ) const
+    {
+        return Iterator( *( this ), sample );
+    }
+    
+    SampleTable::IMPL::IMPL( const Container & stbl ):
+        _stts( stbl.GetTypedBox< STTS >( "stts" ) ),
+        _ctts( stbl.GetTypedBox< CTTS >( "ctts" ) ),
+        _stss( stbl.GetTypedBox< STSS >( "stss" ) ),
+        _stsc( stbl.GetTypedBox< STSC >( "stsc" ) ),
+        _stsz( stbl.GetTypedBox< STSZ >( "stsz" ) ),
+        _stz2( stbl.GetTypedBox< STZ2 >( "stz2" ) ),
+        _stco( stbl.GetTypedBox< STCO >( "stco" ) ),
+        _co64( stbl.GetTypedBox< CO64 >( "co64" ) ),
+        _sampleCount( 0 ),
+        _chunkCount( 0 ),
+        _constantSize( 0 )
+    {
+        uint64_t samples;
+        uint64_t begin;
+        uint64_t end;
+        
+        if( this->_stts == nullptr || this->_stsc == nullptr || ( this->_stsz == nullptr && this->_stz2 == nullptr ) || ( this->_stco == nullptr && this->_co64 == nullptr ) )
+        {
+            throw std::runtime_error( "Missing sample table box" );
+        }
+        
+        this->_chunkCount = ( this->_stco != nullptr ) ? this->_stco->GetEntryCount() : this->_co64->GetEntryCount();
+        
+        /*
+         * Each STSC entry describes a run of chunks, up to the next entry's
+         * first chunk, or up to the last chunk for the last entry.
+         */
+        for( size_t i = 0; i < this->_stsc->GetEntryCount(); i++ )
+        {
+            if( this->_stsc->GetFirstChunk( i ) == 0 || ( i > 0 && this->_stsc->GetFirstChunk( i ) <= this->_stsc->GetFirstChunk( i - 1 ) ) )
+            {
+                throw std::runtime_error( "Invalid STSC" );
+            }
+            
+            begin = std::min< uint64_t >( this->_stsc->GetFirstChunk( i ) - 1, this->_chunkCount );
+            end   = ( i + 1 < this->_stsc->GetEntryCount() ) ? std::min< uint64_t >( this->_stsc->GetFirstChunk( i + 1 ) - 1, this->_chunkCount ) : this->_chunkCount;
+            
+            this->_runFirstSample.push_back( this->_sampleCount );
+            
+            this->_sampleCount += ( end - begin ) * this->_stsc->GetSamplesPerChunk( i );
+        }
+        
+        samples            = ( this->_stsz != nullptr ) ? this->_stsz->GetSampleCount() : this->_stz2->GetSampleCount();
+        this->_sampleCount = std::min( this->_sampleCount, samples );
+        this->_sampleCount = std::min( this->_sampleCount, this->_stts->GetTotalSampleCount() );
+        
+        if( this->_stsz != nullptr && this->_stsz->GetSampleSize() != 0 )
+        {
+            this->_constantSize = this->_stsz->GetSampleSize();
+            
+            return;
+        }
+        
+        this->_sizeBlocks.resize( static_cast< size_t >( this->_sampleCount >> SizeBlockShift ) + 1 );
+        
+        samples = 0;
+        
+        for( uint64_t i = 0; i < this->_sampleCount; i++ )
+        {
+            if( ( i & ( ( 1 << SizeBlockShift ) - 1 ) ) == 0 )
+            {
+                this->_sizeBlocks[ static_cast< size_t >( i >> SizeBlockShift ) ] = samples;
+            }
+            
+            samples += this->GetSampleSize( i );
+        }
+    }
+    
+    SampleTable::IMPL::IMPL( const IMPL & o ):
+        _stts( o._stts ),
+        _ctts( o._ctts ),
+        _stss( o._stss ),
+        _stsc( o._stsc ),
+        _stsz( o._stsz ),
+        _stz2( o._stz2 ),
+        _stco( o._stco ),
+        _co64( o._co64 ),
+        _sampleCount( o._sampleCount ),
+        _chunkCount( o._chunkCount ),
+        _constantSize( o._constantSize ),
+        _runFirstSample( o._runFirstSample ),
+        _sizeBlocks( o._sizeBlocks )
+    {}
+    
+    SampleTable::IMPL::~IMPL()
+    {}
+    
+    size_t SampleTable::IMPL::GetRunForSample( uint64_t sample ) const
+    {
+        /*
+         * Runs without samples start with the same sample as the next run,
+         * so searching for the last run starting at or before the sample
+         * never lands on them.
+         */
+        return static_cast< size_t >( std::upper_bound( this->_runFirstSample.begin(), this->_runFirstSample.end(), sample ) - this->_runFirstSample.begin() ) - 1;
+    }
+    
+    size_t SampleTable::IMPL::GetRunForChunk( uint64_t chunk ) const
+    {
+        size_t lower;
+        size_t upper;
+        size_t middle;
+        
+        lower = 0;
+        upper = this->_stsc->GetEntryCount();
+        
+        while( upper - lower > 1 )
+        {
+            middle = lower + ( upper - lower ) / 2;
+            
+            if( this->_stsc->GetFirstChunk( middle ) - 1 <= chunk )
+            {
+                lower = middle;
+            }
+            else
+            {
+                upper = middle;
+            }
+        }
+        
+        return lower;
+    }
+    
+    uint32_t SampleTable::IMPL::GetSampleSize( uint64_t sample ) const
+    {
+        if( this->_stsz != nullptr )
+        {
+            return this->_stsz->GetEntrySize( static_cast< size_t >( sample ) );
+        }
+        
+        return this->_stz2->GetEntrySize( static_cast< size_t >( sample ) );
+    }
+    
+    uint64_t SampleTable::IMPL::GetSizeBefore( uint64_t sample ) const
+    {
+        uint64_t size;
+        
+        if( this->_constantSize != 0 )
+        {
+            return sample * this->_constantSize;
+        }
+        
+        size = this->_sizeBlocks[ static_cast< size_t >( sample >> SizeBlockShift ) ];
+        
+        for( uint64_t i = ( sample >> SizeBlockShift ) << SizeBlockShift; i < sample; i++ )
+        {
+            size += this->GetSampleSize( i );
+        }
+        
+        return size;
+    }
+}
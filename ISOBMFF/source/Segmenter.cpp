@@ -0,0 +1,627 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Segmenter.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Segmenter.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/ContainerBox.hpp>
+#include <ISOBMFF/SampleTable.hpp>
+#include <ISOBMFF/BinaryDataOutputStream.hpp>
+#include <ISOBMFF/FTYP.hpp>
+#include <ISOBMFF/MVHD.hpp>
+#include <ISOBMFF/TKHD.hpp>
+#include <ISOBMFF/MDHD.hpp>
+#include <ISOBMFF/MEHD.hpp>
+#include <ISOBMFF/TREX.hpp>
+#include <ISOBMFF/MFHD.hpp>
+#include <ISOBMFF/TFHD.hpp>
+#include <ISOBMFF/TFDT.hpp>
+#include <ISOBMFF/TRUN.hpp>
+#include <ISOBMFF/STTS.hpp>
+#include <ISOBMFF/STSC.hpp>
+#include <ISOBMFF/STSZ.hpp>
+#include <ISOBMFF/STCO.hpp>
+#include <ISOBMFF/Casts.hpp>
+#include <limits>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class Segmenter::IMPL
+    {
+        public:
+            
+            IMPL( BinaryStream & stream, uint32_t trackID );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            static std::shared_ptr< ContainerBox > CopyContainer( const Container & container, const std::string & name, const std::vector< std::string > & skip );
+            
+            uint64_t GetBoundary( uint64_t time ) const;
+            uint64_t GetTime( uint64_t sample )   const;
+            
+            uint32_t                       _trackID;
+            uint32_t                       _timescale;
+            bool                           _compositionOffsets;
+            std::shared_ptr< SampleTable > _table;
+            std::vector< uint8_t >         _init;
+    };
+    
+    class Segmenter::Segment::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t                         _sequenceNumber;
+            uint64_t                         _firstSample;
+            uint64_t                         _sampleCount;
+            uint64_t                         _startTime;
+            uint64_t                         _duration;
+            std::vector< uint8_t >           _header;
+            std::vector< ItemReader::Range > _ranges;
+    };
+    
+    Segmenter::Segmenter( BinaryStream & stream, uint32_t trackID ):
+        impl( std::make_unique< IMPL >( stream, trackID ) )
+    {}
+    
+    Segmenter::Segmenter( const Segmenter & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Segmenter::Segmenter( Segmenter && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Segmenter::~Segmenter()
+    {}
+    
+    Segmenter & Segmenter::operator =( Segmenter o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( Segmenter & o1, Segmenter & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint32_t Segmenter::GetTrackID() const
+    {
+        return this->impl->_trackID;
+    }
+    
+    uint32_t Segmenter::GetTimescale() const
+    {
+        return this->impl->_timescale;
+    }
+    
+    uint64_t Segmenter::GetDuration() const
+    {
+        return this->impl->GetTime( this->impl->_table->GetSampleCount() );
+    }
+    
+    std::vector< uint8_t > Segmenter::GetInitSegment() const
+    {
+        return this->impl->_init;
+    }
+    
+    std::vector< uint64_t > Segmenter::GetBoundaries( uint64_t duration ) const
+    {
+        std::vector< uint64_t > times;
+        uint64_t                sample;
+        uint64_t                count;
+        
+        if( duration == 0 )
+        {
+            throw std::runtime_error( "Invalid segment duration" );
+        }
+        
+        count  = this->impl->_table->GetSampleCount();
+        sample = this->impl->GetBoundary( 0 );
+        
+        times.push_back( this->impl->GetTime( sample ) );
+        
+        while( sample < count )
+        {
+            sample = this->impl->GetBoundary( times.back() + duration );
+            
+            times.push_back( this->impl->GetTime( sample ) );
+        }
+        
+        return times;
+    }
+    
+    Segmenter::Segment Segmenter::GetSegment( uint64_t start, uint64_t end, uint32_t sequenceNumber ) const
+    {
+        Segment                          segment;
+        std::shared_ptr< ContainerBox >  moof;
+        std::shared_ptr< ContainerBox >  traf;
+        std::shared_ptr< MFHD >          mfhd;
+        std::shared_ptr< TFHD >          tfhd;
+        std::shared_ptr< TFDT >          tfdt;
+        std::shared_ptr< TRUN >          trun;
+        std::vector< ItemReader::Range > ranges;
+        BinaryDataOutputStream           stream;
+        uint64_t                         first;
+        uint64_t                         last;
+        uint64_t                         size;
+        uint64_t                         header;
+        uint64_t                         duration;
+        uint32_t                         description;
+        
+        first = this->impl->GetBoundary( start );
+        last  = this->impl->GetBoundary( end );
+        
+        if( first >= last )
+        {
+            throw std::runtime_error( "Invalid segment - No samples in time range" );
+        }
+        
+        moof = std::make_shared< ContainerBox >( "moof" );
+        traf = std::make_shared< ContainerBox >( "traf" );
+        mfhd = std::make_shared< MFHD >();
+        tfhd = std::make_shared< TFHD >();
+        tfdt = std::make_shared< TFDT >();
+        trun = std::make_shared< TRUN >();
+        
+        description = this->impl->_table->GetSampleDescriptionIndex( first );
+        
+        mfhd->SetSequenceNumber( sequenceNumber );
+        
+        /* sample-description-index-present, default-base-is-moof */
+        tfhd->SetFlags( 0x020002 );
+        tfhd->SetTrackID( this->impl->_trackID );
+        tfhd->SetSampleDescriptionIndex( description );
+        
+        tfdt->SetVersion( 1 );
+        tfdt->SetBaseMediaDecodeTime( this->impl->GetTime( first ) );
+        
+        /* data-offset, sample duration, size, flags, and composition time offset */
+        trun->SetVersion( ( this->impl->_compositionOffsets ) ? 1 : 0 );
+        trun->SetFlags( ( this->impl->_compositionOffsets ) ? 0x000F01 : 0x000701 );
+        
+        size     = 0;
+        duration = 0;
+        
+        for( auto it = this->impl->_table->GetIterator( first ); it.HasSample() && it.GetSample() < last; it.Next() )
+        {
+            if( it.GetSampleDescriptionIndex() != description )
+            {
+                throw std::runtime_error( "Invalid segment - Sample description changes in time range" );
+            }
+            
+            trun->AddSample
+            (
+                it.GetDuration(),
+                it.GetSize(),
+                ( it.IsSync() ) ? 0x02000000 : 0x01010000,
+                it.GetCompositionTime() - static_cast< int64_t >( it.GetDecodeTime() )
+            );
+            
+            if( ranges.size() > 0 && ranges.back().GetOffset() + ranges.back().GetLength() == it.GetOffset() )
+            {
+                ranges.back().SetLength( ranges.back().GetLength() + it.GetSize() );
+            }
+            else
+            {
+                ranges.push_back( ItemReader::Range( ItemReader::Range::Source::File, it.GetOffset(), it.GetSize() ) );
+            }
+            
+            size     += it.GetSize();
+            duration += it.GetDuration();
+        }
+        
+        traf->AddBox( tfhd );
+        traf->AddBox( tfdt );
+        traf->AddBox( trun );
+        moof->AddBox( mfhd );
+        moof->AddBox( traf );
+        
+        /* The data offset field has a fixed size, so the MOOF size is known */
+        header = ( size + 8 > ( std::numeric_limits< uint32_t >::max )() ) ? 16 : 8;
+        
+        trun->SetDataOffset( numeric_cast< int32_t >( moof->GetSerializedSize() + header ) );
+        moof->Write( stream );
+        
+        if( header == 16 )
+        {
+            stream.WriteBigEndianUInt32( 1 );
+            stream.WriteFourCC( "mdat" );
+            stream.WriteBigEndianUInt64( size + 16 );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( size + 8 ) );
+            stream.WriteFourCC( "mdat" );
+        }
+        
+        segment.SetSequenceNumber( sequenceNumber );
+        segment.SetFirstSample( first );
+        segment.SetSampleCount( last - first );
+        segment.SetStartTime( this->impl->GetTime( first ) );
+        segment.SetDuration( duration );
+        segment.SetHeader( stream.GetData() );
+        segment.SetRanges( ranges );
+        
+        return segment;
+    }
+    
+    Segmenter::Segment::Segment():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    Segmenter::Segment::Segment( const Segment & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Segmenter::Segment::Segment( Segment && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Segmenter::Segment::~Segment()
+    {}
+    
+    Segmenter::Segment & Segmenter::Segment::operator =( Segment o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( Segmenter::Segment & o1, Segmenter::Segment & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint32_t Segmenter::Segment::GetSequenceNumber() const
+    {
+        return this->impl->_sequenceNumber;
+    }
+    
+    uint64_t Segmenter::Segment::GetFirstSample() const
+    {
+        return this->impl->_firstSample;
+    }
+    
+    uint64_t Segmenter::Segment::GetSampleCount() const
+    {
+        return this->impl->_sampleCount;
+    }
+    
+    uint64_t Segmenter::Segment::GetStartTime() const
+    {
+        return this->impl->_startTime;
+    }
+    
+    uint64_t Segmenter::Segment::GetDuration() const
+    {
+        return this->impl->_duration;
+    }
+    
+    std::vector< uint8_t > Segmenter::Segment::GetHeader() const
+    {
+        return this->impl->_header;
+    }
+    
+    std::vector< ItemReader::Range > Segmenter::Segment::GetRanges() const
+    {
+        return this->impl->_ranges;
+    }
+    
+    uint64_t Segmenter::Segment::GetSize() const
+    {
+        uint64_t size;
+        
+        size = this->impl->_header.size();
+        
+        for( const auto & range: this->impl->_ranges )
+        {
+            size += range.GetLength();
+        }
+        
+        return size;
+    }
+    
+    void Segmenter::Segment::SetSequenceNumber( uint32_t value )
+    {
+        this->impl->_sequenceNumber = value;
+    }
+    
+    void Segmenter::Segment::SetFirstSample( uint64_t value )
+    {
+        this->impl->_firstSample = value;
+    }
+    
+    void Segmenter::Segment::SetSampleCount( uint64_t value )
+    {
+        this->impl->_sampleCount = value;
+    }
+    
+    void Segmenter::Segment::SetStartTime( uint64_t value )
+    {
+        this->impl->_startTime = value;
+    }
+    
+    void Segmenter::Segment::SetDuration( uint64_t value )
+    {
+        this->impl->_duration = value;
+    }
+    
+    void Segmenter::Segment::SetHeader( const std::vector< uint8_t > & value )
+    {
+        this->impl->_header = value;
+    }
+    
+    void Segmenter::Segment::SetRanges( const std::vector< ItemReader::Range > & value )
+    {
+        this->impl->_ranges = value;
+    }
+    
+    Segmenter::IMPL::IMPL( BinaryStream & stream, uint32_t trackID ):
+        _trackID( 0 ),
+        _timescale( 0 ),
+        _compositionOffsets( false )
+    {
+        Parser                          parser;
+        std::shared_ptr< ContainerBox > moov;
+        std::shared_ptr< ContainerBox > trak;
+        std::shared_ptr< ContainerBox > mdia;
+        std::shared_ptr< ContainerBox > minf;
+        std::shared_ptr< ContainerBox > stbl;
+        std::shared_ptr< MVHD >         mvhd;
+        std::shared_ptr< MDHD >         mdhd;
+        std::shared_ptr< Container >    stsd;
+        std::shared_ptr< FTYP >         ftyp;
+        std::shared_ptr< ContainerBox > mvex;
+        std::shared_ptr< MEHD >         mehd;
+        std::shared_ptr< TREX >         trex;
+        std::shared_ptr< ContainerBox > box;
+        BinaryDataOutputStream          output;
+        
+        parser.AddOption( Parser::Options::SkipMDATData );
+        parser.Parse( stream );
+        
+        moov = parser.GetFile()->GetTypedBox< ContainerBox >( "moov" );
+        mvhd = ( moov ) ? moov->GetTypedBox< MVHD >( "mvhd" ) : nullptr;
+        
+        if( mvhd == nullptr )
+        {
+            throw std::runtime_error( "Cannot segment - No MOOV box" );
+        }
+        
+        for( const auto & child: moov->GetBoxes() )
+        {
+            std::shared_ptr< ContainerBox > container;
+            std::shared_ptr< TKHD >         tkhd;
+            
+            container = std::dynamic_pointer_cast< ContainerBox >( child );
+            tkhd      = ( container && child->GetName() == "trak" ) ? container->GetTypedBox< TKHD >( "tkhd" ) : nullptr;
+            
+            if( tkhd != nullptr && ( trackID == 0 || tkhd->GetTrackID() == trackID ) )
+            {
+                trak           = container;
+                this->_trackID = tkhd->GetTrackID();
+                
+                break;
+            }
+        }
+        
+        mdia = ( trak ) ? trak->GetTypedBox< ContainerBox >( "mdia" ) : nullptr;
+        mdhd = ( mdia ) ? mdia->GetTypedBox< MDHD >( "mdhd" )         : nullptr;
+        minf = ( mdia ) ? mdia->GetTypedBox< ContainerBox >( "minf" ) : nullptr;
+        stbl = ( minf ) ? minf->GetTypedBox< ContainerBox >( "stbl" ) : nullptr;
+        stsd = ( stbl ) ? stbl->GetTypedBox< Container >( "stsd" )    : nullptr;
+        
+        if( mdhd == nullptr || stsd == nullptr )
+        {
+            throw std::runtime_error( "Cannot segment - Track not found" );
+        }
+        
+        for( const auto & entry: stsd->GetBoxes() )
+        {
+            if( entry->GetName() == "encv" || entry->GetName() == "enca" )
+            {
+                throw std::runtime_error( "Cannot segment - Protected tracks are not supported" );
+            }
+        }
+        
+        this->_timescale          = mdhd->GetTimescale();
+        this->_table              = std::make_shared< SampleTable >( *( stbl ) );
+        this->_compositionOffsets = this->_table->GetCTTS() != nullptr;
+        
+        if( this->_table->GetSampleCount() == 0 )
+        {
+            throw std::runtime_error( "Cannot segment - Track has no samples" );
+        }
+        
+        ftyp = std::make_shared< FTYP >();
+        
+        ftyp->SetMajorBrand( "iso6" );
+        ftyp->SetMinorVersion( 0 );
+        ftyp->AddCompatibleBrand( "iso6" );
+        ftyp->AddCompatibleBrand( "cmfc" );
+        
+        mvex = std::make_shared< ContainerBox >( "mvex" );
+        mehd = std::make_shared< MEHD >();
+        trex = std::make_shared< TREX >();
+        
+        mehd->SetVersion( ( mvhd->GetDuration() > ( std::numeric_limits< uint32_t >::max )() ) ? 1 : 0 );
+        mehd->SetFragmentDuration( mvhd->GetDuration() );
+        trex->SetTrackID( this->_trackID );
+        trex->SetDefaultSampleDescriptionIndex( 1 );
+        mvex->AddBox( mehd );
+        mvex->AddBox( trex );
+        
+        /*
+         * Source boxes are shared with the new containers and copied from
+         * the stream, so only the containers and sample tables are encoded.
+         */
+        box = std::make_shared< ContainerBox >( "stbl" );
+        
+        box->AddBox( std::dynamic_pointer_cast< Box >( stsd ) );
+        box->AddBox( std::make_shared< STTS >() );
+        box->AddBox( std::make_shared< STSC >() );
+        box->AddBox( std::make_shared< STSZ >() );
+        box->AddBox( std::make_shared< STCO >() );
+        
+        stbl = box;
+        box  = CopyContainer( *( minf ), "minf", { "stbl" } );
+        
+        box->AddBox( stbl );
+        
+        minf = box;
+        box  = CopyContainer( *( mdia ), "mdia", { "minf" } );
+        
+        box->AddBox( minf );
+        
+        mdia = box;
+        box  = CopyContainer( *( trak ), "trak", { "mdia", "tref" } );
+        
+        box->AddBox( mdia );
+        
+        trak = box;
+        moov = std::make_shared< ContainerBox >( "moov" );
+        
+        moov->AddBox( mvhd );
+        moov->AddBox( trak );
+        moov->AddBox( mvex );
+        
+        output.SetSource( &stream );
+        ftyp->Write( output );
+        moov->Write( output );
+        
+        this->_init = output.GetData();
+    }
+    
+    Segmenter::IMPL::IMPL( const IMPL & o ):
+        _trackID( o._trackID ),
+        _timescale( o._timescale ),
+        _compositionOffsets( o._compositionOffsets ),
+        _table( o._table ),
+        _init( o._init )
+    {}
+    
+    Segmenter::IMPL::~IMPL()
+    {}
+    
+    std::shared_ptr< ContainerBox > Segmenter::IMPL::CopyContainer( const Container & container, const std::string & name, const std::vector< std::string > & skip )
+    {
+        std::shared_ptr< ContainerBox > copy;
+        
+        copy = std::make_shared< ContainerBox >( name );
+        
+        for( const auto & box: container.GetBoxes() )
+        {
+            if( std::find( skip.begin(), skip.end(), box->GetName() ) == skip.end() )
+            {
+                copy->AddBox( box );
+            }
+        }
+        
+        return copy;
+    }
+    
+    uint64_t Segmenter::IMPL::GetBoundary( uint64_t time ) const
+    {
+        uint64_t count;
+        uint64_t sample;
+        uint64_t sync;
+        
+        count = this->_table->GetSampleCount();
+        
+        if( time >= this->GetTime( count ) )
+        {
+            return count;
+        }
+        
+        sample = this->_table->GetSampleAtTime( time );
+        
+        if( this->GetTime( sample ) < time )
+        {
+            sample++;
+        }
+        
+        if( sample >= count || this->_table->IsSyncSample( sample ) )
+        {
+            return sample;
+        }
+        
+        /* Without a STSS box, all samples are sync samples */
+        sync = this->_table->GetSTSS()->GetSyncSampleAtOrAfter( sample );
+        
+        return ( sync > sample ) ? sync : count;
+    }
+    
+    uint64_t Segmenter::IMPL::GetTime( uint64_t sample ) const
+    {
+        if( sample >= this->_table->GetSampleCount() )
+        {
+            return this->_table->GetDecodeTime( this->_table->GetSampleCount() - 1 ) + this->_table->GetSampleDuration( this->_table->GetSampleCount() - 1 );
+        }
+        
+        return this->_table->GetDecodeTime( sample );
+    }
+    
+    Segmenter::Segment::IMPL::IMPL():
+        _sequenceNumber( 0 ),
+        _firstSample( 0 ),
+        _sampleCount( 0 ),
+        _startTime( 0 ),
+        _duration( 0 ),
+        _header(),
+        _ranges()
+    {}
+    
+    Segmenter::Segment::IMPL::IMPL( const IMPL & o ):
+        _sequenceNumber( o._sequenceNumber ),
+        _firstSample( o._firstSample ),
+        _sampleCount( o._sampleCount ),
+        _startTime( o._startTime ),
+        _duration( o._duration ),
+        _header( o._header ),
+        _ranges( o._ranges )
+    {}
+    
+    Segmenter::Segment::IMPL::~IMPL()
+    {}
+}
@@ -45,6 +45,8 @@ namespace ISOBMFF
             
             uint32_t                _fromItemID;
             std::vector< uint32_t > _toItemIDs;
+            uint8_t                 _version;
+            bool                    _raw;
     };
     
     SingleItemTypeReferenceBox::SingleItemTypeReferenceBox( const std::string & name ):
@@ -95,9 +97,14 @@ namespace ISOBMFF
         {
             Box::ReadData( parser, stream );
             
+            this->impl->_raw = true;
+            
             return;
         }
         
+        this->impl->_version = iref->GetVersion();
+        this->impl->_raw     = false;
+        
         if( iref->GetVersion() == 0 )
         {
             this->SetFromItemID( stream.ReadBigEndianUInt16() );
@@ -122,6 +129,49 @@ namespace ISOBMFF
         }
     }
     
+    uint64_t SingleItemTypeReferenceBox::GetDataSize() const
+    {
+        if( this->impl->_raw )
+        {
+            return Box::GetDataSize();
+        }
+        
+        if( this->impl->_version == 0 )
+        {
+            return 4 + this->impl->_toItemIDs.size() * 2;
+        }
+        
+        return 6 + this->impl->_toItemIDs.size() * 4;
+    }
+    
+    void SingleItemTypeReferenceBox::WriteData( BinaryOutputStream & stream ) const
+    {
+        if( this->impl->_raw )
+        {
+            Box::WriteData( stream );
+        }
+        else if( this->impl->_version == 0 )
+        {
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->GetFromItemID() ) );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->impl->_toItemIDs.size() ) );
+            
+            for( uint32_t id: this->impl->_toItemIDs )
+            {
+                stream.WriteBigEndianUInt16( static_cast< uint16_t >( id ) );
+            }
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( this->GetFromItemID() );
+            stream.WriteBigEndianUInt16( static_cast< uint16_t >( this->impl->_toItemIDs.size() ) );
+            
+            for( uint32_t id: this->impl->_toItemIDs )
+            {
+                stream.WriteBigEndianUInt32( id );
+            }
+        }
+    }
+    
     std::vector< std::pair< std::string, std::string > > SingleItemTypeReferenceBox::GetDisplayableProperties() const
     {
         auto props( Box::GetDisplayableProperties() );
@@ -145,20 +195,38 @@ namespace ISOBMFF
     void SingleItemTypeReferenceBox::SetFromItemID( uint32_t value )
     {
         this->impl->_fromItemID = value;
+        this->SetModified( true );
     }
     
     void SingleItemTypeReferenceBox::AddToItemID( uint32_t value )
     {
         this->impl->_toItemIDs.push_back( value );
+        this->SetModified( true );
+    }
+    
+    uint8_t SingleItemTypeReferenceBox::GetVersion() const
+    {
+        return this->impl->_version;
+    }
+    
+    void SingleItemTypeReferenceBox::SetVersion( uint8_t value )
+    {
+        this->impl->_version = value;
+        this->impl->_raw     = false;
+        this->SetModified( true );
     }
     
     SingleItemTypeReferenceBox::IMPL::IMPL():
-        _fromItemID( 0 )
+        _fromItemID( 0 ),
+        _version( 0 ),
+        _raw( false )
     {}
 
     SingleItemTypeReferenceBox::IMPL::IMPL( const IMPL & o ):
         _fromItemID( o._fromItemID ),
-        _toItemIDs( o._toItemIDs )
+        _toItemIDs( o._toItemIDs ),
+        _version( o._version ),
+        _raw( o._raw )
     {}
 
     SingleItemTypeReferenceBox::IMPL::~IMPL()
@@ -0,0 +1,222 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        TENC.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/TENC.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/Utils.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class TENC::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint8_t                _defaultCryptByteBlock;
+            uint8_t                _defaultSkipByteBlock;
+            bool                   _defaultIsProtected;
+            uint8_t                _defaultPerSampleIVSize;
+            std::vector< uint8_t > _defaultKID;
+            std::vector< uint8_t > _defaultConstantIV;
+    };
+    
+    TENC::TENC():
+        FullBox( "tenc" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    TENC::TENC( const TENC & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    TENC::TENC( TENC && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    TENC::~TENC()
+    {}
+    
+    TENC & TENC::operator =( TENC o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( TENC & o1, TENC & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void TENC::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint8_t u8;
+        
+        stream.ReadUInt8();
+        
+        u8 = stream.ReadUInt8();
+        
+        if( this->GetVersion() > 0 )
+        {
+            this->impl->_defaultCryptByteBlock = static_cast< uint8_t >( u8 >> 4 );
+            this->impl->_defaultSkipByteBlock  = static_cast< uint8_t >( u8 & 0x0F );
+        }
+        
+        this->impl->_defaultIsProtected     = stream.ReadUInt8() != 0;
+        this->impl->_defaultPerSampleIVSize = stream.ReadUInt8();
+        this->impl->_defaultKID             = stream.Read( 16 );
+        
+        if( this->impl->_defaultIsProtected && this->impl->_defaultPerSampleIVSize == 0 )
+        {
+            this->impl->_defaultConstantIV = stream.Read( stream.ReadUInt8() );
+        }
+    }
+    
+    uint64_t TENC::GetDataSize() const
+    {
+        uint64_t size;
+        
+        size = FullBox::GetDataSize() + 20;
+        
+        if( this->impl->_defaultIsProtected && this->impl->_defaultPerSampleIVSize == 0 )
+        {
+            size += 1 + this->impl->_defaultConstantIV.size();
+        }
+        
+        return size;
+    }
+    
+    void TENC::WriteData( BinaryOutputStream & stream ) const
+    {
+        std::vector< uint8_t > kid( this->impl->_defaultKID );
+        
+        FullBox::WriteData( stream );
+        
+        kid.resize( 16 );
+        
+        stream.WriteUInt8( 0 );
+        
+        if( this->GetVersion() > 0 )
+        {
+            stream.WriteUInt8( static_cast< uint8_t >( ( this->impl->_defaultCryptByteBlock << 4 ) | ( this->impl->_defaultSkipByteBlock & 0x0F ) ) );
+        }
+        else
+        {
+            stream.WriteUInt8( 0 );
+        }
+        
+        stream.WriteUInt8( ( this->impl->_defaultIsProtected ) ? 1 : 0 );
+        stream.WriteUInt8( this->impl->_defaultPerSampleIVSize );
+        stream.Write( kid );
+        
+        if( this->impl->_defaultIsProtected && this->impl->_defaultPerSampleIVSize == 0 )
+        {
+            stream.WriteUInt8( static_cast< uint8_t >( this->impl->_defaultConstantIV.size() ) );
+            stream.Write( this->impl->_defaultConstantIV );
+        }
+    }
+    
+    std::vector< std::pair< std::string, std::string > > TENC::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Default crypt byte block",     std::to_string( this->GetDefaultCryptByteBlock() ) } );
+        props.push_back( { "Default skip byte block",      std::to_string( this->GetDefaultSkipByteBlock() ) } );
+        props.push_back( { "Default is protected",         ( this->GetDefaultIsProtected() ) ? "yes" : "no" } );
+        props.push_back( { "Default per sample IV size",   std::to_string( this->GetDefaultPerSampleIVSize() ) } );
+        props.push_back( { "Default KID",                  Utils::ToHexString( this->GetDefaultKID() ) } );
+        props.push_back( { "Default constant IV",          Utils::ToHexString( this->GetDefaultConstantIV() ) } );
+        
+        return props;
+    }
+    
+    uint8_t TENC::GetDefaultCryptByteBlock() const
+    {
+        return this->impl->_defaultCryptByteBlock;
+    }
+    
+    uint8_t TENC::GetDefaultSkipByteBlock() const
+    {
+        return this->impl->_defaultSkipByteBlock;
+    }
+    
+    bool TENC::GetDefaultIsProtected() const
+    {
+        return this->impl->_defaultIsProtected;
+    }
+    
+    uint8_t TENC::GetDefaultPerSampleIVSize() const
+    {
+        return this->impl->_defaultPerSampleIVSize;
+    }
+    
+    std::vector< uint8_t > TENC::GetDefaultKID() const
+    {
+        return this->impl->_defaultKID;
+    }
+    
+    std::vector< uint8_t > TENC::GetDefaultConstantIV() const
+    {
+        return this->impl->_defaultConstantIV;
+    }
+    
+    TENC::IMPL::IMPL():
+        _defaultCryptByteBlock( 0 ),
+        _defaultSkipByteBlock( 0 ),
+        _defaultIsProtected( false ),
+        _defaultPerSampleIVSize( 0 )
+    {}
+    
+    TENC::IMPL::IMPL( const IMPL & o ):
+        _defaultCryptByteBlock( o._defaultCryptByteBlock ),
+        _defaultSkipByteBlock( o._defaultSkipByteBlock ),
+        _defaultIsProtected( o._defaultIsProtected ),
+        _defaultPerSampleIVSize( o._defaultPerSampleIVSize ),
+        _defaultKID( o._defaultKID ),
+        _defaultConstantIV( o._defaultConstantIV )
+    {}
+    
+    TENC::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,293 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        TFRA.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/TFRA.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class TFRA::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t                _trackID;
+            uint8_t                 _trafNumberSize;
+            uint8_t                 _trunNumberSize;
+            uint8_t                 _sampleNumberSize;
+            std::vector< uint64_t > _times;
+            std::vector< uint64_t > _moofOffsets;
+            std::vector< uint32_t > _trafNumbers;
+            std::vector< uint32_t > _trunNumbers;
+            std::vector< uint32_t > _sampleNumbers;
+    };
+    
+    /*
+     * Reads a big endian unsigned integer of 1 to 8 bytes, and advances
+     * the pointer.
+     */
+    static uint64_t ReadBigEndian( const uint8_t * & p, size_t size )
+    {
+        uint64_t value( 0 );
+        
+        for( size_t i = 0; i < size; i++ )
+        {
+            value = ( value << 8 ) | *( p++ );
+        }
+        
+        return value;
+    }
+    
+    /*
+     * Writes a big endian unsigned integer of 1 to 8 bytes.
+     */
+    static void WriteBigEndian( BinaryOutputStream & stream, uint64_t value, size_t size )
+    {
+        for( size_t i = size; i > 0; i-- )
+        {
+            stream.WriteUInt8( static_cast< uint8_t >( value >> ( ( i - 1 ) * 8 ) ) );
+        }
+    }
+    
+    TFRA::TFRA():
+        FullBox( "tfra" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    TFRA::TFRA( const TFRA & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    TFRA::TFRA( TFRA && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    TFRA::~TFRA()
+    {}
+    
+    TFRA & TFRA::operator =( TFRA o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( TFRA & o1, TFRA & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void TFRA::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint32_t               sizes;
+        uint32_t               count;
+        size_t                 entrySize;
+        size_t                 timeSize;
+        std::vector< uint8_t > entries;
+        const uint8_t        * p;
+        
+        this->impl->_trackID = stream.ReadBigEndianUInt32();
+        sizes                = stream.ReadBigEndianUInt32();
+        count                = stream.ReadBigEndianUInt32();
+        
+        this->impl->_trafNumberSize   = static_cast< uint8_t >( ( ( sizes >> 4 ) & 0x03 ) + 1 );
+        this->impl->_trunNumberSize   = static_cast< uint8_t >( ( ( sizes >> 2 ) & 0x03 ) + 1 );
+        this->impl->_sampleNumberSize = static_cast< uint8_t >( ( sizes & 0x03 ) + 1 );
+        
+        timeSize  = ( this->GetVersion() == 1 ) ? 8 : 4;
+        entrySize = timeSize * 2 + this->impl->_trafNumberSize + this->impl->_trunNumberSize + this->impl->_sampleNumberSize;
+        
+        if( count > stream.AvailableBytes() / entrySize )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        entries = stream.Read( count * entrySize );
+        p       = entries.data();
+        
+        this->impl->_times.resize( count );
+        this->impl->_moofOffsets.resize( count );
+        this->impl->_trafNumbers.resize( count );
+        this->impl->_trunNumbers.resize( count );
+        this->impl->_sampleNumbers.resize( count );
+        
+        for( size_t i = 0; i < count; i++ )
+        {
+            this->impl->_times[ i ]         = ReadBigEndian( p, timeSize );
+            this->impl->_moofOffsets[ i ]   = ReadBigEndian( p, timeSize );
+            this->impl->_trafNumbers[ i ]   = static_cast< uint32_t >( ReadBigEndian( p, this->impl->_trafNumberSize ) );
+            this->impl->_trunNumbers[ i ]   = static_cast< uint32_t >( ReadBigEndian( p, this->impl->_trunNumberSize ) );
+            this->impl->_sampleNumbers[ i ] = static_cast< uint32_t >( ReadBigEndian( p, this->impl->_sampleNumberSize ) );
+        }
+    }
+    
+    uint64_t TFRA::GetDataSize() const
+    {
+        uint64_t entrySize;
+        
+        entrySize = ( ( this->GetVersion() == 1 ) ? 16 : 8 ) + this->impl->_trafNumberSize + this->impl->_trunNumberSize + this->impl->_sampleNumberSize;
+        
+        return FullBox::GetDataSize() + 12 + this->impl->_times.size() * entrySize;
+    }
+    
+    void TFRA::WriteData( BinaryOutputStream & stream ) const
+    {
+        size_t timeSize;
+        
+        FullBox::WriteData( stream );
+        
+        timeSize = ( this->GetVersion() == 1 ) ? 8 : 4;
+        
+        stream.WriteBigEndianUInt32( this->impl->_trackID );
+        stream.WriteBigEndianUInt32
+        (
+            static_cast< uint32_t >
+            (
+                  ( ( this->impl->_trafNumberSize   - 1 ) << 4 )
+                | ( ( this->impl->_trunNumberSize   - 1 ) << 2 )
+                | ( ( this->impl->_sampleNumberSize - 1 ) )
+            )
+        );
+        stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_times.size() ) );
+        
+        for( size_t i = 0; i < this->impl->_times.size(); i++ )
+        {
+            WriteBigEndian( stream, this->impl->_times[ i ],         timeSize );
+            WriteBigEndian( stream, this->impl->_moofOffsets[ i ],   timeSize );
+            WriteBigEndian( stream, this->impl->_trafNumbers[ i ],   this->impl->_trafNumberSize );
+            WriteBigEndian( stream, this->impl->_trunNumbers[ i ],   this->impl->_trunNumberSize );
+            WriteBigEndian( stream, this->impl->_sampleNumbers[ i ], this->impl->_sampleNumberSize );
+        }
+    }
+    
+    std::vector< std::pair< std::string, std::string > > TFRA::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Track ID", std::to_string( this->GetTrackID() ) } );
+        
+        for( size_t i = 0; i < this->GetEntryCount(); i++ )
+        {
+            props.push_back( { "Time",          std::to_string( this->GetTime( i ) ) } );
+            props.push_back( { "MOOF offset",   std::to_string( this->GetMoofOffset( i ) ) } );
+            props.push_back( { "TRAF number",   std::to_string( this->GetTrafNumber( i ) ) } );
+            props.push_back( { "TRUN number",   std::to_string( this->GetTrunNumber( i ) ) } );
+            props.push_back( { "Sample number", std::to_string( this->GetSampleNumber( i ) ) } );
+        }
+        
+        return props;
+    }
+    
+    uint32_t TFRA::GetTrackID() const
+    {
+        return this->impl->_trackID;
+    }
+    
+    uint8_t TFRA::GetTrafNumberSize() const
+    {
+        return this->impl->_trafNumberSize;
+    }
+    
+    uint8_t TFRA::GetTrunNumberSize() const
+    {
+        return this->impl->_trunNumberSize;
+    }
+    
+    uint8_t TFRA::GetSampleNumberSize() const
+    {
+        return this->impl->_sampleNumberSize;
+    }
+    
+    size_t TFRA::GetEntryCount() const
+    {
+        return this->impl->_times.size();
+    }
+    
+    uint64_t TFRA::GetTime( size_t index ) const
+    {
+        return this->impl->_times[ index ];
+    }
+    
+    uint64_t TFRA::GetMoofOffset( size_t index ) const
+    {
+        return this->impl->_moofOffsets[ index ];
+    }
+    
+    uint32_t TFRA::GetTrafNumber( size_t index ) const
+    {
+        return this->impl->_trafNumbers[ index ];
+    }
+    
+    uint32_t TFRA::GetTrunNumber( size_t index ) const
+    {
+        return this->impl->_trunNumbers[ index ];
+    }
+    
+    uint32_t TFRA::GetSampleNumber( size_t index ) const
+    {
+        return this->impl->_sampleNumbers[ index ];
+    }
+    
+    TFRA::IMPL::IMPL():
+        _trackID( 0 ),
+        _trafNumberSize( 0 ),
+        _trunNumberSize( 0 ),
+        _sampleNumberSize( 0 )
+    {}
+    
+    TFRA::IMPL::IMPL( const IMPL & o ):
+        _trackID( o._trackID ),
+        _trafNumberSize( o._trafNumberSize ),
+        _trunNumberSize( o._trunNumberSize ),
+        _sampleNumberSize( o._sampleNumberSize ),
+        _times( o._times ),
+        _moofOffsets( o._moofOffsets ),
+        _trafNumbers( o._trafNumbers ),
+        _trunNumbers( o._trunNumbers ),
+        _sampleNumbers( o._sampleNumbers )
+    {}
+    
+    TFRA::IMPL::~IMPL()
+    {}
+}
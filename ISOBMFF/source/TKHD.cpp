@@ -131,6 +131,43 @@ namespace ISOBMFF
         this->SetHeight( stream.ReadBigEndianFixedPoint( 16, 16 ) );
     }
     
+    uint64_t TKHD::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + ( ( this->GetVersion() == 1 ) ? 32 : 20 ) + 60;
+    }
+    
+    void TKHD::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        if( this->GetVersion() == 1 )
+        {
+            stream.WriteBigEndianUInt64( this->GetCreationTime() );
+            stream.WriteBigEndianUInt64( this->GetModificationTime() );
+            stream.WriteBigEndianUInt32( this->GetTrackID() );
+            stream.WriteBigEndianUInt32( this->impl->_reserved1 );
+            stream.WriteBigEndianUInt64( this->GetDuration() );
+        }
+        else
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetCreationTime() ) );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetModificationTime() ) );
+            stream.WriteBigEndianUInt32( this->GetTrackID() );
+            stream.WriteBigEndianUInt32( this->impl->_reserved1 );
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->GetDuration() ) );
+        }
+        
+        stream.WriteBigEndianUInt32( this->impl->_reserved2[ 0 ] );
+        stream.WriteBigEndianUInt32( this->impl->_reserved2[ 1 ] );
+        stream.WriteBigEndianUInt16( this->GetLayer() );
+        stream.WriteBigEndianUInt16( this->GetAlternateGroup() );
+        stream.WriteBigEndianUInt16( this->GetVolume() );
+        stream.WriteBigEndianUInt16( this->impl->_reserved3 );
+        stream.WriteMatrix( this->GetMatrix() );
+        stream.WriteBigEndianFixedPoint( this->GetWidth(),  16, 16 );
+        stream.WriteBigEndianFixedPoint( this->GetHeight(), 16, 16 );
+    }
+    
     std::vector< std::pair< std::string, std::string > > TKHD::GetDisplayableProperties() const
     {
         auto props( FullBox::GetDisplayableProperties() );
@@ -202,51 +239,61 @@ namespace ISOBMFF
     void TKHD::SetCreationTime( uint64_t value )
     {
         this->impl->_creationTime = value;
+        this->SetModified( true );
     }
     
     void TKHD::SetModificationTime( uint64_t value )
     {
         this->impl->_modificationTime = value;
+        this->SetModified( true );
     }
     
     void TKHD::SetTrackID( uint32_t value )
     {
         this->impl->_trackID = value;
+        this->SetModified( true );
     }
     
     void TKHD::SetDuration( uint64_t value )
     {
         this->impl->_duration = value;
+        this->SetModified( true );
     }
     
     void TKHD::SetLayer( uint16_t value )
     {
         this->impl->_layer = value;
+        this->SetModified( true );
     }
     
     void TKHD::SetAlternateGroup( uint16_t value )
     {
         this->impl->_alternateGroup = value;
+        this->SetModified( true );
     }
     
     void TKHD::SetVolume( uint16_t value )
     {
         this->impl->_volume = value;
+        this->SetModified( true );
     }
     
     void TKHD::SetMatrix( Matrix value )
     {
         this->impl->_matrix = value;
+        this->SetModified( true );
     }
     
     void TKHD::SetWidth( float value )
     {
         this->impl->_width = value;
+        this->SetModified( true );
     }
     
     void TKHD::SetHeight( float value )
     {
         this->impl->_height = value;
+        this->SetModified( true );
     }
     
     TKHD::IMPL::IMPL():
@@ -0,0 +1,201 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        TREX.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/TREX.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class TREX::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t _trackID;
+            uint32_t _defaultSampleDescriptionIndex;
+            uint32_t _defaultSampleDuration;
+            uint32_t _defaultSampleSize;
+            uint32_t _defaultSampleFlags;
+    };
+    
+    TREX::TREX():
+        FullBox( "trex" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    TREX::TREX( const TREX & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    TREX::TREX( TREX && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    TREX::~TREX()
+    {}
+    
+    TREX & TREX::operator =( TREX o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( TREX & o1, TREX & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void TREX::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        this->SetTrackID( stream.ReadBigEndianUInt32() );
+        this->SetDefaultSampleDescriptionIndex( stream.ReadBigEndianUInt32() );
+        this->SetDefaultSampleDuration( stream.ReadBigEndianUInt32() );
+        this->SetDefaultSampleSize( stream.ReadBigEndianUInt32() );
+        this->SetDefaultSampleFlags( stream.ReadBigEndianUInt32() );
+    }
+    
+    uint64_t TREX::GetDataSize() const
+    {
+        return FullBox::GetDataSize() + 20;
+    }
+    
+    void TREX::WriteData( BinaryOutputStream & stream ) const
+    {
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( this->GetTrackID() );
+        stream.WriteBigEndianUInt32( this->GetDefaultSampleDescriptionIndex() );
+        stream.WriteBigEndianUInt32( this->GetDefaultSampleDuration() );
+        stream.WriteBigEndianUInt32( this->GetDefaultSampleSize() );
+        stream.WriteBigEndianUInt32( this->GetDefaultSampleFlags() );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > TREX::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Track ID",                         std::to_string( this->GetTrackID() ) } );
+        props.push_back( { "Default sample description index", std::to_string( this->GetDefaultSampleDescriptionIndex() ) } );
+        props.push_back( { "Default sample duration",          std::to_string( this->GetDefaultSampleDuration() ) } );
+        props.push_back( { "Default sample size",              std::to_string( this->GetDefaultSampleSize() ) } );
+        props.push_back( { "Default sample flags",             std::to_string( this->GetDefaultSampleFlags() ) } );
+        
+        return props;
+    }
+    
+    uint32_t TREX::GetTrackID() const
+    {
+        return this->impl->_trackID;
+    }
+    
+    uint32_t TREX::GetDefaultSampleDescriptionIndex() const
+    {
+        return this->impl->_defaultSampleDescriptionIndex;
+    }
+    
+    uint32_t TREX::GetDefaultSampleDuration() const
+    {
+        return this->impl->_defaultSampleDuration;
+    }
+    
+    uint32_t TREX::GetDefaultSampleSize() const
+    {
+        return this->impl->_defaultSampleSize;
+    }
+    
+    uint32_t TREX::GetDefaultSampleFlags() const
+    {
+        return this->impl->_defaultSampleFlags;
+    }
+    
+    void TREX::SetTrackID( uint32_t value )
+    {
+        this->impl->_trackID = value;
+        this->SetModified( true );
+    }
+    
+    void TREX::SetDefaultSampleDescriptionIndex( uint32_t value )
+    {
+        this->impl->_defaultSampleDescriptionIndex = value;
+        this->SetModified( true );
+    }
+    
+    void TREX::SetDefaultSampleDuration( uint32_t value )
+    {
+        this->impl->_defaultSampleDuration = value;
+        this->SetModified( true );
+    }
+    
+    void TREX::SetDefaultSampleSize( uint32_t value )
+    {
+        this->impl->_defaultSampleSize = value;
+        this->SetModified( true );
+    }
+    
+    void TREX::SetDefaultSampleFlags( uint32_t value )
+    {
+        this->impl->_defaultSampleFlags = value;
+        this->SetModified( true );
+    }
+    
+    TREX::IMPL::IMPL():
+        _trackID( 0 ),
+        _defaultSampleDescriptionIndex( 0 ),
+        _defaultSampleDuration( 0 ),
+        _defaultSampleSize( 0 ),
+        _defaultSampleFlags( 0 )
+    {}
+    
+    TREX::IMPL::IMPL( const IMPL & o ):
+        _trackID( o._trackID ),
+        _defaultSampleDescriptionIndex( o._defaultSampleDescriptionIndex ),
+        _defaultSampleDuration( o._defaultSampleDuration ),
+        _defaultSampleSize( o._defaultSampleSize ),
+        _defaultSampleFlags( o._defaultSampleFlags )
+    {}
+    
+    TREX::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,417 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        TRUN.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/TRUN.hpp>
+#include <ISOBMFF/Parser.hpp>
+#include <ISOBMFF/Utils.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class TRUN::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint32_t                _sampleCount;
+            int32_t                 _dataOffset;
+            uint32_t                _firstSampleFlags;
+            std::vector< uint32_t > _durations;
+            std::vector< uint32_t > _sizes;
+            std::vector< uint32_t > _flags;
+            std::vector< uint32_t > _compositionTimeOffsets;
+    };
+    
+    TRUN::TRUN():
+        FullBox( "trun" ),
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    TRUN::TRUN( const TRUN & o ):
+        FullBox( o ),
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    TRUN::TRUN( TRUN && o ) noexcept:
+        FullBox( std::move( o ) ),
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    TRUN::~TRUN()
+    {}
+    
+    TRUN & TRUN::operator =( TRUN o )
+    {
+        FullBox::operator=( o );
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( TRUN & o1, TRUN & o2 )
+    {
+        using std::swap;
+        
+        swap( static_cast< FullBox & >( o1 ), static_cast< FullBox & >( o2 ) );
+        swap( o1.impl, o2.impl );
+    }
+    
+    void TRUN::ReadData( Parser & parser, BinaryStream & stream )
+    {
+        FullBox::ReadData( parser, stream );
+        
+        uint32_t                count;
+        size_t                  fields;
+        std::vector< uint32_t > entries;
+        
+        count = stream.ReadBigEndianUInt32();
+        
+        if( this->HasDataOffset() )
+        {
+            this->impl->_dataOffset = static_cast< int32_t >( stream.ReadBigEndianUInt32() );
+        }
+        
+        if( this->HasFirstSampleFlags() )
+        {
+            this->impl->_firstSampleFlags = stream.ReadBigEndianUInt32();
+        }
+        
+        fields = 0;
+        fields = ( this->HasSampleDuration() )              ? fields + 1 : fields;
+        fields = ( this->HasSampleSize() )                  ? fields + 1 : fields;
+        fields = ( this->HasSampleFlags() )                 ? fields + 1 : fields;
+        fields = ( this->HasSampleCompositionTimeOffset() ) ? fields + 1 : fields;
+        
+        if( fields > 0 && count > stream.AvailableBytes() / ( fields * 4 ) )
+        {
+            throw std::runtime_error( "Invalid read - Not enough data available" );
+        }
+        
+        this->impl->_sampleCount = count;
+        
+        if( fields == 0 )
+        {
+            return;
+        }
+        
+        entries = stream.ReadBigEndianUInt32Array( static_cast< size_t >( count ) * fields );
+        
+        if( this->HasSampleDuration() )
+        {
+            this->impl->_durations.resize( count );
+        }
+        
+        if( this->HasSampleSize() )
+        {
+            this->impl->_sizes.resize( count );
+        }
+        
+        if( this->HasSampleFlags() )
+        {
+            this->impl->_flags.resize( count );
+        }
+        
+        if( this->HasSampleCompositionTimeOffset() )
+        {
+            this->impl->_compositionTimeOffsets.resize( count );
+        }
+        
+        for( size_t i = 0, n = 0; i < count; i++ )
+        {
+            if( this->HasSampleDuration() )
+            {
+                this->impl->_durations[ i ] = entries[ n++ ];
+            }
+            
+            if( this->HasSampleSize() )
+            {
+                this->impl->_sizes[ i ] = entries[ n++ ];
+            }
+            
+            if( this->HasSampleFlags() )
+            {
+                this->impl->_flags[ i ] = entries[ n++ ];
+            }
+            
+            if( this->HasSampleCompositionTimeOffset() )
+            {
+                this->impl->_compositionTimeOffsets[ i ] = entries[ n++ ];
+            }
+        }
+    }
+    
+    uint64_t TRUN::GetDataSize() const
+    {
+        uint64_t size;
+        uint64_t fields;
+        
+        fields = 0;
+        fields = ( this->HasSampleDuration() )              ? fields + 1 : fields;
+        fields = ( this->HasSampleSize() )                  ? fields + 1 : fields;
+        fields = ( this->HasSampleFlags() )                 ? fields + 1 : fields;
+        fields = ( this->HasSampleCompositionTimeOffset() ) ? fields + 1 : fields;
+        
+        size  = FullBox::GetDataSize() + 4;
+        size += ( this->HasDataOffset() )       ? 4 : 0;
+        size += ( this->HasFirstSampleFlags() ) ? 4 : 0;
+        size += fields * 4 * this->impl->_sampleCount;
+        
+        return size;
+    }
+    
+    void TRUN::WriteData( BinaryOutputStream & stream ) const
+    {
+        std::vector< uint32_t > entries;
+        
+        FullBox::WriteData( stream );
+        
+        stream.WriteBigEndianUInt32( this->impl->_sampleCount );
+        
+        if( this->HasDataOffset() )
+        {
+            stream.WriteBigEndianUInt32( static_cast< uint32_t >( this->impl->_dataOffset ) );
+        }
+        
+        if( this->HasFirstSampleFlags() )
+        {
+            stream.WriteBigEndianUInt32( this->impl->_firstSampleFlags );
+        }
+        
+        for( size_t i = 0; i < this->impl->_sampleCount; i++ )
+        {
+            if( this->HasSampleDuration() )
+            {
+                entries.push_back( this->impl->_durations[ i ] );
+            }
+            
+            if( this->HasSampleSize() )
+            {
+                entries.push_back( this->impl->_sizes[ i ] );
+            }
+            
+            if( this->HasSampleFlags() )
+            {
+                entries.push_back( this->impl->_flags[ i ] );
+            }
+            
+            if( this->HasSampleCompositionTimeOffset() )
+            {
+                entries.push_back( this->impl->_compositionTimeOffsets[ i ] );
+            }
+        }
+        
+        stream.WriteBigEndianUInt32Array( entries );
+    }
+    
+    std::vector< std::pair< std::string, std::string > > TRUN::GetDisplayableProperties() const
+    {
+        auto props( FullBox::GetDisplayableProperties() );
+        
+        props.push_back( { "Sample count", std::to_string( this->GetSampleCount() ) } );
+        
+        if( this->HasDataOffset() )
+        {
+            props.push_back( { "Data offset", std::to_string( this->GetDataOffset() ) } );
+        }
+        
+        if( this->HasFirstSampleFlags() )
+        {
+            props.push_back( { "First sample flags", Utils::ToHexString( this->GetFirstSampleFlags() ) } );
+        }
+        
+        for( size_t i = 0; i < this->GetSampleCount(); i++ )
+        {
+            if( this->HasSampleDuration() )
+            {
+                props.push_back( { "Sample duration", std::to_string( this->GetSampleDuration( i ) ) } );
+            }
+            
+            if( this->HasSampleSize() )
+            {
+                props.push_back( { "Sample size", std::to_string( this->GetSampleSize( i ) ) } );
+            }
+            
+            if( this->HasSampleFlags() )
+            {
+                props.push_back( { "Sample flags", Utils::ToHexString( this->GetSampleFlags( i ) ) } );
+            }
+            
+            if( this->HasSampleCompositionTimeOffset() )
+            {
+                props.push_back( { "Sample composition time offset", std::to_string( this->GetSampleCompositionTimeOffset( i ) ) } );
+            }
+        }
+        
+        return props;
+    }
+    
+    uint32_t TRUN::GetSampleCount() const
+    {
+        return this->impl->_sampleCount;
+    }
+    
+    bool TRUN::HasDataOffset() const
+    {
+        return ( this->GetFlags() & 0x000001 ) != 0;
+    }
+    
+    int32_t TRUN::GetDataOffset() const
+    {
+        return this->impl->_dataOffset;
+    }
+    
+    bool TRUN::HasFirstSampleFlags() const
+    {
+        return ( this->GetFlags() & 0x000004 ) != 0;
+    }
+    
+    uint32_t TRUN::GetFirstSampleFlags() const
+    {
+        return this->impl->_firstSampleFlags;
+    }
+    
+    bool TRUN::HasSampleDuration() const
+    {
+        return ( this->GetFlags() & 0x000100 ) != 0;
+    }
+    
+    bool TRUN::HasSampleSize() const
+    {
+        return ( this->GetFlags() & 0x000200 ) != 0;
+    }
+    
+    bool TRUN::HasSampleFlags() const
+    {
+        return ( this->GetFlags() & 0x000400 ) != 0;
+    }
+    
+    bool TRUN::HasSampleCompositionTimeOffset() const
+    {
+        return ( this->GetFlags() & 0x000800 ) != 0;
+    }
+    
+    uint32_t TRUN::GetSampleDuration( size_t index ) const
+    {
+        return this->impl->_durations[ index ];
+    }
+    
+    uint32_t TRUN::GetSampleSize( size_t index ) const
+    {
+        return this->impl->_sizes[ index ];
+    }
+    
+    uint32_t TRUN::GetSampleFlags( size_t index ) const
+    {
+        return this->impl->_flags[ index ];
+    }
+    
+    int64_t TRUN::GetSampleCompositionTimeOffset( size_t index ) const
+    {
+        /*
+         * Version 0 offsets are unsigned, version 1 offsets are signed.
+         */
+        if( this->GetVersion() == 0 )
+        {
+            return this->impl->_compositionTimeOffsets[ index ];
+        }
+        
+        return static_cast< int32_t >( this->impl->_compositionTimeOffsets[ index ] );
+    }
+    
+    void TRUN::SetDataOffset( int32_t value )
+    {
+        this->impl->_dataOffset = value;
+        this->SetModified( true );
+    }
+    
+    void TRUN::SetFirstSampleFlags( uint32_t value )
+    {
+        this->impl->_firstSampleFlags = value;
+        this->SetModified( true );
+    }
+    
+    void TRUN::AddSample( uint32_t duration, uint32_t size, uint32_t flags, int64_t compositionTimeOffset )
+    {
+        size_t count;
+        
+        /* Fields absent from a parsed box have no entries yet */
+        count = this->impl->_sampleCount;
+        
+        this->impl->_durations.resize( count );
+        this->impl->_sizes.resize( count );
+        this->impl->_flags.resize( count );
+        this->impl->_compositionTimeOffsets.resize( count );
+        
+        this->impl->_durations.push_back( duration );
+        this->impl->_sizes.push_back( size );
+        this->impl->_flags.push_back( flags );
+        this->impl->_compositionTimeOffsets.push_back( static_cast< uint32_t >( compositionTimeOffset ) );
+        
+        this->impl->_sampleCount++;
+        
+        this->SetModified( true );
+    }
+    
+    void TRUN::ClearSamples()
+    {
+        this->impl->_durations.clear();
+        this->impl->_sizes.clear();
+        this->impl->_flags.clear();
+        this->impl->_compositionTimeOffsets.clear();
+        
+        this->impl->_sampleCount = 0;
+        
+        this->SetModified( true );
+    }
+    
+    TRUN::IMPL::IMPL():
+        _sampleCount( 0 ),
+        _dataOffset( 0 ),
+        _firstSampleFlags( 0 )
+    {}
+    
+    TRUN::IMPL::IMPL( const IMPL & o ):
+        _sampleCount( o._sampleCount ),
+        _dataOffset( o._dataOffset ),
+        _firstSampleFlags( o._firstSampleFlags ),
+        _durations( o._durations ),
+        _sizes( o._sizes ),
+        _flags( o._flags ),
+        _compositionTimeOffsets( o._compositionTimeOffsets )
+    {}
+    
+    TRUN::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,387 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        Timeline.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/Timeline.hpp>
+#include <stdexcept>
+#include <limits>
+
+namespace ISOBMFF
+{
+    class Timeline::IMPL
+    {
+        public:
+            
+            IMPL( std::shared_ptr< ELST > elst, uint32_t movieTimescale, uint32_t mediaTimescale );
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            static uint64_t Rescale( uint64_t value, uint32_t to, uint32_t from );
+            
+            void    AddSegment( uint64_t duration, int64_t mediaTime, bool dwell );
+            int64_t GetMediaEnd( size_t index ) const;
+            
+            uint32_t                _movieTimescale;
+            uint32_t                _mediaTimescale;
+            std::vector< uint64_t > _movieTime;
+            std::vector< uint64_t > _duration;
+            std::vector< int64_t >  _mediaTime;
+            std::vector< bool >     _dwell;
+            std::vector< size_t >   _mediaOrder;
+            std::vector< int64_t >  _mediaOrderStart;
+            std::vector< int64_t >  _mediaOrderMaxEnd;
+    };
+    
+    static const uint64_t OpenDuration = std::numeric_limits< uint64_t >::max();
+    
+    Timeline::Timeline( std::shared_ptr< ELST > elst, uint32_t movieTimescale, uint32_t mediaTimescale ):
+        impl( std::make_unique< IMPL >( elst, movieTimescale, mediaTimescale ) )
+    {}
+    
+    Timeline::Timeline( const Timeline & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    Timeline::Timeline( Timeline && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    Timeline::~Timeline()
+    {}
+    
+    Timeline & Timeline::operator =( Timeline o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( Timeline & o1, Timeline & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint32_t Timeline::GetMovieTimescale() const
+    {
+        return this->impl->_movieTimescale;
+    }
+    
+    uint32_t Timeline::GetMediaTimescale() const
+    {
+        return this->impl->_mediaTimescale;
+    }
+    
+    size_t Timeline::GetSegmentCount() const
+    {
+        return this->impl->_movieTime.size();
+    }
+    
+    uint64_t Timeline::GetSegmentMovieTime( size_t index ) const
+    {
+        return this->impl->_movieTime[ index ];
+    }
+    
+    uint64_t Timeline::GetSegmentDuration( size_t index ) const
+    {
+        return this->impl->_duration[ index ];
+    }
+    
+    int64_t Timeline::GetSegmentMediaTime( size_t index ) const
+    {
+        return this->impl->_mediaTime[ index ];
+    }
+    
+    bool Timeline::IsEmptySegment( size_t index ) const
+    {
+        return this->impl->_mediaTime[ index ] < 0;
+    }
+    
+    uint64_t Timeline::GetInitialDelay() const
+    {
+        uint64_t delay( 0 );
+        
+        for( size_t i = 0; i < this->impl->_movieTime.size() && this->impl->_mediaTime[ i ] < 0; i++ )
+        {
+            delay += this->impl->_duration[ i ];
+        }
+        
+        return delay;
+    }
+    
+    bool Timeline::GetMediaTime( uint64_t movieTime, int64_t & mediaTime ) const
+    {
+        size_t index;
+        
+        if( this->impl->_movieTime.size() == 0 || movieTime < this->impl->_movieTime[ 0 ] )
+        {
+            return false;
+        }
+        
+        /*
+         * Last segment starting at or before the time. Zero-duration
+         * segments share their start with the next one, and are skipped.
+         */
+        index = static_cast< size_t >( std::upper_bound( this->impl->_movieTime.begin(), this->impl->_movieTime.end(), movieTime ) - this->impl->_movieTime.begin() ) - 1;
+        
+        if( this->impl->_mediaTime[ index ] < 0 )
+        {
+            return false;
+        }
+        
+        if( this->impl->_duration[ index ] != OpenDuration && movieTime - this->impl->_movieTime[ index ] >= this->impl->_duration[ index ] )
+        {
+            return false;
+        }
+        
+        mediaTime = this->impl->_mediaTime[ index ];
+        
+        if( this->impl->_dwell[ index ] == false )
+        {
+            mediaTime += static_cast< int64_t >( IMPL::Rescale( movieTime - this->impl->_movieTime[ index ], this->impl->_mediaTimescale, this->impl->_movieTimescale ) );
+        }
+        
+        return true;
+    }
+    
+    bool Timeline::GetMovieTime( int64_t mediaTime, uint64_t & movieTime ) const
+    {
+        size_t   count;
+        bool     found;
+        uint64_t time;
+        
+        found = false;
+        count = static_cast< size_t >( std::upper_bound( this->impl->_mediaOrderStart.begin(), this->impl->_mediaOrderStart.end(), mediaTime ) - this->impl->_mediaOrderStart.begin() );
+        
+        /*
+         * Segments are sorted by media start, and the running maximum of
+         * their media end stops the scan once no earlier segment can
+         * contain the time.
+         */
+        for( size_t i = count; i > 0 && this->impl->_mediaOrderMaxEnd[ i - 1 ] > mediaTime; i-- )
+        {
+            size_t index( this->impl->_mediaOrder[ i - 1 ] );
+            
+            if( mediaTime >= this->impl->GetMediaEnd( index ) )
+            {
+                continue;
+            }
+            
+            time = this->impl->_movieTime[ index ];
+            
+            if( this->impl->_dwell[ index ] == false )
+            {
+                time += IMPL::Rescale( static_cast< uint64_t >( mediaTime - this->impl->_mediaTime[ index ] ), this->impl->_movieTimescale, this->impl->_mediaTimescale );
+            }
+            
+            if( found == false || time < movieTime )
+            {
+                movieTime = time;
+                found     = true;
+            }
+        }
+        
+        return found;
+    }
+    
+    bool Timeline::GetSampleAtMovieTime( const SampleTable & table, uint64_t movieTime, uint64_t & sample ) const
+    {
+        int64_t  mediaTime;
+        int64_t  best;
+        bool     found;
+        uint64_t start;
+        
+        if( this->GetSyncSampleAtMovieTime( table, movieTime, sample ) == false )
+        {
+            return false;
+        }
+        
+        this->GetMediaTime( movieTime, mediaTime );
+        
+        start = sample;
+        best  = 0;
+        found = false;
+        
+        /*
+         * Decoding starts at the sync sample. The presented sample is the
+         * one with the latest composition time not after the target, and
+         * no sample of the next group of pictures can be presented before
+         * its decode time.
+         */
+        for( SampleTable::Iterator it( table, start ); it.HasSample(); it.Next() )
+        {
+            if( it.IsSync() && it.GetSample() != start && static_cast< int64_t >( it.GetDecodeTime() ) > mediaTime )
+            {
+                break;
+            }
+            
+            if( it.GetCompositionTime() <= mediaTime && ( found == false || it.GetCompositionTime() > best ) )
+            {
+                sample = it.GetSample();
+                best   = it.GetCompositionTime();
+                found  = true;
+            }
+        }
+        
+        return true;
+    }
+    
+    bool Timeline::GetSyncSampleAtMovieTime( const SampleTable & table, uint64_t movieTime, uint64_t & sample ) const
+    {
+        int64_t mediaTime;
+        
+        if( table.GetSampleCount() == 0 || this->GetMediaTime( movieTime, mediaTime ) == false )
+        {
+            return false;
+        }
+        
+        sample = table.GetSyncSampleAtOrBeforeTime( static_cast< uint64_t >( std::max< int64_t >( mediaTime, 0 ) ) );
+        
+        return true;
+    }
+    
+    Timeline::IMPL::IMPL( std::shared_ptr< ELST > elst, uint32_t movieTimescale, uint32_t mediaTimescale ):
+        _movieTimescale( movieTimescale ),
+        _mediaTimescale( mediaTimescale )
+    {
+        if( movieTimescale == 0 || mediaTimescale == 0 )
+        {
+            throw std::runtime_error( "Invalid timescale" );
+        }
+        
+        if( elst == nullptr || elst->GetEntryCount() == 0 )
+        {
+            this->AddSegment( OpenDuration, 0, false );
+        }
+        else
+        {
+            for( size_t i = 0; i < elst->GetEntryCount(); i++ )
+            {
+                uint64_t duration( elst->GetSegmentDuration( i ) );
+                int64_t  mediaTime( elst->GetMediaTime( i ) );
+                
+                /*
+                 * A zero duration on the last edit (eg. in fragmented
+                 * files) extends it to the end of the media.
+                 */
+                if( duration == 0 && mediaTime >= 0 && i == elst->GetEntryCount() - 1 )
+                {
+                    duration = OpenDuration;
+                }
+                
+                this->AddSegment( duration, ( mediaTime < 0 ) ? -1 : mediaTime, elst->GetMediaRateInteger( i ) == 0 && elst->GetMediaRateFraction( i ) == 0 );
+                
+                if( duration == OpenDuration )
+                {
+                    break;
+                }
+            }
+        }
+        
+        for( size_t i = 0; i < this->_movieTime.size(); i++ )
+        {
+            if( this->_mediaTime[ i ] >= 0 && this->_duration[ i ] > 0 )
+            {
+                this->_mediaOrder.push_back( i );
+            }
+        }
+        
+        std::stable_sort
+        (
+            this->_mediaOrder.begin(),
+            this->_mediaOrder.end(),
+            [ & ]( size_t i1, size_t i2 ) -> bool
+            {
+                return this->_mediaTime[ i1 ] < this->_mediaTime[ i2 ];
+            }
+        );
+        
+        for( size_t index: this->_mediaOrder )
+        {
+            this->_mediaOrderStart.push_back( this->_mediaTime[ index ] );
+            this->_mediaOrderMaxEnd.push_back( std::max( this->GetMediaEnd( index ), ( this->_mediaOrderMaxEnd.size() == 0 ) ? 0 : this->_mediaOrderMaxEnd.back() ) );
+        }
+    }
+    
+    Timeline::IMPL::IMPL( const IMPL & o ):
+        _movieTimescale( o._movieTimescale ),
+        _mediaTimescale( o._mediaTimescale ),
+        _movieTime( o._movieTime ),
+        _duration( o._duration ),
+        _mediaTime( o._mediaTime ),
+        _dwell( o._dwell ),
+        _mediaOrder( o._mediaOrder ),
+        _mediaOrderStart( o._mediaOrderStart ),
+        _mediaOrderMaxEnd( o._mediaOrderMaxEnd )
+    {}
+    
+    Timeline::IMPL::~IMPL()
+    {}
+    
+    uint64_t Timeline::IMPL::Rescale( uint64_t value, uint32_t to, uint32_t from )
+    {
+        /*
+         * Split to avoid overflowing the intermediate product.
+         */
+        return ( value / from ) * to + ( value % from ) * to / from;
+    }
+    
+    void Timeline::IMPL::AddSegment( uint64_t duration, int64_t mediaTime, bool dwell )
+    {
+        uint64_t start( 0 );
+        
+        if( this->_movieTime.size() > 0 )
+        {
+            start = this->_movieTime.back() + this->_duration.back();
+        }
+        
+        this->_movieTime.push_back( start );
+        this->_duration.push_back( duration );
+        this->_mediaTime.push_back( mediaTime );
+        this->_dwell.push_back( dwell );
+    }
+    
+    int64_t Timeline::IMPL::GetMediaEnd( size_t index ) const
+    {
+        if( this->_duration[ index ] == OpenDuration )
+        {
+            return std::numeric_limits< int64_t >::max();
+        }
+        
+        if( this->_dwell[ index ] )
+        {
+            return this->_mediaTime[ index ] + 1;
+        }
+        
+        return this->_mediaTime[ index ] + static_cast< int64_t >( Rescale( this->_duration[ index ], this->_mediaTimescale, this->_movieTimescale ) );
+    }
+}
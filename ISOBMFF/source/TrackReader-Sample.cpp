@@ -0,0 +1,172 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        TrackReader-Sample.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/TrackReader.hpp>
+
+namespace ISOBMFF
+{
+    class TrackReader::Sample::IMPL
+    {
+        public:
+            
+            IMPL();
+            IMPL( const IMPL & o );
+            ~IMPL();
+            
+            uint64_t                                        _index;
+            uint64_t                                        _offset;
+            uint64_t                                        _decodeTime;
+            int64_t                                         _compositionTime;
+            uint32_t                                        _duration;
+            bool                                            _sync;
+            uint32_t                                        _sampleDescriptionIndex;
+            const uint8_t                                 * _data;
+            size_t                                          _size;
+            std::shared_ptr< const std::vector< uint8_t > > _buffer;
+    };
+    
+    TrackReader::Sample::Sample():
+        impl( std::make_unique< IMPL >() )
+    {}
+    
+    TrackReader::Sample::Sample( const Sample & o ):
+        impl( std::make_unique< IMPL >( *( o.impl ) ) )
+    {}
+    
+    TrackReader::Sample::Sample( Sample && o ) noexcept:
+        impl( std::move( o.impl ) )
+    {
+        o.impl = nullptr;
+    }
+    
+    TrackReader::Sample::~Sample()
+    {}
+    
+    TrackReader::Sample & TrackReader::Sample::operator =( Sample o )
+    {
+        swap( *( this ), o );
+        
+        return *( this );
+    }
+    
+    void swap( TrackReader::Sample & o1, TrackReader::Sample & o2 )
+    {
+        using std::swap;
+        
+        swap( o1.impl, o2.impl );
+    }
+    
+    uint64_t TrackReader::Sample::GetIndex() const
+    {
+        return this->impl->_index;
+    }
+    
+    uint64_t TrackReader::Sample::GetOffset() const
+    {
+        return this->impl->_offset;
+    }
+    
+    uint64_t TrackReader::Sample::GetDecodeTime() const
+    {
+        return this->impl->_decodeTime;
+    }
+    
+    int64_t TrackReader::Sample::GetCompositionTime() const
+    {
+        return this->impl->_compositionTime;
+    }
+    
+    uint32_t TrackReader::Sample::GetDuration() const
+    {
+        return this->impl->_duration;
+    }
+    
+    bool TrackReader::Sample::IsSync() const
+    {
+        return this->impl->_sync;
+    }
+    
+    uint32_t TrackReader::Sample::GetSampleDescriptionIndex() const
+    {
+        return this->impl->_sampleDescriptionIndex;
+    }
+    
+    const uint8_t * TrackReader::Sample::GetData() const
+    {
+        return this->impl->_data;
+    }
+    
+    size_t TrackReader::Sample::GetSize() const
+    {
+        return this->impl->_size;
+    }
+    
+    void TrackReader::Sample::Set( const SampleTable::Iterator & it, const uint8_t * data, std::shared_ptr< const std::vector< uint8_t > > buffer )
+    {
+        this->impl->_index                  = it.GetSample();
+        this->impl->_offset                 = it.GetOffset();
+        this->impl->_decodeTime             = it.GetDecodeTime();
+        this->impl->_compositionTime        = it.GetCompositionTime();
+        this->impl->_duration               = it.GetDuration();
+        this->impl->_sync                   = it.IsSync();
+        this->impl->_sampleDescriptionIndex = it.GetSampleDescriptionIndex();
+        this->impl->_data                   = data;
+        this->impl->_size                   = static_cast< size_t >( it.GetSize() );
+        this->impl->_buffer                 = buffer;
+    }
+    
+    TrackReader::Sample::IMPL::IMPL():
+        _index( 0 ),
+        _offset( 0 ),
+        _decodeTime( 0 ),
+        _compositionTime( 0 ),
+        _duration( 0 ),
+        _sync( false ),
+        _sampleDescriptionIndex( 0 ),
+        _data( nullptr ),
+        _size( 0 )
+    {}
+    
+    TrackReader::Sample::IMPL::IMPL( const IMPL & o ):
+        _index( o._index ),
+        _offset( o._offset ),
+        _decodeTime( o._decodeTime ),
+        _compositionTime( o._compositionTime ),
+        _duration( o._duration ),
+        _sync( o._sync ),
+        _sampleDescriptionIndex( o._sampleDescriptionIndex ),
+        _data( o._data ),
+        _size( o._size ),
+        _buffer( o._buffer )
+    {}
+    
+    TrackReader::Sample::IMPL::~IMPL()
+    {}
+}
@@ -0,0 +1,285 @@
+/*******************************************************************************
+ * The MIT License (MIT)
+ * 
+ * Copyright (c) 2017 DigiDNA - www.digidna.net
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+/*!
+ * @file        TrackReader.cpp
+ * @copyright   (c) 2017, DigiDNA - www.digidna.net
+ * @author      Jean-David Gadina - www.digidna.net
+ */
+
+#include <ISOBMFF/TrackReader.hpp>
+#include <stdexcept>
+
+namespace ISOBMFF
+{
+    class TrackReader::IMPL
+    {
+        public:
+            
+            IMPL( const Container & trak, BinaryStream & stream, std::shared_ptr< BufferPool > pool );
+            ~IMPL();
+            
+            static const Container & GetSTBL( const Container & trak );
+            
+            void LoadBatch();
+            
+            BinaryStream                            & _stream;
+            std::shared_ptr< BufferPool >             _pool;
+            SampleTable                               _table;
+            SampleTable::Iterator                     _iterator;
+            const uint8_t                           * _bytes;
+            uint64_t                                  _streamSize;
+            size_t                                    _prefetchChunks;
+            uint64_t                                  _reads;
+            std::shared_ptr< std::vector< uint8_t > > _batch;
+            std::vector< size_t >                     _batchPositions;
+            uint64_t                                  _batchFirst;
+            uint64_t                                  _batchEnd;
+            std::shared_ptr< SampleDecryptor >        _decryptor;
+            std::shared_ptr< EncryptionIndex >        _encryptionIndex;
+    };
+    
+    /*
+     * Upper bound for a batch, so tracks stored as a few huge chunks do not
+     * end up fully loaded in memory. A batch always holds at least one
+     * sample.
+     */
+    static const uint64_t MaxBatchSize = 8 * 1024 * 1024;
+    
+    TrackReader::TrackReader( const Container & trak, BinaryStream & stream, std::shared_ptr< BufferPool > pool ):
+        impl( std::make_unique< IMPL >( trak, stream, pool ) )
+    {}
+    
+    TrackReader::~TrackReader()
+    {}
+    
+    const SampleTable & TrackReader::GetSampleTable() const
+    {
+        return this->impl->_table;
+    }
+    
+    size_t TrackReader::GetPrefetchChunks() const
+    {
+        return this->impl->_prefetchChunks;
+    }
+    
+    void TrackReader::SetPrefetchChunks( size_t value )
+    {
+        this->impl->_prefetchChunks = value;
+    }
+    
+    void TrackReader::SetDecryptor( std::shared_ptr< SampleDecryptor > decryptor, std::shared_ptr< EncryptionIndex > index )
+    {
+        if( decryptor != nullptr && index == nullptr )
+        {
+            throw std::runtime_error( "Missing encryption index" );
+        }
+        
+        this->impl->_decryptor       = decryptor;
+        this->impl->_encryptionIndex = index;
+        this->impl->_batchFirst      = 0;
+        this->impl->_batchEnd        = 0;
+        
+        this->impl->_batch.reset();
+    }
+    
+    uint64_t TrackReader::GetReadCount() const
+    {
+        return this->impl->_reads;
+    }
+    
+    bool TrackReader::HasSample() const
+    {
+        return this->impl->_iterator.HasSample();
+    }
+    
+    void TrackReader::Seek( uint64_t sample )
+    {
+        this->impl->_iterator   = this->impl->_table.GetIterator( sample );
+        this->impl->_batchFirst = 0;
+        this->impl->_batchEnd   = 0;
+        
+        this->impl->_batch.reset();
+    }
+    
+    bool TrackReader::ReadSample( Sample & sample )
+    {
+        SampleTable::Iterator & it( this->impl->_iterator );
+        
+        if( it.HasSample() == false )
+        {
+            return false;
+        }
+        
+        if( this->impl->_bytes != nullptr && this->impl->_decryptor == nullptr )
+        {
+            if( it.GetOffset() > this->impl->_streamSize || it.GetSize() > this->impl->_streamSize - it.GetOffset() )
+            {
+                throw std::runtime_error( "Invalid read - Not enough data available" );
+            }
+            
+            sample.Set( it, this->impl->_bytes + it.GetOffset(), nullptr );
+        }
+        else
+        {
+            if( it.GetSample() < this->impl->_batchFirst || it.GetSample() >= this->impl->_batchEnd )
+            {
+                this->impl->LoadBatch();
+            }
+            
+            sample.Set( it, this->impl->_batch->data() + this->impl->_batchPositions[ static_cast< size_t >( it.GetSample() - this->impl->_batchFirst ) ], this->impl->_batch );
+        }
+        
+        it.Next();
+        
+        return true;
+    }
+    
+    TrackReader::IMPL::IMPL( const Container & trak, BinaryStream & stream, std::shared_ptr< BufferPool > pool ):
+        _stream( stream ),
+        _pool( pool ),
+        _table( GetSTBL( trak ) ),
+        _iterator( _table ),
+        _bytes( stream.GetBytes() ),
+        _streamSize( 0 ),
+        _prefetchChunks( 0 ),
+        _reads( 0 ),
+        _batchFirst( 0 ),
+        _batchEnd( 0 )
+    {
+        if( this->_bytes != nullptr )
+        {
+            size_t pos( stream.Tell() );
+            
+            stream.Seek( 0, BinaryStream::SeekDirection::End );
+            
+            this->_streamSize = stream.Tell();
+            
+            stream.Seek( numeric_cast< std::streamoff >( pos ), BinaryStream::SeekDirection::Begin );
+        }
+    }
+    
+    TrackReader::IMPL::~IMPL()
+    {}
+    
+    const Container & TrackReader::IMPL::GetSTBL( const Container & trak )
+    {
+        std::shared_ptr< Container > mdia;
+        std::shared_ptr< Container > minf;
+        std::shared_ptr< Container > stbl;
+        
+        mdia = std::dynamic_pointer_cast< Container >( trak.GetBox( "mdia" ) );
+        minf = ( mdia == nullptr ) ? nullptr : std::dynamic_pointer_cast< Container >( mdia->GetBox( "minf" ) );
+        stbl = ( minf == nullptr ) ? nullptr : std::dynamic_pointer_cast< Container >( minf->GetBox( "stbl" ) );
+        
+        if( stbl == nullptr )
+        {
+            throw std::runtime_error( "Track has no sample table" );
+        }
+        
+        /*
+         * The box is owned by the track, which outlives the construction
+         * of the sample table.
+         */
+        return *( stbl );
+    }
+    
+    void TrackReader::IMPL::LoadBatch()
+    {
+        SampleTable::Iterator it( this->_iterator );
+        uint64_t              lastChunk;
+        uint64_t              size;
+        uint64_t              start;
+        uint64_t              end;
+        size_t                position;
+        
+        lastChunk = it.GetChunk() + this->_prefetchChunks;
+        size      = 0;
+        
+        this->_batchFirst = it.GetSample();
+        
+        this->_batchPositions.clear();
+        
+        /*
+         * Samples of a chunk are contiguous, so each sample's position in
+         * the batch buffer is the running total of the sizes.
+         */
+        for( ; it.HasSample() && it.GetChunk() <= lastChunk; it.Next() )
+        {
+            if( size > 0 && size + it.GetSize() > MaxBatchSize )
+            {
+                break;
+            }
+            
+            this->_batchPositions.push_back( static_cast< size_t >( size ) );
+            
+            size += it.GetSize();
+        }
+        
+        this->_batchEnd = it.GetSample();
+        this->_batch    = ( this->_pool != nullptr ) ? this->_pool->Acquire( static_cast< size_t >( size ) ) : std::make_shared< std::vector< uint8_t > >( static_cast< size_t >( size ) );
+        
+        /*
+         * One read per contiguous range: consecutive chunks written back to
+         * back in the file are merged.
+         */
+        it       = this->_iterator;
+        start    = it.GetOffset();
+        end      = start;
+        position = 0;
+        
+        for( ; it.HasSample() && it.GetSample() < this->_batchEnd; it.Next() )
+        {
+            if( it.GetOffset() != end )
+            {
+                this->_stream.Seek( numeric_cast< std::streamoff >( start ), BinaryStream::SeekDirection::Begin );
+                this->_stream.Read( this->_batch->data() + position, static_cast< size_t >( end - start ) );
+                this->_reads++;
+                
+                position += static_cast< size_t >( end - start );
+                start     = it.GetOffset();
+                end       = start;
+            }
+            
+            end += it.GetSize();
+        }
+        
+        if( end > start )
+        {
+            this->_stream.Seek( numeric_cast< std::streamoff >( start ), BinaryStream::SeekDirection::Begin );
+            this->_stream.Read( this->_batch->data() + position, static_cast< size_t >( end - start ) );
+            this->_reads++;
+        }
+        
+        if( this->_decryptor != nullptr )
+        {
+            it = this->_iterator;
+            
+            for( size_t i = 0; i < this->_batchPositions.size(); i++, it.Next() )
+            {
+                this->_decryptor->Decrypt( this->_batch->data() + this->_batchPositions[ i ], it.GetSize(), *( this->_encryptionIndex ), static_cast< size_t >( it.GetSample() ) );
+            }
+        }
+    }
+}
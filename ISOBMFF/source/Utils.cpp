@@ -118,5 +118,24 @@ namespace ISOBMFF
             
             return ss.str();
         }
+        
+        std::string ToHexString( const std::vector< uint8_t > & v )
+        {
+            std::stringstream ss;
+            
+            if( v.size() == 0 )
+            {
+                return "";
+            }
+            
+            ss << "0x" << std::hex << std::uppercase << std::setfill( '0' );
+            
+            for( uint8_t u: v )
+            {
+                ss << std::setw( 2 ) << static_cast< uint32_t >( u );
+            }
+            
+            return ss.str();
+        }
     }
 }